@@ -292,6 +292,8 @@ namespace
                 data->times.push_back(knot.time);
                 data->knots.push_back(knot);
             }
+
+            data->summary.Rebuild(data);
         }
     };
 }
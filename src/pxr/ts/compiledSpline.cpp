@@ -0,0 +1,176 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include "./compiledSpline.h"
+#include "./splineData.h"
+#include "./knotData.h"
+#include "./regressionPreventer.h"
+#include <pxr/gf/math.h>
+
+namespace pxr {
+
+// Convert Bezier control points to power-basis coefficients, in the order
+// (t^3, t^2, t, 1).  This is the same conversion that eval.cpp performs.
+//
+static void
+_GetPowerCoeffs(
+    const double p0,
+    const double p1,
+    const double p2,
+    const double p3,
+    double coeffsOut[4])
+{
+    coeffsOut[0] = -p0 + 3*p1 - 3*p2 + p3;
+    coeffsOut[1] = 3*p0 - 6*p1 + 3*p2;
+    coeffsOut[2] = -3*p0 + 3*p1;
+    coeffsOut[3] = p0;
+}
+
+static void
+_CompileBezier(
+    const Ts_TypedKnotData<double> &beginDataIn,
+    const Ts_TypedKnotData<double> &endDataIn,
+    Ts_CompiledSegment* const segment)
+{
+    // De-regress, as evaluation does, using the Keep Ratio strategy.
+    Ts_TypedKnotData<double> beginData = beginDataIn;
+    Ts_TypedKnotData<double> endData = endDataIn;
+    Ts_RegressionPreventerBatchAccess::ProcessSegment(
+        &beginData, &endData, TsAntiRegressionKeepRatio);
+
+    // Time cubic, relative to the segment start time.
+    const TsTime duration = endData.time - beginData.time;
+    double timeCoeffs[4];
+    _GetPowerCoeffs(
+        0,
+        beginData.GetPostTanWidth(),
+        duration - endData.GetPreTanWidth(),
+        duration,
+        timeCoeffs);
+
+    // Value cubic.
+    _GetPowerCoeffs(
+        beginData.value,
+        beginData.value + beginData.GetPostTanHeight(),
+        endData.GetPreValue() + endData.GetPreTanHeight(),
+        endData.GetPreValue(),
+        segment->valueCoeffs);
+
+    // Classify the time cubic the same way the evaluation-time solver does.
+    static constexpr double epsilon = 1e-10;
+    const bool aZero = GfIsClose(timeCoeffs[0], 0, epsilon);
+    const bool bZero = GfIsClose(timeCoeffs[1], 0, epsilon);
+    const bool cZero = GfIsClose(timeCoeffs[2], 0, epsilon);
+
+    // Constant time function.  Should never happen; leave it to the uncompiled
+    // path to diagnose.
+    if (aZero && bZero && cZero)
+    {
+        return;
+    }
+
+    segment->type = Ts_CompiledBezier;
+    segment->timeCoeffs[0] = timeCoeffs[0];
+    segment->timeCoeffs[1] = timeCoeffs[1];
+    segment->timeCoeffs[2] = timeCoeffs[2];
+
+    if (aZero && bZero)
+    {
+        segment->timeSolver = Ts_CompiledSolveLinear;
+    }
+    else if (aZero)
+    {
+        segment->timeSolver = Ts_CompiledSolveQuadratic;
+    }
+    else
+    {
+        segment->timeSolver = Ts_CompiledSolveCubic;
+        segment->normTimeCoeffs[0] = timeCoeffs[1] / timeCoeffs[0];
+        segment->normTimeCoeffs[1] = timeCoeffs[2] / timeCoeffs[0];
+    }
+}
+
+static void
+_CompileHermite(
+    const Ts_TypedKnotData<double> &beginData,
+    const Ts_TypedKnotData<double> &endData,
+    Ts_CompiledSegment* const segment)
+{
+    // Hermite tangents are a third of the segment long, so the time cubic is
+    // linear, and needs no coefficients.  The value cubic is the same as
+    // eval.cpp computes.
+    const TsTime duration = endData.time - beginData.time;
+    segment->type = Ts_CompiledHermite;
+    segment->duration = duration;
+    _GetPowerCoeffs(
+        beginData.value,
+        beginData.value + beginData.GetPostTanSlope() * duration / 3,
+        endData.GetPreValue() - endData.GetPreTanSlope() * duration / 3,
+        endData.GetPreValue(),
+        segment->valueCoeffs);
+}
+
+void
+Ts_CompileSegment(
+    const Ts_TypedKnotData<double> &beginData,
+    const Ts_TypedKnotData<double> &endData,
+    Ts_CompiledSegment* const segment)
+{
+    segment->startTime = beginData.time;
+    segment->startValue = beginData.value;
+    segment->endValue = endData.value;
+
+    switch (beginData.nextInterp)
+    {
+        case TsInterpHeld:
+            segment->type = Ts_CompiledHeld;
+            break;
+
+        case TsInterpLinear:
+            segment->type = Ts_CompiledLinear;
+            segment->slope = (endData.GetPreValue() - beginData.value) /
+                (endData.time - beginData.time);
+            break;
+
+        case TsInterpValueBlock:
+            segment->type = Ts_CompiledValueBlock;
+            break;
+
+        case TsInterpCurve:
+            if (beginData.curveType == TsCurveTypeBezier)
+            {
+                _CompileBezier(beginData, endData, segment);
+            }
+            else
+            {
+                _CompileHermite(beginData, endData, segment);
+            }
+            break;
+    }
+}
+
+Ts_CompiledSpline::Ts_CompiledSpline(
+    const Ts_SplineData* const data)
+{
+    const size_t numKnots = data->times.size();
+    if (numKnots < 2)
+    {
+        return;
+    }
+
+    segments.resize(numKnots - 1);
+
+    std::vector<Ts_TypedKnotData<double>> knots(numKnots);
+    data->GetKnotRangeAsDouble(0, numKnots, knots.data());
+    for (size_t i = 0; i < numKnots - 1; i++)
+    {
+        Ts_CompileSegment(knots[i], knots[i + 1], &segments[i]);
+    }
+}
+
+
+}  // namespace pxr
@@ -0,0 +1,118 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#ifndef PXR_TS_COMPILED_SPLINE_H
+#define PXR_TS_COMPILED_SPLINE_H
+
+#include "./api.h"
+#include "./knotData.h"
+#include "./types.h"
+
+#include <vector>
+
+namespace pxr {
+
+struct Ts_SplineData;
+
+
+// How the interior of a compiled segment is evaluated.
+//
+enum Ts_CompiledSegmentType
+{
+    Ts_CompiledHeld,
+    Ts_CompiledLinear,
+    Ts_CompiledBezier,
+    Ts_CompiledHermite,
+    Ts_CompiledValueBlock,
+
+    // The segment must be evaluated from knot data.  Used for segments that
+    // can't be compiled.
+    Ts_CompiledUncompiled
+};
+
+// How the time cubic of a compiled Bezier segment is inverted.  Degenerate
+// cubics are classified when compiling, so that evaluation needn't check.
+//
+enum Ts_CompiledTimeSolver
+{
+    Ts_CompiledSolveLinear,
+    Ts_CompiledSolveQuadratic,
+    Ts_CompiledSolveCubic
+};
+
+// Precomputed evaluation data for the interior of one segment, between two
+// authored knots.  Evaluation exactly at knots, in extrapolation regions, and
+// at loop boundaries still uses knot data; this covers the common case.
+//
+// Bezier segments are de-regressed, and their control points are converted to
+// power-basis coefficients, so that evaluation is one root solve and one
+// polynomial evaluation.  Hermite segments need no root solve, because their
+// time function is linear; evaluation is one polynomial evaluation.
+//
+struct Ts_CompiledSegment
+{
+    Ts_CompiledSegmentType type = Ts_CompiledUncompiled;
+    Ts_CompiledTimeSolver timeSolver = Ts_CompiledSolveCubic;
+
+    // Time and value of the start knot.  Held segments, and held evaluation of
+    // all segments, use startValue.
+    TsTime startTime = 0;
+    double startValue = 0;
+
+    // Value of the end knot (not its pre-value).  Bezier evaluation returns
+    // this when the solved parameter reaches the end of the segment.
+    double endValue = 0;
+
+    // Linear segments only.
+    double slope = 0;
+
+    // Hermite segments only.  Time from the start knot to the end knot.
+    TsTime duration = 0;
+
+    // Bezier segments only.  Coefficients of the t^3, t^2, and t terms of
+    // the time cubic.  Times are relative to startTime, so the constant term is
+    // always zero.
+    double timeCoeffs[3] = {};
+
+    // Bezier segments only.  The t^2 and t coefficients of the time cubic,
+    // divided by the t^3 coefficient.  Used by Ts_CompiledSolveCubic.
+    double normTimeCoeffs[2] = {};
+
+    // Bezier and Hermite segments only.  Coefficients of the t^3, t^2, t, and
+    // constant terms of the value cubic.
+    double valueCoeffs[4] = {};
+};
+
+// Precomputed evaluation data for a whole spline.  Immutable once built.
+// Cached on Ts_SplineData by TsSpline::Compile, and thus shared by all TsSpline
+// copies that share that data.
+//
+struct Ts_CompiledSpline
+{
+public:
+    explicit Ts_CompiledSpline(const Ts_SplineData *data);
+
+public:
+    // One entry per segment.  Entry i covers the interior of the segment that
+    // starts at knot i.  Empty if there are fewer than two knots.
+    std::vector<Ts_CompiledSegment> segments;
+};
+
+// Compiles the segment between two knots, as Ts_CompiledSpline does.  Used to
+// compile single segments of splines that haven't been compiled, when many
+// evaluations are known to fall in one segment.
+//
+TS_API
+void Ts_CompileSegment(
+    const Ts_TypedKnotData<double> &beginData,
+    const Ts_TypedKnotData<double> &endData,
+    Ts_CompiledSegment *segmentOut);
+
+
+}  // namespace pxr
+
+#endif
@@ -6,6 +6,8 @@
 // Modified by Jeremy Retailleau.
 
 #include "./eval.h"
+#include "./evalImpl.h"
+#include "./compiledSpline.h"
 #include "./splineData.h"
 #include "./regressionPreventer.h"
 #include "./debugCodes.h"
@@ -14,6 +16,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <initializer_list>
+#include <limits>
+#include <type_traits>
+#include <utility>
 
 namespace pxr {
 
@@ -90,8 +96,11 @@ namespace
     };
 }
 
+// Candidates are passed as an initializer list, which lives on the stack.  This
+// is part of the evaluation hot path, which must not allocate.
+//
 static double _FilterZeroes(
-    const std::vector<double> &candidates)
+    const std::initializer_list<double> candidates)
 {
     double result = 0;
     bool found = false;
@@ -224,70 +233,396 @@ static double _FindMonotonicZero(
         cubic.d / cubic.a);
 }
 
+// Upper bound on iterations for the iterative solvers.  Bisection alone reaches
+// the tightest useful tolerance in about 50 iterations; Newton and Halley steps
+// usually converge in a handful.
+static constexpr int _maxSolverIterations = 64;
+
+// Given the specified cubic coefficients; given that the caller has ensured
+// that the function is monotonically increasing on t in [lo, hi], and its
+// range there includes zero: find the unique t-value in [lo, hi] that causes
+// the function to have a zero value, starting from a guess t.  See
+// _FindMonotonicZeroIterative below.
+//
+static double _FindMonotonicZeroInBracket(
+    const _Cubic &cubic,
+    double lo,
+    double hi,
+    double t,
+    const TsEvalOptions &options)
+{
+    const bool halley = (options.bezierSolver == TsBezierSolverHalley);
+    const _Quadratic deriv = cubic.GetDerivative();
+
+    for (int i = 0; i < _maxSolverIterations; i++)
+    {
+        const double f = cubic.Eval(t);
+        if (f == 0)
+        {
+            break;
+        }
+
+        // The function is increasing, so its sign tells us which side of the
+        // zero we're on.
+        if (f < 0)
+        {
+            lo = t;
+        }
+        else
+        {
+            hi = t;
+        }
+
+        const double df = deriv.Eval(t);
+        double next = 0;
+        if (halley)
+        {
+            const double ddf = 6 * cubic.a * t + 2 * cubic.b;
+            next = t - (2 * f * df) / (2 * df * df - f * ddf);
+        }
+        else
+        {
+            next = t - f / df;
+        }
+
+        // Written to also reject NaN steps.
+        if (!(df > 0 && next > lo && next < hi))
+        {
+            next = 0.5 * (lo + hi);
+        }
+
+        const double step = std::abs(next - t);
+        t = next;
+        if (step <= options.solverTolerance)
+        {
+            break;
+        }
+    }
+
+    return t;
+}
+
+// Given the specified cubic coefficients; given that the caller has ensured
+// that the function is monotonically increasing on t in [0, 1], and its range
+// includes zero: find the unique t-value in [0, 1] that causes the function to
+// have a zero value.
+//
+// Uses Newton's or Halley's method, as specified by the options, seeded with
+// the linear guess.  Since the function is monotonic, each evaluation narrows a
+// bracket around the zero.  Any step that would leave the bracket, or that
+// can't be computed because the slope is zero, bisects instead.  This avoids
+// the transcendental functions and the near-zero-coefficient special cases of
+// Cardano's formula, and stays accurate near vertical tangents.
+//
+static double _FindMonotonicZeroIterative(
+    const _Cubic &cubic,
+    const TsEvalOptions &options)
+{
+    // Seed with the zero of the chord from f(0) to f(1).
+    const double rise = cubic.a + cubic.b + cubic.c;
+    const double t = (rise > 0 ? GfClamp(-cubic.d / rise, 0.0, 1.0) : 0.5);
+
+    return _FindMonotonicZeroInBracket(cubic, 0, 1, t, options);
+}
+
+// Find the t-value at which a Bezier time cubic is zero, using the solver
+// specified by the options.
+//
+static double _FindBezierZero(
+    const _Cubic &timeCubic,
+    const TsEvalOptions &options)
+{
+    if (options.bezierSolver == TsBezierSolverCardano)
+    {
+        return _FindMonotonicZero(timeCubic);
+    }
+
+    return _FindMonotonicZeroIterative(timeCubic, options);
+}
+
+// t should always be in [0, 1], but tolerate some slight imprecision.  Returns
+// t clamped to [0, 1].
+//
 static double
-_EvalBezier(
+_ClampBezierParameter(
+    const double t)
+{
+    static constexpr double epsilon = 1e-10;
+    if (t <= 0)
+    {
+        TF_VERIFY(t > -epsilon);
+        return 0;
+    }
+    else if (t >= 1)
+    {
+        TF_VERIFY(t < 1 + epsilon);
+        return 1;
+    }
+    return t;
+}
+
+// Derivatives of a Bezier segment with respect to time, at parameter t, given
+// the time and value cubics.
+//
+static double
+_GetBezierDerivative(
+    const _Cubic &timeCubic,
+    const _Cubic &valueCubic,
+    const double t)
+{
+    // Evaluate dy/dx (value delta over time delta)
+    // as dy/dt / dx/dt (quotient of derivatives).
+    const _Quadratic valueDeriv = valueCubic.GetDerivative();
+    const _Quadratic timeDeriv = timeCubic.GetDerivative();
+    return valueDeriv.Eval(t) / timeDeriv.Eval(t);
+}
+
+static double
+_GetBezierSecondDerivative(
+    const _Cubic &timeCubic,
+    const _Cubic &valueCubic,
+    const double t)
+{
+    // d2y/dx2 = (y''x' - y'x'') / x'^3, with primes denoting d/dt.
+    const _Quadratic valueDeriv = valueCubic.GetDerivative();
+    const _Quadratic timeDeriv = timeCubic.GetDerivative();
+    const double dx = timeDeriv.Eval(t);
+    const double dy = valueDeriv.Eval(t);
+    const double ddx = 2 * timeDeriv.a * t + timeDeriv.b;
+    const double ddy = 2 * valueDeriv.a * t + valueDeriv.b;
+    return (ddy * dx - dy * ddx) / (dx * dx * dx);
+}
+
+// De-regress a Bezier segment if necessary, and find its time and value
+// cubics.  The time cubic is offset by the eval time.
+//
+static void
+_GetBezierCubics(
     const Ts_TypedKnotData<double> &beginDataIn,
     const Ts_TypedKnotData<double> &endDataIn,
     const TsTime time,
-    const Ts_EvalAspect aspect)
+    _Cubic* const timeCubicOut,
+    _Cubic* const valueCubicOut)
 {
     // If the segment is regressive, de-regress it.
     // Our eval-time behavior always uses the Keep Ratio strategy.
-    Ts_TypedKnotData<double> beginData = beginDataIn;
-    Ts_TypedKnotData<double> endData = endDataIn;
-    Ts_RegressionPreventerBatchAccess::ProcessSegment(
-        &beginData, &endData, TsAntiRegressionKeepRatio);
+    // Most segments aren't regressive, so check first, and only copy the knots
+    // if we need to adjust them.
+    const Ts_TypedKnotData<double> *beginData = &beginDataIn;
+    const Ts_TypedKnotData<double> *endData = &endDataIn;
+    Ts_TypedKnotData<double> beginCopy, endCopy;
+    if (Ts_RegressionPreventerBatchAccess::IsSegmentRegressive(
+            &beginDataIn, &endDataIn, TsAntiRegressionKeepRatio))
+    {
+        beginCopy = beginDataIn;
+        endCopy = endDataIn;
+        Ts_RegressionPreventerBatchAccess::ProcessSegment(
+            &beginCopy, &endCopy, TsAntiRegressionKeepRatio);
+        beginData = &beginCopy;
+        endData = &endCopy;
+    }
 
     // Find the coefficients for x = f(t).
     // Offset everything by the eval time, so that we can just find a zero.
-    const _Cubic timeCubic = _Cubic::FromPoints(
-        beginData.time - time,
-        beginData.time + beginData.GetPostTanWidth() - time,
-        endData.time - endData.GetPreTanWidth() - time,
-        endData.time - time);
+    *timeCubicOut = _Cubic::FromPoints(
+        beginData->time - time,
+        beginData->time + beginData->GetPostTanWidth() - time,
+        endData->time - endData->GetPreTanWidth() - time,
+        endData->time - time);
+
+    // Find the coefficients for y = f(t).
+    *valueCubicOut = _Cubic::FromPoints(
+        beginData->value,
+        beginData->value + beginData->GetPostTanHeight(),
+        endData->GetPreValue() + endData->GetPreTanHeight(),
+        endData->GetPreValue());
+}
+
+// De-regress a Bezier segment if necessary, and solve it at an eval time.
+// Returns the parameter value, clamped to [0, 1], and the cubics.
+//
+static double
+_SolveBezier(
+    const Ts_TypedKnotData<double> &beginData,
+    const Ts_TypedKnotData<double> &endData,
+    const TsTime time,
+    const TsEvalOptions &options,
+    _Cubic* const timeCubicOut,
+    _Cubic* const valueCubicOut)
+{
+    _GetBezierCubics(beginData, endData, time, timeCubicOut, valueCubicOut);
 
     // Find the value of t for which f(t) = 0.
     // Due to the offset, this is the t-value at which we reach the eval time.
-    const double t = _FindMonotonicZero(timeCubic);
+    return _ClampBezierParameter(_FindBezierZero(*timeCubicOut, options));
+}
 
-    // t should always be in [0, 1], but tolerate some slight imprecision.
-    static constexpr double epsilon = 1e-10;
-    if (t <= 0)
+static double
+_EvalBezier(
+    const Ts_TypedKnotData<double> &beginData,
+    const Ts_TypedKnotData<double> &endData,
+    const TsTime time,
+    const Ts_EvalAspect aspect,
+    const TsEvalOptions &options)
+{
+    _Cubic timeCubic, valueCubic;
+    const double t = _SolveBezier(
+        beginData, endData, time, options, &timeCubic, &valueCubic);
+
+    if (aspect == Ts_EvalValue)
     {
-        TF_VERIFY(t > -epsilon);
-        return beginData.value;
+        // At the ends, return the knot values exactly.
+        if (t == 0)
+        {
+            return beginData.value;
+        }
+        if (t == 1)
+        {
+            return endData.value;
+        }
+
+        // Evaluate y = f(t).
+        return valueCubic.Eval(t);
     }
-    else if (t >= 1)
+    else
     {
-        TF_VERIFY(t < 1 + epsilon);
-        return endData.value;
+        return _GetBezierDerivative(timeCubic, valueCubic, t);
     }
+}
 
-    // Find the coefficients for y = f(t).
-    const _Cubic valueCubic = _Cubic::FromPoints(
-        beginData.value,
-        beginData.value + beginData.GetPostTanHeight(),
-        endData.GetPreValue() + endData.GetPreTanHeight(),
-        endData.GetPreValue());
+// Evaluate value and derivatives of a Bezier segment, with a single solve.
+// Equivalent to _EvalBezier for each aspect.
+//
+static Ts_EvalResults
+_EvalBezierWithDerivatives(
+    const Ts_TypedKnotData<double> &beginData,
+    const Ts_TypedKnotData<double> &endData,
+    const TsTime time,
+    const TsEvalOptions &options)
+{
+    _Cubic timeCubic, valueCubic;
+    const double t = _SolveBezier(
+        beginData, endData, time, options, &timeCubic, &valueCubic);
+
+    Ts_EvalResults result;
+    result.value = (t == 0 ? beginData.value :
+        t == 1 ? endData.value : valueCubic.Eval(t));
+    result.derivative = _GetBezierDerivative(timeCubic, valueCubic, t);
+    result.secondDerivative =
+        _GetBezierSecondDerivative(timeCubic, valueCubic, t);
+    return result;
+}
+
+// Evaluate a Bezier segment from precomputed coefficients.  Equivalent to
+// _EvalBezier, up to rounding.
+//
+static double
+_SolveCompiledBezier(
+    const Ts_CompiledSegment &segment,
+    const TsTime time,
+    const TsEvalOptions &options)
+{
+    // The time cubic is relative to the segment start time.  Its constant term
+    // is the offset that makes the eval time a zero.
+    const double *const tc = segment.timeCoeffs;
+    const double offset = segment.startTime - time;
+
+    // Find the value of t at which we reach the eval time.  The iterative
+    // solvers need no classification of the cubic.
+    double t = 0;
+    if (options.bezierSolver != TsBezierSolverCardano)
+    {
+        t = _FindMonotonicZeroIterative(
+            _Cubic{tc[0], tc[1], tc[2], offset}, options);
+    }
+    else
+    {
+        switch (segment.timeSolver)
+        {
+            case Ts_CompiledSolveLinear:
+                t = -offset / tc[2];
+                break;
+
+            case Ts_CompiledSolveQuadratic:
+                t = _FindMonotonicZero(_Quadratic{tc[1], tc[2], offset});
+                break;
+
+            case Ts_CompiledSolveCubic:
+                t = _FindMonotonicZero(
+                    segment.normTimeCoeffs[0],
+                    segment.normTimeCoeffs[1],
+                    offset / tc[0]);
+                break;
+        }
+    }
+
+    return _ClampBezierParameter(t);
+}
+
+static double
+_EvalCompiledBezier(
+    const Ts_CompiledSegment &segment,
+    const TsTime time,
+    const Ts_EvalAspect aspect,
+    const TsEvalOptions &options)
+{
+    const double t = _SolveCompiledBezier(segment, time, options);
+
+    const double *const tc = segment.timeCoeffs;
+    const double *const vc = segment.valueCoeffs;
+    const _Cubic valueCubic{vc[0], vc[1], vc[2], vc[3]};
 
     if (aspect == Ts_EvalValue)
     {
-        // Evaluate y = f(t).
+        if (t == 0)
+        {
+            return segment.startValue;
+        }
+        if (t == 1)
+        {
+            return segment.endValue;
+        }
         return valueCubic.Eval(t);
     }
     else
     {
-        // Evaluate dy/dx (value delta over time delta)
-        // as dy/dt / dx/dt (quotient of derivatives).
-        const _Quadratic valueDeriv = valueCubic.GetDerivative();
-        const _Quadratic timeDeriv = timeCubic.GetDerivative();
-        return valueDeriv.Eval(t) / timeDeriv.Eval(t);
+        const _Cubic timeCubic{tc[0], tc[1], tc[2], segment.startTime - time};
+        return _GetBezierDerivative(timeCubic, valueCubic, t);
     }
 }
 
+// Equivalent to _EvalCompiledBezier for each aspect.
+//
+static Ts_EvalResults
+_EvalCompiledBezierWithDerivatives(
+    const Ts_CompiledSegment &segment,
+    const TsTime time,
+    const TsEvalOptions &options)
+{
+    const double t = _SolveCompiledBezier(segment, time, options);
+
+    const double *const tc = segment.timeCoeffs;
+    const double *const vc = segment.valueCoeffs;
+    const _Cubic valueCubic{vc[0], vc[1], vc[2], vc[3]};
+    const _Cubic timeCubic{tc[0], tc[1], tc[2], segment.startTime - time};
+
+    Ts_EvalResults result;
+    result.value = (t == 0 ? segment.startValue :
+        t == 1 ? segment.endValue : valueCubic.Eval(t));
+    result.derivative = _GetBezierDerivative(timeCubic, valueCubic, t);
+    result.secondDerivative =
+        _GetBezierSecondDerivative(timeCubic, valueCubic, t);
+    return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // HERMITE MATH
 
+// Hermite tangents always extend a third of the way across the segment, so the
+// time function of the equivalent Bezier is linear: x(t) = t0 + t * duration.
+// That means we can find t directly from the eval time, with no root solve.
+// Hermite segments are also never regressive.
+//
 static double
 _EvalHermite(
     const Ts_TypedKnotData<double> &beginData,
@@ -295,28 +630,163 @@ _EvalHermite(
     const TsTime time,
     const Ts_EvalAspect aspect)
 {
-    // XXX TODO
-    TF_WARN("Hermite evaluation is not yet implemented");
-    return 0.0;
+    const TsTime duration = endData.time - beginData.time;
+    const double t = (time - beginData.time) / duration;
+
+    // Find the coefficients for y = f(t).
+    const _Cubic valueCubic = _Cubic::FromPoints(
+        beginData.value,
+        beginData.value + beginData.GetPostTanSlope() * duration / 3,
+        endData.GetPreValue() - endData.GetPreTanSlope() * duration / 3,
+        endData.GetPreValue());
+
+    if (aspect == Ts_EvalValue)
+    {
+        // Evaluate y = f(t).
+        return valueCubic.Eval(t);
+    }
+    else
+    {
+        // Evaluate dy/dx as dy/dt / dx/dt.  The latter is the duration.
+        return valueCubic.GetDerivative().Eval(t) / duration;
+    }
+}
+
+// Equivalent to _EvalHermite for each aspect.
+//
+static Ts_EvalResults
+_EvalHermiteWithDerivatives(
+    const Ts_TypedKnotData<double> &beginData,
+    const Ts_TypedKnotData<double> &endData,
+    const TsTime time)
+{
+    const TsTime duration = endData.time - beginData.time;
+    const double t = (time - beginData.time) / duration;
+
+    const _Cubic valueCubic = _Cubic::FromPoints(
+        beginData.value,
+        beginData.value + beginData.GetPostTanSlope() * duration / 3,
+        endData.GetPreValue() - endData.GetPreTanSlope() * duration / 3,
+        endData.GetPreValue());
+    const _Quadratic valueDeriv = valueCubic.GetDerivative();
+
+    Ts_EvalResults result;
+    result.value = valueCubic.Eval(t);
+    result.derivative = valueDeriv.Eval(t) / duration;
+    result.secondDerivative =
+        (2 * valueDeriv.a * t + valueDeriv.b) / (duration * duration);
+    return result;
+}
+
+// Evaluate a Hermite segment from precomputed coefficients.  Equivalent to
+// _EvalHermite.
+//
+static double
+_EvalCompiledHermite(
+    const Ts_CompiledSegment &segment,
+    const TsTime time,
+    const Ts_EvalAspect aspect)
+{
+    const double t = (time - segment.startTime) / segment.duration;
+    const double* const v = segment.valueCoeffs;
+
+    if (aspect == Ts_EvalValue)
+    {
+        return t * (t * (t * v[0] + v[1]) + v[2]) + v[3];
+    }
+    else
+    {
+        return (t * (t * (3 * v[0]) + 2 * v[1]) + v[2]) / segment.duration;
+    }
+}
+
+// Equivalent to _EvalCompiledHermite for each aspect.
+//
+static Ts_EvalResults
+_EvalCompiledHermiteWithDerivatives(
+    const Ts_CompiledSegment &segment,
+    const TsTime time)
+{
+    const double t = (time - segment.startTime) / segment.duration;
+    const double* const v = segment.valueCoeffs;
+
+    Ts_EvalResults result;
+    result.value = t * (t * (t * v[0] + v[1]) + v[2]) + v[3];
+    result.derivative =
+        (t * (t * (3 * v[0]) + 2 * v[1]) + v[2]) / segment.duration;
+    result.secondDerivative =
+        (t * (6 * v[0]) + 2 * v[1]) / (segment.duration * segment.duration);
+    return result;
+}
+
+// Returns the second derivative of a curved segment at its start or end.
+// There's no need to solve for the parameter there; it is 0 or 1.
+//
+static double
+_GetCurveSecondDerivativeAtEnd(
+    const Ts_TypedKnotData<double> &beginData,
+    const Ts_TypedKnotData<double> &endData,
+    const bool atEnd)
+{
+    if (beginData.curveType == TsCurveTypeBezier)
+    {
+        _Cubic timeCubic, valueCubic;
+        _GetBezierCubics(
+            beginData, endData, beginData.time, &timeCubic, &valueCubic);
+        return _GetBezierSecondDerivative(
+            timeCubic, valueCubic, atEnd ? 1.0 : 0.0);
+    }
+
+    return _EvalHermiteWithDerivatives(
+        beginData, endData,
+        atEnd ? endData.time : beginData.time).secondDerivative;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 // EVAL HELPERS
+//
+// Evaluation code below is templated on a combination of Ts_EvalFeature
+// values, and skips the handling of features that aren't present.
+
+template <unsigned Features>
+static constexpr bool _HasFeature(const unsigned feature)
+{
+    return (Features & feature) != 0;
+}
+
+// Returns a knot's pre-value.
+//
+template <unsigned Features>
+static double
+_GetPreValue(
+    const Ts_TypedKnotData<double> &knotData)
+{
+    if constexpr (_HasFeature<Features>(Ts_EvalFeatureDualValues))
+    {
+        return knotData.GetPreValue();
+    }
+    else
+    {
+        return knotData.value;
+    }
+}
 
 // Find the slope from one knot to another in a linear segment.  Such slopes are
 // implicit: based on times and values, not tangents.
 //
+template <unsigned Features>
 static double
 _GetSegmentSlope(
     const Ts_TypedKnotData<double> &beginData,
     const Ts_TypedKnotData<double> &endData)
 {
-    return (endData.GetPreValue() - beginData.value) /
+    return (_GetPreValue<Features>(endData) - beginData.value) /
         (endData.time - beginData.time);
 }
 
 // Find the slope in an extrapolation region.
 //
+template <unsigned Features>
 static std::optional<double>
 _GetExtrapolationSlope(
     const TsExtrapolation &extrap,
@@ -326,6 +796,13 @@ _GetExtrapolationSlope(
     const TsCurveType curveType,
     const Ts_EvalLocation location)
 {
+    // Without sloped extrapolation or value blocks, extrapolation is held.
+    if constexpr (!_HasFeature<Features>(
+                      Ts_EvalFeatureSlopedExtrap | Ts_EvalFeatureValueBlocks))
+    {
+        return 0.0;
+    }
+
     // None, Held, and Sloped have simple answers.
     if (extrap.mode == TsExtrapValueBlock)
     {
@@ -354,7 +831,8 @@ _GetExtrapolationSlope(
     }
 
     // If the end knot is dual-valued, the slope is flat.
-    if (endKnotData.dualValued)
+    if (_HasFeature<Features>(Ts_EvalFeatureDualValues)
+        && endKnotData.dualValued)
     {
         return 0.0;
     }
@@ -371,7 +849,7 @@ _GetExtrapolationSlope(
         // between the first two knots.
         if (endKnotData.nextInterp == TsInterpLinear)
         {
-            return _GetSegmentSlope(endKnotData, adjacentData);
+            return _GetSegmentSlope<Features>(endKnotData, adjacentData);
         }
 
         // Otherwise the first segment is curved.  The slope is continued from
@@ -390,7 +868,7 @@ _GetExtrapolationSlope(
         // between the last two knots.
         if (adjacentData.nextInterp == TsInterpLinear)
         {
-            return _GetSegmentSlope(adjacentData, endKnotData);
+            return _GetSegmentSlope<Features>(adjacentData, endKnotData);
         }
 
         // Otherwise the last segment is curved.  The slope is continued from
@@ -401,6 +879,7 @@ _GetExtrapolationSlope(
 
 // Extrapolate a straight line from a knot.
 //
+template <unsigned Features>
 static double
 _ExtrapolateLinear(
     const Ts_TypedKnotData<double> &knotData,
@@ -410,7 +889,8 @@ _ExtrapolateLinear(
 {
     if (location == Ts_EvalPre)
     {
-        return knotData.GetPreValue() - slope * (knotData.time - time);
+        return _GetPreValue<Features>(knotData)
+            - slope * (knotData.time - time);
     }
     else
     {
@@ -421,36 +901,318 @@ _ExtrapolateLinear(
 ////////////////////////////////////////////////////////////////////////////////
 // LOOPING
 
-namespace
+// Returns the evaluation features required by a spline's knots.
+//
+template <typename T>
+static unsigned
+_GetKnotFeatures(
+    const Ts_SplineData* const data)
 {
-    // When we evaluate in a loop echo region, we must consider copies of knots
-    // from the prototype region.  Rather than actually make those copies, we
-    // determine a location within the prototype region where we will evaluate
-    // instead.  This class computes that shift, accounting for both inner loops
-    // and extrapolating loops.
-    //
-    // GetEvalTime() returns the time at which to evaluate, which is in a
-    // non-echoed region.  GetEvalLocation() returns the location at which to
-    // evaluate, which can differ from the original in the case of oscillating
-    // extrapolation.  IsBetweenLastProtoAndEnd() returns whether we are in the
-    // special case of evaluating (after the shift) between the last prototype
-    // knot and the end of the prototype region.
-    //
-    // ReplaceBoundaryKnots() handles some inner-looping interpolation cases:
-    // between the last knot of one loop iteration and the first knot of the
-    // next, and between an echoed knot and an unlooped one.  The previous and
-    // next knots are passed in, and one of them may be replaced by a shifted
-    // copy of the first prototype knot.  Replace{Pre,Post}ExtrapKnots does the
-    // same thing for extrapolating cases, where the final knots may be created
-    // by inner-loop copying.
-    //
-    // GetValueOffset() returns an amount to add to the value obtained at the
-    // shifted evaluation time.  This supports cases where the copied knots are
-    // offset in the value dimension.  GetValueOffset() is always zero when
-    // evaluating derivatives, which aren't affected by value offsets.
-    //
-    // GetNegate() returns whether the value should be negated.  This can be
-    // needed for derivatives in oscillating loops.
+    unsigned features = 0;
+
+    for (const Ts_TypedKnotData<T> &knotData :
+             static_cast<const Ts_TypedSplineData<T>*>(data)->knots)
+    {
+        if (knotData.dualValued)
+        {
+            features |= Ts_EvalFeatureDualValues;
+        }
+
+        if (knotData.nextInterp == TsInterpCurve)
+        {
+            features |= (knotData.curveType == TsCurveTypeBezier ?
+                Ts_EvalFeatureBezier : Ts_EvalFeatureHermite);
+        }
+        else if (knotData.nextInterp == TsInterpValueBlock)
+        {
+            features |= Ts_EvalFeatureValueBlocks;
+        }
+    }
+
+    return features;
+}
+
+// Copies a prototype knot, shifted by a number of prototype iterations.
+//
+static Ts_LoopTopology::EchoedKnot
+_EchoProtoKnot(
+    const Ts_SplineData* const data,
+    const size_t index,
+    const int shiftIters)
+{
+    const TsLoopParams &lp = data->loopParams;
+    const TsTime protoSpan = lp.GetPrototypeInterval().GetSize();
+
+    Ts_LoopTopology::EchoedKnot echo;
+    echo.knot = data->GetKnotDataAsDouble(index);
+    echo.knot.time += shiftIters * protoSpan;
+    echo.valueOffset = shiftIters * lp.valueOffset;
+    return echo;
+}
+
+Ts_TypedKnotData<double>
+Ts_LoopTopology::EchoedKnot::Get(
+    const Ts_EvalAspect aspect) const
+{
+    Ts_TypedKnotData<double> result = knot;
+
+    // Shift value.
+    if (aspect == Ts_EvalValue)
+    {
+        result.value += valueOffset;
+        if (result.dualValued)
+        {
+            result.preValue += valueOffset;
+        }
+    }
+
+    return result;
+}
+
+Ts_LoopTopology::Ts_LoopTopology(
+    const Ts_SplineData* const data)
+{
+    // Is inner looping enabled?
+    haveInnerLoops = data->HasInnerLoops(&firstInnerProtoIndex);
+
+    // We have multiple knots if there are multiple authored.  We also always
+    // have at least two knots if there is valid inner looping.
+    const bool haveMultipleKnots =
+        (haveInnerLoops || data->times.size() > 1);
+
+    // Are any extrapolating loops enabled?
+    havePreExtrapLoops =
+        haveMultipleKnots && data->preExtrapolation.IsLooping();
+    havePostExtrapLoops =
+        haveMultipleKnots && data->postExtrapolation.IsLooping();
+
+    _InitFeatures(data);
+
+    // Anything to do?
+    if (!haveInnerLoops && !havePreExtrapLoops && !havePostExtrapLoops)
+    {
+        return;
+    }
+
+    // Find first and last knot times.  These may be authored, or they may be
+    // echoed.
+    const TsTime rawFirstTime = firstTime = data->times.front();
+    const TsTime rawLastTime = lastTime = data->times.back();
+    if (haveInnerLoops)
+    {
+        const GfInterval loopedInterval = data->loopParams.GetLoopedInterval();
+
+        if (loopedInterval.GetMin() < rawFirstTime)
+        {
+            firstTime = loopedInterval.GetMin();
+            firstTimeLooped = true;
+        }
+
+        if (loopedInterval.GetMax() > rawLastTime)
+        {
+            lastTime = loopedInterval.GetMax();
+            lastTimeLooped = true;
+        }
+    }
+
+    if (haveInnerLoops)
+    {
+        _InitInnerLoops(data);
+    }
+
+    if (havePreExtrapLoops || havePostExtrapLoops)
+    {
+        _InitExtrapLoops(data);
+    }
+}
+
+void Ts_LoopTopology::_InitFeatures(
+    const Ts_SplineData* const data)
+{
+    if (haveInnerLoops || havePreExtrapLoops || havePostExtrapLoops)
+    {
+        features |= Ts_EvalFeatureLoops;
+    }
+
+    // Held extrapolation needs no slope computation.  Looping modes are
+    // treated like sloped ones: a looped side can still reach the extrapolation
+    // slope code, for derivatives at the first and last knots.
+    for (const TsExtrapolation *extrap :
+             {&data->preExtrapolation, &data->postExtrapolation})
+    {
+        if (extrap->mode == TsExtrapValueBlock)
+        {
+            features |= Ts_EvalFeatureValueBlocks;
+        }
+        else if (extrap->mode != TsExtrapHeld)
+        {
+            features |= Ts_EvalFeatureSlopedExtrap;
+        }
+    }
+
+    const TfType valueType = data->GetValueType();
+    if (valueType == Ts_GetType<double>())
+    {
+        features |= _GetKnotFeatures<double>(data);
+    }
+    else if (valueType == Ts_GetType<float>())
+    {
+        features |= _GetKnotFeatures<float>(data);
+    }
+    else if (valueType == Ts_GetType<GfHalf>())
+    {
+        features |= _GetKnotFeatures<GfHalf>(data);
+    }
+    else
+    {
+        features = Ts_EvalFeatureAll;
+    }
+}
+
+void Ts_LoopTopology::_InitInnerLoops(
+    const Ts_SplineData* const data)
+{
+    const TsLoopParams &lp = data->loopParams;
+    const GfInterval loopedInterval = lp.GetLoopedInterval();
+    const GfInterval protoInterval = lp.GetPrototypeInterval();
+
+    const std::vector<TsTime> &times = data->times;
+    const auto firstProtoIt = times.begin() + firstInnerProtoIndex;
+
+    // Find the last prototype knot.  Use binary search to find the first knot
+    // at or after prototype end, and unconditionally take the preceding knot.
+    // If there is no knot equal or greater, we want the last knot.  If there
+    // is a knot that is greater but not one that is equal, we want the one
+    // before that.  If there is a knot that is exactly at the end of the
+    // prototype, that isn't part of the prototype, and we want the one before
+    // it.  In all cases, it is OK if the last prototype knot is also the first
+    // and only prototype knot.
+    const auto lastProtoIt = std::lower_bound(
+        firstProtoIt, times.end(), lp.protoEnd) - 1;
+    lastInnerProtoIndex = lastProtoIt - times.begin();
+    lastInnerProtoTime = *lastProtoIt;
+
+    // Use binary search to find first authored knot at or after start of
+    // looping region.  This may be a shadowed knot or a prototype knot.  If it
+    // isn't the overall first knot, the preceding one is the last pre-unlooped
+    // knot.
+    const auto lbIt = std::lower_bound(
+        times.begin(), firstProtoIt, loopedInterval.GetMin());
+    if (lbIt != times.begin())
+    {
+        lastPreUnloopedTime = *(lbIt - 1);
+    }
+
+    // Use binary search to find first authored knot strictly after end of
+    // looping region.  (Note upper_bound here instead of lower_bound.)
+    const auto ubIt = std::upper_bound(
+        firstProtoIt + 1, times.end(), loopedInterval.GetMax());
+    if (ubIt != times.end())
+    {
+        firstPostUnloopedTime = *ubIt;
+    }
+
+    // Echoes of the first prototype knot.
+    protoEndKnot = _EchoProtoKnot(data, firstInnerProtoIndex, 1);
+    loopStartKnot = _EchoProtoKnot(
+        data, firstInnerProtoIndex, -lp.numPreLoops);
+    loopEndKnot = _EchoProtoKnot(
+        data, firstInnerProtoIndex, lp.numPostLoops + 1);
+
+    // When the first knot is an echo, the second is a copy of the second
+    // prototype knot.  If there are no knots after the first prototype knot,
+    // the second is another copy of the first.
+    if (firstTimeLooped)
+    {
+        if (times.size() > firstInnerProtoIndex + 1
+            && protoInterval.Contains(times[firstInnerProtoIndex + 1]))
+        {
+            secondKnot = _EchoProtoKnot(
+                data, firstInnerProtoIndex + 1, -lp.numPreLoops);
+        }
+        else
+        {
+            secondKnot = _EchoProtoKnot(
+                data, firstInnerProtoIndex, -lp.numPreLoops + 1);
+        }
+    }
+
+    // When the last knot is an echo, the second-to-last is a copy of the last
+    // prototype knot.
+    if (lastTimeLooped)
+    {
+        secondToLastKnot = _EchoProtoKnot(
+            data, lastInnerProtoIndex, lp.numPostLoops);
+    }
+}
+
+void Ts_LoopTopology::_InitExtrapLoops(
+    const Ts_SplineData* const data)
+{
+    const TsLoopParams &lp = data->loopParams;
+
+    double firstValue;
+    if (!firstTimeLooped)
+    {
+        // Earliest knot is not from inner loops.  Read its value.
+        firstValue = data->GetKnotDataAsDouble(0).GetPreValue();
+    }
+    else
+    {
+        // Earliest knot is from inner loops.  Compute its value.
+        firstValue =
+            data->GetKnotDataAsDouble(firstInnerProtoIndex).GetPreValue()
+            - lp.numPreLoops * lp.valueOffset;
+    }
+
+    double lastValue;
+    if (!lastTimeLooped)
+    {
+        // Latest knot is not from inner loops.  Read its value.
+        lastValue = data->GetKnotDataAsDouble(data->times.size() - 1).value;
+    }
+    else
+    {
+        // Latest knot is from inner loops.  It is the final echo of the
+        // prototype start knot.  Compute its value.
+        lastValue =
+            data->GetKnotDataAsDouble(firstInnerProtoIndex).value
+            + (lp.numPostLoops + 1) * lp.valueOffset;
+    }
+
+    extrapValueOffset = lastValue - firstValue;
+}
+
+namespace
+{
+    // When we evaluate in a loop echo region, we must consider copies of knots
+    // from the prototype region.  Rather than actually make those copies, we
+    // determine a location within the prototype region where we will evaluate
+    // instead.  This class computes that shift, accounting for both inner loops
+    // and extrapolating loops.
+    //
+    // GetEvalTime() returns the time at which to evaluate, which is in a
+    // non-echoed region.  GetEvalLocation() returns the location at which to
+    // evaluate, which can differ from the original in the case of oscillating
+    // extrapolation.  IsBetweenLastProtoAndEnd() returns whether we are in the
+    // special case of evaluating (after the shift) between the last prototype
+    // knot and the end of the prototype region.
+    //
+    // ReplaceBoundaryKnots() handles some inner-looping interpolation cases:
+    // between the last knot of one loop iteration and the first knot of the
+    // next, and between an echoed knot and an unlooped one.  The previous and
+    // next knots are passed in, and one of them may be replaced by a shifted
+    // copy of the first prototype knot.  Replace{Pre,Post}ExtrapKnots does the
+    // same thing for extrapolating cases, where the final knots may be created
+    // by inner-loop copying.
+    //
+    // GetValueOffset() returns an amount to add to the value obtained at the
+    // shifted evaluation time.  This supports cases where the copied knots are
+    // offset in the value dimension.  GetValueOffset() is always zero when
+    // evaluating derivatives, which aren't affected by value offsets.
+    //
+    // GetNegate() returns whether the value should be negated.  This can be
+    // needed for derivatives in oscillating loops.
     //
     class _LoopResolver
     {
@@ -458,6 +1220,7 @@ namespace
         // Constructor performs all computation.
         _LoopResolver(
             const Ts_SplineData *data,
+            const Ts_LoopTopology &topology,
             TsTime time,
             Ts_EvalAspect aspect,
             Ts_EvalLocation location);
@@ -470,6 +1233,14 @@ namespace
         double GetValueOffset() const { return _valueOffset; }
         bool GetNegate() const { return _negate; }
 
+        // Returns whether ReplaceBoundaryKnots will replace either knot.
+        bool HasBoundaryKnots() const
+        {
+            return _betweenLastProtoAndEnd
+                || _betweenPreUnloopedAndLooped
+                || _betweenLoopedAndPostUnlooped;
+        }
+
         // Knot copiers for special cases.
         void ReplaceBoundaryKnots(
             Ts_TypedKnotData<double> *prevData,
@@ -488,14 +1259,11 @@ namespace
             const TsExtrapolation &extrapolation,
             TsTime offset,
             bool isPre);
-        void _ComputeExtrapValueOffset();
-        Ts_TypedKnotData<double> _CopyProtoKnotData(
-            size_t index,
-            int shiftIters) const;
 
     private:
         // Inputs.
         const Ts_SplineData* const _data;
+        const Ts_LoopTopology &_topology;
         const Ts_EvalAspect _aspect;
 
         // Inputs that may be altered, and serve as outputs.
@@ -508,75 +1276,31 @@ namespace
         bool _betweenLastProtoAndEnd = false;
 
         // Intermediate data.
-        bool _haveInnerLoops = false;
-        size_t _firstInnerProtoIndex = 0;
-        bool _havePreExtrapLoops = false;
-        bool _havePostExtrapLoops = false;
-        TsTime _firstTime = 0;
-        TsTime _lastTime = 0;
-        bool _firstTimeLooped = false;
-        bool _lastTimeLooped = false;
-        bool _doPreExtrap = false;
-        bool _doPostExtrap = false;
-        double _extrapValueOffset = 0;
         bool _betweenPreUnloopedAndLooped = false;
         bool _betweenLoopedAndPostUnlooped = false;
-        Ts_TypedKnotData<double> _extrapKnot1;
-        Ts_TypedKnotData<double> _extrapKnot2;
     };
 }
 
 _LoopResolver::_LoopResolver(
     const Ts_SplineData* const data,
+    const Ts_LoopTopology &topology,
     const TsTime timeIn,
     const Ts_EvalAspect aspect,
     const Ts_EvalLocation location)
     : _data(data),
+      _topology(topology),
       _aspect(aspect),
       _evalTime(timeIn),
       _location(location)
 {
-    // Is inner looping enabled?
-    _haveInnerLoops = _data->HasInnerLoops(&_firstInnerProtoIndex);
-
-    // We have multiple knots if there are multiple authored.  We also always
-    // have at least two knots if there is valid inner looping.
-    const bool haveMultipleKnots =
-        (_haveInnerLoops || _data->times.size() > 1);
-
-    // Are any extrapolating loops enabled?
-    _havePreExtrapLoops =
-        haveMultipleKnots && _data->preExtrapolation.IsLooping();
-    _havePostExtrapLoops =
-        haveMultipleKnots && _data->postExtrapolation.IsLooping();
-
     // Anything to do?
-    if (!_haveInnerLoops && !_havePreExtrapLoops && !_havePostExtrapLoops)
+    if (!_topology.haveInnerLoops
+        && !_topology.havePreExtrapLoops
+        && !_topology.havePostExtrapLoops)
     {
         return;
     }
 
-    // Find first and last knot times.  These may be authored, or they may be
-    // echoed.
-    const TsTime rawFirstTime = _firstTime = _data->times.front();
-    const TsTime rawLastTime = _lastTime = _data->times.back();
-    if (_haveInnerLoops)
-    {
-        const GfInterval loopedInterval = _data->loopParams.GetLoopedInterval();
-
-        if (loopedInterval.GetMin() < rawFirstTime)
-        {
-            _firstTime = loopedInterval.GetMin();
-            _firstTimeLooped = true;
-        }
-
-        if (loopedInterval.GetMax() > rawLastTime)
-        {
-            _lastTime = loopedInterval.GetMax();
-            _lastTimeLooped = true;
-        }
-    }
-
     TF_DEBUG_MSG(
         TS_DEBUG_LOOPS,
         "\n"
@@ -588,21 +1312,21 @@ _LoopResolver::_LoopResolver(
         "  firstTimeLooped: %d\n"
         "  lastTimeLooped: %d\n",
         _evalTime,
-        _haveInnerLoops,
-        _havePreExtrapLoops,
-        _havePostExtrapLoops,
-        _firstTimeLooped,
-        _lastTimeLooped);
+        _topology.haveInnerLoops,
+        _topology.havePreExtrapLoops,
+        _topology.havePostExtrapLoops,
+        _topology.firstTimeLooped,
+        _topology.lastTimeLooped);
 
     // Resolve.  If we have both extrapolating and inner loops, handle
     // extrapolating loops first, then inner loops.  We are reversing the
     // procedure of knot copying, which copies knots from inner loops first,
     // then from extrapolating loops.
-    if (_havePreExtrapLoops || _havePostExtrapLoops)
+    if (_topology.havePreExtrapLoops || _topology.havePostExtrapLoops)
     {
         _ResolveExtrap();
     }
-    if (_haveInnerLoops)
+    if (_topology.haveInnerLoops)
     {
         _ResolveInner();
     }
@@ -620,7 +1344,7 @@ void _LoopResolver::_ResolveInner()
         "  numPreLoops: %d\n"
         "  numPostLoops: %d\n"
         "  valueOffset: %g\n",
-        _firstInnerProtoIndex,
+        _topology.firstInnerProtoIndex,
         _data->loopParams.protoStart,
         _data->loopParams.protoEnd,
         _data->loopParams.numPreLoops,
@@ -672,127 +1396,45 @@ void _LoopResolver::_ResolveInner()
         }
     }
 
-    // Look for special interpolation and extrapolation cases.
-
-    const std::vector<TsTime> &times = _data->times;
-    const auto firstProtoIt = times.begin() + _firstInnerProtoIndex;
+    // Look for special interpolation and extrapolation cases.  The knots
+    // involved were found when building the topology.
 
     // Case 1: between last prototype knot and prototype end, after performing
     // shift out of echo region, if any.
     if (protoInterval.Contains(_evalTime))
     {
-        // Use binary search to find first knot at or after prototype end.
-        const auto lbIt = std::lower_bound(
-            firstProtoIt, times.end(), lp.protoEnd);
-
-        // Unconditionally take the preceding knot as the last in the
-        // prototype.  If there is no knot equal or greater, we want the last
-        // knot.  If there is a knot that is greater but not one that is equal,
-        // we want the one before that.  If there is a knot that is exactly at
-        // the end of the prototype, that isn't part of the prototype, and we
-        // want the one before it.  In all cases, it is OK if the last prototype
-        // knot is also the first and only prototype knot.
-        const TsTime lastProtoKnotTime = *(lbIt - 1);
-
         // Check whether we are evaluating after the last prototype knot.
-        if (_evalTime > lastProtoKnotTime)
+        if (_evalTime > _topology.lastInnerProtoTime)
         {
             _betweenLastProtoAndEnd = true;
         }
     }
 
-    // Case 2: pre-extrapolating, and the first knots are copies made by inner
-    // looping.
-    else if (_evalTime < _firstTime)
-    {
-        if (_firstTimeLooped)
-        {
-            // First knot is always a copy of the first prototype knot.
-            _extrapKnot1 = _CopyProtoKnotData(
-                _firstInnerProtoIndex, -lp.numPreLoops);
-
-            if (_data->times.size() > _firstInnerProtoIndex + 1
-                && protoInterval.Contains(
-                    _data->times[_firstInnerProtoIndex + 1]))
-            {
-                // Second knot is a copy of the second prototype knot.
-                _extrapKnot2 = _CopyProtoKnotData(
-                    _firstInnerProtoIndex + 1, -lp.numPreLoops);
-            }
-            else
-            {
-                // There are no knots after the first prototype knot, so the
-                // second is another copy of the first.
-                _extrapKnot2 = _CopyProtoKnotData(
-                    _firstInnerProtoIndex, -lp.numPreLoops + 1);
-            }
-        }
-    }
-
-    // Case 3: post-extrapolating, and the last knots are copies mad by inner
-    // looping.
-    else if (_evalTime > _lastTime)
+    // Cases 2 and 3: pre- or post-extrapolating.
+    else if (_evalTime < _topology.firstTime
+             || _evalTime > _topology.lastTime)
     {
-        if (_lastTimeLooped)
-        {
-            // Last knot is always a copy of the first prototype knot.
-            _extrapKnot1 = _CopyProtoKnotData(
-                _firstInnerProtoIndex, lp.numPostLoops + 1);
-
-            // Find last authored prototype knot, which may also be the first.
-            // See comments in Case 1 above.
-            const auto lastProtoIt = std::lower_bound(
-                firstProtoIt, times.end(), lp.protoEnd) - 1;
-            const size_t lastProtoIndex = lastProtoIt - _data->times.begin();
-
-            // Second-to-last knot is a copy of the last prototype knot.
-            _extrapKnot2 = _CopyProtoKnotData(
-                lastProtoIndex, lp.numPostLoops);
-        }
+        // Nothing to record.  If the first or last knots are copies made by
+        // inner looping, Replace{Pre,Post}ExtrapKnots supplies them.
     }
 
     // Case 4: between last knot before looping region and start of looping
-    // region.
+    // region.  If there is no such knot, the comparison fails.
     else if (_evalTime < loopedInterval.GetMin())
     {
-        // Use binary search to find first authored knot at or after start of
-        // looping region.  This may be a shadowed knot or a prototype knot.
-        const auto lbIt = std::lower_bound(
-            times.begin(), firstProtoIt, loopedInterval.GetMin());
-
-        // If the first knot in the looping region isn't the overall first knot,
-        // take the preceding one as the last pre-unlooped knot.
-        if (lbIt != times.begin())
+        if (_evalTime > _topology.lastPreUnloopedTime)
         {
-            const TsTime lastPreUnloopedKnotTime = *(lbIt - 1);
-
-            // Check whether we are evaluating after last pre-unlooped knot.
-            if (_evalTime > lastPreUnloopedKnotTime)
-            {
-                _betweenPreUnloopedAndLooped = true;
-            }
+            _betweenPreUnloopedAndLooped = true;
         }
     }
 
     // Case 5: between end of looping region and first knot after looping
-    // region.
+    // region.  If there is no such knot, the comparison fails.
     else if (_evalTime > loopedInterval.GetMax())
     {
-        // Use binary search to find first authored knot strictly after end of
-        // looping region.  (Note upper_bound here instead of lower_bound.)
-        const auto ubIt = std::upper_bound(
-            firstProtoIt + 1, times.end(), loopedInterval.GetMax());
-
-        // If we found such a knot, it's the one we want.
-        if (ubIt != times.end())
+        if (_evalTime < _topology.firstPostUnloopedTime)
         {
-            const TsTime firstPostUnloopedKnotTime = *ubIt;
-
-            // Check whether we are evaluating before first post-unlooped knot.
-            if (_evalTime < firstPostUnloopedKnotTime)
-            {
-                _betweenLoopedAndPostUnlooped = true;
-            }
+            _betweenLoopedAndPostUnlooped = true;
         }
     }
 
@@ -816,7 +1458,7 @@ void _LoopResolver::_ResolveExtrap()
     // Determine the interval that doesn't require extrapolation.  One end is
     // closed, the other is open; which one depends on the eval location.
     const GfInterval knotInterval(
-        _firstTime, _lastTime,
+        _topology.firstTime, _topology.lastTime,
         /* minClosed = */ (_location != Ts_EvalPre),
         /* maxClosed = */ (_location == Ts_EvalPre));
 
@@ -827,21 +1469,25 @@ void _LoopResolver::_ResolveExtrap()
     }
 
     // Is the extrapolation looped?
-    _doPreExtrap = (_havePreExtrapLoops && _evalTime < _lastTime);
-    _doPostExtrap = (_havePostExtrapLoops && _evalTime > _firstTime);
-    if (!_doPreExtrap && !_doPostExtrap)
+    const bool doPreExtrap =
+        (_topology.havePreExtrapLoops && _evalTime < _topology.lastTime);
+    const bool doPostExtrap =
+        (_topology.havePostExtrapLoops && _evalTime > _topology.firstTime);
+    if (!doPreExtrap && !doPostExtrap)
     {
         return;
     }
 
     // Handle looped extrapolation.
-    if (_doPreExtrap)
+    if (doPreExtrap)
     {
-        _DoExtrap(_data->preExtrapolation, _firstTime - _evalTime, true);
+        _DoExtrap(
+            _data->preExtrapolation, _topology.firstTime - _evalTime, true);
     }
-    else if (_doPostExtrap)
+    else if (doPostExtrap)
     {
-        _DoExtrap(_data->postExtrapolation, _evalTime - _lastTime, false);
+        _DoExtrap(
+            _data->postExtrapolation, _evalTime - _topology.lastTime, false);
     }
 
     TF_DEBUG_MSG(
@@ -855,9 +1501,9 @@ void _LoopResolver::_ResolveExtrap()
         "  negate: %d\n",
         _evalTime,
         _valueOffset,
-        _doPreExtrap,
-        _doPostExtrap,
-        _extrapValueOffset,
+        doPreExtrap,
+        doPostExtrap,
+        _topology.extrapValueOffset,
         _negate);
 }
 
@@ -871,7 +1517,7 @@ void _LoopResolver::_DoExtrap(
 {
     // Figure out how many whole iterations the extrapolation distance covers.
     // Also determine if we're exactly at an iteration boundary.
-    const TsTime protoSpan = _lastTime - _firstTime;
+    const TsTime protoSpan = _topology.lastTime - _topology.firstTime;
     const double numItersFrac = offset / protoSpan;
     const int numItersTrunc = int(numItersFrac);
     const bool boundary = (numItersTrunc == numItersFrac);
@@ -899,8 +1545,7 @@ void _LoopResolver::_DoExtrap(
     if (_data->preExtrapolation.mode == TsExtrapLoopRepeat
         && _aspect != Ts_EvalDerivative)
     {
-        _ComputeExtrapValueOffset();
-        _valueOffset -= iterHop * _extrapValueOffset;
+        _valueOffset -= iterHop * _topology.extrapValueOffset;
     }
 
     // Oscillate mode: every other extrapolating loop iteration is reflected
@@ -909,7 +1554,8 @@ void _LoopResolver::_DoExtrap(
         _data->preExtrapolation.mode == TsExtrapLoopOscillate
         && iterHop % 2 != 0)
     {
-        _evalTime = _firstTime + (protoSpan - (_evalTime - _firstTime));
+        _evalTime = _topology.firstTime
+            + (protoSpan - (_evalTime - _topology.firstTime));
         _location = (_location == Ts_EvalPre ? Ts_EvalPost : Ts_EvalPre);
         if (_aspect == Ts_EvalDerivative)
         {
@@ -924,42 +1570,6 @@ void _LoopResolver::_DoExtrap(
     // evaluating on the pre-side or post-side.
 }
 
-void _LoopResolver::_ComputeExtrapValueOffset()
-{
-    const TsLoopParams &lp = _data->loopParams;
-
-    double firstValue;
-    if (!_firstTimeLooped)
-    {
-        // Earliest knot is not from inner loops.  Read its value.
-        firstValue = _data->GetKnotDataAsDouble(0).GetPreValue();
-    }
-    else
-    {
-        // Earliest knot is from inner loops.  Compute its value.
-        firstValue =
-            _data->GetKnotDataAsDouble(_firstInnerProtoIndex).GetPreValue()
-            - lp.numPreLoops * lp.valueOffset;
-    }
-
-    double lastValue;
-    if (!_lastTimeLooped)
-    {
-        // Latest knot is not from inner loops.  Read its value.
-        lastValue = _data->GetKnotDataAsDouble(_data->times.size() - 1).value;
-    }
-    else
-    {
-        // Latest knot is from inner loops.  It is the final echo of the
-        // prototype start knot.  Compute its value.
-        lastValue =
-            _data->GetKnotDataAsDouble(_firstInnerProtoIndex).value
-            + (lp.numPostLoops + 1) * lp.valueOffset;
-    }
-
-    _extrapValueOffset = lastValue - firstValue;
-}
-
 // Handle some oddball interpolation cases arising from inner loops.
 // Extrapolating loops don't cause these cases, because their prototype region
 // (the set of all authored knots) always includes knots at the start and end,
@@ -969,33 +1579,28 @@ void _LoopResolver::ReplaceBoundaryKnots(
     Ts_TypedKnotData<double> *prevData,
     Ts_TypedKnotData<double> *nextData) const
 {
-    const TsLoopParams &lp = _data->loopParams;
-
     // Case 1: between last prototype knot and prototype end, after performing
-    // shift out of echo region, if any.  Make a copy of the first prototype
-    // knot at the end of the prototype region, and use that as nextData.
+    // shift out of echo region, if any.  Use a copy of the first prototype
+    // knot at the end of the prototype region as nextData.
     if (_betweenLastProtoAndEnd)
     {
-        *nextData = _CopyProtoKnotData(
-            _firstInnerProtoIndex, 1);
+        *nextData = _topology.protoEndKnot.Get(_aspect);
     }
 
     // Case 2: between last knot before looping region and start of looping
-    // region.  Make a copy of the first prototype knot at the start of the
-    // looping region, and use that as nextData.
+    // region.  Use a copy of the first prototype knot at the start of the
+    // looping region as nextData.
     else if (_betweenPreUnloopedAndLooped)
     {
-        *nextData = _CopyProtoKnotData(
-            _firstInnerProtoIndex, -lp.numPreLoops);
+        *nextData = _topology.loopStartKnot.Get(_aspect);
     }
 
     // Case 3: between end of looping region and first knot after looping
-    // region.  Make a copy of the first prototype knot at the end of the
-    // looping region, and use that as prevData.
+    // region.  Use a copy of the first prototype knot at the end of the
+    // looping region as prevData.
     else if (_betweenLoopedAndPostUnlooped)
     {
-        *prevData = _CopyProtoKnotData(
-            _firstInnerProtoIndex, lp.numPostLoops + 1);
+        *prevData = _topology.loopEndKnot.Get(_aspect);
     }
 }
 
@@ -1003,50 +1608,183 @@ void _LoopResolver::ReplacePreExtrapKnots(
     Ts_TypedKnotData<double>* const nextData,
     Ts_TypedKnotData<double>* const nextData2) const
 {
-    if (!_firstTimeLooped)
+    if (!_topology.firstTimeLooped)
         return;
 
-    *nextData = _extrapKnot1;
-    *nextData2 = _extrapKnot2;
+    *nextData = _topology.loopStartKnot.Get(_aspect);
+    *nextData2 = _topology.secondKnot.Get(_aspect);
 }
 
 void _LoopResolver::ReplacePostExtrapKnots(
     Ts_TypedKnotData<double>* const prevData,
     Ts_TypedKnotData<double>* const prevData2) const
 {
-    if (!_lastTimeLooped)
+    if (!_topology.lastTimeLooped)
         return;
 
-    *prevData = _extrapKnot1;
-    *prevData2 = _extrapKnot2;
+    *prevData = _topology.loopEndKnot.Get(_aspect);
+    *prevData2 = _topology.secondToLastKnot.Get(_aspect);
 }
 
-Ts_TypedKnotData<double>
-_LoopResolver::_CopyProtoKnotData(
-    const size_t index,
-    const int shiftIters) const
+namespace
 {
-    const TsLoopParams &lp = _data->loopParams;
-    const TsTime protoSpan = lp.GetPrototypeInterval().GetSize();
+    // Stands in for _LoopResolver when a spline has no loops.  The evaluation
+    // time and location pass through unchanged, and there are no special
+    // cases.  Constructed like _LoopResolver, so that code can be templated on
+    // the resolver type.
+    //
+    class _NoLoops
+    {
+    public:
+        _NoLoops(
+            const Ts_SplineData*,
+            const Ts_LoopTopology&,
+            const TsTime time,
+            const Ts_EvalAspect,
+            const Ts_EvalLocation location)
+            : _evalTime(time),
+              _location(location)
+        {}
+
+        TsTime GetEvalTime() const { return _evalTime; }
+        Ts_EvalLocation GetEvalLocation() const { return _location; }
+        bool IsBetweenLastProtoAndEnd() const { return false; }
+        double GetValueOffset() const { return 0; }
+        bool GetNegate() const { return false; }
+        bool HasBoundaryKnots() const { return false; }
+
+        void ReplaceBoundaryKnots(
+            Ts_TypedKnotData<double>*,
+            Ts_TypedKnotData<double>*) const {}
+        void ReplacePreExtrapKnots(
+            Ts_TypedKnotData<double>*,
+            Ts_TypedKnotData<double>*) const {}
+        void ReplacePostExtrapKnots(
+            Ts_TypedKnotData<double>*,
+            Ts_TypedKnotData<double>*) const {}
 
-    // Copy the knot.
-    Ts_TypedKnotData<double> knotCopy = _data->GetKnotDataAsDouble(index);
+    private:
+        const TsTime _evalTime;
+        const Ts_EvalLocation _location;
+    };
+}
 
-    // Shift time.
-    knotCopy.time += shiftIters * protoSpan;
+////////////////////////////////////////////////////////////////////////////////
+// KNOT ACCESS
 
-    // Shift value.
-    if (_aspect == Ts_EvalValue)
+// Returns a pointer to the knots of typed spline data.
+//
+template <typename T>
+static const Ts_TypedKnotData<T>*
+_GetTypedKnots(
+    const Ts_SplineData* const data)
+{
+    return static_cast<const Ts_TypedSplineData<T>*>(data)->knots.data();
+}
+
+Ts_EvalCursor::Ts_EvalCursor(
+    const Ts_SplineData* const data)
+    : _times(&data->times),
+      _compiled(data->compiled.Get())
+{
+    const TfType valueType = data->GetValueType();
+    if (valueType == Ts_GetType<double>())
+    {
+        _doubleKnots = _GetTypedKnots<double>(data);
+    }
+    else if (valueType == Ts_GetType<float>())
+    {
+        _floatKnots = _GetTypedKnots<float>(data);
+    }
+    else if (valueType == Ts_GetType<GfHalf>())
+    {
+        _halfKnots = _GetTypedKnots<GfHalf>(data);
+    }
+
+    std::fill_n(_cachedIndices, _numCachedKnots, _noIndex);
+}
+
+bool Ts_EvalCursor::_IsLowerBound(
+    const size_t index,
+    const TsTime time) const
+{
+    const std::vector<TsTime> &times = *_times;
+    return (index == 0 || times[index - 1] < time)
+        && (index == times.size() || times[index] >= time);
+}
+
+size_t Ts_EvalCursor::FindLowerBound(
+    const TsTime time)
+{
+    const std::vector<TsTime> &times = *_times;
+
+    // Check whether the previous result still applies, or whether we have
+    // moved by exactly one knot.  These are the common cases when evaluating
+    // at advancing times, as in playback, or when scrubbing back and forth.
+    if (_IsLowerBound(_lbIndex, time))
+    {
+        return _lbIndex;
+    }
+    if (_lbIndex < times.size() && _IsLowerBound(_lbIndex + 1, time))
+    {
+        return ++_lbIndex;
+    }
+    if (_lbIndex > 0 && _IsLowerBound(_lbIndex - 1, time))
+    {
+        return --_lbIndex;
+    }
+
+    // Otherwise use binary search.
+    _lbIndex =
+        std::lower_bound(times.begin(), times.end(), time) - times.begin();
+    return _lbIndex;
+}
+
+const Ts_TypedKnotData<double>&
+Ts_EvalCursor::GetKnot(
+    const size_t index)
+{
+    // Double data needs no conversion.
+    if (_doubleKnots)
+    {
+        return _doubleKnots[index];
+    }
+
+    for (size_t i = 0; i < _numCachedKnots; i++)
     {
-        const double offset = shiftIters * lp.valueOffset;
-        knotCopy.value += offset;
-        if (knotCopy.dualValued)
+        if (_cachedIndices[i] == index)
         {
-            knotCopy.preValue += offset;
+            return _cachedKnots[i];
         }
     }
 
-    return knotCopy;
+    // Not cached.  Replace the oldest entry.
+    const size_t slot = _nextCacheSlot;
+    _nextCacheSlot = (_nextCacheSlot + 1) % _numCachedKnots;
+
+    _cachedIndices[slot] = index;
+    if (_floatKnots)
+    {
+        Ts_ConvertKnotDataToDouble(_floatKnots + index, 1, &_cachedKnots[slot]);
+    }
+    else
+    {
+        Ts_ConvertKnotDataToDouble(_halfKnots + index, 1, &_cachedKnots[slot]);
+    }
+    return _cachedKnots[slot];
+}
+
+const Ts_CompiledSegment*
+Ts_EvalCursor::GetCompiledSegment(
+    const size_t index) const
+{
+    if (!_compiled)
+    {
+        return nullptr;
+    }
+
+    const Ts_CompiledSegment &segment = _compiled->segments[index];
+    return (segment.type != Ts_CompiledUncompiled ? &segment : nullptr);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1054,12 +1792,14 @@ _LoopResolver::_CopyProtoKnotData(
 
 // Interpolate between two knots.
 //
+template <unsigned Features>
 static std::optional<double>
 _Interpolate(
     const Ts_TypedKnotData<double> &beginData,
     const Ts_TypedKnotData<double> &endData,
     const TsTime time,
-    const Ts_EvalAspect aspect)
+    const Ts_EvalAspect aspect,
+    const TsEvalOptions &options)
 {
     // Special-case held evaluation.
     if (aspect == Ts_EvalHeldValue)
@@ -1067,12 +1807,17 @@ _Interpolate(
         return beginData.value;
     }
 
-    // Curved segment: Bezier/Hermite math.
-    if (beginData.nextInterp == TsInterpCurve)
+    // Curved segment: Bezier/Hermite math.  Only splines with both curve
+    // types need to check which one this is.
+    constexpr bool haveBezier = _HasFeature<Features>(Ts_EvalFeatureBezier);
+    constexpr bool haveHermite = _HasFeature<Features>(Ts_EvalFeatureHermite);
+    if ((haveBezier || haveHermite)
+        && beginData.nextInterp == TsInterpCurve)
     {
-        if (beginData.curveType == TsCurveTypeBezier)
+        if (!haveHermite
+            || (haveBezier && beginData.curveType == TsCurveTypeBezier))
         {
-            return _EvalBezier(beginData, endData, time, aspect);
+            return _EvalBezier(beginData, endData, time, aspect, options);
         }
         else
         {
@@ -1089,17 +1834,19 @@ _Interpolate(
     // Linear segment: find slope, extrapolate from previous knot.
     if (beginData.nextInterp == TsInterpLinear)
     {
-        const double slope = _GetSegmentSlope(beginData, endData);
+        const double slope = _GetSegmentSlope<Features>(beginData, endData);
         if (aspect == Ts_EvalDerivative)
         {
             return slope;
         }
 
-        return _ExtrapolateLinear(beginData, slope, time, Ts_EvalPost);
+        return _ExtrapolateLinear<Features>(
+            beginData, slope, time, Ts_EvalPost);
     }
 
     // Disabled interpolation -> no value.
-    if (beginData.nextInterp == TsInterpValueBlock)
+    if (_HasFeature<Features>(Ts_EvalFeatureValueBlocks)
+        && beginData.nextInterp == TsInterpValueBlock)
     {
         return std::nullopt;
     }
@@ -1109,18 +1856,197 @@ _Interpolate(
     return std::nullopt;
 }
 
+// Interpolate within a compiled segment.  Equivalent to _Interpolate.
+//
+static std::optional<double>
+_InterpolateCompiled(
+    const Ts_CompiledSegment &segment,
+    const TsTime time,
+    const Ts_EvalAspect aspect,
+    const TsEvalOptions &options)
+{
+    // Special-case held evaluation.
+    if (aspect == Ts_EvalHeldValue)
+    {
+        return segment.startValue;
+    }
+
+    switch (segment.type)
+    {
+        case Ts_CompiledHeld:
+            return (aspect == Ts_EvalValue ? segment.startValue : 0.0);
+
+        case Ts_CompiledLinear:
+            if (aspect == Ts_EvalDerivative)
+            {
+                return segment.slope;
+            }
+            return segment.startValue
+                + segment.slope * (time - segment.startTime);
+
+        case Ts_CompiledBezier:
+            return _EvalCompiledBezier(segment, time, aspect, options);
+
+        case Ts_CompiledHermite:
+            return _EvalCompiledHermite(segment, time, aspect);
+
+        case Ts_CompiledValueBlock:
+            return std::nullopt;
+
+        case Ts_CompiledUncompiled:
+            break;
+    }
+
+    // Should be unreachable.
+    TF_CODING_ERROR("Unexpected compiled segment type");
+    return std::nullopt;
+}
+
+// Evaluate the value at a knot.
+//
+template <unsigned Features>
+static double
+_EvalValueAtKnot(
+    const Ts_TypedKnotData<double> &knotData,
+    const Ts_TypedKnotData<double> &prevData,
+    const bool atFirst,
+    const Ts_EvalLocation location)
+{
+    // Pre-value after held segment = previous knot value.
+    if (location == Ts_EvalPre
+            && !atFirst && prevData.nextInterp == TsInterpHeld)
+    {
+        return prevData.value;
+    }
+
+    // Not a special case.  Return what's stored in the knot.
+    return (location == Ts_EvalPre ?
+        _GetPreValue<Features>(knotData) : knotData.value);
+}
+
+// Evaluate the derivative at a knot.
+//
+template <unsigned Features>
+static std::optional<double>
+_EvalDerivativeAtKnot(
+    const Ts_SplineData* const data,
+    const Ts_TypedKnotData<double> &knotData,
+    const Ts_TypedKnotData<double> &prevData,
+    const Ts_TypedKnotData<double> &nextData,
+    const bool atFirst,
+    const bool atLast,
+    const Ts_EvalLocation location)
+{
+    const bool haveMultipleKnots = (data->times.size() > 1);
+
+    if (location == Ts_EvalPre)
+    {
+        // Pre-derivative at first knot = extrapolation slope.
+        if (atFirst)
+        {
+            return _GetExtrapolationSlope<Features>(
+                data->preExtrapolation,
+                haveMultipleKnots, knotData, nextData,
+                data->curveType, Ts_EvalPre);
+        }
+
+        // Derivative in held segment = zero.
+        if (prevData.nextInterp == TsInterpHeld)
+        {
+            return 0.0;
+        }
+
+        // Derivative in linear segment = slope to adjacent knot.
+        if (prevData.nextInterp == TsInterpLinear)
+        {
+            return _GetSegmentSlope<Features>(prevData, knotData);
+        }
+
+        // Not a special case.  Return what's stored in the knot.
+        return knotData.preTanSlope;
+    }
+    else
+    {
+        // Post-derivative at last knot = extrapolation slope.
+        if (atLast)
+        {
+            return _GetExtrapolationSlope<Features>(
+                data->postExtrapolation,
+                haveMultipleKnots, knotData, prevData,
+                data->curveType, Ts_EvalPost);
+        }
+
+        // Derivative in held segment = zero.
+        if (knotData.nextInterp == TsInterpHeld)
+        {
+            return 0.0;
+        }
+
+        // Derivative in linear segment = slope to adjacent knot.
+        if (knotData.nextInterp == TsInterpLinear)
+        {
+            return _GetSegmentSlope<Features>(knotData, nextData);
+        }
+
+        // Not a special case.  Return what's stored in the knot.
+        return knotData.postTanSlope;
+    }
+}
+
+// If the (loop-resolved) eval time is in the interior of a compiled segment,
+// return that segment.  Returns null if the spline hasn't been compiled; if the
+// time is at a knot, in an extrapolation region, or at a loop boundary; or if
+// the segment must be evaluated from knot data.
+//
+template <typename Resolver>
+static const Ts_CompiledSegment*
+_FindCompiledSegment(
+    const Ts_SplineData* const data,
+    const Resolver &loopRes,
+    Ts_EvalCursor* const cursor)
+{
+    if (!cursor->IsCompiled() || loopRes.HasBoundaryKnots())
+    {
+        return nullptr;
+    }
+
+    const TsTime time = loopRes.GetEvalTime();
+    const std::vector<TsTime> &times = data->times;
+    const size_t lbIndex = cursor->FindLowerBound(time);
+    if (lbIndex == 0 || lbIndex == times.size() || times[lbIndex] == time)
+    {
+        return nullptr;
+    }
+
+    return cursor->GetCompiledSegment(lbIndex - 1);
+}
+
+// Evaluate, given the results of loop resolution.  The resolver is a
+// _LoopResolver for splines with loops, and a _NoLoops otherwise.  Its value
+// offset and negation are not applied.
+//
+template <unsigned Features, typename Resolver>
 static std::optional<double>
 _EvalMain(
     const Ts_SplineData* const data,
-    const _LoopResolver &loopRes,
-    const Ts_EvalAspect aspect)
+    const Resolver &loopRes,
+    const Ts_EvalAspect aspect,
+    const TsEvalOptions &options,
+    Ts_EvalCursor* const cursor)
 {
     const TsTime time = loopRes.GetEvalTime();
     const Ts_EvalLocation location = loopRes.GetEvalLocation();
     const std::vector<TsTime> &times = data->times;
 
-    // Use binary search to find first knot at or after the specified time.
-    const auto lbIt = std::lower_bound(times.begin(), times.end(), time);
+    // Use compiled segment data if we have it.
+    if (const Ts_CompiledSegment* const segment =
+            _FindCompiledSegment(data, loopRes, cursor))
+    {
+        return _InterpolateCompiled(*segment, time, aspect, options);
+    }
+
+    // Find first knot at or after the specified time.
+    const auto lbIt = times.begin() + cursor->FindLowerBound(time);
 
     // Figure out where we are in the sequence.  Find the bracketing knots, the
     // knot we're at, if any, and what type of position (before start, after
@@ -1141,91 +2067,31 @@ _EvalMain(
     Ts_TypedKnotData<double> knotData, prevData, nextData;
     if (knotIt != times.end())
     {
-        knotData = data->GetKnotDataAsDouble(knotIt - times.begin());
+        knotData = cursor->GetKnot(knotIt - times.begin());
     }
     if (prevIt != times.end())
     {
-        prevData = data->GetKnotDataAsDouble(prevIt - times.begin());
+        prevData = cursor->GetKnot(prevIt - times.begin());
     }
     if (nextIt != times.end())
     {
-        nextData = data->GetKnotDataAsDouble(nextIt - times.begin());
+        nextData = cursor->GetKnot(nextIt - times.begin());
     }
 
     // Handle times at knots.
     if (atKnot)
     {
-        // Handle values.
         if (aspect == Ts_EvalValue
             || aspect == Ts_EvalHeldValue)
         {
-            // Pre-value after held segment = previous knot value.
-            if (location == Ts_EvalPre
-                    && !atFirst && prevData.nextInterp == TsInterpHeld)
-            {
-                return prevData.value;
-            }
-
-            // Not a special case.  Return what's stored in the knot.
-            return (location == Ts_EvalPre ?
-                knotData.GetPreValue() : knotData.value);
+            return _EvalValueAtKnot<Features>(
+                knotData, prevData, atFirst, location);
         }
-
-        // Handle derivatives.
         else
         {
-            if (location == Ts_EvalPre)
-            {
-                // Pre-derivative at first knot = extrapolation slope.
-                if (atFirst)
-                {
-                    return _GetExtrapolationSlope(
-                        data->preExtrapolation,
-                        haveMultipleKnots, knotData, nextData,
-                        data->curveType, Ts_EvalPre);
-                }
-
-                // Derivative in held segment = zero.
-                if (prevData.nextInterp == TsInterpHeld)
-                {
-                    return 0.0;
-                }
-
-                // Derivative in linear segment = slope to adjacent knot.
-                if (prevData.nextInterp == TsInterpLinear)
-                {
-                    return _GetSegmentSlope(prevData, knotData);
-                }
-
-                // Not a special case.  Return what's stored in the knot.
-                return knotData.preTanSlope;
-            }
-            else
-            {
-                // Post-derivative at last knot = extrapolation slope.
-                if (atLast)
-                {
-                    return _GetExtrapolationSlope(
-                        data->postExtrapolation,
-                        haveMultipleKnots, knotData, prevData,
-                        data->curveType, Ts_EvalPost);
-                }
-
-                // Derivative in held segment = zero.
-                if (knotData.nextInterp == TsInterpHeld)
-                {
-                    return 0.0;
-                }
-
-                // Derivative in linear segment = slope to adjacent knot.
-                if (knotData.nextInterp == TsInterpLinear)
-                {
-                    return _GetSegmentSlope(knotData, nextData);
-                }
-
-                // Not a special case.  Return what's stored in the knot.
-                return knotData.postTanSlope;
-            }
+            return _EvalDerivativeAtKnot<Features>(
+                data, knotData, prevData, nextData,
+                atFirst, atLast, location);
         }
     }
 
@@ -1237,7 +2103,7 @@ _EvalMain(
         Ts_TypedKnotData<double> nextData2;
         if (nextIt + 1 != times.end())
         {
-            nextData2 = data->GetKnotDataAsDouble((nextIt + 1) - times.begin());
+            nextData2 = cursor->GetKnot((nextIt + 1) - times.begin());
         }
 
         loopRes.ReplacePreExtrapKnots(&nextData, &nextData2);
@@ -1245,12 +2111,12 @@ _EvalMain(
         // Special-case held evaluation.
         if (aspect == Ts_EvalHeldValue)
         {
-            return nextData.GetPreValue();
+            return _GetPreValue<Features>(nextData);
         }
 
         // Find the extrapolation slope.
         const std::optional<double> slope =
-            _GetExtrapolationSlope(
+            _GetExtrapolationSlope<Features>(
                 data->preExtrapolation,
                 haveMultipleKnots, nextData, nextData2,
                 data->curveType, Ts_EvalPre);
@@ -1268,7 +2134,8 @@ _EvalMain(
         }
 
         // Extrapolate value.
-        return _ExtrapolateLinear(nextData, *slope, time, Ts_EvalPre);
+        return _ExtrapolateLinear<Features>(
+            nextData, *slope, time, Ts_EvalPre);
     }
 
     // Extrapolate after last knot.
@@ -1279,7 +2146,7 @@ _EvalMain(
         Ts_TypedKnotData<double> prevData2;
         if (prevIt != times.begin())
         {
-            prevData2 = data->GetKnotDataAsDouble((prevIt - 1) - times.begin());
+            prevData2 = cursor->GetKnot((prevIt - 1) - times.begin());
         }
 
         loopRes.ReplacePostExtrapKnots(&prevData, &prevData2);
@@ -1292,7 +2159,7 @@ _EvalMain(
 
         // Find the extrapolation slope.
         const std::optional<double> slope =
-            _GetExtrapolationSlope(
+            _GetExtrapolationSlope<Features>(
                 data->postExtrapolation,
                 haveMultipleKnots, prevData, prevData2,
                 data->curveType, Ts_EvalPost);
@@ -1310,7 +2177,8 @@ _EvalMain(
         }
 
         // Extrapolate value.
-        return _ExtrapolateLinear(prevData, *slope, time, Ts_EvalPost);
+        return _ExtrapolateLinear<Features>(
+            prevData, *slope, time, Ts_EvalPost);
     }
 
     // Otherwise we are between knots.
@@ -1319,31 +2187,98 @@ _EvalMain(
     loopRes.ReplaceBoundaryKnots(&prevData, &nextData);
 
     // Interpolate.
-    return _Interpolate(prevData, nextData, time, aspect);
+    return _Interpolate<Features>(prevData, nextData, time, aspect, options);
 }
 
-////////////////////////////////////////////////////////////////////////////////
-// EVAL ENTRY POINT
-
-std::optional<double>
-Ts_Eval(
-    const Ts_SplineData* const data,
-    const TsTime timeIn,
-    const Ts_EvalAspect aspect,
-    const Ts_EvalLocation location)
+// Calls fn with a std::integral_constant holding the features to evaluate a
+// spline with.  The common combinations for splines without loops each get
+// their own instantiation; all others, and all looping splines, use the one
+// that handles every feature.  Specializing every combination would multiply
+// code size for little gain, and makes the rare cases slower.
+//
+template <typename Resolver, typename Fn>
+static decltype(auto)
+_DispatchFeatures(
+    const unsigned features,
+    Fn &&fn)
 {
-    // If no knots, no value or slope.
-    if (data->times.empty())
+    using std::integral_constant;
+
+    if constexpr (std::is_same_v<Resolver, _NoLoops>)
     {
-        return std::nullopt;
+        constexpr unsigned bezier = Ts_EvalFeatureBezier;
+        constexpr unsigned hermite = Ts_EvalFeatureHermite;
+        constexpr unsigned sloped = Ts_EvalFeatureSlopedExtrap;
+
+        switch (features)
+        {
+            case 0:
+                return fn(integral_constant<unsigned, 0>());
+            case bezier:
+                return fn(integral_constant<unsigned, bezier>());
+            case hermite:
+                return fn(integral_constant<unsigned, hermite>());
+            case sloped:
+                return fn(integral_constant<unsigned, sloped>());
+            case bezier | sloped:
+                return fn(integral_constant<unsigned, bezier | sloped>());
+            case hermite | sloped:
+                return fn(integral_constant<unsigned, hermite | sloped>());
+            default:
+                return fn(integral_constant<unsigned,
+                          Ts_EvalFeatureAll & ~Ts_EvalFeatureLoops>());
+        }
+    }
+    else
+    {
+        return fn(integral_constant<unsigned, Ts_EvalFeatureAll>());
     }
+}
+
+template <typename Resolver>
+using _EvalKernel = std::optional<double> (*)(
+    const Ts_SplineData *data,
+    const Resolver &loopRes,
+    Ts_EvalAspect aspect,
+    const TsEvalOptions &options,
+    Ts_EvalCursor *cursor);
+
+// Returns the kernel for a spline's features.
+//
+template <typename Resolver>
+static _EvalKernel<Resolver>
+_GetEvalKernel(
+    const Ts_LoopTopology &topology)
+{
+    return _DispatchFeatures<Resolver>(
+        topology.features,
+        [](auto features) -> _EvalKernel<Resolver>
+        {
+            return &_EvalMain<decltype(features)::value, Resolver>;
+        });
+}
 
+// Evaluate at one time, with the kernel for a spline's features.
+//
+template <typename Resolver>
+static std::optional<double>
+_EvalWithResolver(
+    const Ts_SplineData* const data,
+    const Ts_LoopTopology &topology,
+    Ts_EvalCursor* const cursor,
+    const TsTime time,
+    const Ts_EvalAspect aspect,
+    const Ts_EvalLocation location,
+    const TsEvalOptions &options)
+{
     // If loops are in use, and we're evaluating in an echo region, figure out
     // time and value shifts, and special interpolation cases.
-    _LoopResolver loopRes(data, timeIn, aspect, location);
+    const Resolver loopRes(data, topology, time, aspect, location);
 
     // Perform the main evaluation.
-    std::optional<double> result = _EvalMain(data, loopRes, aspect);
+    const std::optional<double> result =
+        _GetEvalKernel<Resolver>(topology)(
+            data, loopRes, aspect, options, cursor);
     if (!result)
     {
         return std::nullopt;
@@ -1354,5 +2289,2957 @@ Ts_Eval(
         * (loopRes.GetNegate() ? -1 : 1);
 }
 
+// Evaluate at one time, given the per-spline setup.
+//
+static std::optional<double>
+_EvalWithSetup(
+    const Ts_SplineData* const data,
+    const Ts_LoopTopology &topology,
+    Ts_EvalCursor* const cursor,
+    const TsTime time,
+    const Ts_EvalAspect aspect,
+    const Ts_EvalLocation location,
+    const TsEvalOptions &options)
+{
+    if (topology.features & Ts_EvalFeatureLoops)
+    {
+        return _EvalWithResolver<_LoopResolver>(
+            data, topology, cursor, time, aspect, location, options);
+    }
+    return _EvalWithResolver<_NoLoops>(
+        data, topology, cursor, time, aspect, location, options);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// EVALUATION WITH DERIVATIVES
+//
+// Evaluates the value, derivative, and second derivative at one time, with a
+// single knot search, loop resolution, and segment solve.  Values and
+// derivatives are the same as those of _EvalMain for each aspect.
+//
+// Loop resolution depends on the aspect: value offsets apply only to values,
+// and negation only to derivatives.  So we take a resolver for each aspect.
+// Their eval times and locations are the same.  They use different knots only
+// in a few segments at inner loop boundaries, which we interpolate twice.
+
+// Interpolate value and derivatives between two knots.
+//
+template <unsigned Features>
+static std::optional<Ts_EvalResults>
+_InterpolateWithDerivatives(
+    const Ts_TypedKnotData<double> &beginData,
+    const Ts_TypedKnotData<double> &endData,
+    const TsTime time,
+    const TsEvalOptions &options)
+{
+    // Curved segment: Bezier/Hermite math.
+    if (beginData.nextInterp == TsInterpCurve)
+    {
+        if (beginData.curveType == TsCurveTypeBezier)
+        {
+            return _EvalBezierWithDerivatives(
+                beginData, endData, time, options);
+        }
+        else
+        {
+            return _EvalHermiteWithDerivatives(beginData, endData, time);
+        }
+    }
+
+    // Held segment: determined by previous knot.
+    if (beginData.nextInterp == TsInterpHeld)
+    {
+        return Ts_EvalResults{beginData.value, 0.0, 0.0};
+    }
+
+    // Linear segment: find slope, extrapolate from previous knot.
+    if (beginData.nextInterp == TsInterpLinear)
+    {
+        const double slope = _GetSegmentSlope<Features>(beginData, endData);
+        return Ts_EvalResults{
+            _ExtrapolateLinear<Features>(beginData, slope, time, Ts_EvalPost),
+            slope,
+            0.0};
+    }
+
+    // Disabled interpolation -> no value.
+    if (beginData.nextInterp == TsInterpValueBlock)
+    {
+        return std::nullopt;
+    }
+
+    // Should be unreachable.
+    TF_CODING_ERROR("Unexpected interpolation type");
+    return std::nullopt;
+}
+
+// Interpolate value and derivatives within a compiled segment.
+//
+static std::optional<Ts_EvalResults>
+_InterpolateCompiledWithDerivatives(
+    const Ts_CompiledSegment &segment,
+    const TsTime time,
+    const TsEvalOptions &options)
+{
+    switch (segment.type)
+    {
+        case Ts_CompiledHeld:
+            return Ts_EvalResults{segment.startValue, 0.0, 0.0};
+
+        case Ts_CompiledLinear:
+            return Ts_EvalResults{
+                segment.startValue
+                    + segment.slope * (time - segment.startTime),
+                segment.slope,
+                0.0};
+
+        case Ts_CompiledBezier:
+            return _EvalCompiledBezierWithDerivatives(segment, time, options);
+
+        case Ts_CompiledHermite:
+            return _EvalCompiledHermiteWithDerivatives(segment, time);
+
+        case Ts_CompiledValueBlock:
+            return std::nullopt;
+
+        case Ts_CompiledUncompiled:
+            break;
+    }
+
+    // Should be unreachable.
+    TF_CODING_ERROR("Unexpected compiled segment type");
+    return std::nullopt;
+}
+
+// Evaluate value and derivatives, given the results of loop resolution for
+// values and for derivatives.  The resolvers' value offsets and negation are
+// not applied.
+//
+template <unsigned Features, typename Resolver>
+static std::optional<Ts_EvalResults>
+_EvalMainWithDerivatives(
+    const Ts_SplineData* const data,
+    const Resolver &valueRes,
+    const Resolver &derivRes,
+    const TsEvalOptions &options,
+    Ts_EvalCursor* const cursor)
+{
+    const TsTime time = valueRes.GetEvalTime();
+    const Ts_EvalLocation location = valueRes.GetEvalLocation();
+    const std::vector<TsTime> &times = data->times;
+
+    // Use compiled segment data if we have it.
+    if (const Ts_CompiledSegment* const segment =
+            _FindCompiledSegment(data, valueRes, cursor))
+    {
+        return _InterpolateCompiledWithDerivatives(*segment, time, options);
+    }
+
+    // Find the bracketing knots, as in _EvalMain.
+    const auto lbIt = times.begin() + cursor->FindLowerBound(time);
+    const auto prevIt = (lbIt != times.begin() ? lbIt - 1 : times.end());
+    const bool atKnot = (lbIt != times.end() && *lbIt == time);
+    const auto knotIt = (atKnot ? lbIt : times.end());
+    const auto nextIt = (atKnot ? lbIt + 1 : lbIt);
+    const bool beforeStart = (nextIt == times.begin());
+    const bool afterEnd =
+        (valueRes.IsBetweenLastProtoAndEnd() ?
+            false : prevIt == times.end() - 1);
+    const bool atFirst = (knotIt == times.begin());
+    const bool atLast = (knotIt == times.end() - 1);
+    const bool haveMultipleKnots = (times.size() > 1);
+
+    Ts_TypedKnotData<double> knotData, prevData, nextData;
+    if (knotIt != times.end())
+    {
+        knotData = cursor->GetKnot(knotIt - times.begin());
+    }
+    if (prevIt != times.end())
+    {
+        prevData = cursor->GetKnot(prevIt - times.begin());
+    }
+    if (nextIt != times.end())
+    {
+        nextData = cursor->GetKnot(nextIt - times.begin());
+    }
+
+    // Handle times at knots.  The second derivative is that of the segment on
+    // the evaluated side, or zero if that segment isn't curved.
+    if (atKnot)
+    {
+        const std::optional<double> derivative =
+            _EvalDerivativeAtKnot<Features>(
+                data, knotData, prevData, nextData,
+                atFirst, atLast, location);
+        if (!derivative)
+        {
+            return std::nullopt;
+        }
+
+        Ts_EvalResults result;
+        result.value = _EvalValueAtKnot<Features>(
+            knotData, prevData, atFirst, location);
+        result.derivative = *derivative;
+
+        if (location == Ts_EvalPre)
+        {
+            if (!atFirst && prevData.nextInterp == TsInterpCurve)
+            {
+                result.secondDerivative = _GetCurveSecondDerivativeAtEnd(
+                    prevData, knotData, /* atEnd = */ true);
+            }
+        }
+        else if (!atLast && knotData.nextInterp == TsInterpCurve)
+        {
+            result.secondDerivative = _GetCurveSecondDerivativeAtEnd(
+                knotData, nextData, /* atEnd = */ false);
+        }
+        return result;
+    }
+
+    // Extrapolate.  Slopes are found separately for each aspect, in case loop
+    // resolution replaces the knots differently.
+    if (beforeStart || afterEnd)
+    {
+        const TsExtrapolation &extrap = (beforeStart ?
+            data->preExtrapolation : data->postExtrapolation);
+        const Ts_EvalLocation side = (beforeStart ? Ts_EvalPre : Ts_EvalPost);
+
+        // The end knot, and the knot adjacent to it, if there is one.
+        Ts_TypedKnotData<double> endData, adjacentData;
+        if (beforeStart)
+        {
+            endData = nextData;
+            if (nextIt + 1 != times.end())
+            {
+                adjacentData = cursor->GetKnot((nextIt + 1) - times.begin());
+            }
+        }
+        else
+        {
+            endData = prevData;
+            if (prevIt != times.begin())
+            {
+                adjacentData = cursor->GetKnot((prevIt - 1) - times.begin());
+            }
+        }
+
+        Ts_TypedKnotData<double> derivEndData = endData;
+        Ts_TypedKnotData<double> derivAdjacentData = adjacentData;
+        if (beforeStart)
+        {
+            valueRes.ReplacePreExtrapKnots(&endData, &adjacentData);
+            derivRes.ReplacePreExtrapKnots(&derivEndData, &derivAdjacentData);
+        }
+        else
+        {
+            valueRes.ReplacePostExtrapKnots(&endData, &adjacentData);
+            derivRes.ReplacePostExtrapKnots(
+                &derivEndData, &derivAdjacentData);
+        }
+
+        const std::optional<double> slope =
+            _GetExtrapolationSlope<Features>(
+                extrap, haveMultipleKnots, endData, adjacentData,
+                data->curveType, side);
+        const std::optional<double> derivSlope =
+            _GetExtrapolationSlope<Features>(
+                extrap, haveMultipleKnots, derivEndData, derivAdjacentData,
+                data->curveType, side);
+        if (!slope || !derivSlope)
+        {
+            return std::nullopt;
+        }
+
+        return Ts_EvalResults{
+            _ExtrapolateLinear<Features>(endData, *slope, time, side),
+            *derivSlope,
+            0.0};
+    }
+
+    // Otherwise we are between knots.  Usually both aspects use the same
+    // knots, and we interpolate once.
+    if (!valueRes.HasBoundaryKnots())
+    {
+        return _InterpolateWithDerivatives<Features>(
+            prevData, nextData, time, options);
+    }
+
+    Ts_TypedKnotData<double> derivPrevData = prevData;
+    Ts_TypedKnotData<double> derivNextData = nextData;
+    valueRes.ReplaceBoundaryKnots(&prevData, &nextData);
+    derivRes.ReplaceBoundaryKnots(&derivPrevData, &derivNextData);
+
+    const std::optional<Ts_EvalResults> valueResult =
+        _InterpolateWithDerivatives<Features>(
+            prevData, nextData, time, options);
+    std::optional<Ts_EvalResults> result =
+        _InterpolateWithDerivatives<Features>(
+            derivPrevData, derivNextData, time, options);
+    if (!valueResult || !result)
+    {
+        return std::nullopt;
+    }
+
+    result->value = valueResult->value;
+    return result;
+}
+
+// Evaluate value and derivatives at one time, given the per-spline setup.
+//
+template <typename Resolver>
+static std::optional<Ts_EvalResults>
+_EvalWithDerivativesWithResolver(
+    const Ts_SplineData* const data,
+    const Ts_LoopTopology &topology,
+    Ts_EvalCursor* const cursor,
+    const TsTime time,
+    const Ts_EvalLocation location,
+    const TsEvalOptions &options)
+{
+    const Resolver valueRes(data, topology, time, Ts_EvalValue, location);
+    const Resolver derivRes(data, topology, time, Ts_EvalDerivative, location);
+
+    // Perform the main evaluation, with the same features as _EvalWithSetup.
+    std::optional<Ts_EvalResults> result = _DispatchFeatures<Resolver>(
+        topology.features,
+        [&](auto features)
+        {
+            return _EvalMainWithDerivatives<decltype(features)::value>(
+                data, valueRes, derivRes, options, cursor);
+        });
+    if (!result)
+    {
+        return std::nullopt;
+    }
+
+    // Add value offset, and/or negate, if applicable, as in _EvalWithSetup.
+    // Oscillating loops reflect time, which negates the first derivative, but
+    // not the second.
+    result->value = (result->value + valueRes.GetValueOffset())
+        * (valueRes.GetNegate() ? -1 : 1);
+    result->derivative = (result->derivative + derivRes.GetValueOffset())
+        * (derivRes.GetNegate() ? -1 : 1);
+    return result;
+}
+
+static std::optional<Ts_EvalResults>
+_EvalWithDerivatives(
+    const Ts_SplineData* const data,
+    const Ts_LoopTopology &topology,
+    Ts_EvalCursor* const cursor,
+    const TsTime time,
+    const Ts_EvalLocation location,
+    const TsEvalOptions &options)
+{
+    if (topology.features & Ts_EvalFeatureLoops)
+    {
+        return _EvalWithDerivativesWithResolver<_LoopResolver>(
+            data, topology, cursor, time, location, options);
+    }
+    return _EvalWithDerivativesWithResolver<_NoLoops>(
+        data, topology, cursor, time, location, options);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// BLOCK EVALUATION
+//
+// Batch evaluation of compiled splines defers samples that fall in Bezier
+// segments, gathers them into fixed-size blocks, and evaluates each block with
+// the kernels below.  The kernels are fixed-length loops over lanes, with no
+// branches or library calls in the loop bodies, so that compilers can vectorize
+// them for whatever instruction set the build targets: SSE2 on baseline x86-64,
+// wider vectors when building for AVX2 or AVX-512, NEON on ARM.
+//
+// Cardano's formula, used for single evaluations, requires acos, cbrt, and cos,
+// and branches on the discriminant; it doesn't vectorize.  Instead the block
+// solver uses Newton's method, safeguarded by bisection.  This relies on the
+// time cubic being monotonic, which de-regression guarantees.  The solved
+// parameter is within _blockSolveTolerance of the exact root, or within the
+// tolerance from the eval options if they specify an iterative solver.  Near
+// vertical tangents Cardano's formula is the less accurate of the two, so
+// results can differ from single evaluation by more than rounding there.
+
+namespace
+{
+    // Number of lanes in a block.  Enough to fill an AVX-512 register with
+    // doubles.
+    constexpr size_t _blockSize = 8;
+
+    // Default convergence tolerance for the block solver, in units of t, which
+    // is in [0, 1].  A few ULPs at 1.  Used when the eval options specify
+    // Cardano's formula, which the block solver doesn't implement.
+    constexpr double _blockSolveTolerance = 1e-15;
+
+    // Compiled Bezier samples awaiting evaluation, in structure-of-arrays form.
+    // Lanes may come from different segments.
+    //
+    class _BezierBlock
+    {
+    public:
+        explicit _BezierBlock(const TsEvalOptions &options);
+
+        bool IsEmpty() const { return _count == 0; }
+        bool IsFull() const { return _count == _blockSize; }
+
+        // Adds a sample whose result is destined for the specified index in
+        // the output.
+        template <typename Resolver>
+        void Add(
+            const Ts_CompiledSegment &segment,
+            const Resolver &loopRes,
+            size_t outIndex);
+
+        // Evaluates all pending samples, writes results to valuesOut, and
+        // empties the block.
+        template <typename T>
+        void Flush(
+            Ts_EvalAspect aspect,
+            TfSpan<T> valuesOut);
+
+    private:
+        void _Solve(double *tOut) const;
+
+    private:
+        double _tolerance = _blockSolveTolerance;
+        size_t _count = 0;
+        size_t _outIndices[_blockSize];
+
+        // Time cubic, with the eval time folded into the constant term.
+        double _ta[_blockSize], _tb[_blockSize], _tc[_blockSize];
+        double _td[_blockSize];
+
+        // Value cubic.
+        double _va[_blockSize], _vb[_blockSize], _vc[_blockSize];
+        double _vd[_blockSize];
+
+        // Segment start and end values.
+        double _startValues[_blockSize], _endValues[_blockSize];
+
+        // Loop adjustments.
+        double _valueOffsets[_blockSize], _signs[_blockSize];
+    };
+}
+
+_BezierBlock::_BezierBlock(
+    const TsEvalOptions &options)
+{
+    // The block solver is always Newton.  If an iterative solver was requested,
+    // honor its tolerance.
+    if (options.bezierSolver != TsBezierSolverCardano)
+    {
+        _tolerance = options.solverTolerance;
+    }
+}
+
+template <typename Resolver>
+void _BezierBlock::Add(
+    const Ts_CompiledSegment &segment,
+    const Resolver &loopRes,
+    const size_t outIndex)
+{
+    const size_t i = _count++;
+
+    _outIndices[i] = outIndex;
+
+    _ta[i] = segment.timeCoeffs[0];
+    _tb[i] = segment.timeCoeffs[1];
+    _tc[i] = segment.timeCoeffs[2];
+    _td[i] = segment.startTime - loopRes.GetEvalTime();
+
+    _va[i] = segment.valueCoeffs[0];
+    _vb[i] = segment.valueCoeffs[1];
+    _vc[i] = segment.valueCoeffs[2];
+    _vd[i] = segment.valueCoeffs[3];
+
+    _startValues[i] = segment.startValue;
+    _endValues[i] = segment.endValue;
+
+    _valueOffsets[i] = loopRes.GetValueOffset();
+    _signs[i] = (loopRes.GetNegate() ? -1 : 1);
+}
+
+// For each lane, finds the unique t in [0, 1] at which the time cubic is zero.
+//
+void _BezierBlock::_Solve(
+    double* const t) const
+{
+    double lo[_blockSize], hi[_blockSize], step[_blockSize];
+
+    // Whether each lane has converged.  Converged lanes stop moving, so that
+    // each lane's result depends only on its own problem, and not on which
+    // other samples share its block.  This keeps batch results independent of
+    // how samples are grouped, as when a batch is split across threads.
+    bool done[_blockSize];
+
+    // Seed with the linear guess: the fraction of the segment's duration that
+    // precedes the eval time.  The full duration is the sum of the time
+    // cubic's coefficients.
+    for (size_t i = 0; i < _blockSize; i++)
+    {
+        const double guess = -_td[i] / (_ta[i] + _tb[i] + _tc[i]);
+        t[i] = GfClamp(guess, 0.0, 1.0);
+        lo[i] = 0;
+        hi[i] = 1;
+        done[i] = false;
+    }
+
+    for (int iter = 0; iter < _maxSolverIterations; iter++)
+    {
+        for (size_t i = 0; i < _blockSize; i++)
+        {
+            const double x = t[i];
+            const double f = ((_ta[i] * x + _tb[i]) * x + _tc[i]) * x + _td[i];
+            const double df = (3 * _ta[i] * x + 2 * _tb[i]) * x + _tc[i];
+
+            // The function is increasing, so its sign tells us which side of
+            // the root we're on.
+            const double l = (f < 0 ? x : lo[i]);
+            const double h = (f < 0 ? hi[i] : x);
+
+            // Take the Newton step if it stays strictly inside the bracket;
+            // otherwise bisect.  This also rejects zero and non-finite slopes.
+            // The conditions are written as a chain of selects, rather than
+            // combined with logical operators, so that the loop body has no
+            // branches.
+            const double newton = x - f / df;
+            const double bisect = 0.5 * (l + h);
+            const double next1 = (df > 0 ? newton : bisect);
+            const double next2 = (newton > l ? next1 : bisect);
+            const double next3 = (newton < h ? next2 : bisect);
+            const double next4 = (f == 0 ? x : next3);
+            const double next = (done[i] ? x : next4);
+
+            lo[i] = l;
+            hi[i] = h;
+            step[i] = std::abs(next - x);
+            t[i] = next;
+            done[i] = done[i] || step[i] <= _tolerance;
+        }
+
+        double maxStep = 0;
+        for (size_t i = 0; i < _blockSize; i++)
+        {
+            maxStep = std::max(maxStep, step[i]);
+        }
+        if (maxStep <= _tolerance)
+        {
+            break;
+        }
+    }
+}
+
+template <typename T>
+void _BezierBlock::Flush(
+    const Ts_EvalAspect aspect,
+    const TfSpan<T> valuesOut)
+{
+    if (IsEmpty())
+    {
+        return;
+    }
+
+    // Fill unused lanes with a trivial problem, so that the kernels can always
+    // process a whole block.
+    for (size_t i = _count; i < _blockSize; i++)
+    {
+        _ta[i] = _tb[i] = 0;
+        _tc[i] = 1;
+        _td[i] = -0.5;
+        _va[i] = _vb[i] = _vc[i] = _vd[i] = 0;
+        _startValues[i] = _endValues[i] = 0;
+        _valueOffsets[i] = 0;
+        _signs[i] = 1;
+    }
+
+    double t[_blockSize];
+    _Solve(t);
+
+    double results[_blockSize];
+    if (aspect == Ts_EvalValue)
+    {
+        // At the segment ends, use the knot values, as _EvalCompiledBezier
+        // does.
+        for (size_t i = 0; i < _blockSize; i++)
+        {
+            const double x = t[i];
+            const double value =
+                ((_va[i] * x + _vb[i]) * x + _vc[i]) * x + _vd[i];
+            results[i] =
+                (x <= 0 ? _startValues[i] :
+                 (x >= 1 ? _endValues[i] : value));
+        }
+    }
+    else
+    {
+        // Derivative dy/dx, as the quotient dy/dt / dx/dt.  As in
+        // _EvalCompiledBezier, t is clamped to the segment, and the quotient
+        // is taken there even at the ends.
+        for (size_t i = 0; i < _blockSize; i++)
+        {
+            const double x = GfClamp(t[i], 0.0, 1.0);
+            const double dv = (3 * _va[i] * x + 2 * _vb[i]) * x + _vc[i];
+            const double dt = (3 * _ta[i] * x + 2 * _tb[i]) * x + _tc[i];
+            results[i] = dv / dt;
+        }
+    }
+
+    // Apply loop adjustments.
+    for (size_t i = 0; i < _blockSize; i++)
+    {
+        results[i] = (results[i] + _valueOffsets[i]) * _signs[i];
+    }
+
+    for (size_t i = 0; i < _count; i++)
+    {
+        valuesOut[_outIndices[i]] = T(results[i]);
+    }
+
+    _count = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// UNIFORM RUNS
+//
+// Evaluates runs of evenly spaced times that lie within a single segment
+// between authored knots: the subframe samples of a shutter window, and the
+// frames of a uniform bake.  The segment is found once per run, and compiled if
+// the spline hasn't been.  Hermite segments, whose parameter is linear in time,
+// are evaluated by forward differencing, three additions per sample.  Bezier
+// segments aren't uniform in their parameter, but times are ascending, so each
+// solve is bracketed below by the previous sample's parameter, and seeded with
+// a Newton step from it.  Times that reach knots, inner loops, or
+// extrapolation are evaluated individually.
+
+// Number of samples after which forward differences are recomputed from the
+// polynomial, bounding the growth of rounding error over long runs.
+static constexpr size_t _forwardDiffRestart = 64;
+
+// Returns the compiled data for the segment that starts at a knot, if the
+// segment is between authored knots outside any inner loops.  The data may be
+// compiled into the provided storage.  Returns null if the segment isn't
+// authored, or can't be compiled.
+//
+static const Ts_CompiledSegment*
+_GetRunSegment(
+    const Ts_SplineData* const data,
+    const Ts_LoopTopology &topology,
+    Ts_EvalCursor* const cursor,
+    const size_t startIndex,
+    Ts_CompiledSegment* const storage)
+{
+    // Authored knots in the looped interval are shadowed or echoed.
+    if (topology.haveInnerLoops)
+    {
+        const GfInterval looped = data->loopParams.GetLoopedInterval();
+        if (data->times[startIndex + 1] >= looped.GetMin()
+            && data->times[startIndex] <= looped.GetMax())
+        {
+            return nullptr;
+        }
+    }
+
+    if (const Ts_CompiledSegment* const segment =
+            cursor->GetCompiledSegment(startIndex))
+    {
+        return segment;
+    }
+
+    // The cursor's knot references are only good until the next call.
+    const Ts_TypedKnotData<double> beginData = cursor->GetKnot(startIndex);
+    *storage = Ts_CompiledSegment();
+    Ts_CompileSegment(beginData, cursor->GetKnot(startIndex + 1), storage);
+    return (storage->type == Ts_CompiledUncompiled ? nullptr : storage);
+}
+
+// Sample times of a run within a uniform bake: start + (first + i) * step.
+// Times are always computed from the start of the bake, never accumulated,
+// because near vertical tangents a rounding difference in a time makes a much
+// larger difference in the value.
+struct _UniformTimes
+{
+    TsTime operator()(const size_t i) const
+    {
+        return start + (first + i) * step;
+    }
+
+    TsTime start;
+    TsTime step;
+    size_t first;
+};
+
+// Sample times of a shutter window: frame + offsets[i].  The offsets are
+// stratum centers, spaced by step up to rounding.
+struct _ShutterTimes
+{
+    TsTime operator()(const size_t i) const { return frame + offsets[i]; }
+
+    TsTime frame;
+    const TsTime* offsets;
+    TsTime step;
+};
+
+// Evaluates the Hermite segment at times(i) for each element of valuesOut.
+// Forward differencing assumes that the times are spaced by times.step.
+//
+template <typename T, typename Times>
+static void
+_EvalHermiteRun(
+    const Ts_CompiledSegment &segment,
+    const Times &times,
+    const TfSpan<T> valuesOut)
+{
+    const double* const v = segment.valueCoeffs;
+    const double h = times.step / segment.duration;
+
+    for (size_t start = 0; start < valuesOut.size();
+            start += _forwardDiffRestart)
+    {
+        // The value and its first three forward differences at the start of
+        // this stretch.  The third difference is constant.
+        const double u = (times(start) - segment.startTime) / segment.duration;
+        double value = ((v[0] * u + v[1]) * u + v[2]) * u + v[3];
+        double diff1 = v[0] * h * (3 * u * u + 3 * u * h + h * h)
+            + v[1] * h * (2 * u + h) + v[2] * h;
+        double diff2 = v[0] * 6 * h * h * (u + h) + v[1] * 2 * h * h;
+        const double diff3 = v[0] * 6 * h * h * h;
+
+        const size_t end =
+            std::min(start + _forwardDiffRestart, valuesOut.size());
+        for (size_t i = start; i < end; i++)
+        {
+            valuesOut[i] = T(value);
+            value += diff1;
+            diff1 += diff2;
+            diff2 += diff3;
+        }
+    }
+}
+
+// Evaluates the Bezier segment at times(i) for each element of valuesOut.
+//
+template <typename T, typename Times>
+static void
+_EvalBezierRun(
+    const Ts_CompiledSegment &segment,
+    const Times &times,
+    const TsEvalOptions &options,
+    const TfSpan<T> valuesOut)
+{
+    // As in _BezierBlock, solve iteratively, to the block tolerance unless an
+    // iterative solver was requested.
+    TsEvalOptions solveOptions = options;
+    if (options.bezierSolver == TsBezierSolverCardano)
+    {
+        solveOptions.bezierSolver = TsBezierSolverNewton;
+        solveOptions.solverTolerance = _blockSolveTolerance;
+    }
+
+    const double* const tc = segment.timeCoeffs;
+    const double* const vc = segment.valueCoeffs;
+    const _Cubic valueCubic{vc[0], vc[1], vc[2], vc[3]};
+    const double duration = tc[0] + tc[1] + tc[2];
+
+    double t = 0;
+    TsTime prevTime = segment.startTime;
+    for (size_t i = 0; i < valuesOut.size(); i++)
+    {
+        const TsTime time = times(i);
+        const _Cubic timeCubic{tc[0], tc[1], tc[2], segment.startTime - time};
+
+        // Seed the first sample with the linear guess, and the others with a
+        // Newton step from the previous parameter, which bounds this one from
+        // below.
+        double guess = (time - segment.startTime) / duration;
+        if (i > 0)
+        {
+            const double slope = timeCubic.GetDerivative().Eval(t);
+            guess = (slope > 0 ? t + (time - prevTime) / slope : t);
+        }
+        t = _ClampBezierParameter(_FindMonotonicZeroInBracket(
+            timeCubic, t, 1, GfClamp(guess, t, 1.0), solveOptions));
+        prevTime = time;
+
+        valuesOut[i] = T(t == 0 ? segment.startValue :
+            t == 1 ? segment.endValue : valueCubic.Eval(t));
+    }
+}
+
+// Evaluates a compiled segment at times(i) for each element of valuesOut.  The
+// times must be ascending, evenly spaced, and within the segment's interior.
+// Returns false for value blocks, which have no values.
+//
+template <typename T, typename Times>
+static bool
+_EvalRun(
+    const Ts_CompiledSegment &segment,
+    const Times &times,
+    const TsEvalOptions &options,
+    const TfSpan<T> valuesOut)
+{
+    switch (segment.type)
+    {
+        case Ts_CompiledHeld:
+            std::fill(valuesOut.begin(), valuesOut.end(),
+                T(segment.startValue));
+            return true;
+
+        case Ts_CompiledLinear:
+            // Direct evaluation is as cheap as differencing, and exact.
+            for (size_t i = 0; i < valuesOut.size(); i++)
+            {
+                valuesOut[i] = T(segment.startValue + segment.slope
+                    * (times(i) - segment.startTime));
+            }
+            return true;
+
+        case Ts_CompiledHermite:
+            _EvalHermiteRun(segment, times, valuesOut);
+            return true;
+
+        case Ts_CompiledBezier:
+            _EvalBezierRun(segment, times, options, valuesOut);
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// INVERSE EVALUATION
+//
+// Finds the times at which a spline has a given value.  Knots are unrolled
+// through inner loops, as in sampling, and each segment between them is
+// classified once: its value bounds, whether it is monotonic, and the
+// parameter values that divide it into monotonic pieces.  Each monotonic piece
+// has at most one solution, which the bracketed iterative solver finds.
+// Segments whose bounds exclude the value are skipped, and when all of the
+// segments together are monotonic, a binary search finds the only segment
+// that can have solutions.
+//
+// Extrapolating loops are handled by mapping each iteration onto the unrolled
+// knots, shifting the value that we look for rather than the knots.
+//
+// At times where a spline jumps, evaluation takes the value on one side, and
+// so do we: segments include their start and exclude their end, except in
+// reflected iterations of oscillating loops, which are evaluated on the
+// pre-side of the reflected times, and so include their end and exclude their
+// start.
+
+namespace
+{
+    // One segment between unrolled knots, prepared for inverse evaluation.
+    //
+    struct _InverseSegment
+    {
+        TsTime startTime = 0;
+        TsTime endTime = 0;
+        TsInterpMode interp = TsInterpHeld;
+
+        // The value at the start knot, and the value on the pre-side of the
+        // end knot.  For held segments, these are the same.
+        double startValue = 0;
+        double endValue = 0;
+
+        // Bounds on the values above, and on the interior of the segment.
+        double minValue = 0;
+        double maxValue = 0;
+
+        // Whether the value never decreases, or never increases, from the
+        // start of the segment to the end.  Both for flat segments; neither
+        // for value blocks.
+        bool nonDecreasing = false;
+        bool nonIncreasing = false;
+
+        // Curved segments only.  Value and time, relative to the start time,
+        // as cubics in the Bezier parameter; and the parameter values that
+        // divide the segment into monotonic pieces: 0, any interior extrema,
+        // and 1, with the values there.
+        _Cubic valueCubic;
+        _Cubic timeCubic;
+        double pieceParams[4] = {};
+        double pieceValues[4] = {};
+        int numPieceParams = 0;
+    };
+
+    // A time, or a span of times, at which a spline has a value.  Points
+    // have equal start and end.
+    //
+    struct _InverseHit
+    {
+        TsTime start = 0;
+        TsTime end = 0;
+    };
+
+    // Spline data prepared for inverse evaluation, and reused for each value
+    // in a batch.
+    //
+    class _Inverter
+    {
+    public:
+        _Inverter(
+            const Ts_SplineData *data,
+            const Ts_LoopTopology &topology);
+
+        // Whether the interval can be searched.  Extrapolating loops over an
+        // unbounded interval can reach a value infinitely many times.
+        bool CanSearch(const GfInterval &interval) const;
+
+        // Writes the times within the interval at which the spline has the
+        // value, in ascending order.  Fails if the value could be reached in
+        // too many iterations of extrapolating loops.
+        bool FindTimes(
+            double value,
+            const GfInterval &interval,
+            const TsEvalOptions &options,
+            std::vector<TsTime> *timesOut) const;
+
+    private:
+        // Appends hits within the unrolled knots, in segments that overlap
+        // [minTime, maxTime].  Hits may lie outside that range.
+        void _FindInKnots(
+            double value,
+            Ts_EvalLocation location,
+            TsTime minTime,
+            TsTime maxTime,
+            const TsEvalOptions &options,
+            std::vector<_InverseHit> *hitsOut) const;
+
+        // Appends hits within iterations minIter through maxIter of
+        // extrapolating loops, on the side given by the sign of hopSign.
+        // Iteration numbers are whole, but are passed as doubles, since they
+        // are computed from times and may be out of range.  Fails if there are
+        // too many iterations to search.
+        bool _FindInLoops(
+            double value,
+            double minIter,
+            double maxIter,
+            int hopSign,
+            const GfInterval &interval,
+            const TsEvalOptions &options,
+            std::vector<_InverseHit> *hitsOut) const;
+
+        // Appends hits within one iteration of extrapolating loops.  The hop
+        // is the signed number of iterations from the iteration to the knots,
+        // as in _LoopResolver::_DoExtrap.
+        void _FindInLoopIteration(
+            double value,
+            int64_t hop,
+            const GfInterval &interval,
+            const TsEvalOptions &options,
+            std::vector<_InverseHit> *hitsOut) const;
+
+        // Appends hits in non-looping extrapolation.
+        void _FindInPreExtrap(
+            double value,
+            std::vector<_InverseHit> *hitsOut) const;
+        void _FindInPostExtrap(
+            double value,
+            std::vector<_InverseHit> *hitsOut) const;
+
+    private:
+        // Unrolled knots.  Only the first two and last two are needed after
+        // construction, for extrapolation.
+        std::vector<Ts_TypedKnotData<double>> _knots;
+        std::vector<_InverseSegment> _segments;
+
+        // Bounds on the values of all segments.
+        double _minValue = 0;
+        double _maxValue = 0;
+
+        // Whether the value never decreases, or never increases, from the
+        // first knot to the last, including at knots.
+        bool _nonDecreasing = false;
+        bool _nonIncreasing = false;
+
+        // Extrapolation.  Slopes are empty for value blocks, and for looping
+        // sides.
+        std::optional<double> _preSlope;
+        std::optional<double> _postSlope;
+        bool _havePreLoops = false;
+        bool _havePostLoops = false;
+        TsExtrapMode _loopMode = TsExtrapHeld;
+        double _loopValueOffset = 0;
+    };
+}
+
+// Finds the real roots of a quadratic, in ascending order.  Returns the number
+// of roots.
+//
+static int
+_FindQuadraticRoots(
+    const _Quadratic &quad,
+    double rootsOut[2])
+{
+    if (quad.a == 0)
+    {
+        if (quad.b == 0)
+        {
+            return 0;
+        }
+        rootsOut[0] = -quad.c / quad.b;
+        return 1;
+    }
+
+    const double discrim = quad.b * quad.b - 4 * quad.a * quad.c;
+    if (discrim < 0)
+    {
+        return 0;
+    }
+
+    // Avoid cancellation between b and the square root.
+    const double q =
+        -0.5 * (quad.b + std::copysign(std::sqrt(discrim), quad.b));
+    if (q == 0)
+    {
+        // b and c are both zero.
+        rootsOut[0] = 0;
+        return 1;
+    }
+
+    rootsOut[0] = q / quad.a;
+    rootsOut[1] = quad.c / q;
+    if (rootsOut[0] > rootsOut[1])
+    {
+        std::swap(rootsOut[0], rootsOut[1]);
+    }
+    return 2;
+}
+
+static _InverseSegment
+_MakeInverseSegment(
+    const Ts_TypedKnotData<double> &beginData,
+    const Ts_TypedKnotData<double> &endData)
+{
+    _InverseSegment seg;
+    seg.startTime = beginData.time;
+    seg.endTime = endData.time;
+    seg.interp = beginData.nextInterp;
+    seg.startValue = beginData.value;
+    seg.endValue = (seg.interp == TsInterpHeld ?
+        beginData.value : endData.GetPreValue());
+    seg.minValue = std::min(seg.startValue, seg.endValue);
+    seg.maxValue = std::max(seg.startValue, seg.endValue);
+
+    if (seg.interp == TsInterpValueBlock)
+    {
+        return seg;
+    }
+
+    seg.nonDecreasing = (seg.endValue >= seg.startValue);
+    seg.nonIncreasing = (seg.endValue <= seg.startValue);
+    if (seg.interp != TsInterpCurve)
+    {
+        return seg;
+    }
+
+    // Find the cubics as the evaluator does.
+    if (beginData.curveType == TsCurveTypeBezier)
+    {
+        _GetBezierCubics(
+            beginData, endData, beginData.time,
+            &seg.timeCubic, &seg.valueCubic);
+    }
+    else
+    {
+        const TsTime duration = endData.time - beginData.time;
+        seg.timeCubic = _Cubic{0, 0, duration, 0};
+        seg.valueCubic = _Cubic::FromPoints(
+            beginData.value,
+            beginData.value + beginData.GetPostTanSlope() * duration / 3,
+            endData.GetPreValue() - endData.GetPreTanSlope() * duration / 3,
+            endData.GetPreValue());
+    }
+
+    // Divide the segment at the extrema of the value.
+    double roots[2];
+    const int numRoots =
+        _FindQuadraticRoots(seg.valueCubic.GetDerivative(), roots);
+
+    seg.pieceParams[0] = 0;
+    seg.pieceValues[0] = seg.startValue;
+    seg.numPieceParams = 1;
+    for (int i = 0; i < numRoots; i++)
+    {
+        if (roots[i] > 0 && roots[i] < 1)
+        {
+            const double value = seg.valueCubic.Eval(roots[i]);
+            seg.pieceParams[seg.numPieceParams] = roots[i];
+            seg.pieceValues[seg.numPieceParams] = value;
+            seg.numPieceParams++;
+
+            seg.minValue = std::min(seg.minValue, value);
+            seg.maxValue = std::max(seg.maxValue, value);
+            seg.nonDecreasing &= (value >= seg.startValue);
+            seg.nonIncreasing &= (value <= seg.startValue);
+        }
+    }
+    seg.pieceParams[seg.numPieceParams] = 1;
+    seg.pieceValues[seg.numPieceParams] = seg.endValue;
+    seg.numPieceParams++;
+
+    // With an interior extremum, the segment isn't monotonic, even if its
+    // ends are in order.
+    if (seg.numPieceParams > 2)
+    {
+        seg.nonDecreasing = seg.nonIncreasing = false;
+    }
+
+    return seg;
+}
+
+// Appends hits within one segment.
+//
+static void
+_FindInSegment(
+    const _InverseSegment &seg,
+    const double value,
+    const Ts_EvalLocation location,
+    const TsEvalOptions &options,
+    std::vector<_InverseHit>* const hitsOut)
+{
+    if (value < seg.minValue || value > seg.maxValue)
+    {
+        return;
+    }
+
+    // Values at the included end of the segment.
+    const bool pre = (location == Ts_EvalPre);
+    if (!pre && value == seg.startValue
+        && seg.interp != TsInterpHeld && seg.minValue != seg.maxValue)
+    {
+        hitsOut->push_back({seg.startTime, seg.startTime});
+    }
+    else if (pre && value == seg.endValue
+             && seg.interp != TsInterpHeld && seg.minValue != seg.maxValue)
+    {
+        hitsOut->push_back({seg.endTime, seg.endTime});
+    }
+
+    // Blocked segments have values only at their knots.
+    if (seg.interp == TsInterpValueBlock)
+    {
+        return;
+    }
+
+    // Flat segments either have the value throughout or not at all.
+    if (seg.minValue == seg.maxValue)
+    {
+        hitsOut->push_back({seg.startTime, seg.endTime});
+        return;
+    }
+
+    if (seg.interp == TsInterpLinear)
+    {
+        if (value != seg.startValue && value != seg.endValue)
+        {
+            const double slope = (seg.endValue - seg.startValue)
+                / (seg.endTime - seg.startTime);
+            const TsTime time = GfClamp(
+                seg.startTime + (value - seg.startValue) / slope,
+                seg.startTime, seg.endTime);
+            hitsOut->push_back({time, time});
+        }
+        return;
+    }
+
+    // Curved segment.  Interior extrema may have the value exactly.
+    for (int i = 1; i < seg.numPieceParams - 1; i++)
+    {
+        if (seg.pieceValues[i] == value)
+        {
+            const TsTime time =
+                seg.startTime + seg.timeCubic.Eval(seg.pieceParams[i]);
+            hitsOut->push_back({time, time});
+        }
+    }
+
+    // Solve each monotonic piece whose values straddle the value.
+    for (int i = 0; i < seg.numPieceParams - 1; i++)
+    {
+        const double lo = seg.pieceParams[i];
+        const double hi = seg.pieceParams[i + 1];
+        const double loValue = seg.pieceValues[i];
+        const double hiValue = seg.pieceValues[i + 1];
+        if (!(std::min(loValue, hiValue) < value
+              && value < std::max(loValue, hiValue)))
+        {
+            continue;
+        }
+
+        // Make the function increasing, with a zero at the value.
+        const _Cubic &vc = seg.valueCubic;
+        const _Cubic cubic = (hiValue > loValue ?
+            _Cubic{vc.a, vc.b, vc.c, vc.d - value} :
+            _Cubic{-vc.a, -vc.b, -vc.c, value - vc.d});
+
+        // Seed with the zero of the chord across the piece.
+        const double seed =
+            lo + (hi - lo) * (value - loValue) / (hiValue - loValue);
+        const double t =
+            _FindMonotonicZeroInBracket(cubic, lo, hi, seed, options);
+
+        const TsTime time = GfClamp(
+            seg.startTime + seg.timeCubic.Eval(t),
+            seg.startTime, seg.endTime);
+        hitsOut->push_back({time, time});
+    }
+}
+
+void
+Ts_UnrollKnots(
+    const Ts_SplineData* const data,
+    const Ts_LoopTopology &topology,
+    std::vector<Ts_TypedKnotData<double>>* const knotsOut)
+{
+    const std::vector<TsTime> &times = data->times;
+
+    if (!topology.haveInnerLoops)
+    {
+        knotsOut->reserve(times.size());
+        for (size_t i = 0; i < times.size(); i++)
+        {
+            knotsOut->push_back(data->GetKnotDataAsDouble(i));
+        }
+        return;
+    }
+
+    const TsLoopParams &lp = data->loopParams;
+    const GfInterval loopedInterval = lp.GetLoopedInterval();
+
+    for (size_t i = 0; i < times.size()
+             && times[i] < loopedInterval.GetMin(); i++)
+    {
+        knotsOut->push_back(data->GetKnotDataAsDouble(i));
+    }
+    for (int iter = -lp.numPreLoops; iter <= lp.numPostLoops; iter++)
+    {
+        for (size_t i = topology.firstInnerProtoIndex;
+                 i <= topology.lastInnerProtoIndex; i++)
+        {
+            knotsOut->push_back(
+                _EchoProtoKnot(data, i, iter).Get(Ts_EvalValue));
+        }
+    }
+    knotsOut->push_back(topology.loopEndKnot.Get(Ts_EvalValue));
+    for (size_t i = 0; i < times.size(); i++)
+    {
+        if (times[i] > loopedInterval.GetMax())
+        {
+            knotsOut->push_back(data->GetKnotDataAsDouble(i));
+        }
+    }
+}
+
+_Inverter::_Inverter(
+    const Ts_SplineData* const data,
+    const Ts_LoopTopology &topology)
+{
+    if (data->times.empty())
+    {
+        return;
+    }
+
+    Ts_UnrollKnots(data, topology, &_knots);
+
+    // Classify segments.
+    _segments.reserve(_knots.size() - 1);
+    _nonDecreasing = _nonIncreasing = true;
+    _minValue = _maxValue = _knots.front().value;
+    for (size_t i = 0; i + 1 < _knots.size(); i++)
+    {
+        const _InverseSegment seg =
+            _MakeInverseSegment(_knots[i], _knots[i + 1]);
+
+        _minValue = std::min(_minValue, seg.minValue);
+        _maxValue = std::max(_maxValue, seg.maxValue);
+        _nonDecreasing &= seg.nonDecreasing
+            && (_segments.empty()
+                || _segments.back().endValue <= seg.startValue);
+        _nonIncreasing &= seg.nonIncreasing
+            && (_segments.empty()
+                || _segments.back().endValue >= seg.startValue);
+
+        _segments.push_back(seg);
+    }
+
+    // Extrapolation.
+    _havePreLoops = topology.havePreExtrapLoops;
+    _havePostLoops = topology.havePostExtrapLoops;
+    _loopValueOffset = topology.extrapValueOffset;
+
+    // Like _LoopResolver::_DoExtrap, take the looping mode from
+    // pre-extrapolation, for both sides.
+    _loopMode = data->preExtrapolation.mode;
+
+    const bool haveMultipleKnots = (_knots.size() > 1);
+    const Ts_TypedKnotData<double> &first = _knots.front();
+    const Ts_TypedKnotData<double> &last = _knots.back();
+    const Ts_TypedKnotData<double> second =
+        (haveMultipleKnots ? _knots[1] : Ts_TypedKnotData<double>());
+    const Ts_TypedKnotData<double> secondToLast =
+        (haveMultipleKnots ?
+            _knots[_knots.size() - 2] : Ts_TypedKnotData<double>());
+
+    if (!_havePreLoops)
+    {
+        _preSlope = _GetExtrapolationSlope<Ts_EvalFeatureAll>(
+            data->preExtrapolation, haveMultipleKnots, first, second,
+            data->curveType, Ts_EvalPre);
+    }
+    if (!_havePostLoops)
+    {
+        _postSlope = _GetExtrapolationSlope<Ts_EvalFeatureAll>(
+            data->postExtrapolation, haveMultipleKnots, last, secondToLast,
+            data->curveType, Ts_EvalPost);
+    }
+}
+
+bool
+_Inverter::CanSearch(
+    const GfInterval &interval) const
+{
+    if (_knots.empty())
+    {
+        return true;
+    }
+
+    return !(_havePreLoops && interval.GetMin() < _knots.front().time
+             && std::isinf(interval.GetMin()))
+        && !(_havePostLoops && interval.GetMax() >= _knots.back().time
+             && std::isinf(interval.GetMax()));
+}
+
+void
+_Inverter::_FindInKnots(
+    const double value,
+    const Ts_EvalLocation location,
+    const TsTime minTime,
+    const TsTime maxTime,
+    const TsEvalOptions &options,
+    std::vector<_InverseHit>* const hitsOut) const
+{
+    if (_segments.empty() || value < _minValue || value > _maxValue)
+    {
+        return;
+    }
+
+    // Find the first segment that overlaps the range, including a segment
+    // that ends at minTime, which has a hit there on the pre-side.
+    auto it = std::lower_bound(
+        _segments.begin(), _segments.end(), minTime,
+        [](const _InverseSegment &seg, const TsTime time)
+        { return seg.startTime < time; });
+    if (it != _segments.begin())
+    {
+        --it;
+    }
+
+    // Monotonic knots reach the value in a single run of segments.  Search
+    // for the first segment whose end reaches the value, and continue while
+    // segments start at the value.  Reflected iterations search the whole
+    // range, since they include segment ends.
+    if (location != Ts_EvalPre && (_nonDecreasing || _nonIncreasing))
+    {
+        const bool increasing = _nonDecreasing;
+        it = std::partition_point(
+            it, _segments.end(),
+            [value, increasing](const _InverseSegment &seg)
+            {
+                return increasing ?
+                    seg.endValue < value : seg.endValue > value;
+            });
+
+        for (; it != _segments.end() && it->startTime <= maxTime; ++it)
+        {
+            if (increasing ?
+                    it->startValue > value : it->startValue < value)
+            {
+                break;
+            }
+            _FindInSegment(*it, value, location, options, hitsOut);
+        }
+        return;
+    }
+
+    for (; it != _segments.end() && it->startTime <= maxTime; ++it)
+    {
+        _FindInSegment(*it, value, location, options, hitsOut);
+    }
+}
+
+void
+_Inverter::_FindInLoopIteration(
+    const double value,
+    const int64_t hop,
+    const GfInterval &interval,
+    const TsEvalOptions &options,
+    std::vector<_InverseHit>* const hitsOut) const
+{
+    const TsTime firstTime = _knots.front().time;
+    const TsTime lastTime = _knots.back().time;
+    const TsTime span = lastTime - firstTime;
+
+    // Repeat mode offsets each iteration's values.
+    const double knotValue = (_loopMode == TsExtrapLoopRepeat ?
+        value + hop * _loopValueOffset : value);
+    if (knotValue < _minValue || knotValue > _maxValue)
+    {
+        return;
+    }
+
+    // Oscillate mode reflects every other iteration, and evaluates on the
+    // opposite side.
+    const bool reflect = (_loopMode == TsExtrapLoopOscillate && hop % 2 != 0);
+    const auto toKnotTime = [=](const TsTime time)
+    {
+        const TsTime shifted = time + hop * span;
+        return reflect ? firstTime + lastTime - shifted : shifted;
+    };
+    const auto fromKnotTime = [=](const TsTime time)
+    {
+        return (reflect ? firstTime + lastTime - time : time) - hop * span;
+    };
+
+    // The range of knot times that map into the interval.
+    const TsTime min = toKnotTime(interval.GetMin());
+    const TsTime max = toKnotTime(interval.GetMax());
+
+    // Find hits in knot times, then map them back in place.
+    const size_t firstHit = hitsOut->size();
+    _FindInKnots(
+        knotValue, reflect ? Ts_EvalPre : Ts_EvalAtTime,
+        std::min(min, max), std::max(min, max), options, hitsOut);
+
+    for (size_t i = firstHit; i < hitsOut->size(); i++)
+    {
+        _InverseHit &hit = (*hitsOut)[i];
+        const TsTime start = fromKnotTime(hit.start);
+        const TsTime end = fromKnotTime(hit.end);
+        hit = {std::min(start, end), std::max(start, end)};
+    }
+}
+
+bool
+_Inverter::_FindInLoops(
+    const double value,
+    double minIter,
+    double maxIter,
+    const int hopSign,
+    const GfInterval &interval,
+    const TsEvalOptions &options,
+    std::vector<_InverseHit>* const hitsOut) const
+{
+    if (_loopMode == TsExtrapLoopRepeat && _loopValueOffset != 0)
+    {
+        // Repeat mode offsets each iteration's values, so only the iterations
+        // whose offset value lies within the knot values can have hits.
+        // Widen by one iteration on each side for rounding;
+        // _FindInLoopIteration checks the bounds exactly.
+        const double step = hopSign * _loopValueOffset;
+        const double bound1 = (_minValue - value) / step;
+        const double bound2 = (_maxValue - value) / step;
+        minIter = std::max(minIter, std::floor(std::min(bound1, bound2)) - 1);
+        maxIter = std::min(maxIter, std::ceil(std::max(bound1, bound2)) + 1);
+    }
+    else if (value < _minValue || value > _maxValue)
+    {
+        // Every iteration has the values of the knots.
+        return true;
+    }
+
+    if (!(minIter <= maxIter))
+    {
+        return true;
+    }
+
+    // Every searched iteration can reach the value, and iteration times lose
+    // meaning once they can't be represented exactly.
+    static const double maxNumIters = 1e6;
+    static const double maxIterNumber = 9007199254740992.0;  // 2^53
+    if (maxIter - minIter >= maxNumIters || maxIter > maxIterNumber)
+    {
+        TF_CODING_ERROR(
+            "Inverse evaluation interval spans too many iterations of "
+            "extrapolating loops");
+        return false;
+    }
+
+    const int64_t lastIter = int64_t(maxIter);
+    for (int64_t k = int64_t(minIter); k <= lastIter; k++)
+    {
+        _FindInLoopIteration(value, hopSign * k, interval, options, hitsOut);
+    }
+    return true;
+}
+
+void
+_Inverter::_FindInPreExtrap(
+    const double value,
+    std::vector<_InverseHit>* const hitsOut) const
+{
+    if (!_preSlope)
+    {
+        return;
+    }
+
+    const Ts_TypedKnotData<double> &first = _knots.front();
+    const double preValue = first.GetPreValue();
+    if (*_preSlope == 0)
+    {
+        if (value == preValue)
+        {
+            hitsOut->push_back(
+                {-std::numeric_limits<TsTime>::infinity(), first.time});
+        }
+        return;
+    }
+
+    const TsTime time = first.time - (preValue - value) / *_preSlope;
+    if (time < first.time)
+    {
+        hitsOut->push_back({time, time});
+    }
+}
+
+void
+_Inverter::_FindInPostExtrap(
+    const double value,
+    std::vector<_InverseHit>* const hitsOut) const
+{
+    // Even without extrapolation, the last knot has a value.
+    const Ts_TypedKnotData<double> &last = _knots.back();
+    if (!_postSlope || *_postSlope == 0)
+    {
+        if (value == last.value)
+        {
+            hitsOut->push_back({last.time, _postSlope ?
+                std::numeric_limits<TsTime>::infinity() : last.time});
+        }
+        return;
+    }
+
+    const TsTime time = last.time + (value - last.value) / *_postSlope;
+    if (time >= last.time)
+    {
+        hitsOut->push_back({time, time});
+    }
+}
+
+bool
+_Inverter::FindTimes(
+    const double value,
+    const GfInterval &interval,
+    const TsEvalOptions &options,
+    std::vector<TsTime>* const timesOut) const
+{
+    timesOut->clear();
+    if (_knots.empty() || interval.IsEmpty())
+    {
+        return true;
+    }
+
+    const TsTime firstTime = _knots.front().time;
+    const TsTime lastTime = _knots.back().time;
+    const TsTime span = lastTime - firstTime;
+    std::vector<_InverseHit> hits;
+
+    // Before the first knot.  Iteration k of pre-extrapolating loops covers
+    // [firstTime - k * span, firstTime - (k - 1) * span).
+    if (interval.GetMin() < firstTime)
+    {
+        if (_havePreLoops)
+        {
+            const double minIter = std::max(
+                1.0, std::floor((firstTime - interval.GetMax()) / span));
+            const double maxIter =
+                std::ceil((firstTime - interval.GetMin()) / span);
+            if (!_FindInLoops(
+                    value, minIter, maxIter, 1, interval, options, &hits))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            _FindInPreExtrap(value, &hits);
+        }
+    }
+
+    // From the first knot up to, but not including, the last.
+    if (interval.GetMax() >= firstTime && interval.GetMin() < lastTime)
+    {
+        _FindInKnots(
+            value, Ts_EvalAtTime,
+            std::max(interval.GetMin(), firstTime),
+            std::min(interval.GetMax(), lastTime),
+            options, &hits);
+    }
+
+    // From the last knot on.  Iteration k of post-extrapolating loops covers
+    // [lastTime + (k - 1) * span, lastTime + k * span).
+    if (interval.GetMax() >= lastTime)
+    {
+        if (_havePostLoops)
+        {
+            const double minIter = std::max(
+                1.0, std::floor((interval.GetMin() - lastTime) / span));
+            const double maxIter =
+                std::floor((interval.GetMax() - lastTime) / span) + 1;
+            if (!_FindInLoops(
+                    value, minIter, maxIter, -1, interval, options, &hits))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            _FindInPostExtrap(value, &hits);
+        }
+    }
+
+    // Report each hit that overlaps the interval.  Spans that extend outside
+    // the interval are reported where they enter it.  Hits that touch the
+    // span of an earlier hit are part of the same span.
+    std::sort(
+        hits.begin(), hits.end(),
+        [](const _InverseHit &a, const _InverseHit &b)
+        { return a.start < b.start; });
+
+    bool covered = false;
+    TsTime coveredEnd = 0;
+    for (const _InverseHit &hit : hits)
+    {
+        if (covered && hit.start <= coveredEnd)
+        {
+            coveredEnd = std::max(coveredEnd, hit.end);
+            continue;
+        }
+
+        // Spans that extend to negative infinity in an unbounded interval
+        // have no start to report.  Report them by the first knot instead,
+        // which starts the next hit.
+        const TsTime time = std::max(hit.start, interval.GetMin());
+        if (std::isinf(time) || time > hit.end || !interval.Contains(time))
+        {
+            continue;
+        }
+
+        timesOut->push_back(time);
+        covered = true;
+        coveredEnd = hit.end;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// VALUE RANGE
+//
+// Finds the range of a spline's values over an interval.  The value range tree
+// bounds each segment between unrolled knots, using the extrema found for
+// inverse evaluation, and combines the bounds in a min/max tree.  A query
+// visits whole segments through the tree, examines the segments that the
+// interval cuts, and evaluates the spline at the ends of the interval.
+//
+// Extrapolating loops are handled by mapping the first and last iterations
+// that the interval touches onto the knots.  Iterations in between cover all of
+// the knots, and differ only by their value offsets, which vary linearly.
+
+Ts_ValueRangeTree::Ts_ValueRangeTree(
+    const Ts_SplineData* const data)
+{
+    if (data->times.empty())
+    {
+        return;
+    }
+
+    const Ts_LoopTopology &topology = data->GetLoopTopology();
+    std::vector<Ts_TypedKnotData<double>> knots;
+    Ts_UnrollKnots(data, topology, &knots);
+
+    const Ts_TypedKnotData<double> &first = knots.front();
+    const Ts_TypedKnotData<double> &last = knots.back();
+    haveKnots = true;
+    firstTime = first.time;
+    lastTime = last.time;
+    firstValue = first.value;
+    firstPreValue = first.GetPreValue();
+    lastValue = last.value;
+
+    // Bound each segment.
+    const size_t numSegments = knots.size() - 1;
+    segments.reserve(numSegments);
+    for (size_t i = 0; i < numSegments; i++)
+    {
+        const _InverseSegment analysis =
+            _MakeInverseSegment(knots[i], knots[i + 1]);
+
+        Segment seg;
+        seg.startTime = analysis.startTime;
+        seg.endTime = analysis.endTime;
+        seg.startValue = analysis.startValue;
+        seg.endValue = analysis.endValue;
+        seg.blocked = (analysis.interp == TsInterpValueBlock);
+        for (int j = 1; j < analysis.numPieceParams - 1; j++)
+        {
+            seg.extremumTimes[seg.numExtrema] = analysis.startTime
+                + analysis.timeCubic.Eval(analysis.pieceParams[j]);
+            seg.extremumValues[seg.numExtrema] = analysis.pieceValues[j];
+            seg.numExtrema++;
+        }
+        segments.push_back(seg);
+    }
+
+    // Build the tree bottom-up.  Blocked segments are bounded by their start
+    // values.
+    treeMins.resize(2 * numSegments);
+    treeMaxs.resize(2 * numSegments);
+    for (size_t i = 0; i < numSegments; i++)
+    {
+        const Segment &seg = segments[i];
+        double min = seg.startValue, max = seg.startValue;
+        if (!seg.blocked)
+        {
+            min = std::min(min, seg.endValue);
+            max = std::max(max, seg.endValue);
+            for (int j = 0; j < seg.numExtrema; j++)
+            {
+                min = std::min(min, seg.extremumValues[j]);
+                max = std::max(max, seg.extremumValues[j]);
+            }
+        }
+        treeMins[numSegments + i] = min;
+        treeMaxs[numSegments + i] = max;
+    }
+    for (size_t i = numSegments; i-- > 1;)
+    {
+        treeMins[i] = std::min(treeMins[2 * i], treeMins[2 * i + 1]);
+        treeMaxs[i] = std::max(treeMaxs[2 * i], treeMaxs[2 * i + 1]);
+    }
+
+    // Extrapolation.  As in _LoopResolver::_DoExtrap, take the looping mode
+    // from pre-extrapolation, for both sides.
+    havePreExtrapLoops = topology.havePreExtrapLoops;
+    havePostExtrapLoops = topology.havePostExtrapLoops;
+    loopMode = data->preExtrapolation.mode;
+    extrapValueOffset = topology.extrapValueOffset;
+
+    const bool haveMultipleKnots = (knots.size() > 1);
+    if (!havePreExtrapLoops)
+    {
+        preSlope = _GetExtrapolationSlope<Ts_EvalFeatureAll>(
+            data->preExtrapolation, haveMultipleKnots, first,
+            haveMultipleKnots ? knots[1] : first,
+            data->curveType, Ts_EvalPre);
+    }
+    if (!havePostExtrapLoops)
+    {
+        postSlope = _GetExtrapolationSlope<Ts_EvalFeatureAll>(
+            data->postExtrapolation, haveMultipleKnots, last,
+            haveMultipleKnots ? knots[numSegments - 1] : last,
+            data->curveType, Ts_EvalPost);
+    }
+}
+
+namespace
+{
+    // An accumulated range of values.  Empty until a value is added.
+    //
+    struct _ValueRange
+    {
+        void Add(const double value)
+        {
+            min = std::min(min, value);
+            max = std::max(max, value);
+        }
+
+        bool IsEmpty() const
+        {
+            return min > max;
+        }
+
+        double min = std::numeric_limits<double>::infinity();
+        double max = -std::numeric_limits<double>::infinity();
+    };
+}
+
+// Adds the values that the unrolled knots take or approach over [minTime,
+// maxTime], which may extend past the knots, except for values at minTime and
+// maxTime inside segments, which the caller provides.
+//
+static void
+_AddKnotRange(
+    const Ts_ValueRangeTree &tree,
+    const TsTime minTime,
+    const TsTime maxTime,
+    _ValueRange* const rangeOut)
+{
+    using _Segment = Ts_ValueRangeTree::Segment;
+
+    if (tree.segments.empty())
+    {
+        if (minTime <= tree.firstTime && tree.firstTime <= maxTime)
+        {
+            rangeOut->Add(tree.firstValue);
+        }
+        return;
+    }
+
+    // Segments that end after minTime and start no later than maxTime.
+    const auto begin = std::partition_point(
+        tree.segments.begin(), tree.segments.end(),
+        [minTime](const _Segment &seg) { return seg.endTime <= minTime; });
+    const auto end = std::partition_point(
+        begin, tree.segments.end(),
+        [maxTime](const _Segment &seg) { return seg.startTime <= maxTime; });
+    if (begin == end)
+    {
+        return;
+    }
+
+    // Add the parts of a segment that are within the times.
+    const auto addPartial = [&](const _Segment &seg)
+    {
+        if (minTime <= seg.startTime)
+        {
+            rangeOut->Add(seg.startValue);
+        }
+        if (seg.blocked)
+        {
+            return;
+        }
+        if (maxTime >= seg.endTime)
+        {
+            rangeOut->Add(seg.endValue);
+        }
+        for (int i = 0; i < seg.numExtrema; i++)
+        {
+            if (minTime < seg.extremumTimes[i]
+                && seg.extremumTimes[i] < maxTime)
+            {
+                rangeOut->Add(seg.extremumValues[i]);
+            }
+        }
+    };
+
+    addPartial(*begin);
+    if (end - begin > 1)
+    {
+        addPartial(*(end - 1));
+    }
+
+    // Whole segments between, from the tree.  Standard bottom-up traversal
+    // over the half-open leaf range [lo, hi).
+    const size_t numSegments = tree.segments.size();
+    size_t lo = (begin - tree.segments.begin()) + 1 + numSegments;
+    size_t hi = (end - tree.segments.begin()) - 1 + numSegments;
+    while (lo < hi)
+    {
+        if (lo & 1)
+        {
+            rangeOut->Add(tree.treeMins[lo]);
+            rangeOut->Add(tree.treeMaxs[lo]);
+            lo++;
+        }
+        if (hi & 1)
+        {
+            hi--;
+            rangeOut->Add(tree.treeMins[hi]);
+            rangeOut->Add(tree.treeMaxs[hi]);
+        }
+        lo /= 2;
+        hi /= 2;
+    }
+}
+
+// Adds the values of extrapolating loops over [minTime, maxTime], which must
+// be on one side of the knots.  Iterations are numbered from 1 outward from the
+// knots.
+//
+static void
+_AddLoopRange(
+    const Ts_ValueRangeTree &tree,
+    const bool isPre,
+    const TsTime minTime,
+    const TsTime maxTime,
+    _ValueRange* const rangeOut)
+{
+    const TsTime span = tree.lastTime - tree.firstTime;
+    const bool repeat = (tree.loopMode == TsExtrapLoopRepeat);
+    const bool oscillate = (tree.loopMode == TsExtrapLoopOscillate);
+
+    // The signed number of iterations from an iteration to the knots, as in
+    // _LoopResolver::_DoExtrap.
+    const auto getHop = [isPre](const double iter)
+    {
+        return isPre ? iter : -iter;
+    };
+
+    // The value offset of an iteration.  Written to allow infinite iterations.
+    const auto getShift = [&](const double iter)
+    {
+        if (!repeat || tree.extrapValueOffset == 0)
+        {
+            return 0.0;
+        }
+        return -getHop(iter) * tree.extrapValueOffset;
+    };
+
+    // Adds part of one iteration.
+    const auto addIteration = [&](const double iter)
+    {
+        const double hop = getHop(iter);
+        const TsTime iterMin = (isPre ?
+            tree.firstTime - iter * span : tree.lastTime + (iter - 1) * span);
+        TsTime min = std::max(minTime, iterMin) + hop * span;
+        TsTime max = std::min(maxTime, iterMin + span) + hop * span;
+        if (oscillate && std::fmod(hop, 2) != 0)
+        {
+            const TsTime reflectedMin = tree.firstTime + tree.lastTime - max;
+            max = tree.firstTime + tree.lastTime - min;
+            min = reflectedMin;
+        }
+
+        _ValueRange knotRange;
+        _AddKnotRange(tree, min, max, &knotRange);
+        if (!knotRange.IsEmpty())
+        {
+            rangeOut->Add(knotRange.min + getShift(iter));
+            rangeOut->Add(knotRange.max + getShift(iter));
+        }
+    };
+
+    // The iterations nearest to and farthest from the knots.
+    const TsTime nearTime = (isPre ? maxTime : minTime);
+    const TsTime farTime = (isPre ? minTime : maxTime);
+    const TsTime nearDist = std::abs(nearTime - (isPre ?
+        tree.firstTime : tree.lastTime));
+    const TsTime farDist = std::abs(farTime - (isPre ?
+        tree.firstTime : tree.lastTime));
+    const double nearIter = std::floor(nearDist / span) + 1;
+    const double farIter = std::max(nearIter, std::ceil(farDist / span));
+
+    addIteration(nearIter);
+    if (std::isinf(farIter))
+    {
+        // Unbounded.  All knot values, with offsets out to infinity.
+        _ValueRange knotRange;
+        _AddKnotRange(tree, tree.firstTime, tree.lastTime, &knotRange);
+        for (const double iter : {nearIter + 1, farIter})
+        {
+            rangeOut->Add(knotRange.min + getShift(iter));
+            rangeOut->Add(knotRange.max + getShift(iter));
+        }
+        return;
+    }
+    if (farIter > nearIter)
+    {
+        addIteration(farIter);
+    }
+    if (farIter > nearIter + 1)
+    {
+        _ValueRange knotRange;
+        _AddKnotRange(tree, tree.firstTime, tree.lastTime, &knotRange);
+        for (const double iter : {nearIter + 1, farIter - 1})
+        {
+            rangeOut->Add(knotRange.min + getShift(iter));
+            rangeOut->Add(knotRange.max + getShift(iter));
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// INTEGRATION
+//
+// Integrates a spline's value over time.  The area of a segment from its start
+// to curve parameter u is the integral of y(u) x'(u), a polynomial of degree
+// six for Bezier curves, and of lower degree for the other interpolation
+// modes, whose time is linear in u.  Running totals make the integral from the
+// first knot to any time a lookup plus one partial segment, and the integral
+// over an interval is the difference of two such totals.
+//
+// Extrapolating loops are handled in closed form.  Whole iterations have the
+// area of the knots, plus, in Repeat mode, their value offset times the
+// unblocked time of the knots; offsets vary linearly with the iteration, so
+// any number of whole iterations sums directly.  The partial iteration at the
+// end is mapped onto the knots, reflected in Oscillate mode.
+
+// Finds the area polynomial of an unblocked segment.
+//
+static void
+_SetSegmentArea(
+    const Ts_TypedKnotData<double> &beginData,
+    const Ts_TypedKnotData<double> &endData,
+    Ts_IntegralTable::Segment* const segOut)
+{
+    const TsTime duration = endData.time - beginData.time;
+    _Cubic valueCubic;
+    _Quadratic timeDeriv{0, 0, duration};
+
+    switch (beginData.nextInterp)
+    {
+        case TsInterpHeld:
+            valueCubic = _Cubic{0, 0, 0, beginData.value};
+            break;
+
+        case TsInterpLinear:
+            valueCubic = _Cubic{
+                0, 0, endData.GetPreValue() - beginData.value,
+                beginData.value};
+            break;
+
+        case TsInterpCurve:
+            if (beginData.curveType == TsCurveTypeBezier)
+            {
+                _Cubic timeCubic;
+                _GetBezierCubics(
+                    beginData, endData, beginData.time,
+                    &timeCubic, &valueCubic);
+                timeDeriv = timeCubic.GetDerivative();
+
+                segOut->bezier = true;
+                segOut->timeCubic[0] = timeCubic.a;
+                segOut->timeCubic[1] = timeCubic.b;
+                segOut->timeCubic[2] = timeCubic.c;
+                segOut->timeCubic[3] = timeCubic.d;
+            }
+            else
+            {
+                valueCubic = _Cubic::FromPoints(
+                    beginData.value,
+                    beginData.value
+                        + beginData.GetPostTanSlope() * duration / 3,
+                    endData.GetPreValue()
+                        - endData.GetPreTanSlope() * duration / 3,
+                    endData.GetPreValue());
+            }
+            break;
+
+        default:
+            return;
+    }
+
+    // Multiply, in ascending powers, and integrate term by term.
+    const double values[4] =
+        {valueCubic.d, valueCubic.c, valueCubic.b, valueCubic.a};
+    const double rates[3] = {timeDeriv.c, timeDeriv.b, timeDeriv.a};
+    for (int i = 0; i < 4; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            segOut->area[i + j + 1] += values[i] * rates[j] / (i + j + 1);
+        }
+    }
+}
+
+Ts_IntegralTable::Ts_IntegralTable(
+    const Ts_SplineData* const data)
+{
+    if (data->times.empty())
+    {
+        return;
+    }
+
+    const Ts_LoopTopology &topology = data->GetLoopTopology();
+    std::vector<Ts_TypedKnotData<double>> knots;
+    Ts_UnrollKnots(data, topology, &knots);
+
+    const Ts_TypedKnotData<double> &first = knots.front();
+    const Ts_TypedKnotData<double> &last = knots.back();
+    haveKnots = true;
+    firstTime = first.time;
+    lastTime = last.time;
+    firstPreValue = first.GetPreValue();
+    lastValue = last.value;
+
+    // Find each segment's area, and accumulate.
+    const size_t numSegments = knots.size() - 1;
+    segments.reserve(numSegments);
+    prefixAreas.reserve(numSegments + 1);
+    prefixCovered.reserve(numSegments + 1);
+    double area = 0, covered = 0;
+    for (size_t i = 0; i < numSegments; i++)
+    {
+        Segment seg;
+        seg.startTime = knots[i].time;
+        seg.endTime = knots[i + 1].time;
+        seg.blocked = (knots[i].nextInterp == TsInterpValueBlock);
+
+        prefixAreas.push_back(area);
+        prefixCovered.push_back(covered);
+        if (!seg.blocked)
+        {
+            _SetSegmentArea(knots[i], knots[i + 1], &seg);
+            for (const double coeff : seg.area)
+            {
+                area += coeff;
+            }
+            covered += seg.endTime - seg.startTime;
+        }
+        segments.push_back(seg);
+    }
+    prefixAreas.push_back(area);
+    prefixCovered.push_back(covered);
+
+    // Extrapolation, as for Ts_ValueRangeTree.
+    havePreExtrapLoops = topology.havePreExtrapLoops;
+    havePostExtrapLoops = topology.havePostExtrapLoops;
+    loopMode = data->preExtrapolation.mode;
+    extrapValueOffset = topology.extrapValueOffset;
+
+    const bool haveMultipleKnots = (knots.size() > 1);
+    if (!havePreExtrapLoops)
+    {
+        preSlope = _GetExtrapolationSlope<Ts_EvalFeatureAll>(
+            data->preExtrapolation, haveMultipleKnots, first,
+            haveMultipleKnots ? knots[1] : first,
+            data->curveType, Ts_EvalPre);
+    }
+    if (!havePostExtrapLoops)
+    {
+        postSlope = _GetExtrapolationSlope<Ts_EvalFeatureAll>(
+            data->postExtrapolation, haveMultipleKnots, last,
+            haveMultipleKnots ? knots[numSegments - 1] : last,
+            data->curveType, Ts_EvalPost);
+    }
+}
+
+// Returns the area of an unblocked segment from its start to a time within it.
+//
+static double
+_GetPartialArea(
+    const Ts_IntegralTable::Segment &seg,
+    const TsTime time)
+{
+    double u = 0;
+    if (seg.bezier)
+    {
+        // Solve iteratively; the time cubic is monotonic, and Newton's method
+        // is precise without Cardano's special cases.
+        TsEvalOptions options;
+        options.bezierSolver = TsBezierSolverNewton;
+        const _Cubic timeCubic{
+            seg.timeCubic[0], seg.timeCubic[1], seg.timeCubic[2],
+            seg.timeCubic[3] - (time - seg.startTime)};
+        u = _ClampBezierParameter(_FindBezierZero(timeCubic, options));
+    }
+    else
+    {
+        u = (time - seg.startTime) / (seg.endTime - seg.startTime);
+    }
+
+    double area = 0;
+    for (int i = 6; i >= 0; i--)
+    {
+        area = area * u + seg.area[i];
+    }
+    return area;
+}
+
+// Finds the area, and unblocked time, from the first knot to a time within the
+// knots.
+//
+static void
+_GetKnotTotals(
+    const Ts_IntegralTable &table,
+    const TsTime time,
+    double* const areaOut,
+    double* const coveredOut)
+{
+    using _Segment = Ts_IntegralTable::Segment;
+
+    // The segment that contains the time, or the end if the time is the last
+    // knot's.
+    const auto it = std::partition_point(
+        table.segments.begin(), table.segments.end(),
+        [time](const _Segment &seg) { return seg.endTime <= time; });
+    const size_t index = it - table.segments.begin();
+
+    *areaOut = table.prefixAreas[index];
+    *coveredOut = table.prefixCovered[index];
+    if (it == table.segments.end() || it->blocked || time <= it->startTime)
+    {
+        return;
+    }
+
+    *areaOut += _GetPartialArea(*it, time);
+    *coveredOut += time - it->startTime;
+}
+
+// Finds the area, and unblocked time, of the extrapolating loops that lie
+// within a distance of the knots, on one side.  Iterations are numbered from 1
+// outward from the knots.
+//
+static void
+_GetLoopTotals(
+    const Ts_IntegralTable &table,
+    const bool isPre,
+    const TsTime distance,
+    double* const areaOut,
+    double* const coveredOut)
+{
+    const TsTime span = table.lastTime - table.firstTime;
+    const double knotArea = table.prefixAreas.back();
+    const double knotCovered = table.prefixCovered.back();
+
+    // The value offset gained by each iteration, as in _AddLoopRange.
+    const double step =
+        (table.loopMode != TsExtrapLoopRepeat ? 0.0 :
+         isPre ? -table.extrapValueOffset : table.extrapValueOffset);
+
+    // Whole iterations 1 through n.
+    const double numWhole = std::floor(distance / span);
+    *areaOut = numWhole * knotArea;
+    *coveredOut = numWhole * knotCovered;
+    if (step != 0)
+    {
+        *areaOut += step * knotCovered * numWhole * (numWhole + 1) / 2;
+    }
+
+    // The part of iteration n + 1 nearest the knots: its start after the
+    // knots, or its end before them, unless reflected.
+    const TsTime remainder =
+        GfClamp(distance - numWhole * span, 0.0, span);
+    if (remainder == 0)
+    {
+        return;
+    }
+
+    const bool reflect = (table.loopMode == TsExtrapLoopOscillate
+        && std::fmod(numWhole + 1, 2) != 0);
+    double area = 0, covered = 0;
+    if (isPre == reflect)
+    {
+        _GetKnotTotals(table, table.firstTime + remainder, &area, &covered);
+    }
+    else
+    {
+        _GetKnotTotals(table, table.lastTime - remainder, &area, &covered);
+        area = knotArea - area;
+        covered = knotCovered - covered;
+    }
+
+    *areaOut += area + step * (numWhole + 1) * covered;
+    *coveredOut += covered;
+}
+
+// Finds the signed area, and unblocked time, from the first knot to any
+// finite time.
+//
+static void
+_GetTotals(
+    const Ts_IntegralTable &table,
+    const TsTime time,
+    double* const areaOut,
+    double* const coveredOut)
+{
+    // Linear extrapolation from a knot value, over a signed distance.
+    const auto getExtrapTotals = [](
+        const std::optional<double> &slope,
+        const double value,
+        const TsTime distance,
+        double* const areaOut,
+        double* const coveredOut)
+    {
+        if (!slope)
+        {
+            *areaOut = *coveredOut = 0;
+            return;
+        }
+        *areaOut = distance * value
+            + (*slope == 0 ? 0.0 : *slope * distance * distance / 2);
+        *coveredOut = distance;
+    };
+
+    if (time < table.firstTime)
+    {
+        if (table.havePreExtrapLoops)
+        {
+            _GetLoopTotals(
+                table, /* isPre = */ true, table.firstTime - time,
+                areaOut, coveredOut);
+            *areaOut = -*areaOut;
+            *coveredOut = -*coveredOut;
+        }
+        else
+        {
+            getExtrapTotals(
+                table.preSlope, table.firstPreValue, time - table.firstTime,
+                areaOut, coveredOut);
+        }
+        return;
+    }
+
+    if (time <= table.lastTime)
+    {
+        _GetKnotTotals(table, time, areaOut, coveredOut);
+        return;
+    }
+
+    double area = 0, covered = 0;
+    if (table.havePostExtrapLoops)
+    {
+        _GetLoopTotals(
+            table, /* isPre = */ false, time - table.lastTime,
+            &area, &covered);
+    }
+    else
+    {
+        getExtrapTotals(
+            table.postSlope, table.lastValue, time - table.lastTime,
+            &area, &covered);
+    }
+    *areaOut = table.prefixAreas.back() + area;
+    *coveredOut = table.prefixCovered.back() + covered;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// EVAL ENTRY POINTS
+
+std::optional<double>
+Ts_Eval(
+    const Ts_SplineData* const data,
+    const TsTime timeIn,
+    const Ts_EvalAspect aspect,
+    const Ts_EvalLocation location,
+    const TsEvalOptions &options)
+{
+    // If no knots, no value or slope.
+    if (data->times.empty())
+    {
+        return std::nullopt;
+    }
+
+    const Ts_LoopTopology &topology = data->GetLoopTopology();
+    Ts_EvalCursor cursor(data);
+
+    return _EvalWithSetup(
+        data, topology, &cursor, timeIn, aspect, location, options);
+}
+
+std::optional<double>
+Ts_Eval(
+    const Ts_SplineData* const data,
+    const Ts_LoopTopology &topology,
+    Ts_EvalCursor* const cursor,
+    const TsTime time,
+    const Ts_EvalAspect aspect,
+    const Ts_EvalLocation location,
+    const TsEvalOptions &options)
+{
+    return _EvalWithSetup(
+        data, topology, cursor, time, aspect, location, options);
+}
+
+std::optional<double>
+Ts_EvalCompiledSegment(
+    const Ts_CompiledSegment &segment,
+    const TsTime time,
+    const Ts_EvalAspect aspect,
+    const TsEvalOptions &options)
+{
+    return _InterpolateCompiled(segment, time, aspect, options);
+}
+
+// Batch evaluation loop, for one resolver type.
+//
+template <typename Resolver, typename T>
+static bool
+_EvalManyWith(
+    const Ts_SplineData* const data,
+    const Ts_LoopTopology &topology,
+    const TfSpan<const TsTime> times,
+    const Ts_EvalAspect aspect,
+    const Ts_EvalLocation location,
+    const TsEvalOptions &options,
+    const TfSpan<T> valuesOut)
+{
+    const _EvalKernel<Resolver> kernel = _GetEvalKernel<Resolver>(topology);
+    Ts_EvalCursor cursor(data);
+    _BezierBlock block(options);
+
+    bool haveAll = true;
+    for (size_t i = 0; i < times.size(); i++)
+    {
+        const Resolver loopRes(data, topology, times[i], aspect, location);
+
+        // Defer samples in compiled Bezier segments to the block kernels.
+        // Held evaluation doesn't involve the curve.
+        if (aspect != Ts_EvalHeldValue)
+        {
+            const Ts_CompiledSegment* const segment =
+                _FindCompiledSegment(data, loopRes, &cursor);
+            if (segment && segment->type == Ts_CompiledBezier)
+            {
+                block.Add(*segment, loopRes, i);
+                if (block.IsFull())
+                {
+                    block.Flush(aspect, valuesOut);
+                }
+                continue;
+            }
+        }
+
+        const std::optional<double> result =
+            kernel(data, loopRes, aspect, options, &cursor);
+
+        if (result)
+        {
+            valuesOut[i] = T((*result + loopRes.GetValueOffset())
+                * (loopRes.GetNegate() ? -1 : 1));
+        }
+        else
+        {
+            haveAll = false;
+        }
+    }
+
+    block.Flush(aspect, valuesOut);
+
+    return haveAll;
+}
+
+std::optional<Ts_EvalResults>
+Ts_EvalWithDerivatives(
+    const Ts_SplineData* const data,
+    const TsTime time,
+    const Ts_EvalLocation location,
+    const TsEvalOptions &options)
+{
+    // If no knots, no value or slope.
+    if (data->times.empty())
+    {
+        return std::nullopt;
+    }
+
+    const Ts_LoopTopology &topology = data->GetLoopTopology();
+    Ts_EvalCursor cursor(data);
+
+    return _EvalWithDerivatives(
+        data, topology, &cursor, time, location, options);
+}
+
+template <typename T>
+bool
+Ts_EvalManyWithDerivatives(
+    const Ts_SplineData* const data,
+    const TfSpan<const TsTime> times,
+    const Ts_EvalLocation location,
+    const TsEvalOptions &options,
+    const TfSpan<T> valuesOut,
+    const TfSpan<T> derivativesOut,
+    const TfSpan<T> secondDerivativesOut)
+{
+    if (times.size() != valuesOut.size()
+        || times.size() != derivativesOut.size()
+        || (!secondDerivativesOut.empty()
+            && times.size() != secondDerivativesOut.size()))
+    {
+        TF_CODING_ERROR(
+            "Mismatched sizes for times (%zu), values (%zu), derivatives "
+            "(%zu), and second derivatives (%zu) in batch evaluation",
+            times.size(), valuesOut.size(), derivativesOut.size(),
+            secondDerivativesOut.size());
+        return false;
+    }
+
+    // If no knots, no values or slopes.
+    if (data->times.empty())
+    {
+        return times.empty();
+    }
+
+    // Set up once for the whole batch.
+    const Ts_LoopTopology &topology = data->GetLoopTopology();
+    Ts_EvalCursor cursor(data);
+
+    bool haveAll = true;
+    for (size_t i = 0; i < times.size(); i++)
+    {
+        const std::optional<Ts_EvalResults> result =
+            _EvalWithDerivatives(
+                data, topology, &cursor, times[i], location, options);
+
+        if (result)
+        {
+            valuesOut[i] = T(result->value);
+            derivativesOut[i] = T(result->derivative);
+            if (!secondDerivativesOut.empty())
+            {
+                secondDerivativesOut[i] = T(result->secondDerivative);
+            }
+        }
+        else
+        {
+            haveAll = false;
+        }
+    }
+
+    return haveAll;
+}
+
+template <typename T>
+bool
+Ts_EvalMany(
+    const Ts_SplineData* const data,
+    const TfSpan<const TsTime> times,
+    const Ts_EvalAspect aspect,
+    const Ts_EvalLocation location,
+    const TsEvalOptions &options,
+    const TfSpan<T> valuesOut)
+{
+    if (times.size() != valuesOut.size())
+    {
+        TF_CODING_ERROR(
+            "Mismatched sizes for times (%zu) and values (%zu) "
+            "in batch evaluation",
+            times.size(), valuesOut.size());
+        return false;
+    }
+
+    // If no knots, no values or slopes.
+    if (data->times.empty())
+    {
+        return times.empty();
+    }
+
+    // Set up once for the whole batch.
+    const Ts_LoopTopology &topology = data->GetLoopTopology();
+    if (topology.features & Ts_EvalFeatureLoops)
+    {
+        return _EvalManyWith<_LoopResolver>(
+            data, topology, times, aspect, location, options, valuesOut);
+    }
+    return _EvalManyWith<_NoLoops>(
+        data, topology, times, aspect, location, options, valuesOut);
+}
+
+#define _INSTANTIATE_EVAL_MANY(unused, tuple)                          \
+    template TS_API bool                                                \
+    Ts_EvalMany(                                                        \
+        const Ts_SplineData *data,                                      \
+        TfSpan<const TsTime> times,                                     \
+        Ts_EvalAspect aspect,                                           \
+        Ts_EvalLocation location,                                       \
+        const TsEvalOptions &options,                                   \
+        TfSpan<TS_SPLINE_VALUE_CPP_TYPE(tuple)> valuesOut);
+
+TF_PP_SEQ_FOR_EACH(_INSTANTIATE_EVAL_MANY, ~, TS_SPLINE_SUPPORTED_VALUE_TYPES)
+
+#undef _INSTANTIATE_EVAL_MANY
+
+#define _INSTANTIATE_EVAL_MANY_WITH_DERIVATIVES(unused, tuple)         \
+    template TS_API bool                                                \
+    Ts_EvalManyWithDerivatives(                                         \
+        const Ts_SplineData *data,                                      \
+        TfSpan<const TsTime> times,                                     \
+        Ts_EvalLocation location,                                       \
+        const TsEvalOptions &options,                                   \
+        TfSpan<TS_SPLINE_VALUE_CPP_TYPE(tuple)> valuesOut,              \
+        TfSpan<TS_SPLINE_VALUE_CPP_TYPE(tuple)> derivativesOut,         \
+        TfSpan<TS_SPLINE_VALUE_CPP_TYPE(tuple)> secondDerivativesOut);
+
+TF_PP_SEQ_FOR_EACH(
+    _INSTANTIATE_EVAL_MANY_WITH_DERIVATIVES, ~,
+    TS_SPLINE_SUPPORTED_VALUE_TYPES)
+
+#undef _INSTANTIATE_EVAL_MANY_WITH_DERIVATIVES
+
+template <typename T>
+bool
+Ts_EvalShutter(
+    const Ts_SplineData* const data,
+    const TfSpan<const TsTime> frames,
+    const TsShutter &shutter,
+    const TsEvalOptions &options,
+    const TfSpan<T> valuesOut)
+{
+    if (!shutter.IsValid())
+    {
+        TF_CODING_ERROR(
+            "Invalid shutter: open %g, close %g, %d samples",
+            shutter.open, shutter.close, shutter.numSamples);
+        return false;
+    }
+
+    const size_t numSamples = shutter.numSamples;
+    if (valuesOut.size() != frames.size() * numSamples)
+    {
+        TF_CODING_ERROR(
+            "Mismatched sizes for frames (%zu) with %zu samples each, and "
+            "values (%zu) in shutter evaluation",
+            frames.size(), numSamples, valuesOut.size());
+        return false;
+    }
+
+    // If no knots, no values.
+    if (data->times.empty())
+    {
+        return frames.empty();
+    }
+
+    // Set up once for all frames.  The samples are the centers of equal
+    // strata, so they are evenly spaced.
+    std::vector<TsTime> offsets(numSamples);
+    for (size_t i = 0; i < numSamples; i++)
+    {
+        offsets[i] = shutter.GetSampleOffset(i);
+    }
+    const TsTime step = (shutter.close - shutter.open) / numSamples;
+    const std::vector<TsTime> &knotTimes = data->times;
+    const Ts_LoopTopology &topology = data->GetLoopTopology();
+    const bool haveLoops = (topology.features & Ts_EvalFeatureLoops);
+    Ts_EvalCursor cursor(data);
+    Ts_CompiledSegment storage;
+    std::vector<TsTime> times(numSamples);
+
+    bool haveAll = true;
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        const TsTime frame = frames[i];
+        const TfSpan<T> row = valuesOut.subspan(i * numSamples, numSamples);
+
+        // The common case: the whole window within one segment.
+        const size_t lbIndex = cursor.FindLowerBound(frame + offsets.front());
+        if (lbIndex > 0 && lbIndex < knotTimes.size()
+            && knotTimes[lbIndex] > frame + offsets.back())
+        {
+            if (const Ts_CompiledSegment* const segment = _GetRunSegment(
+                    data, topology, &cursor, lbIndex - 1, &storage))
+            {
+                haveAll &= _EvalRun(
+                    *segment, _ShutterTimes{frame, offsets.data(), step},
+                    options, row);
+                continue;
+            }
+        }
+
+        for (size_t j = 0; j < numSamples; j++)
+        {
+            times[j] = frame + offsets[j];
+        }
+        if (haveLoops)
+        {
+            haveAll &= _EvalManyWith<_LoopResolver>(
+                data, topology, times, Ts_EvalValue, Ts_EvalAtTime, options,
+                row);
+        }
+        else
+        {
+            haveAll &= _EvalManyWith<_NoLoops>(
+                data, topology, times, Ts_EvalValue, Ts_EvalAtTime, options,
+                row);
+        }
+    }
+
+    return haveAll;
+}
+
+#define _INSTANTIATE_EVAL_SHUTTER(unused, tuple)                       \
+    template TS_API bool                                                \
+    Ts_EvalShutter(                                                     \
+        const Ts_SplineData *data,                                      \
+        TfSpan<const TsTime> frames,                                    \
+        const TsShutter &shutter,                                       \
+        const TsEvalOptions &options,                                   \
+        TfSpan<TS_SPLINE_VALUE_CPP_TYPE(tuple)> valuesOut);
+
+TF_PP_SEQ_FOR_EACH(_INSTANTIATE_EVAL_SHUTTER, ~,
+                   TS_SPLINE_SUPPORTED_VALUE_TYPES)
+
+#undef _INSTANTIATE_EVAL_SHUTTER
+
+template <typename T>
+bool
+Ts_SampleUniform(
+    const Ts_SplineData* const data,
+    const TsTime start,
+    const TsTime step,
+    const TsEvalOptions &options,
+    const TfSpan<T> valuesOut)
+{
+    if (!std::isfinite(start) || !std::isfinite(step) || !(step > 0))
+    {
+        TF_CODING_ERROR(
+            "Invalid uniform sampling: start %g, step %g", start, step);
+        return false;
+    }
+
+    // If no knots, no values.
+    if (data->times.empty())
+    {
+        return valuesOut.empty();
+    }
+
+    const std::vector<TsTime> &knotTimes = data->times;
+    const Ts_LoopTopology &topology = data->GetLoopTopology();
+    Ts_EvalCursor cursor(data);
+    Ts_CompiledSegment storage;
+
+    bool haveAll = true;
+    size_t i = 0;
+    while (i < valuesOut.size())
+    {
+        const TsTime time = start + i * step;
+        const size_t lbIndex = cursor.FindLowerBound(time);
+
+        // Find the run of samples in the interior of the segment that contains
+        // this one.  The division estimates its end, which is then corrected
+        // against the sample times themselves.
+        size_t end = i;
+        if (lbIndex > 0 && lbIndex < knotTimes.size()
+            && knotTimes[lbIndex] > time)
+        {
+            const TsTime segEnd = knotTimes[lbIndex];
+            const double estimate = std::ceil((segEnd - start) / step);
+            end = (estimate < valuesOut.size() ?
+                std::max(size_t(estimate), i + 1) : valuesOut.size());
+            while (end > i + 1 && start + (end - 1) * step >= segEnd)
+            {
+                end--;
+            }
+            while (end < valuesOut.size() && start + end * step < segEnd)
+            {
+                end++;
+            }
+
+            if (const Ts_CompiledSegment* const segment = _GetRunSegment(
+                    data, topology, &cursor, lbIndex - 1, &storage))
+            {
+                haveAll &= _EvalRun(
+                    *segment, _UniformTimes{start, step, i}, options,
+                    valuesOut.subspan(i, end - i));
+                i = end;
+                continue;
+            }
+        }
+
+        // Knots, inner loops, and extrapolation, one sample at a time.
+        end = std::max(end, i + 1);
+        for (; i < end; i++)
+        {
+            const std::optional<double> value = Ts_Eval(
+                data, topology, &cursor, start + i * step,
+                Ts_EvalValue, Ts_EvalAtTime, options);
+            if (value)
+            {
+                valuesOut[i] = T(*value);
+            }
+            else
+            {
+                haveAll = false;
+            }
+        }
+    }
+
+    return haveAll;
+}
+
+#define _INSTANTIATE_SAMPLE_UNIFORM(unused, tuple)                     \
+    template TS_API bool                                                \
+    Ts_SampleUniform(                                                   \
+        const Ts_SplineData *data,                                      \
+        TsTime start,                                                   \
+        TsTime step,                                                    \
+        const TsEvalOptions &options,                                   \
+        TfSpan<TS_SPLINE_VALUE_CPP_TYPE(tuple)> valuesOut);
+
+TF_PP_SEQ_FOR_EACH(_INSTANTIATE_SAMPLE_UNIFORM, ~,
+                   TS_SPLINE_SUPPORTED_VALUE_TYPES)
+
+#undef _INSTANTIATE_SAMPLE_UNIFORM
+
+bool
+Ts_GetValueRange(
+    const Ts_SplineData* const data,
+    const GfInterval &interval,
+    double* const minOut,
+    double* const maxOut)
+{
+    if (interval.IsEmpty())
+    {
+        return false;
+    }
+
+    const Ts_ValueRangeTree &tree = data->GetValueRangeTree();
+    if (!tree.haveKnots)
+    {
+        return false;
+    }
+
+    const TsTime min = interval.GetMin();
+    const TsTime max = interval.GetMax();
+    _ValueRange range;
+
+    // Values at the ends of the interval.
+    for (const TsTime time : {min, max})
+    {
+        if (std::isfinite(time))
+        {
+            if (const std::optional<double> value = Ts_Eval(
+                    data, time, Ts_EvalValue, Ts_EvalAtTime, TsEvalOptions()))
+            {
+                range.Add(*value);
+            }
+        }
+    }
+
+    // Before the first knot.
+    if (min < tree.firstTime)
+    {
+        const TsTime end = std::min(max, tree.firstTime);
+        if (tree.havePreExtrapLoops)
+        {
+            _AddLoopRange(tree, /* isPre = */ true, min, end, &range);
+        }
+        else if (tree.preSlope)
+        {
+            for (const TsTime time : {min, end})
+            {
+                range.Add(tree.firstPreValue + (*tree.preSlope == 0 ?
+                    0.0 : *tree.preSlope * (time - tree.firstTime)));
+            }
+        }
+    }
+
+    // Within the knots.
+    if (max >= tree.firstTime && min <= tree.lastTime)
+    {
+        _AddKnotRange(
+            tree,
+            std::max(min, tree.firstTime),
+            std::min(max, tree.lastTime),
+            &range);
+    }
+
+    // From the last knot on.
+    if (max >= tree.lastTime)
+    {
+        const TsTime start = std::max(min, tree.lastTime);
+        if (tree.havePostExtrapLoops)
+        {
+            _AddLoopRange(tree, /* isPre = */ false, start, max, &range);
+        }
+        else
+        {
+            // The last knot has a value even if extrapolation is blocked.
+            if (min <= tree.lastTime)
+            {
+                range.Add(tree.lastValue);
+            }
+            if (tree.postSlope)
+            {
+                for (const TsTime time : {start, max})
+                {
+                    range.Add(tree.lastValue + (*tree.postSlope == 0 ?
+                        0.0 : *tree.postSlope * (time - tree.lastTime)));
+                }
+            }
+        }
+    }
+
+    if (range.IsEmpty())
+    {
+        return false;
+    }
+
+    *minOut = range.min;
+    *maxOut = range.max;
+    return true;
+}
+
+bool
+Ts_Integrate(
+    const Ts_SplineData* const data,
+    const TfSpan<const TsTime> boundaries,
+    const TfSpan<double> integralsOut,
+    const TfSpan<double> coveredOut)
+{
+    if (boundaries.size() != integralsOut.size() + 1
+        || coveredOut.size() != integralsOut.size())
+    {
+        TF_CODING_ERROR(
+            "Integration requires one more boundary than intervals");
+        return false;
+    }
+
+    for (size_t i = 0; i < boundaries.size(); i++)
+    {
+        if (!std::isfinite(boundaries[i]))
+        {
+            TF_CODING_ERROR("Integration requires finite intervals");
+            return false;
+        }
+        if (i > 0 && boundaries[i] < boundaries[i - 1])
+        {
+            TF_CODING_ERROR("Integration boundaries must be ascending");
+            return false;
+        }
+    }
+
+    const Ts_IntegralTable &table = data->GetIntegralTable();
+    if (!table.haveKnots)
+    {
+        return false;
+    }
+
+    // Difference the running totals at consecutive boundaries.
+    double prevArea = 0, prevCovered = 0;
+    _GetTotals(table, boundaries[0], &prevArea, &prevCovered);
+    for (size_t i = 0; i < integralsOut.size(); i++)
+    {
+        double area = 0, covered = 0;
+        _GetTotals(table, boundaries[i + 1], &area, &covered);
+        if (boundaries[i + 1] == boundaries[i])
+        {
+            integralsOut[i] = coveredOut[i] = 0;
+        }
+        else
+        {
+            integralsOut[i] = area - prevArea;
+            coveredOut[i] = covered - prevCovered;
+        }
+        prevArea = area;
+        prevCovered = covered;
+    }
+    return true;
+}
+
+bool
+Ts_FindTimesForValues(
+    const Ts_SplineData* const data,
+    const TfSpan<const double> values,
+    const GfInterval &interval,
+    const TsEvalOptions &options,
+    std::vector<std::vector<TsTime>>* const timesOut)
+{
+    if (interval.IsEmpty())
+    {
+        TF_CODING_ERROR("Empty interval for inverse evaluation");
+        return false;
+    }
+
+    // Classify segments once for all of the values.
+    const _Inverter inverter(data, data->GetLoopTopology());
+    if (!inverter.CanSearch(interval))
+    {
+        TF_CODING_ERROR(
+            "Inverse evaluation of a spline with extrapolating loops requires "
+            "an interval that is bounded on the looping sides");
+        return false;
+    }
+
+    timesOut->resize(values.size());
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        if (!inverter.FindTimes(
+                values[i], interval, options, &(*timesOut)[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
 
 }  // namespace pxr
@@ -10,12 +10,16 @@
 
 #include "./api.h"
 #include "./types.h"
+#include <pxr/gf/interval.h>
+#include <pxr/tf/span.h>
 
 #include <optional>
+#include <vector>
 
 namespace pxr {
 
 struct Ts_SplineData;
+struct Ts_CompiledSegment;
 
 
 enum Ts_EvalAspect
@@ -43,8 +47,172 @@ Ts_Eval(
     const Ts_SplineData *data,
     TsTime time,
     Ts_EvalAspect aspect,
-    Ts_EvalLocation location);
+    Ts_EvalLocation location,
+    const TsEvalOptions &options);
 
+// Evaluates the interior of a compiled segment.  The time must be strictly
+// between the segment's knots, and the segment must not be of type
+// Ts_CompiledUncompiled.  The result is the same as that of Ts_Eval for a
+// compiled spline without loops.
+//
+TS_API
+std::optional<double>
+Ts_EvalCompiledSegment(
+    const Ts_CompiledSegment &segment,
+    TsTime time,
+    Ts_EvalAspect aspect,
+    const TsEvalOptions &options);
+
+// Evaluates a spline's value or derivative at each of the given times, writing
+// results to the corresponding elements of valuesOut, which must be the same
+// size as times.  Elements for which there is no value or derivative are left
+// unmodified.  Returns true if every time produced a result.
+//
+// Loop setup is performed once for the whole batch, and the knot search for
+// each time starts from where the previous one ended, so ascending times are
+// the fastest case.  Any order is permitted.  If the spline has been compiled,
+// samples in Bezier segments are evaluated in blocks by vectorizable kernels,
+// which always use Newton's method, regardless of options.bezierSolver.
+//
+// Instantiated for each of the spline value types.
+//
+template <typename T>
+TS_API
+bool
+Ts_EvalMany(
+    const Ts_SplineData *data,
+    TfSpan<const TsTime> times,
+    Ts_EvalAspect aspect,
+    Ts_EvalLocation location,
+    const TsEvalOptions &options,
+    TfSpan<T> valuesOut);
+
+// Evaluates a spline's value at each sample time of a shutter pattern, around
+// each of a set of frames.  valuesOut holds one row of shutter.numSamples
+// values for each frame, in order.  Other conventions are as for Ts_EvalMany.
+//
+// Windows that lie within a single segment are evaluated together: the
+// segment is found once, and compiled if the spline hasn't been, and Bezier
+// solves are seeded from the previous sample.  Results agree with Ts_EvalMany
+// up to rounding.
+//
+// Instantiated for each of the spline value types.
+//
+template <typename T>
+TS_API
+bool
+Ts_EvalShutter(
+    const Ts_SplineData *data,
+    TfSpan<const TsTime> frames,
+    const TsShutter &shutter,
+    const TsEvalOptions &options,
+    TfSpan<T> valuesOut);
+
+// Evaluates a spline's value at start + i * step for each element of
+// valuesOut.  step must be positive.  Other conventions are as for
+// Ts_EvalMany.
+//
+// Runs of samples that lie within a single segment are evaluated together:
+// the segment is found once, and compiled if the spline hasn't been.  Hermite
+// segments are evaluated by forward differencing, and Bezier solves are seeded
+// from the previous sample.  Results agree with Ts_EvalMany up to rounding.
+//
+// Instantiated for each of the spline value types.
+//
+template <typename T>
+TS_API
+bool
+Ts_SampleUniform(
+    const Ts_SplineData *data,
+    TsTime start,
+    TsTime step,
+    const TsEvalOptions &options,
+    TfSpan<T> valuesOut);
+
+// A value and its first and second derivatives with respect to time.
+//
+struct Ts_EvalResults
+{
+    double value = 0;
+    double derivative = 0;
+    double secondDerivative = 0;
+};
+
+// Evaluates a spline's value, derivative, and second derivative at a given
+// time, with a single knot search, loop resolution, and segment solve.  The
+// value and derivative are the same as those of Ts_Eval.  At a knot, the
+// second derivative is that of the segment on the evaluated side.  An empty
+// return value means there is no value, or no derivative.
+//
+TS_API
+std::optional<Ts_EvalResults>
+Ts_EvalWithDerivatives(
+    const Ts_SplineData *data,
+    TsTime time,
+    Ts_EvalLocation location,
+    const TsEvalOptions &options);
+
+// Batch form of Ts_EvalWithDerivatives, with the same conventions as
+// Ts_EvalMany.  If secondDerivativesOut is empty, second derivatives aren't
+// written.
+//
+// Instantiated for each of the spline value types.
+//
+template <typename T>
+TS_API
+bool
+Ts_EvalManyWithDerivatives(
+    const Ts_SplineData *data,
+    TfSpan<const TsTime> times,
+    Ts_EvalLocation location,
+    const TsEvalOptions &options,
+    TfSpan<T> valuesOut,
+    TfSpan<T> derivativesOut,
+    TfSpan<T> secondDerivativesOut);
+
+// Finds the smallest and largest values that a spline takes, or approaches at
+// discontinuities, over an interval, including its endpoints whether or not
+// they are closed.  Values are unbounded where linear or looping
+// extrapolation is unbounded.  Returns false if the spline has no values in
+// the interval.
+//
+TS_API
+bool
+Ts_GetValueRange(
+    const Ts_SplineData *data,
+    const GfInterval &interval,
+    double *minOut,
+    double *maxOut);
+
+// Integrates a spline's value over each interval between consecutive
+// boundaries, which must be finite and ascending.  integralsOut and coveredOut
+// must each have one element fewer than boundaries.  coveredOut receives the
+// length of time in each interval at which the spline has a value; value
+// blocks contribute neither area nor time.  Returns false if the spline has no
+// knots, or if the arguments are invalid.
+//
+TS_API
+bool
+Ts_Integrate(
+    const Ts_SplineData *data,
+    TfSpan<const TsTime> boundaries,
+    TfSpan<double> integralsOut,
+    TfSpan<double> coveredOut);
+
+// Finds the times within an interval at which a spline has each of a set of
+// values, in ascending order.  Where the spline holds a value over a span of
+// time, only the start of the span, or the start of the interval, is reported.
+// Fails if the interval is empty, or if it is unbounded on a side where
+// extrapolation loops.
+//
+TS_API
+bool
+Ts_FindTimesForValues(
+    const Ts_SplineData *data,
+    TfSpan<const double> values,
+    const GfInterval &interval,
+    const TsEvalOptions &options,
+    std::vector<std::vector<TsTime>> *timesOut);
 
 }  // namespace pxr
 
@@ -0,0 +1,329 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#ifndef PXR_TS_EVAL_IMPL_H
+#define PXR_TS_EVAL_IMPL_H
+
+// Evaluation internals: per-spline setup that is cached on spline data, and
+// search state.  This header is private to the library, and is not installed.
+
+#include "./eval.h"
+#include "./knotData.h"
+
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace pxr {
+
+struct Ts_CompiledSpline;
+
+// Features of a spline that evaluation must be prepared for.  Common
+// combinations of features have their own evaluation kernels, so that common
+// splines take paths with few branches; other splines use a kernel that
+// handles all features.
+//
+enum Ts_EvalFeature : unsigned
+{
+    // Inner or extrapolating loops.
+    Ts_EvalFeatureLoops = 1 << 0,
+
+    // Curved segments of each curve type.
+    Ts_EvalFeatureBezier = 1 << 1,
+    Ts_EvalFeatureHermite = 1 << 2,
+
+    // Value-blocked segments or extrapolation.
+    Ts_EvalFeatureValueBlocks = 1 << 3,
+
+    // Dual-valued knots.
+    Ts_EvalFeatureDualValues = 1 << 4,
+
+    // Extrapolation that isn't held or blocked: linear, sloped, or looping.
+    // Without this, and without value blocks, all extrapolation is held.
+    Ts_EvalFeatureSlopedExtrap = 1 << 5,
+
+    Ts_EvalFeatureAll = (1 << 6) - 1
+};
+
+// The parts of evaluation setup that depend only on the spline, and not on the
+// evaluation time: the evaluation features, and loop and extrapolation
+// topology.  Built once per spline data revision, and cached on the data; see
+// Ts_SplineData::GetLoopTopology.
+//
+struct Ts_LoopTopology
+{
+public:
+    explicit Ts_LoopTopology(const Ts_SplineData *data);
+
+    // A copy of a prototype knot, echoed by inner loops.  The time is shifted,
+    // but the value isn't, because value offsets apply only when evaluating
+    // values.  Get returns the copy as seen by the specified aspect.
+    struct EchoedKnot
+    {
+        Ts_TypedKnotData<double> knot;
+        double valueOffset = 0;
+
+        Ts_TypedKnotData<double> Get(Ts_EvalAspect aspect) const;
+    };
+
+public:
+    // Bitwise combination of Ts_EvalFeature values.
+    unsigned features = 0;
+
+    bool haveInnerLoops = false;
+    size_t firstInnerProtoIndex = 0;
+    bool havePreExtrapLoops = false;
+    bool havePostExtrapLoops = false;
+
+    // First and last knot times, which may be authored or echoed.  Only
+    // computed when there is looping of some kind.
+    TsTime firstTime = 0;
+    TsTime lastTime = 0;
+    bool firstTimeLooped = false;
+    bool lastTimeLooped = false;
+
+    // Inner loops only.  The last knot of the prototype, which may also be the
+    // first.
+    size_t lastInnerProtoIndex = 0;
+    TsTime lastInnerProtoTime = 0;
+
+    // Inner loops only.  The time of the last authored knot before the looped
+    // interval, or +inf if there is none; and the time of the first authored
+    // knot after the looped interval, or -inf if there is none.  The
+    // infinities compare so that evaluation is never between those knots and
+    // the looped interval.
+    TsTime lastPreUnloopedTime = std::numeric_limits<TsTime>::infinity();
+    TsTime firstPostUnloopedTime = -std::numeric_limits<TsTime>::infinity();
+
+    // Inner loops only.  Echoes of the first prototype knot: at the end of
+    // the prototype, and at the start and end of the looped interval.
+    EchoedKnot protoEndKnot;
+    EchoedKnot loopStartKnot;
+    EchoedKnot loopEndKnot;
+
+    // Inner loops only.  Echoes that are the second knot when firstTimeLooped,
+    // and the second-to-last knot when lastTimeLooped.  The first and last are
+    // loopStartKnot and loopEndKnot.
+    EchoedKnot secondKnot;
+    EchoedKnot secondToLastKnot;
+
+    // Extrapolating loops only.  The difference between the values of the
+    // last and first knots, by which Repeat mode offsets each iteration.
+    double extrapValueOffset = 0;
+
+private:
+    void _InitFeatures(const Ts_SplineData *data);
+    void _InitInnerLoops(const Ts_SplineData *data);
+    void _InitExtrapLoops(const Ts_SplineData *data);
+};
+
+// Bounds on the values of each segment, for finding the range of a spline's
+// values over an interval.  Segments are those between knots after unrolling
+// inner loops.  Bounds are kept in a min/max tree over the segments, so that
+// the range of any run of whole segments is found in logarithmic time.  Built
+// once per spline data revision, and cached on the data; see
+// Ts_SplineData::GetValueRangeTree.
+//
+struct Ts_ValueRangeTree
+{
+public:
+    explicit Ts_ValueRangeTree(const Ts_SplineData *data);
+
+    // One segment.  The end value is on the pre-side of the end knot; for
+    // held segments, it is the start value.  Extrema are interior to the
+    // segment.  Blocked segments have a value only at their start.
+    struct Segment
+    {
+        TsTime startTime = 0;
+        TsTime endTime = 0;
+        double startValue = 0;
+        double endValue = 0;
+        bool blocked = false;
+        int numExtrema = 0;
+        TsTime extremumTimes[2] = {};
+        double extremumValues[2] = {};
+    };
+
+public:
+    bool haveKnots = false;
+
+    // First and last knot times, after unrolling inner loops, and values at
+    // those knots.
+    TsTime firstTime = 0;
+    TsTime lastTime = 0;
+    double firstValue = 0;
+    double firstPreValue = 0;
+    double lastValue = 0;
+
+    std::vector<Segment> segments;
+
+    // Min/max tree over segments.  Segment i is leaf numSegments + i; node i
+    // bounds nodes 2i and 2i + 1.
+    std::vector<double> treeMins;
+    std::vector<double> treeMaxs;
+
+    // Non-looping extrapolation slopes.  Empty for value blocks, and for
+    // looping sides.
+    std::optional<double> preSlope;
+    std::optional<double> postSlope;
+
+    // Extrapolating loops.
+    bool havePreExtrapLoops = false;
+    bool havePostExtrapLoops = false;
+    TsExtrapMode loopMode = TsExtrapHeld;
+    double extrapValueOffset = 0;
+};
+
+// Exact integrals of each segment, for integrating a spline's value over time.
+// Segments are those between knots after unrolling inner loops.  Each segment
+// stores its area as a polynomial in its curve parameter, and running totals
+// of area and of unblocked time are kept from the first knot, so that the
+// integral between any two times takes two knot lookups.  Built once per
+// spline data revision, and cached on the data; see
+// Ts_SplineData::GetIntegralTable.
+//
+struct Ts_IntegralTable
+{
+public:
+    explicit Ts_IntegralTable(const Ts_SplineData *data);
+
+    // One segment.  The area from the start time to parameter u in [0, 1] is
+    // the sum of area[i] * u^i.  The parameter is linear in time, except for
+    // Bezier segments, whose time is the cubic in u with coefficients
+    // timeCubic, highest power first, relative to the start time.  Blocked
+    // segments have no area.
+    struct Segment
+    {
+        TsTime startTime = 0;
+        TsTime endTime = 0;
+        bool blocked = false;
+        bool bezier = false;
+        double area[7] = {};
+        double timeCubic[4] = {};
+    };
+
+public:
+    bool haveKnots = false;
+
+    // First and last knot times, after unrolling inner loops, and values at
+    // those knots.
+    TsTime firstTime = 0;
+    TsTime lastTime = 0;
+    double firstPreValue = 0;
+    double lastValue = 0;
+
+    std::vector<Segment> segments;
+
+    // Area, and unblocked time, from the first knot to the start of each
+    // segment.  One more element than there are segments; the last holds the
+    // totals for all of the knots.
+    std::vector<double> prefixAreas;
+    std::vector<double> prefixCovered;
+
+    // Non-looping extrapolation slopes.  Empty for value blocks, and for
+    // looping sides.
+    std::optional<double> preSlope;
+    std::optional<double> postSlope;
+
+    // Extrapolating loops.
+    bool havePreExtrapLoops = false;
+    bool havePostExtrapLoops = false;
+    TsExtrapMode loopMode = TsExtrapHeld;
+    double extrapValueOffset = 0;
+};
+
+// State carried from one evaluation to the next when evaluating the same
+// spline at many times.  Remembers where the previous knot search landed, so
+// that times that advance or retreat by at most one segment can find their
+// knots without a binary search.  A single Ts_Eval call uses a fresh cursor.
+//
+// Also provides knot data as double, which is what the math uses.  Knots of
+// double-typed splines are read in place.  Knots of float and half splines are
+// read directly from the typed knot vector, without a virtual call, and
+// widened into a small cache, so that times within the same segment don't
+// repeatedly widen the same knots.
+//
+// Holds pointers into the spline data, which must outlive the cursor and must
+// not be modified while it is in use.  Compiled data is captured at
+// construction.
+//
+class Ts_EvalCursor
+{
+public:
+    explicit Ts_EvalCursor(const Ts_SplineData *data);
+
+    // Equivalent to std::lower_bound over the knot times: returns the index of
+    // the first knot at or after the specified time, or the number of knots if
+    // there is no such knot.
+    size_t FindLowerBound(TsTime time);
+
+    // Equivalent to GetKnotDataAsDouble.  The returned reference is valid only
+    // until the next call.  Must not be called for splines with no knots.
+    const Ts_TypedKnotData<double>& GetKnot(size_t index);
+
+    // Returns whether the spline has compiled data.
+    bool IsCompiled() const { return _compiled != nullptr; }
+
+    // Returns compiled data for the segment that starts at the specified knot.
+    // Returns null if the spline hasn't been compiled, or if the segment must
+    // be evaluated from knot data.
+    const Ts_CompiledSegment* GetCompiledSegment(size_t index) const;
+
+private:
+    bool _IsLowerBound(size_t index, TsTime time) const;
+
+private:
+    // Enough knots to cover one segment and its neighbors, which is the most
+    // that one evaluation reads.
+    static constexpr size_t _numCachedKnots = 4;
+    static constexpr size_t _noIndex = std::numeric_limits<size_t>::max();
+
+    const std::vector<TsTime> *_times;
+    const Ts_CompiledSpline *_compiled;
+
+    // The spline's knots.  Exactly one of these is non-null, according to the
+    // spline's value type, unless the spline has no value type.
+    const Ts_TypedKnotData<double>* _doubleKnots = nullptr;
+    const Ts_TypedKnotData<float>* _floatKnots = nullptr;
+    const Ts_TypedKnotData<GfHalf>* _halfKnots = nullptr;
+
+    size_t _lbIndex = 0;
+
+    size_t _cachedIndices[_numCachedKnots];
+    Ts_TypedKnotData<double> _cachedKnots[_numCachedKnots];
+    size_t _nextCacheSlot = 0;
+};
+
+// Evaluates like Ts_Eval, but with the per-spline setup supplied by the caller,
+// so that it can be reused across calls.  The topology and cursor must have
+// been constructed from the same data, and the data must have at least one
+// knot.
+//
+std::optional<double>
+Ts_Eval(
+    const Ts_SplineData *data,
+    const Ts_LoopTopology &topology,
+    Ts_EvalCursor *cursor,
+    TsTime time,
+    Ts_EvalAspect aspect,
+    Ts_EvalLocation location,
+    const TsEvalOptions &options);
+
+// Copies a spline's knots, unrolling inner loops.  Authored knots in the
+// looped interval are shadowed, except for the prototype, which is echoed once
+// per iteration.  The looped interval ends with a final echo of the first
+// prototype knot.  Echoed values include the inner-loop value offset.
+//
+void
+Ts_UnrollKnots(
+    const Ts_SplineData *data,
+    const Ts_LoopTopology &topology,
+    std::vector<Ts_TypedKnotData<double>> *knotsOut);
+
+}  // namespace pxr
+
+#endif
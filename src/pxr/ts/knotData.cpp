@@ -8,6 +8,11 @@
 #include "./knotData.h"
 #include "./valueTypeDispatch.h"
 
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define TS_HAVE_F16C
+#include <immintrin.h>
+#endif
+
 namespace pxr {
 
 
@@ -74,5 +79,48 @@ Ts_KnotDataProxy::Create(Ts_KnotData *data, const TfType valueType)
 
 Ts_KnotDataProxy::~Ts_KnotDataProxy() = default;
 
+template <>
+void Ts_ConvertKnotDataToDouble(
+    const Ts_TypedKnotData<GfHalf>* const in,
+    const size_t count,
+    Ts_TypedKnotData<double>* const out)
+{
+#ifdef TS_HAVE_F16C
+    for (size_t i = 0; i < count; i++)
+    {
+        static_cast<Ts_KnotData&>(out[i]) =
+            static_cast<const Ts_KnotData&>(in[i]);
+
+        // Convert the four half values to float in one instruction, then to
+        // double two at a time.  Both conversions are exact.
+        const __m128 floats = _mm_cvtph_ps(_mm_setr_epi16(
+            static_cast<short>(in[i].value.bits()),
+            static_cast<short>(in[i].preValue.bits()),
+            static_cast<short>(in[i].preTanSlope.bits()),
+            static_cast<short>(in[i].postTanSlope.bits()),
+            0, 0, 0, 0));
+        double doubles[4];
+        _mm_storeu_pd(doubles, _mm_cvtps_pd(floats));
+        _mm_storeu_pd(doubles + 2, _mm_cvtps_pd(_mm_movehl_ps(floats, floats)));
+
+        out[i].value = doubles[0];
+        out[i].preValue = doubles[1];
+        out[i].preTanSlope = doubles[2];
+        out[i].postTanSlope = doubles[3];
+    }
+#else
+    for (size_t i = 0; i < count; i++)
+    {
+        static_cast<Ts_KnotData&>(out[i]) =
+            static_cast<const Ts_KnotData&>(in[i]);
+
+        out[i].value = in[i].value;
+        out[i].preValue = in[i].preValue;
+        out[i].preTanSlope = in[i].preTanSlope;
+        out[i].postTanSlope = in[i].postTanSlope;
+    }
+#endif
+}
+
 
 }  // namespace pxr
@@ -170,6 +170,26 @@ public:
 // Exceeding this size may impact performance.
 static_assert(sizeof(Ts_TypedKnotData<double>) <= 64);
 
+// Converts count consecutive knots from value type T to double.  Evaluation and
+// sampling do all of their math in double precision.  Depending on T, this is
+// either a verbatim copy or an increase in precision.
+//
+template <typename T>
+void Ts_ConvertKnotDataToDouble(
+    const Ts_TypedKnotData<T> *in,
+    size_t count,
+    Ts_TypedKnotData<double> *out);
+
+// Specialization for half.  Uses the F16C instructions to convert all of a
+// knot's values at once, if the build targets them.
+//
+template <>
+TS_API
+void Ts_ConvertKnotDataToDouble(
+    const Ts_TypedKnotData<GfHalf> *in,
+    size_t count,
+    Ts_TypedKnotData<double> *out);
+
 
 // Virtual interface to TypedKnotData.
 //
@@ -398,6 +418,27 @@ void Ts_TypedKnotDataProxy<T>::GetPostTanSlope(
 }
 
 
+template <typename T>
+void Ts_ConvertKnotDataToDouble(
+    const Ts_TypedKnotData<T>* const in,
+    const size_t count,
+    Ts_TypedKnotData<double>* const out)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        // Use operator= to copy base-class members.  This is admittedly weird,
+        // but it will continue working if members are added to the base class.
+        static_cast<Ts_KnotData&>(out[i]) =
+            static_cast<const Ts_KnotData&>(in[i]);
+
+        // Copy derived members individually.
+        out[i].value = in[i].value;
+        out[i].preValue = in[i].preValue;
+        out[i].preTanSlope = in[i].preTanSlope;
+        out[i].postTanSlope = in[i].postTanSlope;
+    }
+}
+
 }  // namespace pxr
 
 #endif
@@ -0,0 +1,337 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include "./parallel.h"
+#include "./spline.h"
+
+#include <pxr/tf/diagnostic.h>
+
+#include <algorithm>
+
+namespace pxr {
+
+
+////////////////////////////////////////////////////////////////////////////////
+// EXECUTORS
+
+TsExecutor::~TsExecutor() = default;
+
+size_t TsSerialExecutor::GetConcurrency() const
+{
+    return 1;
+}
+
+void TsSerialExecutor::Run(
+    const size_t numTasks,
+    const std::function<void(size_t)> &task)
+{
+    for (size_t i = 0; i < numTasks; i++)
+    {
+        task(i);
+    }
+}
+
+// Whether the current thread is running a task for a thread pool executor.
+// Nested calls to Run execute serially, so that they can't wait on threads
+// that are waiting on them.
+static thread_local bool _inPoolTask = false;
+
+TsThreadPoolExecutor::TsThreadPoolExecutor(
+    size_t concurrency)
+{
+    if (concurrency == 0)
+    {
+        concurrency = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (size_t i = 0; i < concurrency; i++)
+    {
+        _queues.push_back(std::make_unique<_Queue>());
+    }
+
+    // The calling thread owns queue 0, so we need one fewer pool thread.
+    for (size_t i = 1; i < concurrency; i++)
+    {
+        _threads.emplace_back(&TsThreadPoolExecutor::_WorkerMain, this, i);
+    }
+}
+
+TsThreadPoolExecutor::~TsThreadPoolExecutor()
+{
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _wakeCondition.notify_all();
+
+    for (std::thread &thread : _threads)
+    {
+        thread.join();
+    }
+}
+
+size_t TsThreadPoolExecutor::GetConcurrency() const
+{
+    return _queues.size();
+}
+
+void TsThreadPoolExecutor::Run(
+    const size_t numTasks,
+    const std::function<void(size_t)> &task)
+{
+    // Run serially if there is no benefit to waking the pool, or if we are
+    // already inside a task.
+    if (_threads.empty() || numTasks < 2 || _inPoolTask)
+    {
+        for (size_t i = 0; i < numTasks; i++)
+        {
+            task(i);
+        }
+        return;
+    }
+
+    const std::lock_guard<std::mutex> runLock(_runMutex);
+
+    // Divide the tasks evenly.  The pool threads are all idle, so nobody else
+    // is looking at the queues.
+    const size_t numQueues = _queues.size();
+    for (size_t i = 0; i < numQueues; i++)
+    {
+        _Queue &queue = *_queues[i];
+        const std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.begin = numTasks * i / numQueues;
+        queue.end = numTasks * (i + 1) / numQueues;
+    }
+
+    // Wake the pool.
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        _task = &task;
+        _numWorking = _threads.size();
+        _generation++;
+    }
+    _wakeCondition.notify_all();
+
+    // Work alongside the pool.
+    _inPoolTask = true;
+    _Work(0);
+    _inPoolTask = false;
+
+    // Wait for the pool.  Pool threads stop working only when they can't find
+    // any more tasks, so once they have all stopped, every task has finished.
+    std::unique_lock<std::mutex> lock(_mutex);
+    _doneCondition.wait(lock, [this]() { return _numWorking == 0; });
+    _task = nullptr;
+}
+
+void TsThreadPoolExecutor::_WorkerMain(
+    const size_t queueIndex)
+{
+    _inPoolTask = true;
+
+    uint64_t generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wakeCondition.wait(lock, [this, generation]() {
+                return _stop || _generation != generation; });
+            if (_stop)
+            {
+                return;
+            }
+            generation = _generation;
+        }
+
+        _Work(queueIndex);
+
+        {
+            const std::lock_guard<std::mutex> lock(_mutex);
+            if (--_numWorking == 0)
+            {
+                _doneCondition.notify_all();
+            }
+        }
+    }
+}
+
+void TsThreadPoolExecutor::_Work(
+    const size_t queueIndex)
+{
+    size_t taskIndex = 0;
+    while (_Pop(queueIndex, &taskIndex) || _Steal(queueIndex, &taskIndex))
+    {
+        (*_task)(taskIndex);
+    }
+}
+
+bool TsThreadPoolExecutor::_Pop(
+    const size_t queueIndex,
+    size_t* const taskIndexOut)
+{
+    _Queue &queue = *_queues[queueIndex];
+    const std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.begin == queue.end)
+    {
+        return false;
+    }
+
+    *taskIndexOut = queue.begin++;
+    return true;
+}
+
+bool TsThreadPoolExecutor::_Steal(
+    const size_t queueIndex,
+    size_t* const taskIndexOut)
+{
+    // Our own queue is empty, so nobody will steal from it, and we can refill
+    // it without regard to thieves.  Visit the others in turn, starting with
+    // our neighbor, so that thieves spread out.
+    const size_t numQueues = _queues.size();
+    for (size_t i = 1; i < numQueues; i++)
+    {
+        _Queue &victim = *_queues[(queueIndex + i) % numQueues];
+
+        size_t begin = 0, end = 0;
+        {
+            const std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.begin == victim.end)
+            {
+                continue;
+            }
+
+            // Take the back half, rounding up so that we always get at least
+            // one task.
+            end = victim.end;
+            begin = end - (end - victim.begin + 1) / 2;
+            victim.end = begin;
+        }
+
+        // Run the first stolen task now, and queue the rest.
+        _Queue &queue = *_queues[queueIndex];
+        const std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.begin = begin + 1;
+        queue.end = end;
+        *taskIndexOut = begin;
+        return true;
+    }
+
+    return false;
+}
+
+TsExecutor& TsGetDefaultExecutor()
+{
+    static TsThreadPoolExecutor executor;
+    return executor;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PARALLEL EVALUATION
+
+// Evaluation tasks should be big enough that the per-task setup is negligible.
+static constexpr size_t _minItemsPerTask = 1024;
+
+// Tasks per thread.  Several, so that work stealing can even out uneven tasks.
+static constexpr size_t _tasksPerThread = 8;
+
+bool Ts_ParallelForRows(
+    TsExecutor *executor,
+    const size_t numRows,
+    const size_t numColumns,
+    const std::function<
+        bool(size_t row, size_t beginColumn, size_t endColumn)> &rangeFunc)
+{
+    const size_t numItems = numRows * numColumns;
+    if (numItems == 0)
+    {
+        return true;
+    }
+
+    if (!executor)
+    {
+        bool result = true;
+        for (size_t row = 0; row < numRows; row++)
+        {
+            result &= rangeFunc(row, 0, numColumns);
+        }
+        return result;
+    }
+
+    const size_t maxTasks = executor->GetConcurrency() * _tasksPerThread;
+    const size_t numTasks = std::max<size_t>(1,
+        std::min(maxTasks, numItems / _minItemsPerTask));
+
+    // One result per task, combined at the end, so that the outcome doesn't
+    // depend on scheduling.
+    std::vector<char> results(numTasks, true);
+
+    executor->Run(numTasks,
+        [&](const size_t taskIndex)
+        {
+            const size_t begin = numItems * taskIndex / numTasks;
+            const size_t end = numItems * (taskIndex + 1) / numTasks;
+
+            bool result = true;
+            for (size_t item = begin; item < end; )
+            {
+                const size_t row = item / numColumns;
+                const size_t beginColumn = item % numColumns;
+                const size_t endColumn =
+                    std::min(numColumns, beginColumn + (end - item));
+                result &= rangeFunc(row, beginColumn, endColumn);
+                item += endColumn - beginColumn;
+            }
+            results[taskIndex] = result;
+        });
+
+    return std::all_of(results.begin(), results.end(),
+        [](const char result) { return result; });
+}
+
+bool TsEvalManyParallel(
+    const TsSpline &spline,
+    const TfSpan<const TsTime> times,
+    const TfSpan<double> valuesOut,
+    const TsEvalOptions &options,
+    TsExecutor* const executor)
+{
+    return TsEvalManyParallel(
+        TfSpan<const TsSpline>(&spline, 1), times, valuesOut,
+        options, executor);
+}
+
+bool TsEvalManyParallel(
+    const TfSpan<const TsSpline> splines,
+    const TfSpan<const TsTime> times,
+    const TfSpan<double> valuesOut,
+    const TsEvalOptions &options,
+    TsExecutor* const executor)
+{
+    if (valuesOut.size() != splines.size() * times.size())
+    {
+        TF_CODING_ERROR(
+            "Mismatched sizes for splines (%zu) by times (%zu) and "
+            "values (%zu) in parallel evaluation",
+            splines.size(), times.size(), valuesOut.size());
+        return false;
+    }
+
+    // Batch evaluation results don't depend on how the times are divided, so
+    // each task can evaluate its range of times independently.
+    return Ts_ParallelForRows(
+        executor, splines.size(), times.size(),
+        [&](const size_t row, const size_t begin, const size_t end)
+        {
+            return splines[row].EvalMany(
+                times.subspan(begin, end - begin),
+                valuesOut.subspan(row * times.size() + begin, end - begin),
+                options);
+        });
+}
+
+
+}  // namespace pxr
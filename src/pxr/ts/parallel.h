@@ -0,0 +1,186 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#ifndef PXR_TS_PARALLEL_H
+#define PXR_TS_PARALLEL_H
+
+#include "./api.h"
+#include "./types.h"
+#include <pxr/tf/span.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pxr {
+
+class TsSpline;
+
+
+/// Interface for running parallel work.  Ts uses an executor to split large
+/// evaluation jobs across threads.  Clients that have their own thread pool or
+/// task scheduler can implement this interface to have Ts use it.
+///
+/// Ts divides jobs into tasks that write disjoint outputs, so results are
+/// identical regardless of how, or in what order, an executor runs the tasks.
+///
+/// Throughout Ts, functions that take an executor pointer run serially on the
+/// calling thread if it is null.  Pass &TsGetDefaultExecutor() to use the
+/// shared thread pool.
+///
+class TsExecutor
+{
+public:
+    TS_API
+    virtual ~TsExecutor();
+
+    /// Returns the number of tasks that this executor may run at once.  Ts
+    /// uses this to decide how finely to divide jobs.
+    virtual size_t GetConcurrency() const = 0;
+
+    /// Calls \p task once for each index from 0 to \p numTasks - 1, in any
+    /// order and on any threads, and returns once all calls have finished.
+    /// Tasks don't throw exceptions.  Run may be called from inside a task,
+    /// and from several threads at once.
+    virtual void Run(
+        size_t numTasks,
+        const std::function<void(size_t)> &task) = 0;
+};
+
+/// An executor that runs all tasks on the calling thread.
+///
+class TsSerialExecutor : public TsExecutor
+{
+public:
+    TS_API
+    size_t GetConcurrency() const override;
+
+    TS_API
+    void Run(
+        size_t numTasks,
+        const std::function<void(size_t)> &task) override;
+};
+
+/// An executor with its own pool of threads.
+///
+/// Each call to Run divides its tasks evenly between the calling thread and
+/// the pool threads.  A thread that finishes its share steals half of the
+/// remaining share of another thread, so that uneven tasks still keep all
+/// threads busy.  Calls to Run from several threads are serialized.  Calls
+/// from inside a task run serially on the calling thread.
+///
+class TsThreadPoolExecutor : public TsExecutor
+{
+public:
+    /// Creates an executor that runs up to \p concurrency tasks at once,
+    /// including on the thread that calls Run.  If \p concurrency is zero, uses
+    /// the number of hardware threads.
+    TS_API
+    explicit TsThreadPoolExecutor(size_t concurrency = 0);
+
+    TS_API
+    ~TsThreadPoolExecutor() override;
+
+    TsThreadPoolExecutor(const TsThreadPoolExecutor&) = delete;
+    TsThreadPoolExecutor& operator=(const TsThreadPoolExecutor&) = delete;
+
+    TS_API
+    size_t GetConcurrency() const override;
+
+    TS_API
+    void Run(
+        size_t numTasks,
+        const std::function<void(size_t)> &task) override;
+
+private:
+    // A contiguous range of task indices belonging to one thread.  The owner
+    // takes tasks from the front; thieves take from the back.
+    struct _Queue
+    {
+        std::mutex mutex;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    void _WorkerMain(size_t queueIndex);
+    void _Work(size_t queueIndex);
+    bool _Pop(size_t queueIndex, size_t *taskIndexOut);
+    bool _Steal(size_t queueIndex, size_t *taskIndexOut);
+
+private:
+    // One queue per thread.  Queue 0 belongs to the thread that calls Run.
+    std::vector<std::unique_ptr<_Queue>> _queues;
+    std::vector<std::thread> _threads;
+
+    // Serializes calls to Run.
+    std::mutex _runMutex;
+
+    // Protects the members below, which communicate with the pool threads.
+    std::mutex _mutex;
+    std::condition_variable _wakeCondition;
+    std::condition_variable _doneCondition;
+    const std::function<void(size_t)> *_task = nullptr;
+    uint64_t _generation = 0;
+    size_t _numWorking = 0;
+    bool _stop = false;
+};
+
+/// Returns a process-wide thread pool executor, with one thread per hardware
+/// thread, which is created on first use.
+TS_API
+TsExecutor& TsGetDefaultExecutor();
+
+/// Evaluates \p spline at each of \p times, like TsSpline::EvalMany, but
+/// splits the work across threads using \p executor.  If \p executor is null,
+/// evaluates serially.  Results are identical to those of TsSpline::EvalMany.
+TS_API
+bool TsEvalManyParallel(
+    const TsSpline &spline,
+    TfSpan<const TsTime> times,
+    TfSpan<double> valuesOut,
+    const TsEvalOptions &options = TsEvalOptions(),
+    TsExecutor *executor = nullptr);
+
+/// Evaluates each of \p splines at each of \p times, splitting the work across
+/// threads using \p executor, or serially if \p executor is null.  \p
+/// valuesOut must have <tt>splines.size() * times.size()</tt> elements.
+/// Results are grouped by spline: the value of spline \c i at time \c j is
+/// written to element <tt>i * times.size() + j</tt>.  Elements for which there
+/// is no value are left unmodified.  Returns true if every spline produced a
+/// value at every time.  Results are identical to those of TsSpline::EvalMany.
+TS_API
+bool TsEvalManyParallel(
+    TfSpan<const TsSpline> splines,
+    TfSpan<const TsTime> times,
+    TfSpan<double> valuesOut,
+    const TsEvalOptions &options = TsEvalOptions(),
+    TsExecutor *executor = nullptr);
+
+
+// Divides a job of numRows rows by numColumns columns into tasks of contiguous
+// items, in row-major order, and runs them with the executor.  If the executor
+// is null, calls rangeFunc once for each row, serially.  Each task calls
+// rangeFunc once for each row it covers, with the row index and a range of
+// columns.  Returns true if every call to
+// rangeFunc returned true.
+//
+TS_API
+bool Ts_ParallelForRows(
+    TsExecutor *executor,
+    size_t numRows,
+    size_t numColumns,
+    const std::function<
+        bool(size_t row, size_t beginColumn, size_t endColumn)> &rangeFunc);
+
+
+}  // namespace pxr
+
+#endif
@@ -991,7 +991,7 @@ TsRegressionPreventer::_WorkingKnotState::_WorkingKnotState(
     const TsKnot &proposedKnotIn)
     : parentState(parentState),
       proposedKnot(proposedKnotIn),
-      proposedParams(*(proposedKnot._GetData())),
+      proposedParams(*(proposedKnotIn._GetData())),
       workingParams(proposedParams)
 {
 }
@@ -1000,7 +1000,7 @@ TsRegressionPreventer::_WorkingKnotState::_WorkingKnotState(
     _KnotState* const parentState)
     : parentState(parentState),
       proposedKnot(parentState->originalKnot),
-      proposedParams(*(proposedKnot._GetData())),
+      proposedParams(*(parentState->originalKnot._GetData())),
       workingParams(proposedParams)
 {
 }
@@ -1015,14 +1015,14 @@ TsRegressionPreventer::_WorkingKnotState::_WorkingKnotState(
 
 void TsRegressionPreventer::_WorkingKnotState::WriteProposed()
 {
-    parentState->spline->_SetKnotUnchecked(proposedKnot);
+    parentState->spline->_SetKnotUnchecked(*proposedKnot);
 
-    parentState->currentParams = *(proposedKnot._GetData());
+    parentState->currentParams = *(proposedKnot->_GetData());
 }
 
 void TsRegressionPreventer::_WorkingKnotState::WriteWorking()
 {
-    TsKnot knot = proposedKnot;
+    TsKnot knot = *proposedKnot;
     Ts_KnotData* const knotData = knot._GetData();
     knotData->preTanWidth = workingParams.preTanWidth;
     knotData->postTanWidth = workingParams.postTanWidth;
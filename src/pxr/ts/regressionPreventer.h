@@ -241,8 +241,9 @@ private:
         // Link to whole-operation state.
         _KnotState* const parentState;
 
-        // The proposed knot, if one was provided.
-        const TsKnot proposedKnot;
+        // The proposed knot, if one was provided.  Empty for batch use, which
+        // must not allocate, since it is part of the evaluation hot path.
+        const std::optional<TsKnot> proposedKnot;
 
         // The proposed time parameters.
         const Ts_KnotData proposedParams;
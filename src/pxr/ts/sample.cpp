@@ -6,6 +6,7 @@
 // Modified by Jeremy Retailleau.
 
 #include "./sample.h"
+#include "./parallel.h"
 #include "./splineData.h"
 #include "./regressionPreventer.h"
 #include "./debugCodes.h"
@@ -17,210 +18,28 @@
 
 namespace pxr {
 
-// XXX: Should this go in sample.h? Or maybe even knotData.h?
-using Ts_DoubleKnotData = Ts_TypedKnotData<double>;
-
 ////////////////////////////////////////////////////////////////////////////////
 // SAMPLING
 
-namespace
-{
-    // Each spline can have as many as seven intervals that are populated from
-    // different sources, for example, pre-extrapolation loops, inner loops,
-    // post-extrapolation, etc.
-    //
-    // _SourceInterval holds the time interval for a source.
-    struct _SourceInterval
-    {
-        TsSplineSampleSource source;
-        GfInterval interval;
-
-        _SourceInterval(TsSplineSampleSource inSource,
-                        TsTime t1,
-                        TsTime t2)
-        : source(inSource)
-        , interval{t1, t2, true, false}
-        {}
-    };
-
-    // _Sampler constructs a partially unrolled version of the spline and then
-    // samples that version. Only the inner loops are unrolled and only in the
-    // region where sampling will be occurring.
-    //
-    // The unrolled version enables random access to all the relevant knots
-    // and we implement extrapolation looping with simple time and value
-    // shifting.
-    class _Sampler
-    {
-    public:
-        _Sampler(
-            const Ts_SplineData* data,
-            const GfInterval& timeInterval,
-            double timeScale,
-            double valueScale,
-            double tolerance);
-
-        bool Sample(
-            Ts_SampleDataInterface* sampledSpline);
-
-        bool SampleInterval(
-            const GfInterval& subInterval,
-            Ts_SampleDataInterface* sampledSpline);
-
-    private:
-        // Sample knots in sampleInterval. Sampled knot times are converted to
-        // sample times with _ToSampleTime and values are offset by valueOffset
-        // before being stored in sampledSpline.
-        void _SampleKnots(
-            const GfInterval& sampleInterval,
-            const TsSplineSampleSource source,
-            const double knotToSampleTimeScale,
-            const TsTime knotToSampleTimeOffset,
-            const double valueOffset,
-            Ts_SampleDataInterface* sampledSpline);
-
-        // Sample knots in sampleInterval in reverse. Sampled knot times are
-        // converted to sample times with _ToSampleTime and values are offset by
-        // valueOffset before being stored in sampledSpline.
-        void _SampleKnotsReversed(
-            const GfInterval& sampleInterval,
-            const TsSplineSampleSource source,
-            const double knotToSampleTimeScale,
-            const TsTime knotToSampleTimeOffset,
-            const double valueOffset,
-            Ts_SampleDataInterface* sampledSpline);
-
-        // Sample a segment of the spline between 2 adjacent knots.
-        void _SampleSegment(const Ts_DoubleKnotData* prevKnot,
-                            const Ts_DoubleKnotData* nextKnot,
-                            const GfInterval& segmentInterval,
-                            TsSplineSampleSource source,
-                            double knotToSampleTimeScale,
-                            double knotToSampleTimeOffset,
-                            double valueOffset,
-                            Ts_SampleDataInterface* sampledSpline);
-
-        // Sample a segment of the spline between 2 adjacent knots.
-        void _SampleCurveSegment(const Ts_DoubleKnotData* prevKnot,
-                                 const Ts_DoubleKnotData* nextKnot,
-                                 const GfInterval& segmentInterval,
-                                 TsSplineSampleSource source,
-                                 double knotToSampleTimeScale,
-                                 double knotToSampleTimeOffset,
-                                 double valueOffset,
-                                 Ts_SampleDataInterface* sampledSpline);
-
-        void _SampleBezier(GfVec2d cp[4],
-                           const GfInterval& segmentInterval,
-                           TsSplineSampleSource source,
-                           double knotToSampleTimeScale,
-                           double knotToSampleTimeOffset,
-                           double valueOffset,
-                           Ts_SampleDataInterface* sampledSpline);
-
-        // Given a set of bezier control points and a u parameter in the
-        // range [0..1], return 2 sets of control points for the left and
-        // right parts of the original curve, split at u. It is allowable
-        // for the cp input to also be one of the outputs.
-        void _SubdivideBezier(const GfVec2d cp[4],
-                              const double u,
-                              GfVec2d leftCp[4],
-                              GfVec2d rightCp[4]);
-
-        void _ExtrapLinear(
-            const GfInterval& regionInterval,
-            const TsSplineSampleSource source,
-            Ts_SampleDataInterface* sampledSpline);
-
-        void _ExtrapLoop(
-            const GfInterval& regionInterval,
-            const TsSplineSampleSource source,
-            Ts_SampleDataInterface* sampledSpline);
-
-        void _UnrollInnerLoops();
-
-        // Convert sample time to knot time.
-        TsTime _ToKnotTime(TsTime sTime,
-                           double knotToSampleTimeScale,
-                           TsTime knotToSampleTimeOffset) {
-            return (sTime - knotToSampleTimeOffset) / knotToSampleTimeScale;
-        }
-
-        // Convert knot time back to sample time.
-        TsTime _ToSampleTime(TsTime kTime,
-                             double knotToSampleTimeScale,
-                             TsTime knotToSampleTimeOffset) {
-            return kTime * knotToSampleTimeScale + knotToSampleTimeOffset;
-        }
-
-        // Inputs.
-        const Ts_SplineData* const _data;
-        const GfInterval _timeInterval;
-        const double _timeScale;
-        const double _valueScale;
-        const double _tolerance;
-
-        // Intermediate data.
-        bool _haveInnerLoops = false;
-        bool _haveMultipleKnots = false;
-        size_t _firstInnerProtoIndex = 0;
-        bool _havePreExtrapLoops = false;
-        bool _havePostExtrapLoops = false;
-        TsTime _firstTime = 0;
-        TsTime _lastTime = 0;
-        TsTime _firstInnerLoop = 0;
-        TsTime _lastInnerLoop = 0;
-        TsTime _firstInnerProto = 0;
-        TsTime _lastInnerProto = 0;
-        bool _firstTimeLooped = false;
-        bool _lastTimeLooped = false;
-        bool _doPreExtrap = false;
-        bool _doPostExtrap = false;
-        double _extrapValueOffset = 0;
-        bool _betweenPreUnloopedAndLooped = false;
-        bool _betweenLoopedAndPostUnlooped = false;
-        Ts_DoubleKnotData _extrapKnot1;
-        Ts_DoubleKnotData _extrapKnot2;
-
-        std::vector<_SourceInterval> _sourceIntervals;
-
-        // Pointers to vectors knots and their times. If there is no inner
-        // looping then these will point directly to the spline data. Otherwise,
-        // the "internal" vectors below will be populated and these will point
-        // at those. At no time does _knots nor _times ever own the data that
-        // they point to.
-        const std::vector<Ts_DoubleKnotData>* _knots;
-        const std::vector<TsTime>* _times;
-
-        // If we have to bake out the knots or times then we do so here and
-        // point _knots and _times at these arrays.
-        std::vector<Ts_DoubleKnotData> _internalKnots;
-        std::vector<TsTime> _internalTimes;
-    };
-}
-
-_Sampler::_Sampler(
-    const Ts_SplineData* const data,
-    const GfInterval& timeInterval,
-    const double timeScale,
-    const double valueScale,
-    const double tolerance)
-    : _data(data)
-    , _timeInterval(timeInterval)
-    , _timeScale(timeScale)
-    , _valueScale(valueScale)
-    , _tolerance(tolerance)
+void
+Ts_Sampler::SetSpline(
+    const Ts_SplineData* const data)
 {
     // It should be impossible to fail this check. If we do, we're likely to
     // crash or produce nonsense, but this error will at least leave a clue as
     // to why.
-    TF_VERIFY((data &&
-               !data->times.empty() &&
-               !timeInterval.IsEmpty() &&
-               timeScale > 0.0 &&
-               valueScale > 0.0 &&
-               tolerance > 0.0),
-              "Invalid argument to _Sampler::_Sampler.");
+    TF_VERIFY((data && !data->times.empty()),
+              "Invalid argument to Ts_Sampler::SetSpline.");
+
+    _data = data;
+
+    // Forget the previous spline's knots, but keep the buffers.
+    _knots = nullptr;
+    _times = nullptr;
+    _unrolledInterval = GfInterval();
+    _internalKnots.clear();
+    _internalTimes.clear();
+    _sourceIntervals.clear();
 
     // Characterize the spline
     // Is inner looping enabled?
@@ -241,6 +60,9 @@ _Sampler::_Sampler(
     // echoed.
     const TsTime rawFirstTime = _firstTime = _data->times.front();
     const TsTime rawLastTime = _lastTime = _data->times.back();
+    _firstInnerLoop = _lastInnerLoop = 0;
+    _firstInnerProto = _lastInnerProto = 0;
+    _firstTimeLooped = _lastTimeLooped = false;
     if (_haveInnerLoops)
     {
         _firstInnerProto = _data->loopParams.protoStart;
@@ -313,14 +135,22 @@ _Sampler::_Sampler(
             std::numeric_limits<double>::infinity());
     }
 
-    // Setup _knots and _times
-    _UnrollInnerLoops();
+    // If there are no inner loops, double-typed knots can be sampled where
+    // they are.  Otherwise SetParams converts them, and unrolls the loops.
+    if (!_haveInnerLoops &&
+        _data->GetValueType() == Ts_GetType<double>())
+    {
+        const Ts_TypedSplineData<double>* _doubleData =
+            dynamic_cast<const Ts_TypedSplineData<double>*>(_data);
+        _knots = &_doubleData->knots;
+        _times = &_data->times;
+        _unrolledInterval = GfInterval::GetFullInterval();
+    }
 
     TF_DEBUG_MSG(
         TS_DEBUG_SAMPLE,
         "\n"
-        "At _Sampler construction:\n"
-        "  _timeInterval: [%g .. %g]\n"
+        "At Ts_Sampler::SetSpline:\n"
         "  _haveInnerLoops: %d\n"
         "  _havePreExtrapLoops: %d\n"
         "  _havePostExtrapLoops: %d\n"
@@ -331,8 +161,6 @@ _Sampler::_Sampler(
         "  _lastInnerProto:  %g\n"
         "  _lastInnerLoop:   %g\n"
         "  _lastTime:        %g\n",
-        _timeInterval.GetMin(),
-        _timeInterval.GetMax(),
         _haveInnerLoops,
         _havePreExtrapLoops,
         _havePostExtrapLoops,
@@ -345,19 +173,59 @@ _Sampler::_Sampler(
         _lastTime);
 }
 
+void
+Ts_Sampler::SetParams(
+    const GfInterval& timeInterval,
+    const double timeScale,
+    const double valueScale,
+    const double tolerance,
+    const TsBezierFlattening flattening)
+{
+    TF_VERIFY((_data &&
+               !timeInterval.IsEmpty() &&
+               timeScale > 0.0 &&
+               valueScale > 0.0 &&
+               tolerance > 0.0),
+              "Invalid argument to Ts_Sampler::SetParams.");
+
+    _timeInterval = timeInterval;
+    _timeScale = timeScale;
+    _valueScale = valueScale;
+    _tolerance = tolerance;
+    _flattening = flattening;
+
+    // Setup _knots and _times, unless the knots from an earlier call will do.
+    const GfInterval unrollInterval = _GetUnrollInterval(timeInterval);
+    if (_unrolledInterval.Contains(unrollInterval)) {
+        return;
+    }
+
+    _UnrollInnerLoops(unrollInterval);
+    _unrolledInterval = unrollInterval;
+
+    TF_DEBUG_MSG(
+        TS_DEBUG_SAMPLE,
+        "Ts_Sampler unrolled %zu knots for [%g .. %g]\n",
+        _knots->size(),
+        _timeInterval.GetMin(),
+        _timeInterval.GetMax());
+}
+
+template <typename Sink>
 bool
-_Sampler::Sample(
-    Ts_SampleDataInterface* sampledSpline)
+Ts_Sampler::Sample(
+    Sink* sampledSpline)
 {
     // Sample the entire input region _timeInterval
     return SampleInterval(_timeInterval,
                           sampledSpline);
 }
 
+template <typename Sink>
 bool
-_Sampler::SampleInterval(
+Ts_Sampler::SampleInterval(
     const GfInterval& subInterval,
-    Ts_SampleDataInterface* sampledSpline)
+    Sink* sampledSpline)
 {
     if (_knots->empty()) {
         TF_CODING_ERROR("Cannot sample an empty spline!");
@@ -397,11 +265,165 @@ _Sampler::SampleInterval(
     return true;
 }
 
+// Estimated vertices per curve segment, used to size output before sampling
+// when the count isn't known in advance.
+static const size_t _estimatedVerticesPerSegment = 8;
+
+// Limit on the estimate, so that many loop iterations can't cause a huge
+// reservation.  Larger outputs simply grow as needed.
+static const size_t _maxEstimatedVertices = 1 << 20;
+
+size_t
+Ts_Sampler::_EstimateSegmentVertices(const Ts_DoubleKnotData& prevKnot,
+                                   const Ts_DoubleKnotData& nextKnot) const
+{
+    switch (prevKnot.nextInterp) {
+      case TsInterpValueBlock:
+        return 0;
+
+      case TsInterpHeld:
+      case TsInterpLinear:
+        return 1;
+
+      case TsInterpCurve:
+        break;
+    }
+
+    // Uniform flattening knows its count up front, from the segment as
+    // _SampleSegment de-regresses it.
+    if (_flattening == TsBezierFlatteningUniform &&
+        prevKnot.curveType == TsCurveTypeBezier)
+    {
+        Ts_DoubleKnotData pKnot = prevKnot;
+        Ts_DoubleKnotData nKnot = nextKnot;
+        Ts_RegressionPreventerBatchAccess::ProcessSegment(
+            &pKnot, &nKnot, TsAntiRegressionKeepRatio);
+
+        GfVec2d cp[4];
+        cp[0] = GfVec2d(pKnot.time, pKnot.value);
+        cp[3] = GfVec2d(nKnot.time, nKnot.GetPreValue());
+        cp[1] = cp[0] + GfVec2d(pKnot.GetPostTanWidth(),
+                                pKnot.GetPostTanHeight());
+        cp[2] = cp[3] + GfVec2d(-nKnot.GetPreTanWidth(),
+                                nKnot.GetPreTanHeight());
+        return _GetBezierFlatteningCount(cp);
+    }
+
+    return _estimatedVerticesPerSegment;
+}
+
+size_t
+Ts_Sampler::EstimateVertexCount() const
+{
+    const TsTime knotSpan = _lastTime - _firstTime;
+
+    // Vertices for the knot segments whose start times are in [begin, end).
+    const auto countSegments = [this](const ptrdiff_t begin,
+                                      const ptrdiff_t end)
+    {
+        size_t count = 0;
+        for (ptrdiff_t i = std::max<ptrdiff_t>(begin, 0);
+             i < end && i + 1 < ptrdiff_t(_knots->size()); ++i) {
+            count += _EstimateSegmentVertices((*_knots)[i], (*_knots)[i + 1]);
+        }
+        return count;
+    };
+
+    size_t count = 0;
+    for (const auto& si : _sourceIntervals) {
+        const GfInterval regionInterval = _timeInterval & si.interval;
+        if (!(regionInterval.GetSize() > 0.0)) {
+            continue;
+        }
+
+        switch (si.source) {
+          case TsSourcePreExtrap:
+          case TsSourcePostExtrap:
+            // A single line.
+            count += 2;
+            break;
+
+          case TsSourcePreExtrapLoop:
+          case TsSourcePostExtrapLoop:
+            // Every knot segment, once per iteration.
+            if (knotSpan > 0.0) {
+                count += countSegments(0, _knots->size()) * size_t(std::min(
+                    std::ceil(regionInterval.GetSize() / knotSpan),
+                    double(_maxEstimatedVertices)));
+            }
+            break;
+
+          default:
+            // The knot segments that overlap the region.  The unrolled knot
+            // times are in _times.
+            count += 1 + countSegments(
+                (std::upper_bound(_times->begin(), _times->end(),
+                                  regionInterval.GetMin()) -
+                 _times->begin()) - 1,
+                std::lower_bound(_times->begin(), _times->end(),
+                                 regionInterval.GetMax()) -
+                _times->begin());
+        }
+
+        if (count >= _maxEstimatedVertices) {
+            return _maxEstimatedVertices;
+        }
+    }
+
+    return count;
+}
+
+// Fewest knot segments per chunk when sampling in parallel, so that small
+// splines are sampled serially, and each task's setup is negligible.
+static const size_t _minSegmentsPerChunk = 1024;
+
+bool
+Ts_Sampler::GetParallelChunks(const size_t maxChunks,
+                            std::vector<GfInterval>* const chunks) const
+{
+    // Split only at knot times strictly inside the interval.  Knot segments
+    // then fall wholly within one chunk, and are clipped exactly as they are
+    // when sampling the whole interval, and extrapolation, which is outside
+    // the knots, is never split.  Interior splits are closed on both sides,
+    // as the whole interval is there.  So the chunks, sampled in order, make
+    // the same calls to the sink as Sample does.
+    const size_t begin =
+        std::upper_bound(_times->begin(), _times->end(),
+                         _timeInterval.GetMin()) - _times->begin();
+    const size_t end =
+        std::lower_bound(_times->begin(), _times->end(),
+                         _timeInterval.GetMax()) - _times->begin();
+    if (end <= begin) {
+        return false;
+    }
+
+    const size_t numChunks =
+        std::min(maxChunks, (end - begin + 1) / _minSegmentsPerChunk);
+    if (numChunks < 2) {
+        return false;
+    }
+
+    chunks->clear();
+    chunks->reserve(numChunks);
+    TsTime chunkMin = _timeInterval.GetMin();
+    bool chunkMinClosed = _timeInterval.IsMinClosed();
+    for (size_t i = 1; i < numChunks; ++i) {
+        const TsTime split = (*_times)[begin + (end - begin) * i / numChunks];
+        chunks->emplace_back(chunkMin, split, chunkMinClosed, true);
+        chunkMin = split;
+        chunkMinClosed = true;
+    }
+    chunks->emplace_back(chunkMin, _timeInterval.GetMax(),
+                         chunkMinClosed, _timeInterval.IsMaxClosed());
+    return true;
+}
+
+template <typename Sink>
 void
-_Sampler::_ExtrapLinear(
+Ts_Sampler::_ExtrapLinear(
     const GfInterval& regionInterval,
     const TsSplineSampleSource source,
-    Ts_SampleDataInterface* sampledSpline)
+    Sink* sampledSpline)
 {
     const TsExtrapolation* extrap;
     const Ts_DoubleKnotData* knot1;
@@ -439,7 +461,8 @@ _Sampler::_ExtrapLinear(
       case TsExtrapLoopOscillate:
         // Should have called _ExtrapLoop instead! This should be unreachable.
         TF_VERIFY(false,
-                  "Invalid extrapolation mode (%s) in _Sampler::_ExtrapLinear",
+                  "Invalid extrapolation mode (%s) in "
+                  "Ts_Sampler::_ExtrapLinear",
                   TfEnum::GetName(extrap->mode).c_str());
         return;
 
@@ -483,24 +506,29 @@ _Sampler::_ExtrapLinear(
     TsTime t1 = regionInterval.GetMin();
     TsTime t2 = regionInterval.GetMax();
 
+    // The region may stop short of the end knot, when the sampled interval
+    // does.
     double v1, v2;
     if (isPre) {
-        v2 = knot1->GetPreValue();
-        v1 = v2 - slope * (t2 - t1);
+        const double knotValue = knot1->GetPreValue();
+        v1 = knotValue - slope * (knot1->time - t1);
+        v2 = knotValue - slope * (knot1->time - t2);
     } else {
-        v1 = knot2->value;
-        v2 = v1 + slope * (t2 - t1);
+        const double knotValue = knot2->value;
+        v1 = knotValue + slope * (t1 - knot2->time);
+        v2 = knotValue + slope * (t2 - knot2->time);
     }
 
     // There's only ever 1 segment
     sampledSpline->AddSegment(t1, v1, t2, v2, source);
 }
 
+template <typename Sink>
 void
-_Sampler::_ExtrapLoop(
+Ts_Sampler::_ExtrapLoop(
     const GfInterval& regionInterval,
     const TsSplineSampleSource source,
-    Ts_SampleDataInterface* sampledSpline)
+    Sink* sampledSpline)
 {
     // Figure out the time and value conversions and then invoke _SampleKnots,
     // possibly multiple times. Fortunately, for extrapolation looping we
@@ -605,14 +633,15 @@ _Sampler::_ExtrapLoop(
     }
 }
 
+template <typename Sink>
 void
-_Sampler::_SampleKnots(
+Ts_Sampler::_SampleKnots(
     const GfInterval& sampleInterval,
     const TsSplineSampleSource source,
     const double knotToSampleTimeScale,
     const TsTime knotToSampleTimeOffset,
     const double valueOffset,
-    Ts_SampleDataInterface* sampledSpline)
+    Sink* sampledSpline)
 {
     const Ts_DoubleKnotData* prevKnot = nullptr;
     const Ts_DoubleKnotData* nextKnot = nullptr;
@@ -662,14 +691,15 @@ _Sampler::_SampleKnots(
     }
 }
 
+template <typename Sink>
 void
-_Sampler::_SampleKnotsReversed(
+Ts_Sampler::_SampleKnotsReversed(
     const GfInterval& sampleInterval,
     const TsSplineSampleSource source,
     const double knotToSampleTimeScale,
     const TsTime knotToSampleTimeOffset,
     const double valueOffset,
-    Ts_SampleDataInterface* sampledSpline)
+    Sink* sampledSpline)
 {
     // _SampleKnotsReversed is used only for extrapolation loops that oscillate
     // and only for the iterations that traverse backward through time. The
@@ -731,8 +761,9 @@ _Sampler::_SampleKnotsReversed(
     }
 }
 
+template <typename Sink>
 void
-_Sampler::_SampleSegment(
+Ts_Sampler::_SampleSegment(
     const Ts_DoubleKnotData* prevKnot,
     const Ts_DoubleKnotData* nextKnot,
     const GfInterval& segmentInterval,
@@ -740,7 +771,7 @@ _Sampler::_SampleSegment(
     const double knotToSampleTimeScale,
     const double knotToSampleTimeOffset,
     const double valueOffset,
-    Ts_SampleDataInterface* sampledSpline)
+    Sink* sampledSpline)
 {
     // Interpolate from prevKnot to nextKnot and store sample segments into
     // sampledSpline
@@ -749,6 +780,20 @@ _Sampler::_SampleSegment(
         // No value, nothing to do.
         return;
     } else if (prevKnot->nextInterp == TsInterpCurve) {
+        // Hermite tangent widths are fixed, so Hermite segments are never
+        // regressive.
+        if (prevKnot->curveType == TsCurveTypeHermite) {
+            _SampleCurveSegment(prevKnot,
+                                nextKnot,
+                                segmentInterval,
+                                source,
+                                knotToSampleTimeScale,
+                                knotToSampleTimeOffset,
+                                valueOffset,
+                                sampledSpline);
+            return;
+        }
+
         // The segment is a curve that may need to be broken down. Ensure that
         // this segment is not regressive.
         Ts_DoubleKnotData pKnot = *prevKnot;
@@ -804,8 +849,9 @@ _Sampler::_SampleSegment(
         source);
 }
 
+template <typename Sink>
 void
-_Sampler::_SampleCurveSegment(
+Ts_Sampler::_SampleCurveSegment(
     const Ts_DoubleKnotData* prevKnot,
     const Ts_DoubleKnotData* nextKnot,
     const GfInterval& segmentInterval,
@@ -813,7 +859,7 @@ _Sampler::_SampleCurveSegment(
     const double knotToSampleTimeScale,
     const double knotToSampleTimeOffset,
     const double valueOffset,
-    Ts_SampleDataInterface* sampledSpline)
+    Sink* sampledSpline)
 {
     // A switch statement will generate a compile error if we ever add a new
     // curve type without adding a case for it.
@@ -832,26 +878,135 @@ _Sampler::_SampleCurveSegment(
             cp[2] = cp[3] + GfVec2d(-nextKnot->GetPreTanWidth(),
                                     nextKnot->GetPreTanHeight());
 
-            _SampleBezier(cp, segmentInterval, source,
-                          knotToSampleTimeScale, knotToSampleTimeOffset,
-                          valueOffset, sampledSpline);
+            if (_flattening == TsBezierFlatteningUniform) {
+                _SampleBezierUniform(cp, segmentInterval, source,
+                                     knotToSampleTimeScale,
+                                     knotToSampleTimeOffset,
+                                     valueOffset, sampledSpline);
+            } else {
+                _SampleBezier(cp, segmentInterval, source,
+                              knotToSampleTimeScale, knotToSampleTimeOffset,
+                              valueOffset, sampledSpline);
+            }
         }
         break;
 
       case TsCurveTypeHermite:
-        // XXX: Not implemented yet. See USD-10314
+        _SampleHermite(prevKnot, nextKnot, segmentInterval, source,
+                       knotToSampleTimeScale, knotToSampleTimeOffset,
+                       valueOffset, sampledSpline);
         break;
     }
 }
 
+// Limit on the number of samples in one Hermite segment, which only a
+// degenerate curve would reach.
+static const int _maxHermiteSamples = 1 << 16;
+
+template <typename Sink>
 void
-_Sampler::_SampleBezier(GfVec2d cp[4],
+Ts_Sampler::_SampleHermite(const Ts_DoubleKnotData* prevKnot,
+                         const Ts_DoubleKnotData* nextKnot,
+                         const GfInterval& segmentInterval,
+                         TsSplineSampleSource source,
+                         double knotToSampleTimeScale,
+                         double knotToSampleTimeOffset,
+                         double valueOffset,
+                         Sink* sampledSpline)
+{
+    // A Hermite segment is a Bezier segment whose tangent widths are a third
+    // of the segment's duration. That makes time linear in the curve
+    // parameter u, and leaves the value a cubic polynomial in u:
+    //
+    //     v(u) = ((a * u + b) * u + c) * u + d
+    //
+    // Since time is linear in u, we need no recursive subdivision to find
+    // where the curve bends. Linear interpolation between samples at spacing
+    // h in u differs from v by at most h^2 / 8 * max |v''|, and v'' is linear
+    // in u, so its maximum is at one end of the sampled range. The vertical
+    // error bounds the perpendicular one, so we pick the number of evenly
+    // spaced samples that keeps the scaled vertical error within _tolerance.
+    const TsTime t0 = prevKnot->time;
+    const TsTime duration = nextKnot->time - t0;
+    const double v0 = prevKnot->value;
+    const double v3 = nextKnot->GetPreValue();
+    const double v1 = v0 + prevKnot->GetPostTanSlope() * duration / 3;
+    const double v2 = v3 - nextKnot->GetPreTanSlope() * duration / 3;
+
+    const double a = -v0 + 3 * v1 - 3 * v2 + v3;
+    const double b = 3 * v0 - 6 * v1 + 3 * v2;
+    const double c = -3 * v0 + 3 * v1;
+    const double d = v0;
+
+    // The part of the segment that we're sampling.
+    const TsTime tMin = std::max(t0, segmentInterval.GetMin());
+    const TsTime tMax = std::min(nextKnot->time, segmentInterval.GetMax());
+    if (!(tMin < tMax)) {
+        return;
+    }
+    const double uMin = (tMin - t0) / duration;
+    const double uMax = (tMax - t0) / duration;
+
+    const double maxAccel = std::max(std::abs(6 * a * uMin + 2 * b),
+                                     std::abs(6 * a * uMax + 2 * b));
+    const double uSpan = uMax - uMin;
+    const double numSamples = std::ceil(
+        uSpan * std::sqrt(maxAccel * _valueScale / (8 * _tolerance)));
+    const int n = (numSamples >= 1 ?
+                   int(std::min<double>(numSamples, _maxHermiteSamples)) : 1);
+
+    // Sample times and values. Use the knot values exactly at the segment
+    // ends, so that the polyline joins its neighbors.
+    const auto sampleAt = [&](const int i, TsTime* time, double* value)
+    {
+        if (i == 0) {
+            *time = tMin;
+        } else if (i == n) {
+            *time = tMax;
+        } else {
+            *time = GfLerp(double(i) / n, tMin, tMax);
+        }
+
+        if (*time == t0) {
+            *value = v0;
+        } else if (*time == nextKnot->time) {
+            *value = v3;
+        } else {
+            const double u = (*time - t0) / duration;
+            *value = ((a * u + b) * u + c) * u + d;
+        }
+
+        *time = _ToSampleTime(*time,
+                              knotToSampleTimeScale,
+                              knotToSampleTimeOffset);
+        *value += valueOffset;
+    };
+
+    // If the time scale is negative (due to oscillating loops), emit the
+    // samples in reverse, as they will be scaled to the left.
+    const bool reversed = (knotToSampleTimeScale < 0);
+    TsTime prevTime, nextTime;
+    double prevValue, nextValue;
+    sampleAt(reversed ? n : 0, &prevTime, &prevValue);
+    for (int i = 1; i <= n; ++i) {
+        sampleAt(reversed ? n - i : i, &nextTime, &nextValue);
+        sampledSpline->AddSegment(prevTime, prevValue,
+                                  nextTime, nextValue,
+                                  source);
+        prevTime = nextTime;
+        prevValue = nextValue;
+    }
+}
+
+template <typename Sink>
+void
+Ts_Sampler::_SampleBezier(GfVec2d cp[4],
                         const GfInterval& segmentInterval,
                         TsSplineSampleSource source,
                         double knotToSampleTimeScale,
                         double knotToSampleTimeOffset,
                         double valueOffset,
-                        Ts_SampleDataInterface* sampledSpline)
+                        Sink* sampledSpline)
 {
     // Bezier curves exist entirely within the bounds of their control points
     // so we compute the height of the bounding box. This is the length of the
@@ -961,8 +1116,130 @@ _Sampler::_SampleBezier(GfVec2d cp[4],
     }
 }
 
+// Limit on the number of polyline segments in the uniform flattening of one
+// Bezier segment, which only a degenerate curve would reach.
+static const int _maxBezierFlatteningCount = 1 << 16;
+
+// Number of points evaluated together by _SampleBezierUniform.
+static const int _flatteningChunkSize = 64;
+
+int
+Ts_Sampler::_GetBezierFlatteningCount(const GfVec2d cp[4]) const
+{
+    // Wang's formula: the polyline through n + 1 evenly spaced parameters of
+    // a cubic Bezier is within tolerance of the curve if
+    //
+    //     n >= sqrt(3 * 2 / 8 * M / tolerance)
+    //
+    // where M is the largest length of the second differences of the control
+    // points.  All lengths are in tolerance space, as for _SampleBezier.
+    const GfVec2d scaleVec(_timeScale, _valueScale);
+    const GfVec2d diff1 =
+        GfCompMult(scaleVec, cp[0] - 2.0 * cp[1] + cp[2]);
+    const GfVec2d diff2 =
+        GfCompMult(scaleVec, cp[1] - 2.0 * cp[2] + cp[3]);
+    const double maxDiff =
+        std::sqrt(std::max(diff1.GetLengthSq(), diff2.GetLengthSq()));
+
+    const double count = std::ceil(std::sqrt(0.75 * maxDiff / _tolerance));
+    return (count >= 1 ?
+            int(std::min<double>(count, _maxBezierFlatteningCount)) : 1);
+}
+
+template <typename Sink>
+void
+Ts_Sampler::_SampleBezierUniform(const GfVec2d cp[4],
+                               const GfInterval& segmentInterval,
+                               TsSplineSampleSource source,
+                               double knotToSampleTimeScale,
+                               double knotToSampleTimeOffset,
+                               double valueOffset,
+                               Sink* sampledSpline)
+{
+    const int n = _GetBezierFlatteningCount(cp);
+
+    // Power basis coefficients of the time and value cubics.
+    const GfVec2d a = -cp[0] + 3.0 * cp[1] - 3.0 * cp[2] + cp[3];
+    const GfVec2d b = 3.0 * cp[0] - 6.0 * cp[1] + 3.0 * cp[2];
+    const GfVec2d c = -3.0 * cp[0] + 3.0 * cp[1];
+    const GfVec2d d = cp[0];
+
+    const TsTime minTime = segmentInterval.GetMin();
+    const TsTime maxTime = segmentInterval.GetMax();
+
+    // If the time scale is negative (due to oscillating loops), emit the
+    // points in reverse, as they will be scaled to the left.
+    const bool reversed = (knotToSampleTimeScale < 0);
+
+    // Emit the polyline segment between two points, clipped to
+    // segmentInterval.  Time is monotonic in the parameter, so the points
+    // are in time order.
+    const auto emit = [&](TsTime t1, double v1, TsTime t2, double v2)
+    {
+        if (reversed) {
+            std::swap(t1, t2);
+            std::swap(v1, v2);
+        }
+        if (t1 == t2 ? !segmentInterval.Contains(t1) :
+            (t2 <= minTime || t1 >= maxTime)) {
+            return;
+        }
+        if (t1 < minTime) {
+            v1 = GfLerp((minTime - t1) / (t2 - t1), v1, v2);
+            t1 = minTime;
+        }
+        if (t2 > maxTime) {
+            v2 = GfLerp((maxTime - t1) / (t2 - t1), v1, v2);
+            t2 = maxTime;
+        }
+        if (reversed) {
+            std::swap(t1, t2);
+            std::swap(v1, v2);
+        }
+        sampledSpline->AddSegment(
+            _ToSampleTime(t1, knotToSampleTimeScale, knotToSampleTimeOffset),
+            v1 + valueOffset,
+            _ToSampleTime(t2, knotToSampleTimeScale, knotToSampleTimeOffset),
+            v2 + valueOffset,
+            source);
+    };
+
+    // Evaluate the points in chunks, in a loop with no dependencies between
+    // iterations, then emit them.  The end points are exact, so that the
+    // polyline joins its neighbors.
+    TsTime times[_flatteningChunkSize];
+    double values[_flatteningChunkSize];
+    TsTime prevTime = (reversed ? cp[3][0] : cp[0][0]);
+    double prevValue = (reversed ? cp[3][1] : cp[0][1]);
+    const double du = (reversed ? -1.0 : 1.0) / n;
+    const double u0 = (reversed ? 1.0 : 0.0);
+
+    for (int start = 1; start <= n; start += _flatteningChunkSize) {
+        const int count = std::min(_flatteningChunkSize, n + 1 - start);
+        for (int k = 0; k < count; ++k) {
+            const double u = u0 + (start + k) * du;
+            times[k] = ((a[0] * u + b[0]) * u + c[0]) * u + d[0];
+            values[k] = ((a[1] * u + b[1]) * u + c[1]) * u + d[1];
+        }
+        if (start + count > n) {
+            times[count - 1] = (reversed ? cp[0][0] : cp[3][0]);
+            values[count - 1] = (reversed ? cp[0][1] : cp[3][1]);
+        }
+
+        for (int k = 0; k < count; ++k) {
+            if (reversed) {
+                emit(times[k], values[k], prevTime, prevValue);
+            } else {
+                emit(prevTime, prevValue, times[k], values[k]);
+            }
+            prevTime = times[k];
+            prevValue = values[k];
+        }
+    }
+}
+
 void
-_Sampler::_SubdivideBezier(const GfVec2d cp[4],
+Ts_Sampler::_SubdivideBezier(const GfVec2d cp[4],
                            const double u,
                            GfVec2d leftCp[4],
                            GfVec2d rightCp[4])
@@ -990,28 +1267,34 @@ _Sampler::_SubdivideBezier(const GfVec2d cp[4],
     rightCp[3] = cp[3];
 }
 
+// Extrapolation is sampled from the end knots, and looping extrapolation from
+// all of them, so unroll everything when sampling outside the knots.  Inside
+// them, only the knots around timeInterval are needed.
+GfInterval
+Ts_Sampler::_GetUnrollInterval(const GfInterval& timeInterval) const
+{
+    const GfInterval knotInterval(_firstTime, _lastTime);
+    return (knotInterval.Contains(timeInterval) ? timeInterval : knotInterval);
+}
+
 // Unroll inner loops and convert the relevant knot data to Ts_DoubleKnotData.
 // Intermediate computations are all done double precision to match eval and to
-// avoid precision problems. Since we're going to call GetKnotDataAsDouble
-// eventually, do it up front.
+// avoid precision problems. Since we're going to convert to double eventually,
+// do it up front. Knots are converted in contiguous ranges, and the prototype
+// knots of inner loops are converted only once, however many times they are
+// unrolled.
+//
+// The knots cover unrollInterval, including the knots on either side of it, so
+// they can be used to sample any interval whose unroll interval it contains.
 void
-_Sampler::_UnrollInnerLoops()
+Ts_Sampler::_UnrollInnerLoops(const GfInterval& unrollInterval)
 {
-    if (!_haveInnerLoops &&
-        _data->GetValueType() == Ts_GetType<double>())
-    {
-        const Ts_TypedSplineData<double>* _doubleData =
-            dynamic_cast<const Ts_TypedSplineData<double>*>(_data);
-        // The spline data already has everything we need.
-        _knots = &_doubleData->knots;
-        _times = &_data->times;
-        return;
-    }
-
     // We're going to have to convert the knots and times info. Point _knots and
     // _times at the internal arrays that we're about to populate.
     _knots = &_internalKnots;
     _times = &_internalTimes;
+    _internalKnots.clear();
+    _internalTimes.clear();
 
     // Inner loops are defined over a closed interval. The end of the looped
     // interval has a knot that is a copy of the knot at the start of the
@@ -1023,71 +1306,88 @@ _Sampler::_UnrollInnerLoops()
     // in mind where there is one more copy of the first knot than there are
     // loops because there is a copy at both the beginning and the end of the
     // looped range.
-    GfInterval loopedInterval;  // empty interval;
-    if (_haveInnerLoops) {
-        loopedInterval = GfInterval(_firstInnerLoop, _lastInnerLoop);
-        if (_havePreExtrapLoops || _havePostExtrapLoops) {
-            // If we are using a looping extrapolation mode then we need to be
-            // more careful about the region of knots that we unroll. If the
-            // requested time samples extend beyond the last knot then sampling
-            // will wrap around to the beginning again. So limit loopedInterval
-            // only if _timeInterval is entirely within it. If _timeInterval is
-            // at all outside loopInterval we want to unroll the entire
-            // loopInterval.
-            if (loopedInterval.Contains(_timeInterval)) {
-                loopedInterval = _timeInterval;
-            }
-        } else {
-            // No extrapolation looping so we only need to unroll inner loop
-            // knots that affect _timeInterval
-            loopedInterval &= _timeInterval;
-        }
-    }
-
-    // Iterators for the range that is pre-looping, looping prototype, and
-    // post-looping.
-    std::vector<TsTime>::const_iterator preBegin, preEnd;      // before looping
-    std::vector<TsTime>::const_iterator protoBegin, protoEnd;  // looping prototype
-    std::vector<TsTime>::const_iterator postBegin, postEnd;    // after looping
+    //
+    // So the unrolled knots come from up to three ranges: regular knots before
+    // looping, the loops, and regular knots after looping.  Without inner
+    // loops, all knots are in the first range.  From each range that we need,
+    // we take the knots from the last one at or before the start of
+    // unrollInterval to the first one at or after its end.
+    const TsTime minTime = unrollInterval.GetMin();
+    const TsTime maxTime = unrollInterval.GetMax();
 
     // Save some typing and wrapping of long lines.
     std::vector<TsTime>::const_iterator timesBegin = _data->times.begin();
     std::vector<TsTime>::const_iterator timesEnd = _data->times.end();
 
-    preBegin = std::lower_bound(timesBegin, timesEnd, _timeInterval.GetMin());
-    if ((preBegin == timesEnd || *preBegin > _timeInterval.GetMin()) &&
-        preBegin != timesBegin)
-    {
-        --preBegin;
-    }
+    // Iterators for the ranges that are pre-looping and post-looping.
+    std::vector<TsTime>::const_iterator preBegin, preEnd = timesEnd;
+    std::vector<TsTime>::const_iterator postBegin = timesEnd, postEnd;
+    if (_haveInnerLoops) {
+        preEnd = std::lower_bound(timesBegin, timesEnd, _firstInnerLoop);
 
-    postEnd = std::upper_bound(preBegin, timesEnd, _timeInterval.GetMax());
+        // There will be copy of the first prototype region knot at
+        // _lastInnerLoop.  Use upper_bound because the post looping data
+        // starts after the copy.
+        postBegin = std::upper_bound(preEnd, timesEnd, _lastInnerLoop);
+    }
 
-    if (loopedInterval.IsEmpty()) {
-        // Even if there are inner loops, we're not interested in
-        // that portion of the spline. Copy what we need
-        _internalTimes.assign(preBegin, postEnd);
+    // Knots before looping, if the interval starts before it.  If one of them
+    // is at or after the end of the interval, we need nothing more.
+    bool haveEnd = false;
+    preBegin = preEnd;
+    if (!_haveInnerLoops || minTime < _firstInnerLoop) {
+        preBegin = std::upper_bound(timesBegin, preEnd, minTime);
+        if (preBegin != timesBegin) {
+            --preBegin;
+        }
 
-        // Populate the knot vector with double data.
-        ptrdiff_t offset = std::distance(timesBegin, preBegin);
-        _internalKnots.reserve(_internalTimes.size());
+        const auto endIt = std::lower_bound(preBegin, preEnd, maxTime);
+        if (endIt != preEnd) {
+            preEnd = endIt + 1;
+            haveEnd = true;
+        }
+    }
 
-        for (size_t i = 0; i < _internalTimes.size(); ++i) {
-            _internalKnots.push_back(
-                _data->GetKnotDataAsDouble(i + offset));
+    // Knots after looping, if the interval ends after it.  If one of them is
+    // at or before the start of the interval, we need no loops.
+    bool haveStart = false;
+    postEnd = postBegin;
+    if (_haveInnerLoops && !haveEnd && maxTime > _lastInnerLoop) {
+        postEnd = std::lower_bound(postBegin, timesEnd, maxTime);
+        if (postEnd != timesEnd) {
+            ++postEnd;
         }
 
-        return;
+        const auto startIt = std::upper_bound(postBegin, postEnd, minTime);
+        if (startIt != postBegin) {
+            postBegin = startIt - 1;
+            haveStart = true;
+        }
     }
 
-    preEnd = std::lower_bound(preBegin, timesEnd, _firstInnerLoop);
+    // Convert iterators to indices so they work for both knots and times.
+    const ptrdiff_t preBeginIndex  = preBegin  - timesBegin;
+    const ptrdiff_t preEndIndex    = preEnd    - timesBegin;
+    const ptrdiff_t postBeginIndex = postBegin - timesBegin;
+    const ptrdiff_t postEndIndex   = postEnd   - timesBegin;
 
-    protoBegin = std::lower_bound(preEnd, timesEnd, _firstInnerProto);
-    protoEnd = std::lower_bound(protoBegin, timesEnd, _lastInnerProto);
+    if (!_haveInnerLoops || haveEnd || haveStart) {
+        // Even if there are inner loops, we're not interested in
+        // that portion of the spline. Copy what we need.
+        _internalTimes.reserve(
+            (preEndIndex - preBeginIndex) + (postEndIndex - postBeginIndex));
+        _internalTimes.insert(_internalTimes.end(), preBegin, preEnd);
+        _AppendKnotsAsDouble(preBeginIndex, preEndIndex);
+        _internalTimes.insert(_internalTimes.end(), postBegin, postEnd);
+        _AppendKnotsAsDouble(postBeginIndex, postEndIndex);
+        return;
+    }
 
-    // There will be copy of the first prototype region knot at _lastInnerLoop.
-    // Use upper_bound because the post looping data starts after the copy.
-    postBegin = std::upper_bound(protoEnd, timesEnd, _lastInnerLoop);
+    // Iterators for the looping prototype.
+    const std::vector<TsTime>::const_iterator protoBegin =
+        std::lower_bound(preEnd, timesEnd, _firstInnerProto);
+    const std::vector<TsTime>::const_iterator protoEnd =
+        std::lower_bound(protoBegin, timesEnd, _lastInnerProto);
 
     // Note that Ts_SplineData::HasInnerLoops has already validated the
     // loopParams struct so we know we have a positive size for protoSpan
@@ -1096,14 +1396,21 @@ _Sampler::_UnrollInnerLoops()
     const TsTime protoSpan = lp.protoEnd - lp.protoStart;
 
     // Figure out the number of pre- and post-loops that we need. This may be
-    // less than the number of pre- and post-loops that exist because
-    // loopedInterval is only the looped portion of the spline that we want to
-    // sample.
-    const TsTime preOffset = _firstInnerProto - loopedInterval.GetMin();
-    const int preLoops = std::max(0, int(std::ceil(preOffset / protoSpan)));
-
-    const TsTime postOffset = loopedInterval.GetMax() - _lastInnerProto;
-    const int postLoops = std::max(0, int(std::ceil(postOffset / protoSpan)));
+    // less than the number of pre- and post-loops that exist. An interval
+    // that ends before looping starts, or starts after it ends, needs only
+    // the first or last looped knot.
+    const TsTime loopMin =
+        std::clamp(minTime, _firstInnerLoop, _lastInnerLoop);
+    const TsTime loopMax =
+        std::clamp(maxTime, _firstInnerLoop, _lastInnerLoop);
+
+    const TsTime preOffset = _firstInnerProto - loopMin;
+    const int preLoops = std::clamp(
+        int(std::ceil(preOffset / protoSpan)), 0, int(lp.numPreLoops));
+
+    const TsTime postOffset = loopMax - _lastInnerProto;
+    const int postLoops = std::clamp(
+        int(std::ceil(postOffset / protoSpan)), 0, int(lp.numPostLoops));
 
     // Count the knots to minimize memory allocations
     ptrdiff_t count = (preEnd - preBegin) +
@@ -1113,21 +1420,17 @@ _Sampler::_UnrollInnerLoops()
     _internalKnots.reserve(count);
     _internalTimes.reserve(count);
 
-    // Convert iterators to indices so they work for both knots and times.
-    ptrdiff_t preBeginIndex   = preBegin   - timesBegin;
-    ptrdiff_t preEndIndex     = preEnd     - timesBegin;
-
     ptrdiff_t protoBeginIndex = protoBegin - timesBegin;
     ptrdiff_t protoEndIndex   = protoEnd   - timesBegin;
 
-    ptrdiff_t postBeginIndex  = postBegin  - timesBegin;
-    ptrdiff_t postEndIndex    = postEnd    - timesBegin;
-
     // Populate the arrays. Just copy values from before looping starts.
-    for (ptrdiff_t i = preBeginIndex; i < preEndIndex; ++i) {
-        _internalTimes.push_back(_data->times[i]);
-        _internalKnots.push_back(_data->GetKnotDataAsDouble(i));
-    }
+    _internalTimes.insert(_internalTimes.end(), preBegin, preEnd);
+    _AppendKnotsAsDouble(preBeginIndex, preEndIndex);
+
+    // Convert the prototype knots once.
+    _protoKnots.resize(protoEndIndex - protoBeginIndex);
+    _data->GetKnotRangeAsDouble(
+        protoBeginIndex, _protoKnots.size(), _protoKnots.data());
 
     // Copy data for the loops, offsetting the times and values.
     for (int loopIndex = -preLoops; loopIndex <= postLoops; ++loopIndex) {
@@ -1136,7 +1439,7 @@ _Sampler::_UnrollInnerLoops()
         for (ptrdiff_t i = protoBeginIndex; i < protoEndIndex; ++i) {
             _internalTimes.push_back(_data->times[i] + timeOffset);
 
-            _internalKnots.push_back(_data->GetKnotDataAsDouble(i));
+            _internalKnots.push_back(_protoKnots[i - protoBeginIndex]);
             Ts_DoubleKnotData& back = _internalKnots.back();
             back.time += timeOffset;
             back.value += valueOffset;
@@ -1154,27 +1457,48 @@ _Sampler::_UnrollInnerLoops()
     back.preValue += lp.valueOffset * (postLoops + 1);
 
     // Copy knots that are after looping ends.
-    for (ptrdiff_t i = postBeginIndex; i < postEndIndex; ++i) {
-        _internalTimes.push_back(_data->times[i]);
-        _internalKnots.push_back(_data->GetKnotDataAsDouble(i));
+    _internalTimes.insert(_internalTimes.end(), postBegin, postEnd);
+    _AppendKnotsAsDouble(postBeginIndex, postEndIndex);
+}
+
+// Append double-typed copies of the knots in [beginIndex, endIndex) to
+// _internalKnots.
+void
+Ts_Sampler::_AppendKnotsAsDouble(const ptrdiff_t beginIndex,
+                               const ptrdiff_t endIndex)
+{
+    if (endIndex <= beginIndex) {
+        return;
     }
+
+    const size_t oldSize = _internalKnots.size();
+    _internalKnots.resize(oldSize + (endIndex - beginIndex));
+    _data->GetKnotRangeAsDouble(
+        beginIndex, endIndex - beginIndex, _internalKnots.data() + oldSize);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 // SAMPLE ENTRY POINT
 
+// Parallel sampling tasks per thread.  Several, so that work stealing can even
+// out chunks with different amounts of curvature.
+static const size_t _tasksPerThread = 4;
+
+template <typename Sink>
 void
 Ts_Sample(
-    const Ts_SplineData* const data,
+    Ts_Sampler* const sampler,
     const GfInterval& timeInterval,
     const double timeScale,
     const double valueScale,
     const double tolerance,
-    Ts_SampleDataInterface* sampledSpline)
+    const TsBezierFlattening flattening,
+    TsExecutor* executor,
+    Sink* sampledSpline)
 {
     // All arguments should have been validated before reaching this point,
     // but just to be safe...
-    if (!TF_VERIFY((data &&
+    if (!TF_VERIFY((sampler &&
                     !timeInterval.IsEmpty() &&
                     timeScale > 0.0 &&
                     valueScale > 0.0 &&
@@ -1185,20 +1509,90 @@ Ts_Sample(
         return;
     }
 
-    if (data->times.empty()) {
+    // Sort out looping and extrapolation, reusing what the sampler already
+    // has where possible.
+    sampler->SetParams(timeInterval,
+                       timeScale,
+                       valueScale,
+                       tolerance,
+                       flattening);
+
+    // Size the output, then perform the main evaluation.
+    sampledSpline->Reserve(sampler->EstimateVertexCount());
+
+    // Sample long splines in chunks on separate threads, each into its own
+    // samples, then stitch those together in order.  Each chunk makes the
+    // same calls to its sink as serial sampling makes for that part of the
+    // spline, so the stitched polylines are identical, however the executor
+    // runs the tasks.  Without an executor, sample serially.
+    const size_t concurrency = executor ? executor->GetConcurrency() : 1;
+    std::vector<GfInterval> chunks;
+    if (concurrency > 1 &&
+        sampler->GetParallelChunks(concurrency * _tasksPerThread, &chunks))
+    {
+        using Chunk = typename Sink::Chunk;
+        std::vector<Chunk> chunkSamples(chunks.size());
+        for (Chunk& chunk : chunkSamples) {
+            sampledSpline->InitChunk(&chunk);
+        }
+
+        executor->Run(chunks.size(),
+            [&](const size_t chunkIndex)
+            {
+                Ts_SampleData<Chunk> chunkData(&chunkSamples[chunkIndex]);
+                sampler->SampleInterval(chunks[chunkIndex], &chunkData);
+            });
+
+        for (Chunk& chunk : chunkSamples) {
+            sampledSpline->Append(&chunk);
+        }
         return;
     }
 
-    // Construct a _Sampler to sort out looping and extrapolation.
-    _Sampler sampler(data,
-                     timeInterval,
-                     timeScale,
-                     valueScale,
-                     tolerance);
-
-    // Perform the main evaluation.
-    sampler.Sample(sampledSpline);
+    sampler->Sample(sampledSpline);
 }
 
+// Instantiate Ts_Sample for each spline samples class and each supported
+// sample data type, and for visitors.
+#define _INSTANTIATE_SAMPLE(sampleData, tuple)                          \
+    template                                                            \
+    TS_API                                                              \
+    void                                                                \
+    Ts_Sample(                                                          \
+        Ts_Sampler* sampler,                                            \
+        const GfInterval& timeInterval,                                 \
+        double timeScale,                                               \
+        double valueScale,                                              \
+        double tolerance,                                               \
+        TsBezierFlattening flattening,                                  \
+        TsExecutor* executor,                                           \
+        Ts_SampleData<sampleData< TS_SPLINE_VALUE_CPP_TYPE(tuple) >>*   \
+            sampledSpline);
+
+TF_PP_SEQ_FOR_EACH(_INSTANTIATE_SAMPLE,
+                   TsSplineSamples,
+                   TS_SPLINE_SAMPLE_VERTEX_TYPES)
+TF_PP_SEQ_FOR_EACH(_INSTANTIATE_SAMPLE,
+                   TsSplineSamplesWithSources,
+                   TS_SPLINE_SAMPLE_VERTEX_TYPES)
+TF_PP_SEQ_FOR_EACH(_INSTANTIATE_SAMPLE,
+                   TsSplineFlatSamples,
+                   TS_SPLINE_SAMPLE_VERTEX_TYPES)
+
+#undef _INSTANTIATE_SAMPLE
+
+template
+TS_API
+void
+Ts_Sample(
+    Ts_Sampler* sampler,
+    const GfInterval& timeInterval,
+    double timeScale,
+    double valueScale,
+    double tolerance,
+    TsBezierFlattening flattening,
+    TsExecutor* executor,
+    Ts_SampleVisitorSink* sampledSpline);
+
 
 }  // namespace pxr
@@ -10,30 +10,50 @@
 
 #include "./api.h"
 #include "./eval.h"
+#include "./knotData.h"
 #include "./types.h"
+#include <pxr/tf/diagnostic.h>
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
 
 namespace pxr {
 
 struct Ts_SplineData;
+class TsExecutor;
 
-class Ts_SampleDataInterface
-{
-public:
-    // Add a segment to the TsSplineSamples. If the vertex (time0, value0)
-    // does not exactly mat with the last existing vertex in the polyline,
-    // a new polyline will be started.
-    virtual void
-    AddSegment(double time0, double value0,
-               double time1, double value1,
-               TsSplineSampleSource source) = 0;
+using Ts_DoubleKnotData = Ts_TypedKnotData<double>;
 
-    // Clear the existing contents of the sample data prior to filling it.
-    virtual void
-    Clear() = 0;
-};
+// Ts_Sample emits its results to a sink, which is a template parameter so
+// that calls to it are inlined.  A sink has these members:
+//
+//     // Add a segment.  If the vertex (time0, value0) does not exactly match
+//     // the last vertex added, a new polyline is started.
+//     void AddSegment(double time0, double value0,
+//                     double time1, double value1,
+//                     TsSplineSampleSource source);
+//
+//     // Clear the existing contents of the sample data prior to filling it.
+//     void Clear();
+//
+//     // Prepare for about this many vertices.  Only a hint.
+//     void Reserve(size_t numVertices);
+//
+//     // When sampling in parallel, each chunk of the spline is sampled into
+//     // its own Chunk, through a Ts_SampleData<Chunk>, after InitChunk
+//     // prepares it.  The chunks are then passed to Append in order, which
+//     // must leave the sink as if their segments had been added directly.
+//     using Chunk = ...;
+//     void InitChunk(Chunk* chunk) const;
+//     void Append(Chunk* chunk);
+//
+// Ts_Sample is instantiated for each Ts_SampleData specialization below, and
+// for Ts_SampleVisitorSink.
 
 template <typename T>
-class Ts_SampleData : public Ts_SampleDataInterface
+class Ts_SampleData
 {
     Ts_SampleData(T* /* ignored */)
     {
@@ -50,20 +70,23 @@ class Ts_SampleData : public Ts_SampleDataInterface
     void
     AddSegment(double time0, double value0,
                double time1, double value1,
-               TsSplineSampleSource source) override
+               TsSplineSampleSource source)
     { }
 
     // This generic implementation of Clear does nothing. Use one
     // of the partial specializations below instead.
     void
-    Clear() override
+    Clear()
+    { }
+
+    void
+    Reserve(size_t)
     { }
-    
 };
 
 // Partial specialization for TsSplineSamples
 template <typename Vertex>
-class Ts_SampleData<TsSplineSamples<Vertex>> : public Ts_SampleDataInterface
+class Ts_SampleData<TsSplineSamples<Vertex>>
 {
 private:
     using SplineSamples = TsSplineSamples<Vertex>;
@@ -80,7 +103,7 @@ public:
     void
     AddSegment(double time0, double value0,
                double time1, double value1,
-               TsSplineSampleSource /* source*/) override
+               TsSplineSampleSource /* source*/)
     {
         if (time0 > time1) {
             using std::swap;
@@ -105,16 +128,51 @@ public:
 
     // Clear the existing contents of the TsSplineSamples prior to filling it.
     void
-    Clear() override
+    Clear()
     {
         _sampledSpline->polylines.clear();
     }
+
+    // Polylines are allocated individually, so there is nothing to reserve.
+    void
+    Reserve(size_t)
+    { }
+
+    using Chunk = TsSplineSamples<Vertex>;
+
+    void
+    InitChunk(Chunk*) const
+    { }
+
+    // Move a chunk's polylines to the end.  Its first polyline continues the
+    // last one if it starts at the last vertex, as AddSegment would.
+    void
+    Append(Chunk* chunk)
+    {
+        auto& polylines = _sampledSpline->polylines;
+        auto chunkIt = chunk->polylines.begin();
+        if (chunkIt == chunk->polylines.end()) {
+            return;
+        }
+
+        if (!polylines.empty() &&
+            !polylines.back().empty() &&
+            polylines.back().back() == chunkIt->front())
+        {
+            polylines.back().insert(polylines.back().end(),
+                                    chunkIt->begin() + 1, chunkIt->end());
+            ++chunkIt;
+        }
+
+        polylines.insert(polylines.end(),
+                         std::make_move_iterator(chunkIt),
+                         std::make_move_iterator(chunk->polylines.end()));
+    }
 };
 
 // Partial specialization for TsSplineSamplesWithSources
 template <typename Vertex>
-class Ts_SampleData<TsSplineSamplesWithSources<Vertex>> :
-    public Ts_SampleDataInterface
+class Ts_SampleData<TsSplineSamplesWithSources<Vertex>>
 {
 private:
     using SplineSamples = TsSplineSamplesWithSources<Vertex>;
@@ -132,7 +190,7 @@ public:
     void
     AddSegment(double time0, double value0,
                double time1, double value1,
-               TsSplineSampleSource source) override
+               TsSplineSampleSource source)
     {
         if (time0 > time1) {
             using std::swap;
@@ -159,23 +217,541 @@ public:
     }
 
     void
-    Clear() override
+    Clear()
     {
         _sampledSpline->polylines.clear();
         _sampledSpline->sources.clear();
     }
+
+    void
+    Reserve(size_t)
+    { }
+
+    using Chunk = TsSplineSamplesWithSources<Vertex>;
+
+    void
+    InitChunk(Chunk*) const
+    { }
+
+    // Move a chunk's polylines and sources to the end.  Its first polyline
+    // continues the last one if it starts at the last vertex, with the same
+    // source, as AddSegment would.
+    void
+    Append(Chunk* chunk)
+    {
+        auto& polylines = _sampledSpline->polylines;
+        auto& sources = _sampledSpline->sources;
+        if (chunk->polylines.empty()) {
+            return;
+        }
+
+        size_t first = 0;
+        if (!polylines.empty() &&
+            sources.back() == chunk->sources.front() &&
+            !polylines.back().empty() &&
+            polylines.back().back() == chunk->polylines.front().front())
+        {
+            const auto& chunkPolyline = chunk->polylines.front();
+            polylines.back().insert(polylines.back().end(),
+                                    chunkPolyline.begin() + 1,
+                                    chunkPolyline.end());
+            first = 1;
+        }
+
+        polylines.insert(
+            polylines.end(),
+            std::make_move_iterator(chunk->polylines.begin() + first),
+            std::make_move_iterator(chunk->polylines.end()));
+        sources.insert(sources.end(),
+                       chunk->sources.begin() + first, chunk->sources.end());
+    }
+};
+
+// Partial specialization for TsSplineFlatSamples
+template <typename Vertex>
+class Ts_SampleData<TsSplineFlatSamples<Vertex>>
+{
+private:
+    TsSplineFlatSamples<Vertex>* _sampledSpline;
+
+public:
+    Ts_SampleData(TsSplineFlatSamples<Vertex>* sampledSpline)
+    : _sampledSpline(sampledSpline)
+    { }
+
+    // Add a segment to the TsSplineFlatSamples. If the vertex (time0, value0)
+    // does not exactly match the last vertex, or sources are requested and the
+    // source does not match the last source, a new polyline will be started.
+    // The last offset is always the end of the vertices, so the arrays are
+    // consistent at every step.
+    void
+    AddSegment(double time0, double value0,
+               double time1, double value1,
+               TsSplineSampleSource source)
+    {
+        if (time0 > time1) {
+            using std::swap;
+            swap(time0, time1);
+            swap(value0, value1);
+        }
+
+        std::vector<Vertex>& vertices = _sampledSpline->vertices;
+        std::vector<size_t>& offsets = _sampledSpline->offsets;
+        std::vector<TsSplineSampleSource>& sources = _sampledSpline->sources;
+
+        Vertex vertex0(time0, value0);
+        Vertex vertex1(time1, value1);
+
+        if (vertices.empty() ||
+            vertices.back() != vertex0 ||
+            (_sampledSpline->withSources && sources.back() != source))
+        {
+            // We need to create a new polyline
+            if (offsets.empty()) {
+                offsets.push_back(0);
+            }
+            vertices.push_back(vertex0);
+            offsets.push_back(vertices.size());
+            if (_sampledSpline->withSources) {
+                sources.push_back(source);
+            }
+        }
+
+        vertices.push_back(vertex1);
+        offsets.back() = vertices.size();
+    }
+
+    // Clear the existing contents of the TsSplineFlatSamples prior to filling
+    // it, keeping the capacity.
+    void
+    Clear()
+    {
+        _sampledSpline->vertices.clear();
+        _sampledSpline->offsets.clear();
+        _sampledSpline->sources.clear();
+    }
+
+    void
+    Reserve(size_t numVertices)
+    {
+        _sampledSpline->vertices.reserve(numVertices);
+    }
+
+    using Chunk = TsSplineFlatSamples<Vertex>;
+
+    void
+    InitChunk(Chunk* chunk) const
+    {
+        chunk->withSources = _sampledSpline->withSources;
+    }
+
+    // Copy a chunk's arrays to the ends of ours, shifting its offsets.  Its
+    // first polyline continues the last one if it starts at the last vertex,
+    // with the same source if sources are requested, as AddSegment would.
+    void
+    Append(Chunk* chunk)
+    {
+        std::vector<Vertex>& vertices = _sampledSpline->vertices;
+        std::vector<size_t>& offsets = _sampledSpline->offsets;
+        std::vector<TsSplineSampleSource>& sources = _sampledSpline->sources;
+        if (chunk->vertices.empty()) {
+            return;
+        }
+
+        const bool join =
+            !vertices.empty() &&
+            vertices.back() == chunk->vertices.front() &&
+            (!_sampledSpline->withSources ||
+             sources.back() == chunk->sources.front());
+        const size_t first = (join ? 1 : 0);
+
+        // Chunk vertex i becomes vertex base + i.  Its offsets replace our
+        // last one, which is the end of the vertices.
+        const size_t base = vertices.size() - first;
+        if (offsets.empty()) {
+            offsets.push_back(0);
+        } else if (join) {
+            offsets.pop_back();
+        }
+        for (size_t i = 1; i < chunk->offsets.size(); ++i) {
+            offsets.push_back(base + chunk->offsets[i]);
+        }
+        vertices.insert(vertices.end(),
+                        chunk->vertices.begin() + first,
+                        chunk->vertices.end());
+        if (_sampledSpline->withSources) {
+            sources.insert(sources.end(),
+                           chunk->sources.begin() + first,
+                           chunk->sources.end());
+        }
+    }
+};
+
+// A sink that streams polylines to a caller's visitor, which has the members
+// described for TsSpline::SampleToVisitor.  The visitor is called through
+// function pointers, so that Ts_Sample needn't be instantiated for each
+// visitor type.  Polylines are broken where the vertices or the source
+// change, as for TsSplineSamplesWithSources.
+class Ts_SampleVisitorSink
+{
+public:
+    template <typename Visitor>
+    explicit Ts_SampleVisitorSink(Visitor* visitor)
+    : _visitor(visitor)
+    , _beginPolyline(
+        [](void* v, TsSplineSampleSource source) {
+            static_cast<Visitor*>(v)->BeginPolyline(source);
+        })
+    , _addVertex(
+        [](void* v, double time, double value) {
+            static_cast<Visitor*>(v)->AddVertex(time, value);
+        })
+    { }
+
+    void
+    AddSegment(double time0, double value0,
+               double time1, double value1,
+               TsSplineSampleSource source)
+    {
+        if (time0 > time1) {
+            using std::swap;
+            swap(time0, time1);
+            swap(value0, value1);
+        }
+
+        if (!_started ||
+            source != _lastSource ||
+            time0 != _lastTime ||
+            value0 != _lastValue)
+        {
+            _beginPolyline(_visitor, source);
+            _addVertex(_visitor, time0, value0);
+            _started = true;
+            _lastSource = source;
+        }
+
+        _addVertex(_visitor, time1, value1);
+        _lastTime = time1;
+        _lastValue = value1;
+    }
+
+    // The visitor's buffers are its own; there is nothing to clear or
+    // reserve.
+    void
+    Clear()
+    { }
+
+    void
+    Reserve(size_t)
+    { }
+
+    // Visitors must be called in order, so chunks are kept with their
+    // sources, then passed to the visitor segment by segment.
+    using Chunk = TsSplineFlatSamples<GfVec2d>;
+
+    void
+    InitChunk(Chunk* chunk) const
+    {
+        chunk->withSources = true;
+    }
+
+    void
+    Append(Chunk* chunk)
+    {
+        for (size_t i = 0; i < chunk->GetNumPolylines(); ++i) {
+            const GfVec2d* const polyline = chunk->GetPolylineData(i);
+            for (size_t j = 1; j < chunk->GetPolylineSize(i); ++j) {
+                AddSegment(polyline[j - 1][0], polyline[j - 1][1],
+                           polyline[j][0], polyline[j][1],
+                           chunk->sources[i]);
+            }
+        }
+    }
+
+private:
+    void* const _visitor;
+    void (* const _beginPolyline)(void*, TsSplineSampleSource);
+    void (* const _addVertex)(void*, double, double);
+
+    bool _started = false;
+    TsSplineSampleSource _lastSource = TsSourceKnotInterp;
+    TsTime _lastTime = 0;
+    double _lastValue = 0;
+};
+
+// Ts_Sampler constructs a partially unrolled version of the spline and then
+// samples that version. Only the inner loops are unrolled and only in the
+// region where sampling will be occurring.
+//
+// The unrolled version enables random access to all the relevant knots
+// and we implement extrapolation looping with simple time and value
+// shifting.
+//
+// A sampler may be reused, for other parameters or other splines.  It keeps
+// the capacity of its buffers, and when the spline is unchanged, it keeps its
+// unrolled knots for as long as they cover the intervals being sampled.
+class Ts_Sampler
+{
+public:
+    Ts_Sampler() = default;
+
+    explicit Ts_Sampler(const Ts_SplineData* data)
+    {
+        SetSpline(data);
+    }
+
+    // _knots and _times may point into our own buffers.
+    Ts_Sampler(const Ts_Sampler&) = delete;
+    Ts_Sampler& operator=(const Ts_Sampler&) = delete;
+
+    // Characterize a spline, which must have knots, for sampling.  The data
+    // must stay alive and unchanged until SetSpline is called again.
+    void SetSpline(
+        const Ts_SplineData* data);
+
+    // Set the parameters for the following calls, unrolling the spline if
+    // the knots unrolled for earlier parameters do not cover timeInterval.
+    void SetParams(
+        const GfInterval& timeInterval,
+        double timeScale,
+        double valueScale,
+        double tolerance,
+        TsBezierFlattening flattening);
+
+    template <typename Sink>
+    bool Sample(
+        Sink* sampledSpline);
+
+    template <typename Sink>
+    bool SampleInterval(
+        const GfInterval& subInterval,
+        Sink* sampledSpline);
+
+    // Estimate the number of vertices that Sample will produce, so sinks
+    // with contiguous storage can reserve it.
+    size_t EstimateVertexCount() const;
+
+    // Divide the sampled interval into at most maxChunks consecutive
+    // chunks, for sampling with SampleInterval on separate threads.
+    // Returns false if there are too few knot segments to be worth it.
+    bool GetParallelChunks(size_t maxChunks,
+                           std::vector<GfInterval>* chunks) const;
+
+private:
+    // Each spline can have as many as seven intervals that are populated from
+    // different sources, for example, pre-extrapolation loops, inner loops,
+    // post-extrapolation, etc.
+    //
+    // _SourceInterval holds the time interval for a source.
+    struct _SourceInterval
+    {
+        TsSplineSampleSource source;
+        GfInterval interval;
+
+        _SourceInterval(TsSplineSampleSource inSource,
+                        TsTime t1,
+                        TsTime t2)
+        : source(inSource)
+        , interval{t1, t2, true, false}
+        {}
+    };
+
+    // Sample knots in sampleInterval. Sampled knot times are converted to
+    // sample times with _ToSampleTime and values are offset by valueOffset
+    // before being stored in sampledSpline.
+    template <typename Sink>
+    void _SampleKnots(
+        const GfInterval& sampleInterval,
+        const TsSplineSampleSource source,
+        const double knotToSampleTimeScale,
+        const TsTime knotToSampleTimeOffset,
+        const double valueOffset,
+        Sink* sampledSpline);
+
+    // Sample knots in sampleInterval in reverse. Sampled knot times are
+    // converted to sample times with _ToSampleTime and values are offset by
+    // valueOffset before being stored in sampledSpline.
+    template <typename Sink>
+    void _SampleKnotsReversed(
+        const GfInterval& sampleInterval,
+        const TsSplineSampleSource source,
+        const double knotToSampleTimeScale,
+        const TsTime knotToSampleTimeOffset,
+        const double valueOffset,
+        Sink* sampledSpline);
+
+    // Sample a segment of the spline between 2 adjacent knots.
+    template <typename Sink>
+    void _SampleSegment(const Ts_DoubleKnotData* prevKnot,
+                        const Ts_DoubleKnotData* nextKnot,
+                        const GfInterval& segmentInterval,
+                        TsSplineSampleSource source,
+                        double knotToSampleTimeScale,
+                        double knotToSampleTimeOffset,
+                        double valueOffset,
+                        Sink* sampledSpline);
+
+    // Sample a segment of the spline between 2 adjacent knots.
+    template <typename Sink>
+    void _SampleCurveSegment(const Ts_DoubleKnotData* prevKnot,
+                             const Ts_DoubleKnotData* nextKnot,
+                             const GfInterval& segmentInterval,
+                             TsSplineSampleSource source,
+                             double knotToSampleTimeScale,
+                             double knotToSampleTimeOffset,
+                             double valueOffset,
+                             Sink* sampledSpline);
+
+    template <typename Sink>
+    void _SampleBezier(GfVec2d cp[4],
+                       const GfInterval& segmentInterval,
+                       TsSplineSampleSource source,
+                       double knotToSampleTimeScale,
+                       double knotToSampleTimeOffset,
+                       double valueOffset,
+                       Sink* sampledSpline);
+
+    // Sample a Bezier segment, or the part of it in segmentInterval, at
+    // evenly spaced parameters, without recursion.
+    template <typename Sink>
+    void _SampleBezierUniform(const GfVec2d cp[4],
+                              const GfInterval& segmentInterval,
+                              TsSplineSampleSource source,
+                              double knotToSampleTimeScale,
+                              double knotToSampleTimeOffset,
+                              double valueOffset,
+                              Sink* sampledSpline);
+
+    // Get the number of polyline segments for the uniform flattening of
+    // a Bezier segment.
+    int _GetBezierFlatteningCount(const GfVec2d cp[4]) const;
+
+    // Estimate the number of vertices for the segment that starts at
+    // prevKnot.
+    size_t _EstimateSegmentVertices(const Ts_DoubleKnotData& prevKnot,
+                                    const Ts_DoubleKnotData& nextKnot)
+        const;
+
+    // Sample a Hermite segment, or the part of it in segmentInterval.
+    template <typename Sink>
+    void _SampleHermite(const Ts_DoubleKnotData* prevKnot,
+                        const Ts_DoubleKnotData* nextKnot,
+                        const GfInterval& segmentInterval,
+                        TsSplineSampleSource source,
+                        double knotToSampleTimeScale,
+                        double knotToSampleTimeOffset,
+                        double valueOffset,
+                        Sink* sampledSpline);
+
+    // Given a set of bezier control points and a u parameter in the
+    // range [0..1], return 2 sets of control points for the left and
+    // right parts of the original curve, split at u. It is allowable
+    // for the cp input to also be one of the outputs.
+    void _SubdivideBezier(const GfVec2d cp[4],
+                          const double u,
+                          GfVec2d leftCp[4],
+                          GfVec2d rightCp[4]);
+
+    template <typename Sink>
+    void _ExtrapLinear(
+        const GfInterval& regionInterval,
+        const TsSplineSampleSource source,
+        Sink* sampledSpline);
+
+    template <typename Sink>
+    void _ExtrapLoop(
+        const GfInterval& regionInterval,
+        const TsSplineSampleSource source,
+        Sink* sampledSpline);
+
+    // Get the interval over which knots must be unrolled to sample
+    // timeInterval.
+    GfInterval _GetUnrollInterval(const GfInterval& timeInterval) const;
+
+    void _UnrollInnerLoops(const GfInterval& unrollInterval);
+    void _AppendKnotsAsDouble(ptrdiff_t beginIndex, ptrdiff_t endIndex);
+
+    // Convert sample time to knot time.
+    TsTime _ToKnotTime(TsTime sTime,
+                       double knotToSampleTimeScale,
+                       TsTime knotToSampleTimeOffset) {
+        return (sTime - knotToSampleTimeOffset) / knotToSampleTimeScale;
+    }
+
+    // Convert knot time back to sample time.
+    TsTime _ToSampleTime(TsTime kTime,
+                         double knotToSampleTimeScale,
+                         TsTime knotToSampleTimeOffset) {
+        return kTime * knotToSampleTimeScale + knotToSampleTimeOffset;
+    }
+
+    // Inputs.
+    const Ts_SplineData* _data = nullptr;
+    GfInterval _timeInterval;
+    double _timeScale = 1.0;
+    double _valueScale = 1.0;
+    double _tolerance = 1.0;
+    TsBezierFlattening _flattening = TsBezierFlatteningSubdivide;
+
+    // Intermediate data.
+    bool _haveInnerLoops = false;
+    bool _haveMultipleKnots = false;
+    size_t _firstInnerProtoIndex = 0;
+    bool _havePreExtrapLoops = false;
+    bool _havePostExtrapLoops = false;
+    TsTime _firstTime = 0;
+    TsTime _lastTime = 0;
+    TsTime _firstInnerLoop = 0;
+    TsTime _lastInnerLoop = 0;
+    TsTime _firstInnerProto = 0;
+    TsTime _lastInnerProto = 0;
+    bool _firstTimeLooped = false;
+    bool _lastTimeLooped = false;
+    bool _doPreExtrap = false;
+    bool _doPostExtrap = false;
+    double _extrapValueOffset = 0;
+    bool _betweenPreUnloopedAndLooped = false;
+    bool _betweenLoopedAndPostUnlooped = false;
+    Ts_DoubleKnotData _extrapKnot1;
+    Ts_DoubleKnotData _extrapKnot2;
+
+    std::vector<_SourceInterval> _sourceIntervals;
+
+    // Pointers to vectors knots and their times. If there is no inner
+    // looping then these will point directly to the spline data. Otherwise,
+    // the "internal" vectors below will be populated and these will point
+    // at those. At no time does _knots nor _times ever own the data that
+    // they point to.
+    const std::vector<Ts_DoubleKnotData>* _knots = nullptr;
+    const std::vector<TsTime>* _times = nullptr;
+
+    // The interval for which _knots and _times were set up.  They may be
+    // reused to sample any interval whose unroll interval this contains.
+    GfInterval _unrolledInterval;
+
+    // If we have to bake out the knots or times then we do so here and
+    // point _knots and _times at these arrays.
+    std::vector<Ts_DoubleKnotData> _internalKnots;
+    std::vector<TsTime> _internalTimes;
+    std::vector<Ts_DoubleKnotData> _protoKnots;
 };
 
-// Note that SampleData will be some templated version of TsSplineSamples
-// or TsSplineSamplesWithSources.
+// Sample the spline last passed to sampler->SetSpline into a sink, which will
+// be one of the Ts_SampleData specializations, or a Ts_SampleVisitorSink.
+// Long splines are sampled in parallel with the executor, or serially if it is
+// null; the sink is always called on the calling thread, in the same order as
+// when sampling serially.
+template <typename Sink>
 TS_API
 void
-Ts_Sample(const Ts_SplineData* data,
+Ts_Sample(Ts_Sampler* sampler,
           const GfInterval& timeInterval,
           double timeScale,
           double valueScale,
           double tolerance,
-          Ts_SampleDataInterface* sampledSpline);
+          TsBezierFlattening flattening,
+          TsExecutor* executor,
+          Sink* sampledSpline);
 
 #undef _INSTANTIATE_SAMPLE_METHOD
 
@@ -0,0 +1,146 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include "./sampler.h"
+#include "./splineData.h"
+
+#include <pxr/tf/diagnostic.h>
+
+namespace pxr {
+
+
+TsSampler::TsSampler() = default;
+
+TsSampler::TsSampler(
+    const TsSpline &spline)
+{
+    SetSpline(spline);
+}
+
+TsSampler::~TsSampler() = default;
+
+void
+TsSampler::SetSpline(
+    const TsSpline &spline)
+{
+    // If the spline still shares our data, nothing has changed, and our
+    // setup, including any unrolled knots, is still good.
+    const Ts_SplineData* const data = spline._GetData();
+    if (data == _spline._GetData()) {
+        return;
+    }
+
+    _spline = spline;
+    if (!data->times.empty()) {
+        _sampler.SetSpline(data);
+    }
+}
+
+// Reports a coding error and returns false if the sampling arguments are
+// invalid, as TsSpline::Sample does.
+static bool
+_ValidateArgs(
+    const GfInterval& timeInterval,
+    const double timeScale,
+    const double valueScale,
+    const double tolerance)
+{
+    if (timeInterval.IsEmpty() ||
+        timeScale <= 0.0 ||
+        valueScale <= 0.0 ||
+        tolerance <= 0.0)
+    {
+        TF_CODING_ERROR(
+            "The time interval must not be empty and the values of timeScale,"
+            " valueScale, and tolerance must all be greater than 0 when"
+            " sampling a spline.");
+        return false;
+    }
+    return true;
+}
+
+template <typename SampleHolder>
+bool
+TsSampler::_Sample(
+    const GfInterval& timeInterval,
+    const double timeScale,
+    const double valueScale,
+    const double tolerance,
+    const TsBezierFlattening flattening,
+    TsExecutor* const executor,
+    SampleHolder* splineSamples)
+{
+    if (!_ValidateArgs(timeInterval, timeScale, valueScale, tolerance)) {
+        return false;
+    }
+
+    Ts_SampleData<SampleHolder> sampleData(splineSamples);
+
+    // Make sure that splineSamples is empty.
+    sampleData.Clear();
+
+    // Do not bother to sample empty data.
+    if (!_spline.IsEmpty()) {
+        Ts_Sample(&_sampler, timeInterval,
+                  timeScale, valueScale, tolerance, flattening, executor,
+                  &sampleData);
+    }
+    return true;
+}
+
+bool
+TsSampler::_SampleToSink(
+    const GfInterval& timeInterval,
+    const double timeScale,
+    const double valueScale,
+    const double tolerance,
+    const TsBezierFlattening flattening,
+    TsExecutor* const executor,
+    Ts_SampleVisitorSink* const sink)
+{
+    if (!_ValidateArgs(timeInterval, timeScale, valueScale, tolerance)) {
+        return false;
+    }
+
+    // Do not bother to sample empty data.
+    if (!_spline.IsEmpty()) {
+        Ts_Sample(&_sampler, timeInterval,
+                  timeScale, valueScale, tolerance, flattening, executor,
+                  sink);
+    }
+    return true;
+}
+
+// Instantiate Sample for each spline samples class and for
+// each supported sample data type.
+#define _INSTANTIATE_SAMPLE_METHOD(sampleData, tuple)                   \
+    template                                                            \
+    TS_API                                                              \
+    bool                                                                \
+    TsSampler::_Sample(                                                 \
+        const GfInterval& timeInterval,                                 \
+        const double timeScale,                                         \
+        const double valueScale,                                        \
+        const double tolerance,                                         \
+        const TsBezierFlattening flattening,                            \
+        TsExecutor* const executor,                                     \
+        sampleData< TS_SPLINE_VALUE_CPP_TYPE(tuple) >* splineSamples);
+
+TF_PP_SEQ_FOR_EACH(_INSTANTIATE_SAMPLE_METHOD,
+                   TsSplineSamples,
+                   TS_SPLINE_SAMPLE_VERTEX_TYPES)
+TF_PP_SEQ_FOR_EACH(_INSTANTIATE_SAMPLE_METHOD,
+                   TsSplineSamplesWithSources,
+                   TS_SPLINE_SAMPLE_VERTEX_TYPES)
+TF_PP_SEQ_FOR_EACH(_INSTANTIATE_SAMPLE_METHOD,
+                   TsSplineFlatSamples,
+                   TS_SPLINE_SAMPLE_VERTEX_TYPES)
+
+#undef _INSTANTIATE_SAMPLE_METHOD
+
+
+}  // namespace pxr
@@ -0,0 +1,173 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#ifndef PXR_TS_SAMPLER_H
+#define PXR_TS_SAMPLER_H
+
+#include "./api.h"
+#include "./spline.h"
+#include "./sample.h"
+#include "./types.h"
+#include <pxr/gf/interval.h>
+
+namespace pxr {
+
+class TsExecutor;
+
+
+/// Samples splines repeatedly, keeping working storage from one call to the
+/// next.
+///
+/// TsSpline::Sample sets up on every call: it works out the spline's looping
+/// and extrapolation, and copies the knots it needs into temporary buffers
+/// when they aren't double-valued, or when inner loops must be unrolled.  A
+/// sampler keeps that setup and those buffers.  When it samples the same
+/// spline again with a different interval, scale, tolerance, or flattening,
+/// as when a graph editor pans or zooms, it reuses the copied knots as long
+/// as they cover the new interval.  When it samples a different spline, the
+/// buffers keep their capacity.  Results are identical to those of
+/// TsSpline::Sample with the same arguments.
+///
+/// To keep output storage as well, pass the same TsSplineFlatSamples to each
+/// call; its arrays are cleared but keep their capacity.
+///
+/// A sampler holds a copy of the spline it samples, which shares its data.
+/// Because splines are copy-on-write, edits to the original spline, including
+/// edits on other threads, cause the original to duplicate its data, and don't
+/// affect the sampler.  To pick up edits, call SetSpline again.  SetSpline
+/// does nothing when given a spline that still shares the sampler's data, so
+/// it is cheap to call before every redraw.
+///
+/// Sampling modifies a sampler's state, so a sampler must not be used by more
+/// than one thread at a time.  Give each thread its own; for example, a graph
+/// editor may keep one per drawing thread, and sample all its curves with it.
+///
+class TsSampler
+{
+public:
+    /// Creates a sampler with an empty spline.
+    TS_API
+    TsSampler();
+
+    TS_API
+    explicit TsSampler(
+        const TsSpline &spline);
+
+    TS_API
+    ~TsSampler();
+
+    // The sampler refers into its own buffers, so it isn't copyable.
+    TsSampler(const TsSampler&) = delete;
+    TsSampler& operator=(const TsSampler&) = delete;
+
+    /// Sets the spline to be sampled by later calls.
+    TS_API
+    void SetSpline(
+        const TsSpline &spline);
+
+    /// Returns the spline being sampled.
+    const TsSpline& GetSpline() const { return _spline; }
+
+    /// \name Sampling
+    /// @{
+    ///
+    /// These are equivalent to the TsSpline methods of the same names, with
+    /// the same requirements on their arguments.  As there, sampling is
+    /// serial unless an \e executor is given.
+
+    template <typename Vertex>
+    bool Sample(
+        const GfInterval& timeInterval,
+        double timeScale,
+        double valueScale,
+        double tolerance,
+        TsSplineSamples<Vertex>* splineSamples,
+        TsBezierFlattening flattening = TsBezierFlatteningSubdivide,
+        TsExecutor *executor = nullptr)
+    {
+        return _Sample(timeInterval, timeScale, valueScale, tolerance,
+                       flattening, executor, splineSamples);
+    }
+
+    template <typename Vertex>
+    bool Sample(
+        const GfInterval& timeInterval,
+        double timeScale,
+        double valueScale,
+        double tolerance,
+        TsSplineSamplesWithSources<Vertex>* splineSamples,
+        TsBezierFlattening flattening = TsBezierFlatteningSubdivide,
+        TsExecutor *executor = nullptr)
+    {
+        return _Sample(timeInterval, timeScale, valueScale, tolerance,
+                       flattening, executor, splineSamples);
+    }
+
+    template <typename Vertex>
+    bool Sample(
+        const GfInterval& timeInterval,
+        double timeScale,
+        double valueScale,
+        double tolerance,
+        TsSplineFlatSamples<Vertex>* splineSamples,
+        TsBezierFlattening flattening = TsBezierFlatteningSubdivide,
+        TsExecutor *executor = nullptr)
+    {
+        return _Sample(timeInterval, timeScale, valueScale, tolerance,
+                       flattening, executor, splineSamples);
+    }
+
+    template <typename Visitor>
+    bool SampleToVisitor(
+        const GfInterval& timeInterval,
+        double timeScale,
+        double valueScale,
+        double tolerance,
+        Visitor* visitor,
+        TsBezierFlattening flattening = TsBezierFlatteningSubdivide,
+        TsExecutor *executor = nullptr)
+    {
+        Ts_SampleVisitorSink sink(visitor);
+        return _SampleToSink(timeInterval, timeScale, valueScale, tolerance,
+                             flattening, executor, &sink);
+    }
+
+    /// @}
+
+private:
+    template <typename SampleHolder>
+    bool _Sample(
+        const GfInterval& timeInterval,
+        double timeScale,
+        double valueScale,
+        double tolerance,
+        TsBezierFlattening flattening,
+        TsExecutor *executor,
+        SampleHolder* splineSamples);
+
+    TS_API
+    bool _SampleToSink(
+        const GfInterval& timeInterval,
+        double timeScale,
+        double valueScale,
+        double tolerance,
+        TsBezierFlattening flattening,
+        TsExecutor *executor,
+        Ts_SampleVisitorSink* sink);
+
+private:
+    // Our copy of the spline, which keeps the data alive and unchanged.
+    TsSpline _spline;
+
+    // Setup and buffers, for the spline's data if it has knots.
+    Ts_Sampler _sampler;
+};
+
+
+}  // namespace pxr
+
+#endif
@@ -10,6 +10,7 @@
 #include "./raii.h"
 #include "./regressionPreventer.h"
 #include "./sample.h"
+#include "./splineSummary.h"
 
 #include <pxr/tf/stringUtils.h>
 #include <pxr/tf/diagnostic.h>
@@ -18,6 +19,7 @@
 #include <pxr/tf/registryManager.h>
 
 #include <algorithm>
+#include <cmath>
 #include <iterator>
 #include <sstream>
 #include <iostream>
@@ -192,10 +194,11 @@ void TsSpline::SetKnots(const TsKnotMap &knots)
     // Remove existing knots.
     _data->ClearKnots();
 
-    // Copy knot data.
+    // Copy knot data, then summarize all of the knots at once.
     _data->ReserveForKnotCount(knots.size());
     for (const TsKnot &knot : knots)
         _data->PushKnot(knot._GetData(), knot.GetCustomData());
+    _data->summary.Rebuild(_data.get());
 
     // De-regress.
     if (TsEditBehaviorBlock::GetStack().empty())
@@ -271,6 +274,11 @@ bool TsSpline::SetKnot(
             Ts_RegressionPreventerBatchAccess::ProcessSegment(
                 startKnot, endKnot, GetAntiRegressionAuthoringMode());
         }
+
+        // Tangents may have changed on either side of the knot, which affects
+        // the summaries of the knots one further out.
+        _data->summary.KnotsChanged(
+            _data.get(), (first > 0 ? first - 1 : 0), last + 1);
     }
 
     return true;
@@ -335,6 +343,154 @@ void TsSpline::RemoveKnot(
 ////////////////////////////////////////////////////////////////////////////////
 // Evaluation
 
+void TsSpline::Compile() const
+{
+    // Build the compiled data on the shared spline data, which is logically
+    // const; this is a cache, not a modification.
+    const Ts_SplineData* const data = _GetData();
+    data->compiled.GetOrBuild(
+        [data]() { return new Ts_CompiledSpline(data); });
+}
+
+bool TsSpline::IsCompiled() const
+{
+    return _GetData()->compiled.Get() != nullptr;
+}
+
+bool TsSpline::FindTimesForValue(
+    const double value,
+    const GfInterval &interval,
+    std::vector<TsTime>* const timesOut,
+    const TsEvalOptions &options) const
+{
+    std::vector<std::vector<TsTime>> times;
+    if (!FindTimesForValues(
+            TfSpan<const double>(&value, 1), interval, &times, options))
+    {
+        return false;
+    }
+
+    *timesOut = std::move(times[0]);
+    return true;
+}
+
+bool TsSpline::FindTimesForValues(
+    const TfSpan<const double> values,
+    const GfInterval &interval,
+    std::vector<std::vector<TsTime>>* const timesOut,
+    const TsEvalOptions &options) const
+{
+    return Ts_FindTimesForValues(
+        _GetData(), values, interval, options, timesOut);
+}
+
+bool TsSpline::Integrate(
+    const GfInterval &timeSpan,
+    double* const integralOut) const
+{
+    if (timeSpan.IsEmpty())
+    {
+        return false;
+    }
+
+    const TsTime boundaries[2] = {timeSpan.GetMin(), timeSpan.GetMax()};
+    double covered = 0;
+    return Ts_Integrate(
+        _GetData(), TfSpan<const TsTime>(boundaries, 2),
+        TfSpan<double>(integralOut, 1),
+        TfSpan<double>(&covered, 1));
+}
+
+bool TsSpline::Average(
+    const GfInterval &timeSpan,
+    double* const averageOut) const
+{
+    if (timeSpan.IsEmpty())
+    {
+        return false;
+    }
+
+    const TsTime boundaries[2] = {timeSpan.GetMin(), timeSpan.GetMax()};
+    return AverageMany(
+        TfSpan<const TsTime>(boundaries, 2), TfSpan<double>(averageOut, 1));
+}
+
+bool TsSpline::IntegrateMany(
+    const TfSpan<const TsTime> boundaries,
+    const TfSpan<double> integralsOut) const
+{
+    std::vector<double> covered(integralsOut.size());
+    return Ts_Integrate(_GetData(), boundaries, integralsOut, covered);
+}
+
+bool TsSpline::AverageMany(
+    const TfSpan<const TsTime> boundaries,
+    const TfSpan<double> averagesOut) const
+{
+    std::vector<double> integrals(averagesOut.size());
+    std::vector<double> covered(averagesOut.size());
+    if (!Ts_Integrate(_GetData(), boundaries, integrals, covered))
+    {
+        return false;
+    }
+
+    bool allValues = true;
+    for (size_t i = 0; i < averagesOut.size(); i++)
+    {
+        if (covered[i] > 0)
+        {
+            averagesOut[i] = integrals[i] / covered[i];
+        }
+        else if (boundaries[i] == boundaries[i + 1])
+        {
+            // A single time.  Its value, if any.
+            if (const std::optional<double> value = Ts_Eval(
+                    _GetData(), boundaries[i], Ts_EvalValue, Ts_EvalAtTime,
+                    TsEvalOptions()))
+            {
+                averagesOut[i] = *value;
+            }
+            else
+            {
+                allValues = false;
+            }
+        }
+        else
+        {
+            allValues = false;
+        }
+    }
+    return allValues;
+}
+
+bool TsSpline::GetValueRange(
+    const GfInterval &timeSpan,
+    std::pair<VtValue, VtValue>* const rangeOut) const
+{
+    double min = 0, max = 0;
+    if (!Ts_GetValueRange(_GetData(), timeSpan, &min, &max))
+    {
+        return false;
+    }
+
+#define _ASSIGN_TYPE(unused, tuple)                                       \
+    if (GetValueType() == Ts_GetType<TS_SPLINE_VALUE_CPP_TYPE(tuple)>())  \
+    {                                                                     \
+        *rangeOut = std::make_pair(                                       \
+            VtValue(TS_SPLINE_VALUE_CPP_TYPE(tuple)(min)),                \
+            VtValue(TS_SPLINE_VALUE_CPP_TYPE(tuple)(max)));               \
+        return true;                                                      \
+    }
+
+    TF_PP_SEQ_FOR_EACH(_ASSIGN_TYPE, ~, TS_SPLINE_SUPPORTED_VALUE_TYPES);
+
+    TF_CODING_ERROR("Unsupported spline value type");
+
+#undef _ASSIGN_TYPE
+
+    return false;
+}
+
 bool TsSpline::DoSidesDiffer(
     const TsTime time) const
 {
@@ -351,10 +507,11 @@ bool TsSpline::_Eval(
     const TsTime time,
     VtValue* const valueOut,
     const Ts_EvalAspect aspect,
-    const Ts_EvalLocation location) const
+    const Ts_EvalLocation location,
+    const TsEvalOptions &options) const
 {
     const std::optional<double> result =
-        Ts_Eval(_GetData(), time, aspect, location);
+        Ts_Eval(_GetData(), time, aspect, location, options);
 
     if (!result)
     {
@@ -384,6 +541,8 @@ TsSpline::_Sample(
     const double timeScale,
     const double valueScale,
     const double tolerance,
+    const TsBezierFlattening flattening,
+    TsExecutor* const executor,
     SampleHolder* splineSamples) const
 {
     if (timeInterval.IsEmpty() ||
@@ -404,16 +563,49 @@ TsSpline::_Sample(
     sampleData.Clear();
 
     // Do not bother to sample empty data.
-    if (_data || !_data->times.empty()) {
+    if (_data && !_data->times.empty()) {
 
-        Ts_Sample(_data.get(), timeInterval,
-                  timeScale, valueScale, tolerance,
+        Ts_Sampler sampler(_data.get());
+        Ts_Sample(&sampler, timeInterval,
+                  timeScale, valueScale, tolerance, flattening, executor,
                   &sampleData);
     }
     return true;
 }
 
-// Instantiate Sample for both spline samples classes and for
+bool
+TsSpline::_SampleToSink(
+    const GfInterval& timeInterval,
+    const double timeScale,
+    const double valueScale,
+    const double tolerance,
+    const TsBezierFlattening flattening,
+    TsExecutor* const executor,
+    Ts_SampleVisitorSink* const sink) const
+{
+    if (timeInterval.IsEmpty() ||
+        timeScale <= 0.0 ||
+        valueScale <= 0.0 ||
+        tolerance <= 0.0)
+    {
+        TF_CODING_ERROR(
+            "The time interval must not be empty and the values of timeScale,"
+            " valueScale, and tolerance must all be greater than 0 when"
+            " sampling a spline.");
+        return false;
+    }
+
+    // Do not bother to sample empty data.
+    if (_data && !_data->times.empty()) {
+        Ts_Sampler sampler(_data.get());
+        Ts_Sample(&sampler, timeInterval,
+                  timeScale, valueScale, tolerance, flattening, executor,
+                  sink);
+    }
+    return true;
+}
+
+// Instantiate Sample for each spline samples class and for
 // each supported sample data type.
 #define _INSTANTIATE_SAMPLE_METHOD(sampleData, tuple)                   \
     template                                                            \
@@ -424,6 +616,8 @@ TsSpline::_Sample(
         const double timeScale,                                         \
         const double valueScale,                                        \
         const double tolerance,                                         \
+        const TsBezierFlattening flattening,                            \
+        TsExecutor* const executor,                                     \
         sampleData< TS_SPLINE_VALUE_CPP_TYPE(tuple) >* splineSamples) const;
 
 TF_PP_SEQ_FOR_EACH(_INSTANTIATE_SAMPLE_METHOD,
@@ -432,6 +626,9 @@ TF_PP_SEQ_FOR_EACH(_INSTANTIATE_SAMPLE_METHOD,
 TF_PP_SEQ_FOR_EACH(_INSTANTIATE_SAMPLE_METHOD,
                    TsSplineSamplesWithSources,
                    TS_SPLINE_SAMPLE_VERTEX_TYPES)
+TF_PP_SEQ_FOR_EACH(_INSTANTIATE_SAMPLE_METHOD,
+                   TsSplineFlatSamples,
+                   TS_SPLINE_SAMPLE_VERTEX_TYPES)
 
 #undef _INSTANTIATE_SAMPLE_METHOD
 
@@ -449,6 +646,11 @@ bool TsSpline::HasValueBlocks() const
     return _GetData()->HasValueBlocks();
 }
 
+bool TsSpline::IsVarying() const
+{
+    return Ts_IsVarying(_GetData());
+}
+
 bool TsSpline::HasLoops() const
 {
     return HasInnerLoops() || HasExtrapolatingLoops();
@@ -466,6 +668,26 @@ bool TsSpline::HasExtrapolatingLoops() const
         || _GetData()->postExtrapolation.IsLooping());
 }
 
+bool TsSpline::IsLinear() const
+{
+    return Ts_IsLinear(_GetData());
+}
+
+bool TsSpline::IsC0Continuous() const
+{
+    return Ts_IsContinuous(_GetData(), Ts_SummaryKnotC0Break);
+}
+
+bool TsSpline::IsG1Continuous() const
+{
+    return Ts_IsContinuous(_GetData(), Ts_SummaryKnotG1Break);
+}
+
+bool TsSpline::IsC1Continuous() const
+{
+    return Ts_IsContinuous(_GetData(), Ts_SummaryKnotC1Break);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Within-Spline Queries
 
@@ -474,6 +696,30 @@ bool TsSpline::HasValueBlockAtTime(const TsTime time) const
     return _GetData()->HasValueBlockAtTime(time);
 }
 
+bool TsSpline::IsSegmentFlat(const TsTime startTime) const
+{
+    uint16_t flags = 0;
+    if (!Ts_GetSegmentSummary(_GetData(), startTime, &flags))
+    {
+        TF_CODING_ERROR("No segment starts at time %g", startTime);
+        return false;
+    }
+
+    return !(flags & (Ts_SummarySegmentBlocked | Ts_SummarySegmentVarying));
+}
+
+bool TsSpline::IsSegmentMonotonic(const TsTime startTime) const
+{
+    uint16_t flags = 0;
+    if (!Ts_GetSegmentSummary(_GetData(), startTime, &flags))
+    {
+        TF_CODING_ERROR("No segment starts at time %g", startTime);
+        return false;
+    }
+
+    return flags & Ts_SummarySegmentMonotonic;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Human-readable dump
 
@@ -545,6 +791,40 @@ const Ts_SplineData* TsSpline::_GetData() const
     return (_data ? _data.get() : defaultData);
 }
 
+bool TsSpline::_GetUniformSampleCount(
+    const GfInterval &interval,
+    const TsTime step,
+    size_t* const countOut)
+{
+    if (!interval.IsFinite() || interval.GetMin() > interval.GetMax())
+    {
+        TF_CODING_ERROR("Uniform sampling requires a bounded interval");
+        return false;
+    }
+    if (!std::isfinite(step) || !(step > 0))
+    {
+        TF_CODING_ERROR("Invalid uniform sampling step %g", step);
+        return false;
+    }
+
+    // Correct the estimate against the sample times themselves, so that the
+    // maximum is included despite rounding in the division.
+    const TsTime start = interval.GetMin();
+    const TsTime end = interval.GetMax();
+    size_t count = size_t(std::floor((end - start) / step)) + 1;
+    while (count > 1 && start + (count - 1) * step > end)
+    {
+        count--;
+    }
+    while (start + count * step <= end)
+    {
+        count++;
+    }
+
+    *countOut = count;
+    return true;
+}
+
 void TsSpline::_PrepareForWrite(TfType valueType)
 {
     // If we had default state, create storage now.  If no value type was
@@ -580,6 +860,12 @@ void TsSpline::_PrepareForWrite(TfType valueType)
     {
         _data.reset(_data->Clone());
     }
+
+    // Anything derived from the current contents is about to become stale.
+    if (_data)
+    {
+        _data->ClearCaches();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -698,6 +984,14 @@ bool TsSpline::AdjustRegressiveTangents()
         }
     }
 
+    // If we weren't sharing data, we modified it without calling
+    // _PrepareForWrite, so discard derived data here.
+    if (splineChanged)
+    {
+        _data->ClearCaches();
+        _data->summary.Rebuild(_data.get());
+    }
+
     return splineChanged;
 }
 
@@ -15,10 +15,14 @@
 #include "./types.h"
 #include "./typeHelpers.h"
 #include "./eval.h"
+#include "./sample.h"
 #include <pxr/vt/value.h>
+#include <pxr/vt/array.h>
 #include <pxr/gf/interval.h>
+#include <pxr/tf/span.h>
 #include <pxr/tf/type.h>
 
+#include <algorithm>
 #include <string>
 #include <memory>
 #include <iosfwd>
@@ -26,6 +30,7 @@
 namespace pxr {
 
 class VtDictionary;
+class TsExecutor;
 
 
 /// A mathematical description of a curved function from time to value.
@@ -315,6 +320,381 @@ public:
         TsTime time,
         T *valueOut) const;
 
+    /// Evaluates the spline at each of \p times, writing the results to the
+    /// corresponding elements of \p valuesOut, which must be the same size as
+    /// \p times.  Elements for which there is no value (because the spline is
+    /// empty, or because of value blocks) are left unmodified.  Returns true if
+    /// every time produced a value.
+    ///
+    /// The result is the same as calling Eval for each time, but setup work is
+    /// done only once, and knot lookups carry over from one time to the next.
+    /// Times may be in any order, but ascending order is fastest.
+    ///
+    /// If the spline has been compiled (see Compile), samples in Bezier
+    /// segments are evaluated several at a time with a vectorizable iterative
+    /// solver.  Results then agree with Eval up to rounding, except near
+    /// vertical tangents, where they can differ slightly more.
+    ///
+    /// In all of the batch methods, the T parameter may be any of the spline
+    /// value types (double/float/GfHalf); it need not match the value type of
+    /// the spline.
+    template <typename T>
+    bool EvalMany(
+        TfSpan<const TsTime> times,
+        TfSpan<T> valuesOut) const;
+
+    /// \overload
+    /// Resizes \p valuesOut to the number of times before evaluating.
+    template <typename T>
+    bool EvalMany(
+        TfSpan<const TsTime> times,
+        VtArray<T> *valuesOut) const;
+
+    /// Batch form of EvalPreValue.  See EvalMany.
+    template <typename T>
+    bool EvalPreValueMany(
+        TfSpan<const TsTime> times,
+        TfSpan<T> valuesOut) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalPreValueMany(
+        TfSpan<const TsTime> times,
+        VtArray<T> *valuesOut) const;
+
+    /// Batch form of EvalDerivative.  See EvalMany.
+    template <typename T>
+    bool EvalDerivativeMany(
+        TfSpan<const TsTime> times,
+        TfSpan<T> valuesOut) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalDerivativeMany(
+        TfSpan<const TsTime> times,
+        VtArray<T> *valuesOut) const;
+
+    /// Batch form of EvalPreDerivative.  See EvalMany.
+    template <typename T>
+    bool EvalPreDerivativeMany(
+        TfSpan<const TsTime> times,
+        TfSpan<T> valuesOut) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalPreDerivativeMany(
+        TfSpan<const TsTime> times,
+        VtArray<T> *valuesOut) const;
+
+    /// Batch form of EvalHeld.  See EvalMany.
+    template <typename T>
+    bool EvalHeldMany(
+        TfSpan<const TsTime> times,
+        TfSpan<T> valuesOut) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalHeldMany(
+        TfSpan<const TsTime> times,
+        VtArray<T> *valuesOut) const;
+
+    /// Batch form of EvalPreValueHeld.  See EvalMany.
+    template <typename T>
+    bool EvalPreValueHeldMany(
+        TfSpan<const TsTime> times,
+        TfSpan<T> valuesOut) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalPreValueHeldMany(
+        TfSpan<const TsTime> times,
+        VtArray<T> *valuesOut) const;
+
+    /// Each of the evaluation methods above has an overload that takes options
+    /// controlling how the spline is evaluated, such as which method is used to
+    /// solve Bezier segments.  See TsEvalOptions.  The overloads without
+    /// options use default options.
+    template <typename T>
+    bool Eval(
+        TsTime time,
+        T *valueOut,
+        const TsEvalOptions &options) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalPreValue(
+        TsTime time,
+        T *valueOut,
+        const TsEvalOptions &options) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalDerivative(
+        TsTime time,
+        T *valueOut,
+        const TsEvalOptions &options) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalPreDerivative(
+        TsTime time,
+        T *valueOut,
+        const TsEvalOptions &options) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalHeld(
+        TsTime time,
+        T *valueOut,
+        const TsEvalOptions &options) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalPreValueHeld(
+        TsTime time,
+        T *valueOut,
+        const TsEvalOptions &options) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalMany(
+        TfSpan<const TsTime> times,
+        TfSpan<T> valuesOut,
+        const TsEvalOptions &options) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalMany(
+        TfSpan<const TsTime> times,
+        VtArray<T> *valuesOut,
+        const TsEvalOptions &options) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalPreValueMany(
+        TfSpan<const TsTime> times,
+        TfSpan<T> valuesOut,
+        const TsEvalOptions &options) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalPreValueMany(
+        TfSpan<const TsTime> times,
+        VtArray<T> *valuesOut,
+        const TsEvalOptions &options) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalDerivativeMany(
+        TfSpan<const TsTime> times,
+        TfSpan<T> valuesOut,
+        const TsEvalOptions &options) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalDerivativeMany(
+        TfSpan<const TsTime> times,
+        VtArray<T> *valuesOut,
+        const TsEvalOptions &options) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalPreDerivativeMany(
+        TfSpan<const TsTime> times,
+        TfSpan<T> valuesOut,
+        const TsEvalOptions &options) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalPreDerivativeMany(
+        TfSpan<const TsTime> times,
+        VtArray<T> *valuesOut,
+        const TsEvalOptions &options) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalHeldMany(
+        TfSpan<const TsTime> times,
+        TfSpan<T> valuesOut,
+        const TsEvalOptions &options) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalHeldMany(
+        TfSpan<const TsTime> times,
+        VtArray<T> *valuesOut,
+        const TsEvalOptions &options) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalPreValueHeldMany(
+        TfSpan<const TsTime> times,
+        TfSpan<T> valuesOut,
+        const TsEvalOptions &options) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalPreValueHeldMany(
+        TfSpan<const TsTime> times,
+        VtArray<T> *valuesOut,
+        const TsEvalOptions &options) const;
+
+    /// Evaluates the value and derivative at \p time, and optionally the
+    /// second derivative.  The value and derivative are the same as those of
+    /// Eval and EvalDerivative, but the knot search, loop resolution, tangent
+    /// de-regression, and Bezier solve are done only once, which is faster than
+    /// calling both.  At a knot, the second derivative is that of the segment
+    /// on the evaluated side, or zero if that segment isn't curved.  Returns
+    /// false, leaving all outputs unmodified, if there is no value or no
+    /// derivative.
+    ///
+    /// The T parameter may be any of the spline value types
+    /// (double/float/GfHalf).
+    template <typename T>
+    bool EvalWithDerivatives(
+        TsTime time,
+        T *valueOut,
+        T *derivativeOut,
+        T *secondDerivativeOut = nullptr) const;
+
+    /// Like EvalWithDerivatives, but evaluates the pre-side value and
+    /// derivative, as EvalPreValue and EvalPreDerivative do.
+    template <typename T>
+    bool EvalPreWithDerivatives(
+        TsTime time,
+        T *valueOut,
+        T *derivativeOut,
+        T *secondDerivativeOut = nullptr) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalWithDerivatives(
+        TsTime time,
+        T *valueOut,
+        T *derivativeOut,
+        T *secondDerivativeOut,
+        const TsEvalOptions &options) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalPreWithDerivatives(
+        TsTime time,
+        T *valueOut,
+        T *derivativeOut,
+        T *secondDerivativeOut,
+        const TsEvalOptions &options) const;
+
+    /// Batch form of EvalWithDerivatives, with the same conventions as
+    /// EvalMany.  All spans must be the same size as \p times, except that \p
+    /// secondDerivativesOut may be empty, in which case second derivatives
+    /// aren't computed.  Unlike EvalMany, Bezier samples are solved one at a
+    /// time, with the solver selected by the options.
+    template <typename T>
+    bool EvalWithDerivativesMany(
+        TfSpan<const TsTime> times,
+        TfSpan<T> valuesOut,
+        TfSpan<T> derivativesOut,
+        TfSpan<T> secondDerivativesOut = TfSpan<T>()) const;
+
+    /// Batch form of EvalPreWithDerivatives.  See EvalWithDerivativesMany.
+    template <typename T>
+    bool EvalPreWithDerivativesMany(
+        TfSpan<const TsTime> times,
+        TfSpan<T> valuesOut,
+        TfSpan<T> derivativesOut,
+        TfSpan<T> secondDerivativesOut = TfSpan<T>()) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalWithDerivativesMany(
+        TfSpan<const TsTime> times,
+        TfSpan<T> valuesOut,
+        TfSpan<T> derivativesOut,
+        TfSpan<T> secondDerivativesOut,
+        const TsEvalOptions &options) const;
+
+    /// \overload
+    template <typename T>
+    bool EvalPreWithDerivativesMany(
+        TfSpan<const TsTime> times,
+        TfSpan<T> valuesOut,
+        TfSpan<T> derivativesOut,
+        TfSpan<T> secondDerivativesOut,
+        const TsEvalOptions &options) const;
+
+    /// Evaluates this spline at the subframe sample times of \p shutter
+    /// around each of \p frames, as for motion blur.  \p valuesOut receives
+    /// one row of \c shutter.numSamples values for each frame, in order, and
+    /// must have \c frames.size() * \c shutter.numSamples elements.  Other
+    /// conventions are as for EvalMany.  An invalid shutter (see
+    /// TsShutter::IsValid) is a coding error, and returns false.
+    ///
+    /// Shutter windows usually lie within a single segment.  For those, the
+    /// segment is found once per frame, and compiled on the fly if this spline
+    /// hasn't been compiled, and Bezier solves for successive samples start
+    /// from the previous sample's solution.  Results agree with EvalMany up to
+    /// rounding.
+    template <typename T>
+    bool EvalShutter(
+        TfSpan<const TsTime> frames,
+        const TsShutter &shutter,
+        TfSpan<T> valuesOut,
+        const TsEvalOptions &options = TsEvalOptions()) const;
+
+    /// \overload
+    /// Resizes \p valuesOut to the number of samples before evaluating.
+    template <typename T>
+    bool EvalShutter(
+        TfSpan<const TsTime> frames,
+        const TsShutter &shutter,
+        VtArray<T> *valuesOut,
+        const TsEvalOptions &options = TsEvalOptions()) const;
+
+    /// Evaluates this spline at \p start + \e i * \p step for each element of
+    /// \p valuesOut, as when baking at a fixed frame rate.  \p step must be
+    /// positive; otherwise this is a coding error, and returns false.  Other
+    /// conventions are as for EvalMany.
+    ///
+    /// Samples are evaluated in runs, one per segment.  Each segment is found
+    /// once, and compiled on the fly if this spline hasn't been compiled.
+    /// Hermite segments are evaluated by forward differencing, and Bezier
+    /// solves start from the previous sample's solution.  Results agree with
+    /// EvalMany up to rounding.
+    template <typename T>
+    bool SampleUniform(
+        TsTime start,
+        TsTime step,
+        TfSpan<T> valuesOut,
+        const TsEvalOptions &options = TsEvalOptions()) const;
+
+    /// \overload
+    /// Samples from the minimum of \p interval through its maximum, inclusive,
+    /// regardless of whether the interval is open or closed.  Resizes \p
+    /// valuesOut to the number of samples.  An unbounded or empty interval is
+    /// a coding error, and returns false.
+    template <typename T>
+    bool SampleUniform(
+        const GfInterval &interval,
+        TsTime step,
+        VtArray<T> *valuesOut,
+        const TsEvalOptions &options = TsEvalOptions()) const;
+
+    /// Precomputes evaluation data for each segment of this spline: tangents
+    /// are de-regressed, and Bezier curves are converted to polynomial
+    /// coefficients.  Subsequent evaluation of this spline, and of any copies
+    /// that share its data, uses the precomputed data, which is faster when
+    /// evaluating many times.  Results are the same as without compilation, up
+    /// to floating-point rounding.
+    ///
+    /// Compiled data is discarded by any edit.  This method may be called
+    /// concurrently with evaluation and with other calls to Compile.
+    TS_API
+    void Compile() const;
+
+    /// Returns whether this spline has compiled evaluation data.  See Compile.
+    TS_API
+    bool IsCompiled() const;
+
     TS_API
     bool DoSidesDiffer(
         TsTime time) const;
@@ -335,6 +715,14 @@ public:
     /// \c tolerance must all be greater than 0.0. If any of these conditions
     /// are not met, \c Sample returns false and \c *splineSamples is unchanged.
     /// Otherwise, true is returned and \c splineSamples is populated.
+    ///
+    /// \e flattening selects how Bezier segments are approximated; see
+    /// \c TsBezierFlattening.  Other segments are the same either way.
+    ///
+    /// If \e executor is given, long splines are sampled in parallel using
+    /// it; pass &TsGetDefaultExecutor() to use the shared thread pool.  The
+    /// results are identical to those of serial sampling.  If \e executor is
+    /// null, sampling runs on the calling thread only.
     template <typename Vertex>
     bool
     Sample(
@@ -342,10 +730,12 @@ public:
         double timeScale,
         double valueScale,
         double tolerance,
-        TsSplineSamples<Vertex>* splineSamples) const
+        TsSplineSamples<Vertex>* splineSamples,
+        TsBezierFlattening flattening = TsBezierFlatteningSubdivide,
+        TsExecutor *executor = nullptr) const
     {
         return _Sample(timeInterval, timeScale, valueScale, tolerance,
-                       splineSamples);
+                       flattening, executor, splineSamples);
     }
 
     /// \overload
@@ -361,12 +751,156 @@ public:
         double timeScale,
         double valueScale,
         double tolerance,
-        TsSplineSamplesWithSources<Vertex>* splineSamples) const
+        TsSplineSamplesWithSources<Vertex>* splineSamples,
+        TsBezierFlattening flattening = TsBezierFlatteningSubdivide,
+        TsExecutor *executor = nullptr) const
+    {
+        return _Sample(timeInterval, timeScale, valueScale, tolerance,
+                       flattening, executor, splineSamples);
+    }
+
+    /// \overload
+    /// When passed a \c TsSplineFlatSamples<Vertex> class, the polylines are
+    /// returned in contiguous storage, with sources if its \c withSources is
+    /// set.  Its arrays are cleared but keep their capacity, and the vertex
+    /// array is reserved from an estimate of the number of vertices.
+    template <typename Vertex>
+    bool
+    Sample(
+        const GfInterval& timeInterval,
+        double timeScale,
+        double valueScale,
+        double tolerance,
+        TsSplineFlatSamples<Vertex>* splineSamples,
+        TsBezierFlattening flattening = TsBezierFlatteningSubdivide,
+        TsExecutor *executor = nullptr) const
     {
         return _Sample(timeInterval, timeScale, valueScale, tolerance,
-                       splineSamples);
+                       flattening, executor, splineSamples);
     }
 
+    /// \overload
+    /// Streams the polylines to \p visitor as they are generated, instead of
+    /// building a \c TsSplineSamples, so that callers can fill their own
+    /// buffers directly.  The visitor must have these members:
+    ///
+    /// \code
+    /// // Start a new polyline, generated from the given source region.
+    /// void BeginPolyline(TsSplineSampleSource source);
+    ///
+    /// // Add a vertex to the current polyline.
+    /// void AddVertex(double time, double value);
+    /// \endcode
+    ///
+    /// Polylines are broken in the same places as by \c
+    /// TsSplineSamplesWithSources<GfVec2d>, and have the same vertices.  The
+    /// visitor is always called on the calling thread, in time order, even
+    /// when sampling in parallel.  On invalid arguments, returns false without
+    /// calling the visitor.
+    template <typename Visitor>
+    bool
+    SampleToVisitor(
+        const GfInterval& timeInterval,
+        double timeScale,
+        double valueScale,
+        double tolerance,
+        Visitor* visitor,
+        TsBezierFlattening flattening = TsBezierFlatteningSubdivide,
+        TsExecutor *executor = nullptr) const
+    {
+        Ts_SampleVisitorSink sink(visitor);
+        return _SampleToSink(timeInterval, timeScale, valueScale, tolerance,
+                             flattening, executor, &sink);
+    }
+
+    /// @}
+    /// \name Inverse evaluation
+    /// @{
+
+    /// Finds the times within \p interval at which this spline has \p value,
+    /// in ascending order.  This is the inverse of evaluation, as needed for
+    /// time-valued splines that retime other animation.  Each returned time
+    /// evaluates to \p value, up to the precision of the curve solver.  Where
+    /// the spline holds \p value over a span of time, only the start of the
+    /// span, or the start of \p interval, is returned; a span of held
+    /// pre-extrapolation in an interval with no lower bound is reported by the
+    /// first knot.  At discontinuities,
+    /// times are found on the side that Eval reports.
+    ///
+    /// Fails if \p interval is empty, or if it is unbounded on a side where
+    /// extrapolation loops, which could reach \p value infinitely many times.
+    /// Also fails if \p interval spans so many iterations of extrapolating
+    /// loops that \p value could be reached in more than about a million of
+    /// them.
+    /// Splines with no knots have no times.  Curves are always solved
+    /// iteratively; \c options selects Newton's or Halley's method, and the
+    /// Cardano solver is replaced by Newton's method.
+    TS_API
+    bool FindTimesForValue(
+        double value,
+        const GfInterval &interval,
+        std::vector<TsTime> *timesOut,
+        const TsEvalOptions &options = TsEvalOptions()) const;
+
+    /// Batch form of FindTimesForValue.  Analysis of the spline is shared
+    /// among all of the values.  On success, \p timesOut has one vector of
+    /// times for each value.
+    TS_API
+    bool FindTimesForValues(
+        TfSpan<const double> values,
+        const GfInterval &interval,
+        std::vector<std::vector<TsTime>> *timesOut,
+        const TsEvalOptions &options = TsEvalOptions()) const;
+
+    /// @}
+    /// \name Integration
+    /// @{
+
+    /// Integrates the value of this spline over \p timeSpan, which must be
+    /// bounded; otherwise this is a coding error.  Whether the ends of \p
+    /// timeSpan are closed makes no difference.  Value blocks contribute
+    /// nothing.  Returns false if \p timeSpan is empty, or if the spline has
+    /// no knots.
+    ///
+    /// The integral is exact, up to floating-point rounding, for every
+    /// interpolation mode and curve type, and for all extrapolation.
+    /// Integrals of segments are found analytically and cached on first use,
+    /// after which each query takes logarithmic time in the number of knots,
+    /// regardless of how many loop iterations \p timeSpan covers.
+    TS_API
+    bool Integrate(
+        const GfInterval &timeSpan,
+        double *integralOut) const;
+
+    /// Finds the average value of this spline over \p timeSpan: the integral,
+    /// divided by the length of time within \p timeSpan at which the spline
+    /// has a value.  If \p timeSpan is a single time, the result is the value
+    /// there.  Returns false if the spline has no values in \p timeSpan, or
+    /// if \p timeSpan is empty; unbounded \p timeSpan is a coding error.
+    TS_API
+    bool Average(
+        const GfInterval &timeSpan,
+        double *averageOut) const;
+
+    /// Batch form of Integrate, for consecutive intervals.  \p boundaries
+    /// must be finite and ascending; interval \c i runs from \c boundaries[i]
+    /// to \c boundaries[i+1], and its integral is written to \c
+    /// integralsOut[i].  \p integralsOut must have one element fewer than \p
+    /// boundaries.  Each boundary is located only once, so this is nearly
+    /// twice as fast as integrating each interval separately.
+    TS_API
+    bool IntegrateMany(
+        TfSpan<const TsTime> boundaries,
+        TfSpan<double> integralsOut) const;
+
+    /// Batch form of Average, with the same conventions as IntegrateMany.
+    /// Elements for intervals in which the spline has no values are left
+    /// unmodified.  Returns true if every interval produced a value.
+    TS_API
+    bool AverageMany(
+        TfSpan<const TsTime> boundaries,
+        TfSpan<double> averagesOut) const;
+
     /// @}
     /// \name Whole-spline queries
     /// @{
@@ -374,10 +908,21 @@ public:
     TS_API
     bool IsEmpty() const;
 
+    /// Returns whether any segment or extrapolation region has value-block
+    /// interpolation, or the last knot has it.
+    ///
+    /// This and the other whole-spline queries below are answered from
+    /// summary flags that are kept current as knots are edited, and take
+    /// constant time, apart from a few evaluations at the ends of the spline.
+    /// With inner loops, the summary of the unrolled knots is built on the
+    /// first query, and cached until the spline changes.
     TS_API
     bool HasValueBlocks() const;
 
-    /// <b>Not yet implemented.</b>
+    /// Returns whether the value of this spline changes over time: whether
+    /// knots have differing values, a dual-valued knot has differing values
+    /// on its two sides, any segment is not flat, or extrapolation slopes.
+    /// Knot values are compared even where value blocks hide them.
     TS_API
     bool IsVarying() const;
 
@@ -391,29 +936,49 @@ public:
     TS_API
     bool HasExtrapolatingLoops() const;
 
-    /// <b>Not yet implemented.</b>
+    /// Returns whether every segment has linear interpolation.  Extrapolation
+    /// is not considered.  Splines with fewer than two knots have no segments,
+    /// and are not linear.
     TS_API
     bool IsLinear() const;
 
-    /// <b>Not yet implemented.</b>
+    /// Returns whether the value of this spline is continuous everywhere,
+    /// including at joins with extrapolation and between loop iterations.
+    /// Dual-valued knots with differing values, held segments that end at
+    /// knots with different values, and value blocks (other than on the last
+    /// knot) are discontinuities.  An empty spline is continuous.
     TS_API
     bool IsC0Continuous() const;
 
-    /// <b>Not yet implemented.</b>
+    /// Returns whether this spline is C0 continuous, and its slope is also
+    /// continuous everywhere: on both sides of each knot, and at joins with
+    /// extrapolation and between loop iterations.
     TS_API
     bool IsG1Continuous() const;
 
-    /// <b>Not yet implemented.</b>
+    /// Returns whether this spline is G1 continuous, and, wherever two curved
+    /// segments meet, the tangents on either side have equal widths, so that
+    /// the derivative of the curve with respect to its parameter is also
+    /// continuous.  Hermite tangents are always a third of their segment.
     TS_API
     bool IsC1Continuous() const;
 
-    /// <b>Not yet implemented.</b>
+    /// Finds the smallest and largest values of this spline over \p timeSpan,
+    /// including extrapolation and loops.  Values that the spline approaches
+    /// at discontinuities, such as the pre-values of dual-valued knots, are
+    /// included, as are the values at both ends of \p timeSpan, whether or not
+    /// they are closed.  Where \p timeSpan is unbounded, linear and looping
+    /// extrapolation may give infinite bounds.  Returns false if the spline
+    /// has no values in \p timeSpan.
+    ///
+    /// Segment bounds are found analytically and cached on first use, after
+    /// which each query takes logarithmic time in the number of knots.
     TS_API
     bool GetValueRange(
         const GfInterval &timeSpan,
         std::pair<VtValue, VtValue> *rangeOut) const;
 
-    /// <b>Not yet implemented.</b>
+    /// \overload
     template <typename T>
     bool GetValueRange(
         const GfInterval &timeSpan,
@@ -427,12 +992,17 @@ public:
     bool HasValueBlockAtTime(
         TsTime time) const;
 
-    /// <b>Not yet implemented.</b>
+    /// Returns whether the segment that starts at \p startTime has the same
+    /// value throughout.  \p startTime must be the time of a knot, authored
+    /// or echoed by inner loops, that is not the last; otherwise this is a
+    /// coding error, and returns false.  Blocked segments are not flat.
     TS_API
     bool IsSegmentFlat(
         TsTime startTime) const;
 
-    /// <b>Not yet implemented.</b>
+    /// Returns whether the value of the segment that starts at \p startTime
+    /// never both increases and decreases.  Flat segments are monotonic;
+    /// blocked segments are not.  \p startTime is as for IsSegmentFlat.
     TS_API
     bool IsSegmentMonotonic(
         TsTime startTime) const;
@@ -459,6 +1029,9 @@ public:
 
 private:
     friend class TsRegressionPreventer;
+    friend class TsSampler;
+    friend class TsSplineBundle;
+    friend class TsSplineEvaluator;
     void _SetKnotUnchecked(const TsKnot & knot);
 
     template <typename SampleHolder>
@@ -467,8 +1040,20 @@ private:
         double timeScale,
         double valueScale,
         double tolerance,
+        TsBezierFlattening flattening,
+        TsExecutor *executor,
         SampleHolder* splineSamples) const;
 
+    TS_API
+    bool _SampleToSink(
+        const GfInterval& timeInterval,
+        double timeScale,
+        double valueScale,
+        double tolerance,
+        TsBezierFlattening flattening,
+        TsExecutor *executor,
+        Ts_SampleVisitorSink* sink) const;
+
     // External helpers provide direct data access for Ts implementation.
     friend Ts_SplineData* Ts_GetSplineData(TsSpline &spline);
     friend const Ts_SplineData* Ts_GetSplineData(const TsSpline &spline);
@@ -481,6 +1066,15 @@ private:
     TS_API
     const Ts_SplineData* _GetData() const;
 
+    // Get the number of uniform samples from the minimum of an interval
+    // through its maximum.  Returns false, with a coding error, for invalid
+    // arguments.
+    TS_API
+    static bool _GetUniformSampleCount(
+        const GfInterval &interval,
+        TsTime step,
+        size_t *countOut);
+
     // Ensure we have our own independent data, in preparation for writing.  If
     // a value type is passed, and we don't yet have typed data, ensure we have
     // data of the specified type.
@@ -491,7 +1085,42 @@ private:
         TsTime time,
         T *valueOut,
         Ts_EvalAspect aspect,
-        Ts_EvalLocation location) const;
+        Ts_EvalLocation location,
+        const TsEvalOptions &options) const;
+
+    template <typename T>
+    bool _EvalMany(
+        TfSpan<const TsTime> times,
+        TfSpan<T> valuesOut,
+        Ts_EvalAspect aspect,
+        Ts_EvalLocation location,
+        const TsEvalOptions &options) const;
+
+    template <typename T>
+    bool _EvalMany(
+        TfSpan<const TsTime> times,
+        VtArray<T> *valuesOut,
+        Ts_EvalAspect aspect,
+        Ts_EvalLocation location,
+        const TsEvalOptions &options) const;
+
+    template <typename T>
+    bool _EvalWithDerivatives(
+        TsTime time,
+        T *valueOut,
+        T *derivativeOut,
+        T *secondDerivativeOut,
+        Ts_EvalLocation location,
+        const TsEvalOptions &options) const;
+
+    template <typename T>
+    bool _EvalWithDerivativesMany(
+        TfSpan<const TsTime> times,
+        TfSpan<T> valuesOut,
+        TfSpan<T> derivativesOut,
+        TfSpan<T> secondDerivativesOut,
+        Ts_EvalLocation location,
+        const TsEvalOptions &options) const;
 
 private:
     // Our parameter data.  Copy-on-write.  Null only if we are in the default
@@ -537,15 +1166,34 @@ bool TsSpline::IsHolding() const
     return GetValueType() == Ts_GetType<T>();
 }
 
+template <typename T>
+bool TsSpline::GetValueRange(
+    const GfInterval &timeSpan,
+    std::pair<T, T>* const rangeOut) const
+{
+    static_assert(Ts_IsSupportedValueType<T>::value,
+        "Value ranges require a spline value type");
+
+    double min = 0, max = 0;
+    if (!Ts_GetValueRange(_GetData(), timeSpan, &min, &max))
+    {
+        return false;
+    }
+
+    *rangeOut = std::make_pair(T(min), T(max));
+    return true;
+}
+
 template <typename T>
 bool TsSpline::_Eval(
     const TsTime time,
     T* const valueOut,
     const Ts_EvalAspect aspect,
-    const Ts_EvalLocation location) const
+    const Ts_EvalLocation location,
+    const TsEvalOptions &options) const
 {
     const std::optional<double> result =
-        Ts_Eval(_GetData(), time, aspect, location);
+        Ts_Eval(_GetData(), time, aspect, location, options);
 
     if (!result)
     {
@@ -565,42 +1213,258 @@ bool TsSpline::_Eval(
     const TsTime time,
     VtValue* const valueOut,
     const Ts_EvalAspect aspect,
-    const Ts_EvalLocation location) const;
+    const Ts_EvalLocation location,
+    const TsEvalOptions &options) const;
+
+#define TS_SPLINE_DEFINE_EVAL(method, aspect, location)                 \
+    template <typename T>                                               \
+    bool TsSpline::method(                                              \
+        const TsTime time,                                              \
+        T* const valueOut) const                                        \
+    {                                                                   \
+        return _Eval(                                                   \
+            time, valueOut, aspect, location, TsEvalOptions());         \
+    }                                                                   \
+    template <typename T>                                               \
+    bool TsSpline::method(                                              \
+        const TsTime time,                                              \
+        T* const valueOut,                                              \
+        const TsEvalOptions &options) const                             \
+    {                                                                   \
+        return _Eval(time, valueOut, aspect, location, options);        \
+    }
+
+TS_SPLINE_DEFINE_EVAL(Eval, Ts_EvalValue, Ts_EvalAtTime)
+TS_SPLINE_DEFINE_EVAL(EvalPreValue, Ts_EvalValue, Ts_EvalPre)
+TS_SPLINE_DEFINE_EVAL(EvalDerivative, Ts_EvalDerivative, Ts_EvalAtTime)
+TS_SPLINE_DEFINE_EVAL(EvalPreDerivative, Ts_EvalDerivative, Ts_EvalPre)
+TS_SPLINE_DEFINE_EVAL(EvalHeld, Ts_EvalHeldValue, Ts_EvalAtTime)
+TS_SPLINE_DEFINE_EVAL(EvalPreValueHeld, Ts_EvalHeldValue, Ts_EvalPre)
+
+#undef TS_SPLINE_DEFINE_EVAL
+
+template <typename T>
+bool TsSpline::_EvalMany(
+    const TfSpan<const TsTime> times,
+    const TfSpan<T> valuesOut,
+    const Ts_EvalAspect aspect,
+    const Ts_EvalLocation location,
+    const TsEvalOptions &options) const
+{
+    static_assert(Ts_IsSupportedValueType<T>::value,
+        "Batch evaluation requires a spline value type");
+
+    return Ts_EvalMany(
+        _GetData(), times, aspect, location, options, valuesOut);
+}
+
+template <typename T>
+bool TsSpline::_EvalMany(
+    const TfSpan<const TsTime> times,
+    VtArray<T>* const valuesOut,
+    const Ts_EvalAspect aspect,
+    const Ts_EvalLocation location,
+    const TsEvalOptions &options) const
+{
+    valuesOut->resize(times.size());
+    return _EvalMany(times, TfSpan<T>(*valuesOut), aspect, location, options);
+}
+
+#define TS_SPLINE_DEFINE_EVAL_MANY(method, aspect, location)            \
+    template <typename T>                                               \
+    bool TsSpline::method(                                              \
+        const TfSpan<const TsTime> times,                               \
+        const TfSpan<T> valuesOut) const                                \
+    {                                                                   \
+        return _EvalMany(                                               \
+            times, valuesOut, aspect, location, TsEvalOptions());       \
+    }                                                                   \
+    template <typename T>                                               \
+    bool TsSpline::method(                                              \
+        const TfSpan<const TsTime> times,                               \
+        VtArray<T>* const valuesOut) const                              \
+    {                                                                   \
+        return _EvalMany(                                               \
+            times, valuesOut, aspect, location, TsEvalOptions());       \
+    }                                                                   \
+    template <typename T>                                               \
+    bool TsSpline::method(                                              \
+        const TfSpan<const TsTime> times,                               \
+        const TfSpan<T> valuesOut,                                      \
+        const TsEvalOptions &options) const                             \
+    {                                                                   \
+        return _EvalMany(times, valuesOut, aspect, location, options);  \
+    }                                                                   \
+    template <typename T>                                               \
+    bool TsSpline::method(                                              \
+        const TfSpan<const TsTime> times,                               \
+        VtArray<T>* const valuesOut,                                    \
+        const TsEvalOptions &options) const                             \
+    {                                                                   \
+        return _EvalMany(times, valuesOut, aspect, location, options);  \
+    }
+
+TS_SPLINE_DEFINE_EVAL_MANY(EvalMany, Ts_EvalValue, Ts_EvalAtTime)
+TS_SPLINE_DEFINE_EVAL_MANY(EvalPreValueMany, Ts_EvalValue, Ts_EvalPre)
+TS_SPLINE_DEFINE_EVAL_MANY(EvalDerivativeMany, Ts_EvalDerivative, Ts_EvalAtTime)
+TS_SPLINE_DEFINE_EVAL_MANY(EvalPreDerivativeMany, Ts_EvalDerivative, Ts_EvalPre)
+TS_SPLINE_DEFINE_EVAL_MANY(EvalHeldMany, Ts_EvalHeldValue, Ts_EvalAtTime)
+TS_SPLINE_DEFINE_EVAL_MANY(EvalPreValueHeldMany, Ts_EvalHeldValue, Ts_EvalPre)
+
+#undef TS_SPLINE_DEFINE_EVAL_MANY
 
 template <typename T>
-bool TsSpline::Eval(const TsTime time, T* const valueOut) const
+bool TsSpline::_EvalWithDerivatives(
+    const TsTime time,
+    T* const valueOut,
+    T* const derivativeOut,
+    T* const secondDerivativeOut,
+    const Ts_EvalLocation location,
+    const TsEvalOptions &options) const
 {
-    return _Eval(time, valueOut, Ts_EvalValue, Ts_EvalAtTime);
+    static_assert(Ts_IsSupportedValueType<T>::value,
+        "Evaluation with derivatives requires a spline value type");
+
+    const std::optional<Ts_EvalResults> result =
+        Ts_EvalWithDerivatives(_GetData(), time, location, options);
+
+    if (!result)
+    {
+        return false;
+    }
+
+    *valueOut = T(result->value);
+    *derivativeOut = T(result->derivative);
+    if (secondDerivativeOut)
+    {
+        *secondDerivativeOut = T(result->secondDerivative);
+    }
+    return true;
 }
 
 template <typename T>
-bool TsSpline::EvalPreValue(const TsTime time, T* const valueOut) const
+bool TsSpline::_EvalWithDerivativesMany(
+    const TfSpan<const TsTime> times,
+    const TfSpan<T> valuesOut,
+    const TfSpan<T> derivativesOut,
+    const TfSpan<T> secondDerivativesOut,
+    const Ts_EvalLocation location,
+    const TsEvalOptions &options) const
 {
-    return _Eval(time, valueOut, Ts_EvalValue, Ts_EvalPre);
+    static_assert(Ts_IsSupportedValueType<T>::value,
+        "Batch evaluation requires a spline value type");
+
+    return Ts_EvalManyWithDerivatives(
+        _GetData(), times, location, options,
+        valuesOut, derivativesOut, secondDerivativesOut);
 }
 
+#define TS_SPLINE_DEFINE_EVAL_WITH_DERIVATIVES(method, location)        \
+    template <typename T>                                               \
+    bool TsSpline::method(                                              \
+        const TsTime time,                                              \
+        T* const valueOut,                                              \
+        T* const derivativeOut,                                         \
+        T* const secondDerivativeOut) const                             \
+    {                                                                   \
+        return _EvalWithDerivatives(                                    \
+            time, valueOut, derivativeOut, secondDerivativeOut,         \
+            location, TsEvalOptions());                                 \
+    }                                                                   \
+    template <typename T>                                               \
+    bool TsSpline::method(                                              \
+        const TsTime time,                                              \
+        T* const valueOut,                                              \
+        T* const derivativeOut,                                         \
+        T* const secondDerivativeOut,                                   \
+        const TsEvalOptions &options) const                             \
+    {                                                                   \
+        return _EvalWithDerivatives(                                    \
+            time, valueOut, derivativeOut, secondDerivativeOut,         \
+            location, options);                                         \
+    }                                                                   \
+    template <typename T>                                               \
+    bool TsSpline::method##Many(                                        \
+        const TfSpan<const TsTime> times,                               \
+        const TfSpan<T> valuesOut,                                      \
+        const TfSpan<T> derivativesOut,                                 \
+        const TfSpan<T> secondDerivativesOut) const                     \
+    {                                                                   \
+        return _EvalWithDerivativesMany(                                \
+            times, valuesOut, derivativesOut, secondDerivativesOut,     \
+            location, TsEvalOptions());                                 \
+    }                                                                   \
+    template <typename T>                                               \
+    bool TsSpline::method##Many(                                        \
+        const TfSpan<const TsTime> times,                               \
+        const TfSpan<T> valuesOut,                                      \
+        const TfSpan<T> derivativesOut,                                 \
+        const TfSpan<T> secondDerivativesOut,                           \
+        const TsEvalOptions &options) const                             \
+    {                                                                   \
+        return _EvalWithDerivativesMany(                                \
+            times, valuesOut, derivativesOut, secondDerivativesOut,     \
+            location, options);                                         \
+    }
+
+TS_SPLINE_DEFINE_EVAL_WITH_DERIVATIVES(EvalWithDerivatives, Ts_EvalAtTime)
+TS_SPLINE_DEFINE_EVAL_WITH_DERIVATIVES(EvalPreWithDerivatives, Ts_EvalPre)
+
+#undef TS_SPLINE_DEFINE_EVAL_WITH_DERIVATIVES
+
 template <typename T>
-bool TsSpline::EvalDerivative(const TsTime time, T* const valueOut) const
+bool TsSpline::EvalShutter(
+    const TfSpan<const TsTime> frames,
+    const TsShutter &shutter,
+    const TfSpan<T> valuesOut,
+    const TsEvalOptions &options) const
 {
-    return _Eval(time, valueOut, Ts_EvalDerivative, Ts_EvalAtTime);
+    static_assert(Ts_IsSupportedValueType<T>::value,
+        "Shutter evaluation requires a spline value type");
+
+    return Ts_EvalShutter(_GetData(), frames, shutter, options, valuesOut);
 }
 
 template <typename T>
-bool TsSpline::EvalPreDerivative(const TsTime time, T* const valueOut) const
+bool TsSpline::EvalShutter(
+    const TfSpan<const TsTime> frames,
+    const TsShutter &shutter,
+    VtArray<T>* const valuesOut,
+    const TsEvalOptions &options) const
 {
-    return _Eval(time, valueOut, Ts_EvalDerivative, Ts_EvalPre);
+    valuesOut->resize(frames.size() * std::max(shutter.numSamples, 0));
+    return EvalShutter(frames, shutter, TfSpan<T>(*valuesOut), options);
 }
 
 template <typename T>
-bool TsSpline::EvalHeld(const TsTime time, T* const valueOut) const
+bool TsSpline::SampleUniform(
+    const TsTime start,
+    const TsTime step,
+    const TfSpan<T> valuesOut,
+    const TsEvalOptions &options) const
 {
-    return _Eval(time, valueOut, Ts_EvalHeldValue, Ts_EvalAtTime);
+    static_assert(Ts_IsSupportedValueType<T>::value,
+        "Uniform sampling requires a spline value type");
+
+    return Ts_SampleUniform(_GetData(), start, step, options, valuesOut);
 }
 
 template <typename T>
-bool TsSpline::EvalPreValueHeld(const TsTime time, T* const valueOut) const
+bool TsSpline::SampleUniform(
+    const GfInterval &interval,
+    const TsTime step,
+    VtArray<T>* const valuesOut,
+    const TsEvalOptions &options) const
 {
-    return _Eval(time, valueOut, Ts_EvalHeldValue, Ts_EvalPre);
+    size_t count = 0;
+    if (!_GetUniformSampleCount(interval, step, &count))
+    {
+        return false;
+    }
+
+    valuesOut->resize(count);
+    return SampleUniform(
+        interval.GetMin(), step, TfSpan<T>(*valuesOut), options);
 }
 
 
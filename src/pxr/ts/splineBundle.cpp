@@ -0,0 +1,336 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include "./splineBundle.h"
+#include "./splineData.h"
+
+#include <pxr/tf/diagnostic.h>
+
+#include <algorithm>
+#include <optional>
+
+namespace pxr {
+
+
+// Returns the number of arena slots needed to pack a spline.  Splines with
+// loops aren't packed, because evaluating them requires loop resolution; nor
+// are splines with fewer than two knots, which have no segments.
+//
+static size_t
+_GetPackedSize(
+    const Ts_SplineData* const data)
+{
+    if (data->times.size() < 2
+        || data->HasInnerLoops()
+        || data->preExtrapolation.IsLooping()
+        || data->postExtrapolation.IsLooping())
+    {
+        return 0;
+    }
+
+    return data->times.size();
+}
+
+TsSplineBundle::TsSplineBundle() = default;
+
+TsSplineBundle::TsSplineBundle(
+    const std::vector<TsSpline> &splines,
+    const TsEvalOptions &options)
+    : _options(options)
+{
+    Rebuild(splines);
+}
+
+void TsSplineBundle::Rebuild(
+    const std::vector<TsSpline> &splines)
+{
+    _splines = splines;
+    _data.resize(_splines.size());
+    _entries.assign(_splines.size(), _Entry());
+
+    for (size_t i = 0; i < _splines.size(); i++)
+    {
+        _data[i] = _splines[i]._GetData();
+    }
+
+    _Compact();
+}
+
+void TsSplineBundle::SetSpline(
+    const size_t index,
+    const TsSpline &spline)
+{
+    if (index >= _splines.size())
+    {
+        TF_CODING_ERROR(
+            "Spline index %zu out of range for bundle of size %zu",
+            index, _splines.size());
+        return;
+    }
+
+    _splines[index] = spline;
+    _data[index] = _splines[index]._GetData();
+
+    // Repack in place if there is room.
+    _Entry &entry = _entries[index];
+    const size_t size = _GetPackedSize(_data[index]);
+    if (size <= entry.capacity)
+    {
+        _Pack(index, entry.begin);
+        return;
+    }
+
+    // Otherwise move to the end of the arena, abandoning the old slots.
+    _numUnusedSlots += entry.capacity;
+    const size_t begin = _times.size();
+    _times.resize(begin + size);
+    _segments.resize(begin + size);
+    entry.capacity = size;
+    _Pack(index, begin);
+
+    // Don't let abandoned slots dominate the arena.
+    if (_numUnusedSlots > _times.size() / 2)
+    {
+        _Compact();
+    }
+}
+
+void TsSplineBundle::_Pack(
+    const size_t index,
+    const size_t begin)
+{
+    _Entry &entry = _entries[index];
+    const Ts_SplineData* const data = _data[index];
+
+    // Compile the spline, so that evaluation that falls back to the spline's
+    // own data gets the same results as packed evaluation, and so that
+    // unpacked splines still benefit from compiled data.  The compiled data is
+    // a cache on the spline data, shared with the caller's copies.
+    _splines[index].Compile();
+
+    entry.begin = begin;
+    entry.count = _GetPackedSize(data);
+    if (entry.count == 0)
+    {
+        return;
+    }
+
+    const Ts_CompiledSpline* const compiled = data->compiled.Get();
+    if (!TF_VERIFY(compiled
+            && compiled->segments.size() + 1 == entry.count))
+    {
+        entry.count = 0;
+        return;
+    }
+
+    std::copy(
+        data->times.begin(), data->times.end(), _times.begin() + begin);
+    std::copy(
+        compiled->segments.begin(), compiled->segments.end(),
+        _segments.begin() + begin);
+    _segments[begin + entry.count - 1] = Ts_CompiledSegment();
+}
+
+void TsSplineBundle::_Compact()
+{
+    size_t size = 0;
+    for (size_t i = 0; i < _splines.size(); i++)
+    {
+        _entries[i].begin = size;
+        _entries[i].capacity = _GetPackedSize(_data[i]);
+        size += _entries[i].capacity;
+    }
+
+    _times.assign(size, 0.0);
+    _segments.assign(size, Ts_CompiledSegment());
+    _numUnusedSlots = 0;
+
+    for (size_t i = 0; i < _splines.size(); i++)
+    {
+        _Pack(i, _entries[i].begin);
+    }
+}
+
+bool TsSplineBundle::Eval(
+    const TsTime time,
+    const TfSpan<double> valuesOut) const
+{
+    return _EvalMany(
+        TfSpan<const TsTime>(&time, 1), Ts_EvalValue, valuesOut, nullptr);
+}
+
+bool TsSplineBundle::Eval(
+    const TsTime time,
+    const TfSpan<double> valuesOut,
+    TsExecutor* const executor) const
+{
+    return _EvalMany(
+        TfSpan<const TsTime>(&time, 1), Ts_EvalValue, valuesOut, executor);
+}
+
+bool TsSplineBundle::EvalDerivative(
+    const TsTime time,
+    const TfSpan<double> valuesOut) const
+{
+    return _EvalMany(
+        TfSpan<const TsTime>(&time, 1), Ts_EvalDerivative, valuesOut,
+        nullptr);
+}
+
+bool TsSplineBundle::EvalDerivative(
+    const TsTime time,
+    const TfSpan<double> valuesOut,
+    TsExecutor* const executor) const
+{
+    return _EvalMany(
+        TfSpan<const TsTime>(&time, 1), Ts_EvalDerivative, valuesOut,
+        executor);
+}
+
+bool TsSplineBundle::EvalMany(
+    const TfSpan<const TsTime> times,
+    const TfSpan<double> valuesOut) const
+{
+    return _EvalMany(times, Ts_EvalValue, valuesOut, nullptr);
+}
+
+bool TsSplineBundle::EvalMany(
+    const TfSpan<const TsTime> times,
+    const TfSpan<double> valuesOut,
+    TsExecutor* const executor) const
+{
+    return _EvalMany(
+        times, Ts_EvalValue, valuesOut, executor);
+}
+
+bool TsSplineBundle::EvalDerivativeMany(
+    const TfSpan<const TsTime> times,
+    const TfSpan<double> valuesOut) const
+{
+    return _EvalMany(times, Ts_EvalDerivative, valuesOut, nullptr);
+}
+
+bool TsSplineBundle::EvalDerivativeMany(
+    const TfSpan<const TsTime> times,
+    const TfSpan<double> valuesOut,
+    TsExecutor* const executor) const
+{
+    return _EvalMany(
+        times, Ts_EvalDerivative, valuesOut, executor);
+}
+
+bool TsSplineBundle::_EvalMany(
+    const TfSpan<const TsTime> times,
+    const Ts_EvalAspect aspect,
+    const TfSpan<double> valuesOut,
+    TsExecutor* const executor) const
+{
+    if (valuesOut.size() != _splines.size() * times.size())
+    {
+        TF_CODING_ERROR(
+            "Mismatched sizes for splines (%zu) by times (%zu) and "
+            "values (%zu) in bundle evaluation",
+            _splines.size(), times.size(), valuesOut.size());
+        return false;
+    }
+
+    if (executor)
+    {
+        return Ts_ParallelForRows(
+            executor, _splines.size(), times.size(),
+            [&](const size_t index, const size_t begin, const size_t end)
+            {
+                return _EvalRange(
+                    index, times.subspan(begin, end - begin), aspect,
+                    valuesOut.data() + index * times.size() + begin);
+            });
+    }
+
+    bool haveAll = true;
+    for (size_t i = 0; i < _splines.size(); i++)
+    {
+        haveAll &= _EvalRange(
+            i, times, aspect, valuesOut.data() + i * times.size());
+    }
+
+    return haveAll;
+}
+
+bool TsSplineBundle::_EvalRange(
+    const size_t index,
+    const TfSpan<const TsTime> times,
+    const Ts_EvalAspect aspect,
+    double* const valuesOut) const
+{
+    // Each search starts where the previous one ended.
+    size_t hint = 0;
+    bool haveAll = true;
+    for (size_t i = 0; i < times.size(); i++)
+    {
+        haveAll &= _EvalOne(index, times[i], aspect, &hint, &valuesOut[i]);
+    }
+
+    return haveAll;
+}
+
+bool TsSplineBundle::_EvalOne(
+    const size_t index,
+    const TsTime time,
+    const Ts_EvalAspect aspect,
+    size_t* const hint,
+    double* const valueOut) const
+{
+    std::optional<double> result;
+
+    // Use packed data if the time is in the interior of a compiled segment.
+    const _Entry &entry = _entries[index];
+    const TsTime* const times = _times.data() + entry.begin;
+    const size_t last = entry.count - 1;
+    if (entry.count > 0 && time > times[0] && time < times[last])
+    {
+        // Find the segment containing the time.  Check the previous one, and
+        // the one after it, before searching.  All of these indices are less
+        // than last.
+        size_t seg = *hint;
+        if (!(times[seg] <= time && time < times[seg + 1]))
+        {
+            if (seg + 1 < last
+                && times[seg + 1] <= time && time < times[seg + 2])
+            {
+                seg++;
+            }
+            else
+            {
+                seg = std::upper_bound(times, times + entry.count, time)
+                    - times - 1;
+            }
+            *hint = seg;
+        }
+
+        const Ts_CompiledSegment &segment = _segments[entry.begin + seg];
+        if (times[seg] != time && segment.type != Ts_CompiledUncompiled)
+        {
+            result = Ts_EvalCompiledSegment(segment, time, aspect, _options);
+            if (result)
+            {
+                *valueOut = *result;
+            }
+            return result.has_value();
+        }
+    }
+
+    // Otherwise evaluate from the spline data.
+    result = Ts_Eval(_data[index], time, aspect, Ts_EvalAtTime, _options);
+    if (result)
+    {
+        *valueOut = *result;
+    }
+    return result.has_value();
+}
+
+
+}  // namespace pxr
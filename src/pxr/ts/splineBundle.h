@@ -0,0 +1,216 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#ifndef PXR_TS_SPLINE_BUNDLE_H
+#define PXR_TS_SPLINE_BUNDLE_H
+
+#include "./api.h"
+#include "./spline.h"
+#include "./compiledSpline.h"
+#include "./eval.h"
+#include "./parallel.h"
+#include "./types.h"
+#include <pxr/tf/span.h>
+
+#include <vector>
+
+namespace pxr {
+
+
+/// A collection of splines that are evaluated together.
+///
+/// Evaluating many independent splines at the same time, as when evaluating a
+/// rig at each frame, means visiting the heap data of each spline in turn.  A
+/// bundle instead packs compiled evaluation data for all of its splines into
+/// shared arrays: one of knot times, one of segment coefficients (see
+/// TsSpline::Compile), and one of per-spline offsets into the others.
+/// Evaluation streams through these arrays, and touches the splines' own data
+/// only for cases that compiled data doesn't cover: evaluation exactly at
+/// knots, in extrapolation regions, and for splines with inner or
+/// extrapolating loops.
+///
+/// Building a bundle compiles its splines, which also affects copies that share
+/// their data.  Results are the same as those of TsSpline::Eval for compiled
+/// splines, and may differ from uncompiled evaluation by floating-point
+/// rounding.
+///
+/// Each spline is evaluated independently of the others, and the evaluation
+/// methods don't modify the bundle, so a bundle may be evaluated from several
+/// threads at once.  Modifying a bundle is not thread-safe.
+///
+/// A bundle holds copies of its splines.  Because splines are copy-on-write,
+/// later edits to the originals don't affect the bundle; call SetSpline or
+/// Rebuild to pick them up.
+///
+class TsSplineBundle
+{
+public:
+    /// Creates an empty bundle.
+    TS_API
+    TsSplineBundle();
+
+    /// Creates a bundle containing the specified splines.
+    TS_API
+    explicit TsSplineBundle(
+        const std::vector<TsSpline> &splines,
+        const TsEvalOptions &options = TsEvalOptions());
+
+    /// Replaces all of the splines in this bundle.
+    TS_API
+    void Rebuild(const std::vector<TsSpline> &splines);
+
+    /// Replaces one spline.  Only that spline's packed data is rebuilt.  The
+    /// index must be less than GetSize().
+    TS_API
+    void SetSpline(size_t index, const TsSpline &spline);
+
+    /// Returns the number of splines in this bundle.
+    size_t GetSize() const { return _splines.size(); }
+
+    /// Returns one of the splines in this bundle.
+    const TsSpline& GetSpline(size_t index) const { return _splines[index]; }
+
+    /// Returns the options used for evaluation.
+    const TsEvalOptions& GetOptions() const { return _options; }
+
+    /// \name Evaluation
+    /// @{
+    ///
+    /// The forms that take an executor split the work across threads using \p
+    /// executor, or evaluate serially if it is null.  Results are identical to
+    /// those of the serial forms.
+
+    /// Evaluates every spline at \p time, writing one value per spline to \p
+    /// valuesOut, which must have GetSize() elements.  Elements for splines
+    /// that have no value are left unmodified.  Returns true if every spline
+    /// produced a value.
+    TS_API
+    bool Eval(
+        TsTime time,
+        TfSpan<double> valuesOut) const;
+
+    TS_API
+    bool Eval(
+        TsTime time,
+        TfSpan<double> valuesOut,
+        TsExecutor *executor) const;
+
+    /// Like Eval, but evaluates derivatives.
+    TS_API
+    bool EvalDerivative(
+        TsTime time,
+        TfSpan<double> valuesOut) const;
+
+    TS_API
+    bool EvalDerivative(
+        TsTime time,
+        TfSpan<double> valuesOut,
+        TsExecutor *executor) const;
+
+    /// Evaluates every spline at each of \p times.  \p valuesOut must have
+    /// GetSize() * times.size() elements.  Results are grouped by spline: the
+    /// value of spline \c i at time \c j is written to element
+    /// <tt>i * times.size() + j</tt>.  Elements for which there is no value
+    /// are left unmodified.  Returns true if every spline produced a value at
+    /// every time.  Ascending times are the fastest case.
+    TS_API
+    bool EvalMany(
+        TfSpan<const TsTime> times,
+        TfSpan<double> valuesOut) const;
+
+    TS_API
+    bool EvalMany(
+        TfSpan<const TsTime> times,
+        TfSpan<double> valuesOut,
+        TsExecutor *executor) const;
+
+    /// Like EvalMany, but evaluates derivatives.
+    TS_API
+    bool EvalDerivativeMany(
+        TfSpan<const TsTime> times,
+        TfSpan<double> valuesOut) const;
+
+    TS_API
+    bool EvalDerivativeMany(
+        TfSpan<const TsTime> times,
+        TfSpan<double> valuesOut,
+        TsExecutor *executor) const;
+
+    /// @}
+
+private:
+    // Where one spline's data lives in the arena.
+    struct _Entry
+    {
+        // Offset of this spline's first knot in _times and _segments.
+        size_t begin = 0;
+
+        // Number of knots.  Zero if this spline isn't packed, in which case it
+        // is always evaluated from its own data.
+        size_t count = 0;
+
+        // Number of arena slots reserved for this spline, which may exceed
+        // count after SetSpline.
+        size_t capacity = 0;
+    };
+
+    // Packs a spline's data at the specified arena offset, which must have
+    // room for it.
+    void _Pack(size_t index, size_t begin);
+
+    // Repacks all splines with no unused arena slots.
+    void _Compact();
+
+    // Evaluates every spline at every time.  Uses the executor if one is
+    // passed, otherwise evaluates serially.
+    bool _EvalMany(
+        TfSpan<const TsTime> times,
+        Ts_EvalAspect aspect,
+        TfSpan<double> valuesOut,
+        TsExecutor *executor) const;
+
+    // Evaluates one spline at a range of times, writing to the corresponding
+    // range of that spline's values.
+    bool _EvalRange(
+        size_t index,
+        TfSpan<const TsTime> times,
+        Ts_EvalAspect aspect,
+        double *valuesOut) const;
+
+    // Evaluates one spline at one time.  The hint is the index, within the
+    // spline's packed knots, of the knot search result from the previous
+    // call, and is updated.
+    bool _EvalOne(
+        size_t index,
+        TsTime time,
+        Ts_EvalAspect aspect,
+        size_t *hint,
+        double *valueOut) const;
+
+private:
+    TsEvalOptions _options;
+
+    // Our copies of the splines, which keep their data alive and unchanged,
+    // and the data itself.
+    std::vector<TsSpline> _splines;
+    std::vector<const Ts_SplineData*> _data;
+
+    // The arena.  Entry i of _segments covers the segment that starts at knot
+    // i of _times.  The last slot of each spline's range in _segments is
+    // unused.
+    std::vector<_Entry> _entries;
+    std::vector<TsTime> _times;
+    std::vector<Ts_CompiledSegment> _segments;
+
+    // Number of arena slots that no entry refers to.
+    size_t _numUnusedSlots = 0;
+};
+
+
+}  // namespace pxr
+
+#endif
@@ -6,6 +6,7 @@
 // Modified by Jeremy Retailleau.
 
 #include "./splineData.h"
+#include "./evalImpl.h"
 #include "./spline.h"
 #include "./valueTypeDispatch.h"
 #include <pxr/tf/diagnostic.h>
@@ -98,6 +99,39 @@ bool Ts_SplineData::HasInnerLoops(
     return true;
 }
 
+const Ts_LoopTopology& Ts_SplineData::GetLoopTopology() const
+{
+    return *loopTopology.GetOrBuild(
+        [this]() { return new Ts_LoopTopology(this); });
+}
+
+const Ts_ValueRangeTree& Ts_SplineData::GetValueRangeTree() const
+{
+    return *valueRangeTree.GetOrBuild(
+        [this]() { return new Ts_ValueRangeTree(this); });
+}
+
+const Ts_IntegralTable& Ts_SplineData::GetIntegralTable() const
+{
+    return *integralTable.GetOrBuild(
+        [this]() { return new Ts_IntegralTable(this); });
+}
+
+const Ts_UnrolledKnots& Ts_SplineData::GetUnrolledKnots() const
+{
+    return *unrolledKnots.GetOrBuild(
+        [this]() { return new Ts_UnrolledKnots(this); });
+}
+
+void Ts_SplineData::ClearCaches()
+{
+    compiled.Clear();
+    loopTopology.Clear();
+    valueRangeTree.Clear();
+    integralTable.Clear();
+    unrolledKnots.Clear();
+}
+
 Ts_SplineData*
 Ts_GetSplineData(TsSpline &spline)
 {
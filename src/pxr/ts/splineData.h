@@ -9,7 +9,9 @@
 #define PXR_TS_SPLINE_DATA_H
 
 #include "./api.h"
+#include "./compiledSpline.h"
 #include "./knotData.h"
+#include "./splineSummary.h"
 #include "./types.h"
 #include "./typeHelpers.h"
 #include <pxr/vt/dictionary.h>
@@ -17,6 +19,7 @@
 #include <pxr/tf/type.h>
 #include <pxr/tf/stl.h>
 
+#include <atomic>
 #include <vector>
 #include <unordered_map>
 #include <algorithm>
@@ -27,6 +30,82 @@
 namespace pxr {
 
 class TsSpline;
+struct Ts_LoopTopology;
+struct Ts_ValueRangeTree;
+struct Ts_IntegralTable;
+
+
+// Holder for an object derived from spline data, built on demand and discarded
+// whenever the spline data changes.  Copies start out empty, since a copy of
+// spline data is made only in preparation for modifying it.
+//
+// Get and GetOrBuild are thread-safe.  If several threads build at once, one
+// result is kept, and the others are discarded.  Clear is not thread-safe; it
+// is called only by writers, who have exclusive access to the data.
+//
+template <typename T>
+class Ts_SplineDataCache
+{
+public:
+    Ts_SplineDataCache() = default;
+    Ts_SplineDataCache(const Ts_SplineDataCache&) {}
+    Ts_SplineDataCache& operator=(const Ts_SplineDataCache&)
+    {
+        Clear();
+        return *this;
+    }
+
+    ~Ts_SplineDataCache()
+    {
+        _Delete(_ptr.load(std::memory_order_acquire));
+    }
+
+    // Returns the cached object, or null if there isn't one.
+    const T* Get() const
+    {
+        return _ptr.load(std::memory_order_acquire);
+    }
+
+    // Returns the cached object, first calling build() to create one on the
+    // heap if there isn't one.
+    template <typename Builder>
+    const T* GetOrBuild(const Builder &build) const
+    {
+        if (const T* const existing = Get())
+        {
+            return existing;
+        }
+
+        T* const built = build();
+        T* expected = nullptr;
+        if (_ptr.compare_exchange_strong(
+                expected, built,
+                std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            return built;
+        }
+
+        // Another thread got there first.
+        _Delete(built);
+        return expected;
+    }
+
+    void Clear()
+    {
+        _Delete(_ptr.exchange(nullptr, std::memory_order_acq_rel));
+    }
+
+private:
+    // Some cached types are private to the library, and are only declared
+    // here.  Code that deletes them must see their definitions.
+    static void _Delete(T* const ptr)
+    {
+        static_assert(sizeof(T) > 0, "Cached type must be complete");
+        delete ptr;
+    }
+
+    mutable std::atomic<T*> _ptr{nullptr};
+};
 
 
 // Primary data structure for splines.  Abstract; subclasses store knot data,
@@ -59,6 +138,9 @@ public:
     virtual bool operator==(const Ts_SplineData &other) const = 0;
 
     virtual void ReserveForKnotCount(size_t count) = 0;
+
+    // Appends a knot, which must be later than all existing knots.  Doesn't
+    // update the summary; callers push all of their knots, then rebuild it.
     virtual void PushKnot(
         const Ts_KnotData *knotData,
         const VtDictionary &customData) = 0;
@@ -71,6 +153,10 @@ public:
     virtual Ts_KnotData* GetKnotPtrAtIndex(size_t index) = 0;
     virtual Ts_TypedKnotData<double>
         GetKnotDataAsDouble(size_t index) const = 0;
+    virtual void GetKnotRangeAsDouble(
+        size_t firstIndex,
+        size_t count,
+        Ts_TypedKnotData<double> *out) const = 0;
 
     virtual void ClearKnots() = 0;
     virtual void RemoveKnotAtTime(TsTime time) = 0;
@@ -89,6 +175,24 @@ public:
     bool HasInnerLoops(
         size_t *firstProtoIndexOut = nullptr) const;
 
+    // Returns the loop and extrapolation topology, building it on first use.
+    // Thread-safe.
+    const Ts_LoopTopology& GetLoopTopology() const;
+
+    // Returns the value range tree, building it on first use.  Thread-safe.
+    const Ts_ValueRangeTree& GetValueRangeTree() const;
+
+    // Returns the integral table, building it on first use.  Thread-safe.
+    const Ts_IntegralTable& GetIntegralTable() const;
+
+    // Returns the knots as unrolled by inner loops, and their summary,
+    // building them on first use.  Thread-safe.
+    const Ts_UnrolledKnots& GetUnrolledKnots() const;
+
+    // Discards all cached data derived from this struct.  Must be called
+    // before modifying any member.
+    void ClearCaches();
+
 public:
     // BITFIELDS - note: for enum-typed bitfields, we declare one bit more than
     // is minimally needed to represent all declared enum values.  For example,
@@ -125,6 +229,29 @@ public:
 
     // Custom data for knots, sparsely allocated, keyed by time.
     std::unordered_map<TsTime, VtDictionary> customData;
+
+    // Summary flags for the knots, in the same order.  Unlike the caches
+    // below, this is kept current as knots are edited, rather than discarded.
+    // Code that modifies knots directly, rather than through the methods of
+    // this class, must update or rebuild it.
+    Ts_SplineSummary summary;
+
+    // Precomputed evaluation data, built by TsSpline::Compile.  When present,
+    // evaluation uses it.
+    Ts_SplineDataCache<Ts_CompiledSpline> compiled;
+
+    // Loop and extrapolation topology, built on first evaluation.
+    Ts_SplineDataCache<Ts_LoopTopology> loopTopology;
+
+    // Segment value bounds, built on first value range query.
+    Ts_SplineDataCache<Ts_ValueRangeTree> valueRangeTree;
+
+    // Segment areas, built on first integration.
+    Ts_SplineDataCache<Ts_IntegralTable> integralTable;
+
+    // Knots unrolled from inner loops, built on first whole-spline query of a
+    // spline that has them.
+    Ts_SplineDataCache<Ts_UnrolledKnots> unrolledKnots;
 };
 
 
@@ -154,6 +281,10 @@ public:
     Ts_KnotData* GetKnotPtrAtIndex(size_t index) override;
     Ts_TypedKnotData<double>
         GetKnotDataAsDouble(size_t index) const override;
+    void GetKnotRangeAsDouble(
+        size_t firstIndex,
+        size_t count,
+        Ts_TypedKnotData<double> *out) const override;
 
     void ClearKnots() override;
     void RemoveKnotAtTime(TsTime time) override;
@@ -298,11 +429,13 @@ size_t Ts_TypedSplineData<T>::SetKnot(
     {
         times[idx] = knotData->time;
         knots[idx] = *typedKnotData;
+        summary.KnotChanged(this, idx);
     }
     else
     {
         times.insert(it, knotData->time);
         knots.insert(knots.begin() + idx, *typedKnotData);
+        summary.KnotInserted(this, idx);
     }
 
     // Store customData, if any.
@@ -351,28 +484,28 @@ Ts_TypedKnotData<double>
 Ts_TypedSplineData<T>::GetKnotDataAsDouble(
     const size_t index) const
 {
-    const Ts_TypedKnotData<T> &in = knots[index];
     Ts_TypedKnotData<double> out;
-
-    // Use operator= to copy base-class members.  This is admittedly weird, but
-    // it will continue working if members are added to the base class.
-    static_cast<Ts_KnotData&>(out) = static_cast<const Ts_KnotData&>(in);
-
-    // Copy derived members individually.
-    out.value = in.value;
-    out.preValue = in.preValue;
-    out.preTanSlope = in.preTanSlope;
-    out.postTanSlope = in.postTanSlope;
-
+    Ts_ConvertKnotDataToDouble(&knots[index], 1, &out);
     return out;
 }
 
+template <typename T>
+void
+Ts_TypedSplineData<T>::GetKnotRangeAsDouble(
+    const size_t firstIndex,
+    const size_t count,
+    Ts_TypedKnotData<double>* const out) const
+{
+    Ts_ConvertKnotDataToDouble(knots.data() + firstIndex, count, out);
+}
+
 template <typename T>
 void Ts_TypedSplineData<T>::ClearKnots()
 {
     times.clear();
     customData.clear();
     knots.clear();
+    summary.Clear();
 }
 
 template <typename T>
@@ -390,6 +523,7 @@ void Ts_TypedSplineData<T>::RemoveKnotAtTime(
     times.erase(it);
     customData.erase(time);
     knots.erase(knots.begin() + idx);
+    summary.KnotRemoved(this, idx);
 }
 
 template <typename T>
@@ -487,6 +621,10 @@ void Ts_TypedSplineData<T>::ApplyOffsetAndScale(
         }
         customData.swap(newCustomData);
     }
+
+    // Slopes and widths are scaled, and comparisons among them may round
+    // differently.
+    summary.Rebuild(this);
 }
 
 template <typename T>
@@ -503,15 +641,10 @@ bool Ts_TypedSplineData<T>::HasValueBlocks() const
         return true;
     }
 
-    for (const Ts_TypedKnotData<T> &knotData : knots)
-    {
-        if (knotData.nextInterp == TsInterpValueBlock)
-        {
-            return true;
-        }
-    }
-
-    return false;
+    // The summary covers segments.  The last knot has no segment, but a
+    // value-block interpolation mode there still counts.
+    return summary.HasAny(Ts_SummarySegmentBlocked)
+        || knots.back().nextInterp == TsInterpValueBlock;
 }
 
 template <typename T>
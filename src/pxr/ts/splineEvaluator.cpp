@@ -0,0 +1,80 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include "./splineEvaluator.h"
+#include "./evalImpl.h"
+#include "./splineData.h"
+#include "./typeHelpers.h"
+
+#include <pxr/tf/diagnostic.h>
+
+namespace pxr {
+
+
+TsSplineEvaluator::TsSplineEvaluator(
+    const TsSpline &spline,
+    const TsEvalOptions &options)
+    : _spline(spline),
+      _data(_spline._GetData()),
+      _options(options),
+      _topology(_data->GetLoopTopology()),
+      _cursor(std::make_unique<Ts_EvalCursor>(_data))
+{
+}
+
+TsSplineEvaluator::~TsSplineEvaluator() = default;
+
+std::optional<double>
+TsSplineEvaluator::_Eval(
+    const TsTime time,
+    const Ts_EvalAspect aspect,
+    const Ts_EvalLocation location)
+{
+    // If no knots, no value or slope.
+    if (_data->times.empty())
+    {
+        return std::nullopt;
+    }
+
+    return Ts_Eval(
+        _data, _topology, _cursor.get(), time, aspect, location, _options);
+}
+
+template <>
+bool TsSplineEvaluator::_Eval(
+    const TsTime time,
+    VtValue* const valueOut,
+    const Ts_EvalAspect aspect,
+    const Ts_EvalLocation location)
+{
+    const std::optional<double> result = _Eval(time, aspect, location);
+
+    if (!result)
+    {
+        return false;
+    }
+
+    const TfType valueType = _data->GetValueType();
+
+#define _ASSIGN_TYPE(unused, tuple)                                       \
+    if (valueType == Ts_GetType<TS_SPLINE_VALUE_CPP_TYPE(tuple)>())       \
+    {                                                                     \
+        *valueOut = TS_SPLINE_VALUE_CPP_TYPE(tuple)(*result);             \
+        return true;                                                      \
+    }
+
+    TF_PP_SEQ_FOR_EACH(_ASSIGN_TYPE, ~, TS_SPLINE_SUPPORTED_VALUE_TYPES);
+
+    TF_CODING_ERROR("Unsupported spline value type");
+
+#undef _ASSIGN_TYPE
+
+    return false;
+}
+
+
+}  // namespace pxr
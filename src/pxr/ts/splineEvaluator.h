@@ -0,0 +1,186 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#ifndef PXR_TS_SPLINE_EVALUATOR_H
+#define PXR_TS_SPLINE_EVALUATOR_H
+
+#include "./api.h"
+#include "./spline.h"
+#include "./eval.h"
+#include "./types.h"
+#include <pxr/vt/value.h>
+
+#include <memory>
+#include <optional>
+
+namespace pxr {
+
+struct Ts_LoopTopology;
+class Ts_EvalCursor;
+
+
+/// Evaluates one spline repeatedly, carrying state from one evaluation to the
+/// next.
+///
+/// TsSpline::Eval performs per-spline setup, and a binary search for the knots
+/// surrounding the evaluation time, on every call.  An evaluator does the setup
+/// once, at construction, and remembers which segment the previous evaluation
+/// fell in.  When the next time falls in the same segment, or an adjacent one,
+/// as is typical in playback and simulation, the knots are found without a
+/// search.  Times may be in any order; results are identical to those of
+/// TsSpline::Eval with the same options.
+///
+/// An evaluator holds a copy of the spline, which shares its data.  Because
+/// splines are copy-on-write, edits to the original spline, including edits on
+/// other threads, cause the original to duplicate its data, and don't affect
+/// the evaluator, which continues to evaluate the spline as it was at
+/// construction.  To pick up edits, create a new evaluator.  Likewise, compiled
+/// data (see TsSpline::Compile) is used only if it exists when the evaluator is
+/// created.
+///
+/// Evaluators are cheap to create, but evaluation modifies their state, so an
+/// evaluator must not be used by more than one thread at a time.  Give each
+/// thread its own.
+///
+class TsSplineEvaluator
+{
+public:
+    TS_API
+    explicit TsSplineEvaluator(
+        const TsSpline &spline,
+        const TsEvalOptions &options = TsEvalOptions());
+
+    TS_API
+    ~TsSplineEvaluator();
+
+    /// Returns the spline being evaluated.
+    const TsSpline& GetSpline() const { return _spline; }
+
+    /// Returns the options used for evaluation.
+    const TsEvalOptions& GetOptions() const { return _options; }
+
+    /// \name Evaluation
+    /// @{
+    ///
+    /// These are equivalent to the TsSpline methods of the same names.  The T
+    /// parameter may be the value type of the spline (double/float/GfHalf), or
+    /// VtValue.
+
+    template <typename T>
+    bool Eval(
+        TsTime time,
+        T *valueOut);
+
+    template <typename T>
+    bool EvalPreValue(
+        TsTime time,
+        T *valueOut);
+
+    template <typename T>
+    bool EvalDerivative(
+        TsTime time,
+        T *valueOut);
+
+    template <typename T>
+    bool EvalPreDerivative(
+        TsTime time,
+        T *valueOut);
+
+    template <typename T>
+    bool EvalHeld(
+        TsTime time,
+        T *valueOut);
+
+    template <typename T>
+    bool EvalPreValueHeld(
+        TsTime time,
+        T *valueOut);
+
+    /// @}
+
+private:
+    TS_API
+    std::optional<double> _Eval(
+        TsTime time,
+        Ts_EvalAspect aspect,
+        Ts_EvalLocation location);
+
+    template <typename T>
+    bool _Eval(
+        TsTime time,
+        T *valueOut,
+        Ts_EvalAspect aspect,
+        Ts_EvalLocation location);
+
+private:
+    // Our copy of the spline, which keeps the data alive and unchanged.
+    const TsSpline _spline;
+    const Ts_SplineData* const _data;
+    const TsEvalOptions _options;
+
+    // Per-spline setup, which is cached on the data, and search state.  The
+    // cursor is private to the library, so it is held by pointer.
+    const Ts_LoopTopology &_topology;
+    const std::unique_ptr<Ts_EvalCursor> _cursor;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+// TEMPLATE IMPLEMENTATIONS
+
+template <typename T>
+bool TsSplineEvaluator::_Eval(
+    const TsTime time,
+    T* const valueOut,
+    const Ts_EvalAspect aspect,
+    const Ts_EvalLocation location)
+{
+    const std::optional<double> result = _Eval(time, aspect, location);
+
+    if (!result)
+    {
+        return false;
+    }
+
+    *valueOut = T(*result);
+    return true;
+}
+
+// As in TsSpline, ensure that VtValue output holds the spline's value type.
+template <>
+TS_API
+bool TsSplineEvaluator::_Eval(
+    const TsTime time,
+    VtValue* const valueOut,
+    const Ts_EvalAspect aspect,
+    const Ts_EvalLocation location);
+
+#define TS_SPLINE_EVALUATOR_DEFINE_EVAL(method, aspect, location)      \
+    template <typename T>                                               \
+    bool TsSplineEvaluator::method(                                     \
+        const TsTime time,                                              \
+        T* const valueOut)                                              \
+    {                                                                   \
+        return _Eval(time, valueOut, aspect, location);                 \
+    }
+
+TS_SPLINE_EVALUATOR_DEFINE_EVAL(Eval, Ts_EvalValue, Ts_EvalAtTime)
+TS_SPLINE_EVALUATOR_DEFINE_EVAL(EvalPreValue, Ts_EvalValue, Ts_EvalPre)
+TS_SPLINE_EVALUATOR_DEFINE_EVAL(
+    EvalDerivative, Ts_EvalDerivative, Ts_EvalAtTime)
+TS_SPLINE_EVALUATOR_DEFINE_EVAL(
+    EvalPreDerivative, Ts_EvalDerivative, Ts_EvalPre)
+TS_SPLINE_EVALUATOR_DEFINE_EVAL(EvalHeld, Ts_EvalHeldValue, Ts_EvalAtTime)
+TS_SPLINE_EVALUATOR_DEFINE_EVAL(
+    EvalPreValueHeld, Ts_EvalHeldValue, Ts_EvalPre)
+
+#undef TS_SPLINE_EVALUATOR_DEFINE_EVAL
+
+
+}  // namespace pxr
+
+#endif
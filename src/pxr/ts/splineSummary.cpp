@@ -0,0 +1,645 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include "./splineSummary.h"
+#include "./eval.h"
+#include "./evalImpl.h"
+#include "./splineData.h"
+#include "./regressionPreventer.h"
+#include <pxr/tf/diagnostic.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace pxr {
+
+
+////////////////////////////////////////////////////////////////////////////////
+// SEGMENT AND KNOT FLAGS
+
+// The four value control points of a curved segment, as a Bezier.  Bezier
+// segments are de-regressed the same way evaluation does it.  Also returns the
+// tangent widths, which for Hermite segments are always a third of the
+// segment.
+//
+static void
+_GetCurveControlValues(
+    const Ts_TypedKnotData<double> &beginKnot,
+    const Ts_TypedKnotData<double> &endKnot,
+    double valuesOut[4],
+    double* const postTanWidthOut = nullptr,
+    double* const preTanWidthOut = nullptr)
+{
+    if (beginKnot.curveType == TsCurveTypeBezier)
+    {
+        Ts_TypedKnotData<double> begin = beginKnot, end = endKnot;
+        Ts_RegressionPreventerBatchAccess::ProcessSegment(
+            &begin, &end, TsAntiRegressionKeepRatio);
+
+        valuesOut[0] = begin.value;
+        valuesOut[1] = begin.value + begin.GetPostTanHeight();
+        valuesOut[2] = end.GetPreValue() + end.GetPreTanHeight();
+        valuesOut[3] = end.GetPreValue();
+
+        if (postTanWidthOut)
+        {
+            *postTanWidthOut = begin.postTanWidth;
+        }
+        if (preTanWidthOut)
+        {
+            *preTanWidthOut = end.preTanWidth;
+        }
+    }
+    else
+    {
+        const double third = (endKnot.time - beginKnot.time) / 3;
+
+        valuesOut[0] = beginKnot.value;
+        valuesOut[1] = beginKnot.value + beginKnot.postTanSlope * third;
+        valuesOut[2] = endKnot.GetPreValue() - endKnot.preTanSlope * third;
+        valuesOut[3] = endKnot.GetPreValue();
+
+        if (postTanWidthOut)
+        {
+            *postTanWidthOut = third;
+        }
+        if (preTanWidthOut)
+        {
+            *preTanWidthOut = third;
+        }
+    }
+}
+
+bool
+Ts_IsSegmentFlat(
+    const Ts_TypedKnotData<double> &beginKnot,
+    const Ts_TypedKnotData<double> &endKnot)
+{
+    switch (beginKnot.nextInterp)
+    {
+        case TsInterpValueBlock:
+            return false;
+
+        case TsInterpHeld:
+            return true;
+
+        case TsInterpLinear:
+            return beginKnot.value == endKnot.GetPreValue();
+
+        case TsInterpCurve:
+        {
+            double values[4];
+            _GetCurveControlValues(beginKnot, endKnot, values);
+            return values[1] == values[0]
+                && values[2] == values[0]
+                && values[3] == values[0];
+        }
+    }
+
+    return false;
+}
+
+bool
+Ts_IsSegmentMonotonic(
+    const Ts_TypedKnotData<double> &beginKnot,
+    const Ts_TypedKnotData<double> &endKnot)
+{
+    switch (beginKnot.nextInterp)
+    {
+        case TsInterpValueBlock:
+            return false;
+
+        case TsInterpHeld:
+        case TsInterpLinear:
+            return true;
+
+        case TsInterpCurve:
+        {
+            // Time increases with the curve parameter, so the segment is
+            // monotonic if its value cubic is monotonic on [0, 1].  The
+            // derivative is a quadratic Bernstein polynomial with coefficients
+            // d0, d1, d2.  It is non-negative on [0, 1] iff d0 and d2 are, and
+            // either d1 is too, or the interior minimum is; that is, d1^2 <=
+            // d0 * d2.  Non-positive is symmetric.
+            double v[4];
+            _GetCurveControlValues(beginKnot, endKnot, v);
+            const double d0 = v[1] - v[0];
+            const double d1 = v[2] - v[1];
+            const double d2 = v[3] - v[2];
+            const bool interiorOk = (d1 * d1 <= d0 * d2);
+            const bool nonDecreasing =
+                d0 >= 0 && d2 >= 0 && (d1 >= 0 || interiorOk);
+            const bool nonIncreasing =
+                d0 <= 0 && d2 <= 0 && (d1 <= 0 || interiorOk);
+            return nonDecreasing || nonIncreasing;
+        }
+    }
+
+    return false;
+}
+
+// The slope of a segment at one of its ends, as seen by derivative evaluation
+// at a knot.
+//
+static double
+_GetSegmentEndSlope(
+    const Ts_TypedKnotData<double> &beginKnot,
+    const Ts_TypedKnotData<double> &endKnot,
+    const bool atBegin)
+{
+    switch (beginKnot.nextInterp)
+    {
+        case TsInterpLinear:
+            return (endKnot.GetPreValue() - beginKnot.value)
+                / (endKnot.time - beginKnot.time);
+
+        case TsInterpCurve:
+            return (atBegin ? beginKnot.postTanSlope : endKnot.preTanSlope);
+
+        default:
+            return 0;
+    }
+}
+
+uint16_t
+Ts_ComputeSummaryFlags(
+    const Ts_TypedKnotData<double>* const prevKnot,
+    const Ts_TypedKnotData<double> &knot,
+    const Ts_TypedKnotData<double>* const nextKnot)
+{
+    uint16_t flags = 0;
+
+    // The segment that starts here.
+    if (nextKnot)
+    {
+        switch (knot.nextInterp)
+        {
+            case TsInterpValueBlock:
+                flags |= Ts_SummarySegmentBlocked | Ts_SummarySegmentNonLinear;
+                break;
+            case TsInterpHeld:
+                flags |= Ts_SummarySegmentNonLinear;
+                break;
+            case TsInterpCurve:
+                flags |= Ts_SummarySegmentCurve | Ts_SummarySegmentNonLinear;
+                break;
+            default:
+                break;
+        }
+
+        if (knot.nextInterp != TsInterpValueBlock)
+        {
+            if (!Ts_IsSegmentFlat(knot, *nextKnot))
+            {
+                flags |= Ts_SummarySegmentVarying;
+            }
+            if (Ts_IsSegmentMonotonic(knot, *nextKnot))
+            {
+                flags |= Ts_SummarySegmentMonotonic;
+            }
+        }
+    }
+
+    // Value changes, whether or not they are hidden by value blocks.
+    if ((prevKnot && prevKnot->value != knot.value)
+        || knot.GetPreValue() != knot.value)
+    {
+        flags |= Ts_SummaryKnotValueChange;
+    }
+
+    // Continuity.  Skip knots that are adjacent to value blocks.
+    const bool blockedBefore =
+        prevKnot && prevKnot->nextInterp == TsInterpValueBlock;
+    const bool blockedAfter =
+        nextKnot && knot.nextInterp == TsInterpValueBlock;
+    if (blockedBefore || blockedAfter)
+    {
+        return flags;
+    }
+
+    // The value approached from before, as evaluated at the knot.
+    const double preValue =
+        (prevKnot && prevKnot->nextInterp == TsInterpHeld ?
+            prevKnot->value : knot.GetPreValue());
+    if (preValue != knot.value)
+    {
+        flags |= Ts_SummaryKnotC0Break
+            | Ts_SummaryKnotG1Break
+            | Ts_SummaryKnotC1Break;
+        return flags;
+    }
+
+    // Slopes and widths are compared only between two segments.  End knots
+    // join extrapolation, which is examined separately.
+    if (!prevKnot || !nextKnot)
+    {
+        return flags;
+    }
+
+    if (_GetSegmentEndSlope(*prevKnot, knot, /* atBegin = */ false)
+        != _GetSegmentEndSlope(knot, *nextKnot, /* atBegin = */ true))
+    {
+        flags |= Ts_SummaryKnotG1Break | Ts_SummaryKnotC1Break;
+        return flags;
+    }
+
+    if (prevKnot->nextInterp == TsInterpCurve
+        && knot.nextInterp == TsInterpCurve)
+    {
+        double values[4];
+        double preTanWidth = 0, postTanWidth = 0;
+        _GetCurveControlValues(
+            *prevKnot, knot, values, nullptr, &preTanWidth);
+        _GetCurveControlValues(
+            knot, *nextKnot, values, &postTanWidth, nullptr);
+        if (preTanWidth != postTanWidth)
+        {
+            flags |= Ts_SummaryKnotC1Break;
+        }
+    }
+
+    return flags;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// SUMMARY MAINTENANCE
+
+void Ts_SplineSummary::_Set(
+    const size_t index,
+    const uint16_t flags)
+{
+    const uint16_t oldFlags = _flags[index];
+    _flags[index] = flags;
+
+    const uint16_t changed = oldFlags ^ flags;
+    for (size_t bit = 0; changed >> bit; bit++)
+    {
+        if (changed & (1u << bit))
+        {
+            if (flags & (1u << bit))
+            {
+                _counts[bit]++;
+            }
+            else
+            {
+                _counts[bit]--;
+            }
+        }
+    }
+}
+
+void Ts_SplineSummary::Rebuild(
+    const Ts_SplineData* const data)
+{
+    const size_t size = data->times.size();
+    std::vector<Ts_TypedKnotData<double>> knots(size);
+    if (size)
+    {
+        data->GetKnotRangeAsDouble(0, size, knots.data());
+    }
+    Rebuild(knots);
+}
+
+void Ts_SplineSummary::Rebuild(
+    const std::vector<Ts_TypedKnotData<double>> &knots)
+{
+    Clear();
+    _flags.resize(knots.size(), 0);
+
+    const size_t size = knots.size();
+    for (size_t i = 0; i < size; i++)
+    {
+        _Set(i, Ts_ComputeSummaryFlags(
+                 i > 0 ? &knots[i - 1] : nullptr,
+                 knots[i],
+                 i + 1 < size ? &knots[i + 1] : nullptr));
+    }
+}
+
+void Ts_SplineSummary::KnotsChanged(
+    const Ts_SplineData* const data,
+    const size_t firstIndex,
+    const size_t lastIndex)
+{
+    const size_t size = data->times.size();
+    if (!TF_VERIFY(size == _flags.size()) || firstIndex >= size)
+    {
+        return;
+    }
+
+    // Convert the changed knots and their neighbors into a buffer on the
+    // stack, a window at a time.  Single-knot edits change at most five
+    // knots, and need one window.
+    constexpr size_t bufferSize = 8;
+    constexpr size_t windowSize = bufferSize - 2;
+    Ts_TypedKnotData<double> knots[bufferSize];
+
+    const size_t last = std::min(lastIndex, size - 1);
+    for (size_t start = firstIndex; start <= last; start += windowSize)
+    {
+        const size_t end = std::min(last, start + windowSize - 1);
+        const size_t readStart = (start > 0 ? start - 1 : 0);
+        const size_t readEnd = std::min(end + 1, size - 1);
+        data->GetKnotRangeAsDouble(
+            readStart, readEnd - readStart + 1, knots);
+
+        for (size_t i = start; i <= end; i++)
+        {
+            const size_t k = i - readStart;
+            _Set(i, Ts_ComputeSummaryFlags(
+                     i > 0 ? &knots[k - 1] : nullptr,
+                     knots[k],
+                     i < size - 1 ? &knots[k + 1] : nullptr));
+        }
+    }
+}
+
+void Ts_SplineSummary::KnotChanged(
+    const Ts_SplineData* const data,
+    const size_t index)
+{
+    // The knot's flags depend on its neighbors, and its neighbors' flags
+    // depend on it.
+    KnotsChanged(data, (index > 0 ? index - 1 : 0), index + 1);
+}
+
+void Ts_SplineSummary::KnotInserted(
+    const Ts_SplineData* const data,
+    const size_t index)
+{
+    _flags.insert(_flags.begin() + index, 0);
+    KnotChanged(data, index);
+}
+
+void Ts_SplineSummary::KnotRemoved(
+    const Ts_SplineData* const data,
+    const size_t index)
+{
+    _Set(index, 0);
+    _flags.erase(_flags.begin() + index);
+
+    // The former neighbors are now adjacent.
+    if (index > 0)
+    {
+        KnotsChanged(data, index - 1, index);
+    }
+    else
+    {
+        KnotsChanged(data, 0, 0);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// UNROLLED KNOTS
+
+Ts_UnrolledKnots::Ts_UnrolledKnots(
+    const Ts_SplineData* const data)
+{
+    Ts_UnrollKnots(data, data->GetLoopTopology(), &knots);
+
+    times.reserve(knots.size());
+    for (const Ts_TypedKnotData<double> &knot : knots)
+    {
+        times.push_back(knot.time);
+    }
+
+    summary.Rebuild(knots);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// QUERIES
+
+namespace
+{
+    // The knots that whole-spline queries examine.  These are the authored
+    // knots, except with inner loops, when they are the unrolled knots.
+    class _SummaryKnots
+    {
+    public:
+        explicit _SummaryKnots(const Ts_SplineData* const data)
+            : _data(data)
+            , _unrolled(data->HasInnerLoops() ?
+                  &data->GetUnrolledKnots() : nullptr)
+        {
+        }
+
+        const std::vector<TsTime>& GetTimes() const
+        {
+            return (_unrolled ? _unrolled->times : _data->times);
+        }
+
+        const Ts_SplineSummary& GetSummary() const
+        {
+            return (_unrolled ? _unrolled->summary : _data->summary);
+        }
+
+        Ts_TypedKnotData<double> GetKnot(const size_t index) const
+        {
+            return (_unrolled ?
+                _unrolled->knots[index] : _data->GetKnotDataAsDouble(index));
+        }
+
+    private:
+        const Ts_SplineData* const _data;
+        const Ts_UnrolledKnots* const _unrolled;
+    };
+}
+
+bool
+Ts_IsVarying(
+    const Ts_SplineData* const data)
+{
+    if (data->times.empty())
+    {
+        return false;
+    }
+
+    const _SummaryKnots knots(data);
+    const Ts_SplineSummary &summary = knots.GetSummary();
+    if (summary.HasAny(Ts_SummaryKnotValueChange)
+        || summary.HasAny(Ts_SummarySegmentVarying))
+    {
+        return true;
+    }
+
+    // All knots have the same value, and segments are flat.  Non-looping
+    // extrapolation may still slope away.  Looping extrapolation repeats
+    // values that have already been examined.
+    const Ts_LoopTopology &topology = data->GetLoopTopology();
+    const TsEvalOptions options;
+    if (!topology.havePreExtrapLoops)
+    {
+        const std::optional<double> slope = Ts_Eval(
+            data, knots.GetTimes().front(),
+            Ts_EvalDerivative, Ts_EvalPre, options);
+        if (slope && *slope != 0)
+        {
+            return true;
+        }
+    }
+    if (!topology.havePostExtrapLoops)
+    {
+        const std::optional<double> slope = Ts_Eval(
+            data, knots.GetTimes().back(),
+            Ts_EvalDerivative, Ts_EvalPost, options);
+        if (slope && *slope != 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool
+Ts_IsLinear(
+    const Ts_SplineData* const data)
+{
+    if (data->times.size() < 2)
+    {
+        return false;
+    }
+
+    const _SummaryKnots knots(data);
+    return !knots.GetSummary().HasAny(Ts_SummarySegmentNonLinear);
+}
+
+bool
+Ts_IsContinuous(
+    const Ts_SplineData* const data,
+    const Ts_SplineSummaryFlag breakFlag)
+{
+    if (data->times.empty())
+    {
+        return true;
+    }
+
+    // Value blocks are discontinuities.  A block on the last knot has no
+    // effect, and isn't considered.
+    const _SummaryKnots knots(data);
+    const Ts_SplineSummary &summary = knots.GetSummary();
+    if (summary.HasAny(Ts_SummarySegmentBlocked)
+        || data->preExtrapolation.mode == TsExtrapValueBlock
+        || data->postExtrapolation.mode == TsExtrapValueBlock)
+    {
+        return false;
+    }
+
+    // Interior knots.
+    if (summary.HasAny(breakFlag))
+    {
+        return false;
+    }
+
+    // Joins with non-looping extrapolation.  Evaluate on both sides.
+    const Ts_LoopTopology &topology = data->GetLoopTopology();
+    const std::vector<TsTime> &times = knots.GetTimes();
+    const bool checkSlopes = (breakFlag != Ts_SummaryKnotC0Break);
+    const TsEvalOptions options;
+    for (const bool pre : {true, false})
+    {
+        if (pre ? topology.havePreExtrapLoops : topology.havePostExtrapLoops)
+        {
+            continue;
+        }
+
+        const TsTime time = (pre ? times.front() : times.back());
+        if (Ts_Eval(data, time, Ts_EvalValue, Ts_EvalPre, options)
+                != Ts_Eval(data, time, Ts_EvalValue, Ts_EvalPost, options)
+            || (checkSlopes
+                && Ts_Eval(data, time, Ts_EvalDerivative, Ts_EvalPre, options)
+                    != Ts_Eval(
+                        data, time, Ts_EvalDerivative, Ts_EvalPost, options)))
+        {
+            return false;
+        }
+    }
+
+    // Joins between extrapolating loop iterations, where the end of the last
+    // segment meets the start of the first, or its mirror image.  As when
+    // evaluating, the mode is taken from pre-extrapolation for both sides, and
+    // modes other than Repeat and Oscillate join like Reset.
+    if (!topology.havePreExtrapLoops && !topology.havePostExtrapLoops)
+    {
+        return true;
+    }
+
+    const size_t size = times.size();
+    const Ts_TypedKnotData<double> first = knots.GetKnot(0);
+    const Ts_TypedKnotData<double> second = knots.GetKnot(1);
+    const Ts_TypedKnotData<double> secondToLast = knots.GetKnot(size - 2);
+    const Ts_TypedKnotData<double> last = knots.GetKnot(size - 1);
+    const double firstSlope =
+        _GetSegmentEndSlope(first, second, /* atBegin = */ true);
+    const double lastSlope =
+        _GetSegmentEndSlope(secondToLast, last, /* atBegin = */ false);
+    const TsExtrapMode mode = data->preExtrapolation.mode;
+
+    if (mode == TsExtrapLoopOscillate)
+    {
+        // Each end meets its own mirror image, which has the same value and
+        // tangent width, and the opposite slope.
+        return !checkSlopes || (firstSlope == 0 && lastSlope == 0);
+    }
+
+    // Repeat offsets each iteration so that values meet; dual values and held
+    // segments at the ends are already recorded as knot breaks.  Reset
+    // doesn't.
+    const double lastValue =
+        (secondToLast.nextInterp == TsInterpHeld ?
+            secondToLast.value : last.GetPreValue());
+    if (mode != TsExtrapLoopRepeat && lastValue != first.value)
+    {
+        return false;
+    }
+
+    if (checkSlopes && firstSlope != lastSlope)
+    {
+        return false;
+    }
+
+    if (breakFlag == Ts_SummaryKnotC1Break
+        && first.nextInterp == TsInterpCurve
+        && secondToLast.nextInterp == TsInterpCurve)
+    {
+        double values[4];
+        double postTanWidth = 0, preTanWidth = 0;
+        _GetCurveControlValues(
+            first, second, values, &postTanWidth, nullptr);
+        _GetCurveControlValues(
+            secondToLast, last, values, nullptr, &preTanWidth);
+        if (postTanWidth != preTanWidth)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool
+Ts_GetSegmentSummary(
+    const Ts_SplineData* const data,
+    const TsTime startTime,
+    uint16_t* const flagsOut)
+{
+    const _SummaryKnots knots(data);
+    const std::vector<TsTime> &times = knots.GetTimes();
+
+    const auto it = std::lower_bound(times.begin(), times.end(), startTime);
+    if (it == times.end() || *it != startTime || it + 1 == times.end())
+    {
+        return false;
+    }
+
+    *flagsOut = knots.GetSummary().GetFlags(it - times.begin());
+    return true;
+}
+
+
+}  // namespace pxr
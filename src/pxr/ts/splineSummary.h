@@ -0,0 +1,210 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#ifndef PXR_TS_SPLINE_SUMMARY_H
+#define PXR_TS_SPLINE_SUMMARY_H
+
+#include "./api.h"
+#include "./knotData.h"
+#include "./types.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace pxr {
+
+struct Ts_SplineData;
+
+
+// Facts about one knot, and about the segment that starts at it.  Each knot's
+// flags depend only on that knot and its immediate neighbors, so they can be
+// kept up to date as knots are edited, without examining the whole spline.
+//
+enum Ts_SplineSummaryFlag : uint16_t
+{
+    // The segment that starts at the knot.  Never set for the last knot.
+    Ts_SummarySegmentBlocked = 1 << 0,
+    Ts_SummarySegmentCurve = 1 << 1,
+    Ts_SummarySegmentNonLinear = 1 << 2,
+    Ts_SummarySegmentVarying = 1 << 3,     // Not blocked, and not flat.
+    Ts_SummarySegmentMonotonic = 1 << 4,   // Not blocked.
+
+    // The knot itself.  ValueChange: the knot's value differs from the
+    // previous knot's, or its two sides differ.  C0Break: the value approached
+    // from before the knot differs from the value at the knot.  G1Break:
+    // C0Break, or an interior knot whose slopes differ on its two sides.
+    // C1Break: G1Break, or an interior knot between two curved segments whose
+    // tangents differ in width.  Breaks adjacent to value blocks are ignored;
+    // value blocks are discontinuities of their own.
+    Ts_SummaryKnotValueChange = 1 << 5,
+    Ts_SummaryKnotC0Break = 1 << 6,
+    Ts_SummaryKnotG1Break = 1 << 7,
+    Ts_SummaryKnotC1Break = 1 << 8
+};
+
+constexpr size_t Ts_SummaryNumFlags = 9;
+
+// Summary flags for all of a spline's knots, plus a count of the knots that
+// have each flag, so that whole-spline queries take constant time.
+//
+// Ts_SplineData keeps a summary of its authored knots, updating it as knots
+// are set and removed.  A summary can also be built for an arbitrary sequence
+// of knots, such as knots unrolled from inner loops.
+//
+class Ts_SplineSummary
+{
+public:
+    // Recomputes all flags from scratch.
+    TS_API
+    void Rebuild(const Ts_SplineData *data);
+    TS_API
+    void Rebuild(const std::vector<Ts_TypedKnotData<double>> &knots);
+
+    void Clear();
+
+    // Updates flags after a knot has been inserted at, overwritten at, or
+    // removed from, the specified index.  The summary must have been current
+    // before the edit.
+    TS_API
+    void KnotInserted(const Ts_SplineData *data, size_t index);
+    TS_API
+    void KnotChanged(const Ts_SplineData *data, size_t index);
+    TS_API
+    void KnotRemoved(const Ts_SplineData *data, size_t index);
+
+    // Recomputes flags for knots in [firstIndex, lastIndex], after more than
+    // one knot in that range has changed.  Indices are clamped to the knots
+    // that exist; lastIndex may be past the end.
+    TS_API
+    void KnotsChanged(
+        const Ts_SplineData *data, size_t firstIndex, size_t lastIndex);
+
+    // Returns whether any knot has the flag.
+    bool HasAny(Ts_SplineSummaryFlag flag) const;
+
+    // Returns the number of knots that have the flag.
+    size_t GetCount(Ts_SplineSummaryFlag flag) const;
+
+    // Returns the flags for one knot.
+    uint16_t GetFlags(size_t index) const;
+
+    size_t GetSize() const;
+
+private:
+    void _Set(size_t index, uint16_t flags);
+
+private:
+    std::vector<uint16_t> _flags;
+    std::array<uint32_t, Ts_SummaryNumFlags> _counts = {};
+};
+
+// The knots that make up a spline with inner loops, as unrolled, and their
+// summary.  Built on demand for queries that must see echoed knots.
+//
+struct Ts_UnrolledKnots
+{
+public:
+    TS_API
+    explicit Ts_UnrolledKnots(const Ts_SplineData *data);
+
+public:
+    std::vector<TsTime> times;
+    std::vector<Ts_TypedKnotData<double>> knots;
+    Ts_SplineSummary summary;
+};
+
+// Computes summary flags for a knot, given its neighbors.  Either neighbor
+// may be null, if the knot is first or last.
+//
+TS_API
+uint16_t Ts_ComputeSummaryFlags(
+    const Ts_TypedKnotData<double> *prevKnot,
+    const Ts_TypedKnotData<double> &knot,
+    const Ts_TypedKnotData<double> *nextKnot);
+
+// Returns whether the values of a segment are all equal, and whether they
+// never both increase and decrease.  Blocked segments are neither.
+//
+TS_API
+bool Ts_IsSegmentFlat(
+    const Ts_TypedKnotData<double> &beginKnot,
+    const Ts_TypedKnotData<double> &endKnot);
+TS_API
+bool Ts_IsSegmentMonotonic(
+    const Ts_TypedKnotData<double> &beginKnot,
+    const Ts_TypedKnotData<double> &endKnot);
+
+// Whole-spline queries, answered from summaries plus a constant amount of
+// evaluation at the ends of the knots and at loop joins.  See the
+// corresponding TsSpline methods.
+//
+TS_API
+bool Ts_IsVarying(const Ts_SplineData *data);
+TS_API
+bool Ts_IsLinear(const Ts_SplineData *data);
+
+// Returns whether a spline has no discontinuities of the kind that breakFlag
+// records.
+//
+TS_API
+bool Ts_IsContinuous(
+    const Ts_SplineData *data,
+    Ts_SplineSummaryFlag breakFlag);
+
+// Finds the segment that starts at startTime, which may be the time of an
+// authored knot, or of a knot echoed by inner loops, and returns its summary
+// flags.  Returns false if no segment starts there.
+//
+TS_API
+bool Ts_GetSegmentSummary(
+    const Ts_SplineData *data,
+    TsTime startTime,
+    uint16_t *flagsOut);
+
+
+////////////////////////////////////////////////////////////////////////////////
+// INLINE IMPLEMENTATIONS
+
+inline void Ts_SplineSummary::Clear()
+{
+    _flags.clear();
+    _counts.fill(0);
+}
+
+inline bool Ts_SplineSummary::HasAny(const Ts_SplineSummaryFlag flag) const
+{
+    return GetCount(flag) > 0;
+}
+
+inline size_t Ts_SplineSummary::GetCount(
+    const Ts_SplineSummaryFlag flag) const
+{
+    for (size_t bit = 0; bit < Ts_SummaryNumFlags; bit++)
+    {
+        if (flag == (1u << bit))
+        {
+            return _counts[bit];
+        }
+    }
+    return 0;
+}
+
+inline uint16_t Ts_SplineSummary::GetFlags(const size_t index) const
+{
+    return _flags[index];
+}
+
+inline size_t Ts_SplineSummary::GetSize() const
+{
+    return _flags.size();
+}
+
+
+}  // namespace pxr
+
+#endif
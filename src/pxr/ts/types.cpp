@@ -11,6 +11,8 @@
 #include <pxr/tf/enum.h>
 #include <pxr/tf/registryManager.h>
 
+#include <cmath>
+
 namespace pxr {
 
 
@@ -45,6 +47,13 @@ TF_REGISTRY_FUNCTION(pxr::TfEnum)
     TF_ADD_ENUM_NAME(TsSourceKnotInterp, "Knot Interpolation");
     TF_ADD_ENUM_NAME(TsSourcePostExtrap, "Post Extrapolation");
     TF_ADD_ENUM_NAME(TsSourcePostExtrapLoop, "Post Extrapolation Loop");
+
+    TF_ADD_ENUM_NAME(TsBezierSolverCardano, "Cardano");
+    TF_ADD_ENUM_NAME(TsBezierSolverNewton, "Newton");
+    TF_ADD_ENUM_NAME(TsBezierSolverHalley, "Halley");
+
+    TF_ADD_ENUM_NAME(TsBezierFlatteningSubdivide, "Subdivide");
+    TF_ADD_ENUM_NAME(TsBezierFlatteningUniform, "Uniform");
 }
 
 bool TsLoopParams::operator==(const TsLoopParams &other) const
@@ -101,6 +110,42 @@ bool TsExtrapolation::IsLooping() const
     return (mode >= TsExtrapLoopRepeat && mode <= TsExtrapLoopOscillate);
 }
 
+bool TsEvalOptions::operator==(const TsEvalOptions &other) const
+{
+    return
+        bezierSolver == other.bezierSolver
+        && solverTolerance == other.solverTolerance;
+}
+
+bool TsEvalOptions::operator!=(const TsEvalOptions &other) const
+{
+    return !(*this == other);
+}
+
+bool TsShutter::operator==(const TsShutter &other) const
+{
+    return
+        open == other.open
+        && close == other.close
+        && numSamples == other.numSamples;
+}
+
+bool TsShutter::operator!=(const TsShutter &other) const
+{
+    return !(*this == other);
+}
+
+bool TsShutter::IsValid() const
+{
+    return std::isfinite(open) && std::isfinite(close)
+        && open <= close && numSamples > 0;
+}
+
+TsTime TsShutter::GetSampleOffset(const int32_t index) const
+{
+    return open + (index + 0.5) * (close - open) / numSamples;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // TEMPLATE IMPLEMENTATIONS
 
@@ -109,7 +154,9 @@ bool TsExtrapolation::IsLooping() const
     template class TS_API                                               \
         TsSplineSamples< TS_SPLINE_VALUE_CPP_TYPE(tuple) >;             \
     template class TS_API                                               \
-        TsSplineSamplesWithSources< TS_SPLINE_VALUE_CPP_TYPE(tuple) >;
+        TsSplineSamplesWithSources< TS_SPLINE_VALUE_CPP_TYPE(tuple) >; \
+    template class TS_API                                               \
+        TsSplineFlatSamples< TS_SPLINE_VALUE_CPP_TYPE(tuple) >;
 
 TF_PP_SEQ_FOR_EACH(TS_SAMPLE_EXPLICIT_INST, ~, TS_SPLINE_SAMPLE_VERTEX_TYPES)
 #undef TS_SAMPLE_EXTERN_IMPL
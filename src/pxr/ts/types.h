@@ -14,6 +14,7 @@
 #include <pxr/gf/vec2d.h>
 #include <pxr/tf/preprocessorUtilsLite.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -253,13 +254,68 @@ public:
     std::vector<TsSplineSampleSource> sources;
 };
 
+/// \brief \c TsSplineFlatSamples<Vertex> holds the polylines that approximate a
+/// \c TsSpline in contiguous storage, ready to be uploaded or shared without
+/// a gather step.
+///
+/// The vertices of all polylines are in the single \c vertices array.
+/// Polyline \e i is made of the vertices from \c offsets[i] up to, but not
+/// including, \c offsets[i+1], so \c offsets has one more element than there
+/// are polylines, or none if there are no polylines.
+///
+/// If \c withSources is set, \c sources holds the \c TsSplineSampleSource of
+/// each polyline, and polylines are broken where the source changes, as for
+/// \c TsSplineSamplesWithSources.  Otherwise \c sources is left empty, and
+/// polylines are broken as for \c TsSplineSamples.
+///
+/// Sampling clears the arrays but keeps their capacity, so an object that is
+/// reused for repeated sampling stops allocating once it is large enough.
+///
+/// The vertex must be one of \c GfVec2d, \c GfVec2f, or \c GfVec2h.
+///
+/// \sa \ref TsSplineSamples and \ref TsSpline::Sample
+template <typename Vertex>
+class TsSplineFlatSamples
+{
+public:
+    static_assert(TsSplineIsValidSampleType<Vertex>,
+                  "The Vertex template parameter to TsSplineFlatSamples must"
+                  " be one of GfVec2d, GfVec2f, or GfVec2h.");
+
+    bool withSources = false;
+
+    std::vector<Vertex> vertices;
+    std::vector<size_t> offsets;
+    std::vector<TsSplineSampleSource> sources;
+
+    /// Returns the number of polylines.
+    size_t GetNumPolylines() const
+    {
+        return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+
+    /// Returns the number of vertices in polyline \p i.
+    size_t GetPolylineSize(size_t i) const
+    {
+        return offsets[i + 1] - offsets[i];
+    }
+
+    /// Returns a pointer to the first vertex of polyline \p i.
+    const Vertex* GetPolylineData(size_t i) const
+    {
+        return vertices.data() + offsets[i];
+    }
+};
+
 // Declare sampling classes as extern templates. They are explicitly
 // instantiated in types.cpp
 #define TS_SAMPLE_EXTERN_IMPL(unused, tuple)                            \
     TS_API_TEMPLATE_CLASS(                                              \
         TsSplineSamples< TS_SPLINE_VALUE_CPP_TYPE(tuple) >);            \
     TS_API_TEMPLATE_CLASS(                                              \
-        TsSplineSamplesWithSources< TS_SPLINE_VALUE_CPP_TYPE(tuple) >);
+        TsSplineSamplesWithSources< TS_SPLINE_VALUE_CPP_TYPE(tuple) >); \
+    TS_API_TEMPLATE_CLASS(                                              \
+        TsSplineFlatSamples< TS_SPLINE_VALUE_CPP_TYPE(tuple) >);
 TF_PP_SEQ_FOR_EACH(TS_SAMPLE_EXTERN_IMPL, ~, TS_SPLINE_SAMPLE_VERTEX_TYPES)
 #undef TS_SAMPLE_EXTERN_IMPL
 
@@ -292,6 +348,100 @@ enum TsAntiRegressionMode
     TsAntiRegressionKeepStart
 };
 
+/// Methods for finding the Bezier parameter at which a segment reaches an
+/// evaluation time.  This is the costly part of Bezier evaluation.  All methods
+/// rely on the time function being monotonic, which anti-regression
+/// guarantees.
+///
+enum TsBezierSolver
+{
+    /// Closed-form solution using Cardano's formula.  Requires transcendental
+    /// functions, and loses some precision near vertical tangents.
+    TsBezierSolverCardano,
+
+    /// Newton's method, seeded with a linear guess, and safeguarded by
+    /// bisection.  Converges quadratically.
+    TsBezierSolverNewton,
+
+    /// Halley's method, seeded and safeguarded as for Newton.  Converges
+    /// cubically, at the cost of a second derivative per iteration.
+    TsBezierSolverHalley
+};
+
+/// Methods for approximating Bezier segments with polylines when sampling.
+/// Both keep the polylines within the sampling tolerance of the curve.
+///
+enum TsBezierFlattening
+{
+    /// Recursively halve each segment until its control points are within
+    /// the tolerance of its chord.  Adapts to the curvature within each
+    /// segment, so produces the fewest vertices.
+    TsBezierFlatteningSubdivide,
+
+    /// Compute the number of vertices for each segment up front, from a bound
+    /// on the second differences of its control points (Wang's formula), and
+    /// evaluate the curve at evenly spaced parameters.  Needs no recursion or
+    /// flatness tests, and is cheaper per vertex, but the bound is
+    /// conservative, so typically produces more vertices.
+    TsBezierFlatteningUniform
+};
+
+/// Options that control how a spline is evaluated.  The defaults give the
+/// standard behavior; other settings trade speed for accuracy, or vice versa,
+/// but never change which times have values.
+///
+class TsEvalOptions
+{
+public:
+    /// How Bezier segments are solved.
+    TsBezierSolver bezierSolver = TsBezierSolverCardano;
+
+    /// Convergence tolerance for the iterative Bezier solvers.  Iteration stops
+    /// when the Bezier parameter, which is in [0, 1], changes by no more than
+    /// this amount.  Ignored by TsBezierSolverCardano.
+    double solverTolerance = 1e-12;
+
+public:
+    TS_API
+    bool operator==(const TsEvalOptions &other) const;
+
+    TS_API
+    bool operator!=(const TsEvalOptions &other) const;
+};
+
+/// A pattern of subframe sample times, for evaluating a spline over the
+/// shutter interval of each frame, as for motion blur.  The shutter is open
+/// from \c open to \c close, which are offsets from the frame time.  That
+/// interval is divided into \c numSamples equal strata, and each stratum is
+/// sampled at its center.  The defaults sample each frame once, at the frame
+/// time.
+///
+/// \sa TsSpline::EvalShutter
+///
+class TsShutter
+{
+public:
+    TsTime open = 0.0;
+    TsTime close = 0.0;
+    int32_t numSamples = 1;
+
+public:
+    TS_API
+    bool operator==(const TsShutter &other) const;
+
+    TS_API
+    bool operator!=(const TsShutter &other) const;
+
+    /// Returns whether \c open and \c close are finite and in order, and
+    /// there is at least one sample.
+    TS_API
+    bool IsValid() const;
+
+    /// Returns the offset from the frame time of the sample at \p index.
+    TS_API
+    TsTime GetSampleOffset(int32_t index) const;
+};
+
 
 }  // namespace pxr
 
@@ -71,13 +71,15 @@ static void _WrapRemoveKnot(
     spline.RemoveKnot(time);
 }
 
-#define WRAP_EVAL(method)                                   \
-    static object _Wrap##method(                            \
-        const TsSpline &spline, const TsTime time)          \
-    {                                                       \
-        double val = 0;                                     \
-        const bool haveValue = spline.method(time, &val);   \
-        return (haveValue ? object(val) : object());        \
+#define WRAP_EVAL(method)                                           \
+    static object _Wrap##method(                                    \
+        const TsSpline &spline,                                     \
+        const TsTime time,                                          \
+        const TsEvalOptions &options)                               \
+    {                                                               \
+        double val = 0;                                             \
+        const bool haveValue = spline.method(time, &val, options);  \
+        return (haveValue ? object(val) : object());                \
     }
 
 WRAP_EVAL(Eval);
@@ -93,7 +95,8 @@ static object _WrapSample(
     double timeScale,
     double valueScale,
     double tolerance,
-    bool withSources)
+    bool withSources,
+    TsBezierFlattening flattening)
 {
     if (withSources) {
         TsSplineSamplesWithSources<GfVec2d> samplesWithSources;
@@ -102,7 +105,8 @@ static object _WrapSample(
                           timeScale,
                           valueScale,
                           tolerance,
-                          &samplesWithSources))
+                          &samplesWithSources,
+                          flattening))
         {
             return object(samplesWithSources);
         }
@@ -113,7 +117,8 @@ static object _WrapSample(
                           timeScale,
                           valueScale,
                           tolerance,
-                          &samples))
+                          &samples,
+                          flattening))
         {
             return object(samples);
         }
@@ -122,6 +127,31 @@ static object _WrapSample(
     return object();
 }
 
+static object _WrapSampleFlat(
+    const TsSpline &spline,
+    const GfInterval& timeInterval,
+    double timeScale,
+    double valueScale,
+    double tolerance,
+    bool withSources,
+    TsBezierFlattening flattening)
+{
+    TsSplineFlatSamples<GfVec2d> samples;
+    samples.withSources = withSources;
+
+    if (spline.Sample(timeInterval,
+                      timeScale,
+                      valueScale,
+                      tolerance,
+                      &samples,
+                      flattening))
+    {
+        return object(samples);
+    }
+
+    return object();
+}
+
 void wrapSpline()
 {
     using This = TsSpline;
@@ -168,19 +198,42 @@ void wrapSpline()
         .def("HasRegressiveTangents", &This::HasRegressiveTangents)
         .def("AdjustRegressiveTangents", &This::AdjustRegressiveTangents)
 
-        .def("Eval", &_WrapEval)
-        .def("EvalPreValue", &_WrapEvalPreValue)
-        .def("EvalDerivative", &_WrapEvalDerivative)
-        .def("EvalPreDerivative", &_WrapEvalPreDerivative)
-        .def("EvalHeld", &_WrapEvalHeld)
-        .def("EvalPreValueHeld", &_WrapEvalPreValueHeld)
+        .def("Compile", &This::Compile)
+        .def("IsCompiled", &This::IsCompiled)
+
+        .def("Eval", &_WrapEval,
+             (arg("time"),
+              arg("options") = TsEvalOptions()))
+        .def("EvalPreValue", &_WrapEvalPreValue,
+             (arg("time"),
+              arg("options") = TsEvalOptions()))
+        .def("EvalDerivative", &_WrapEvalDerivative,
+             (arg("time"),
+              arg("options") = TsEvalOptions()))
+        .def("EvalPreDerivative", &_WrapEvalPreDerivative,
+             (arg("time"),
+              arg("options") = TsEvalOptions()))
+        .def("EvalHeld", &_WrapEvalHeld,
+             (arg("time"),
+              arg("options") = TsEvalOptions()))
+        .def("EvalPreValueHeld", &_WrapEvalPreValueHeld,
+             (arg("time"),
+              arg("options") = TsEvalOptions()))
 
         .def("Sample", &_WrapSample,
              (arg("timeInterval"),
               arg("timeScale"),
               arg("valueScale"),
               arg("tolerance"),
-              arg("withSources") = false))
+              arg("withSources") = false,
+              arg("flattening") = TsBezierFlatteningSubdivide))
+        .def("SampleFlat", &_WrapSampleFlat,
+             (arg("timeInterval"),
+              arg("timeScale"),
+              arg("valueScale"),
+              arg("tolerance"),
+              arg("withSources") = false,
+              arg("flattening") = TsBezierFlatteningSubdivide))
 
         .def("DoSidesDiffer", &This::DoSidesDiffer)
 
@@ -10,8 +10,12 @@
 #include <pxr/tf/pyOptional.h>
 
 #include <pxr/boost/python/class.hpp>
+#include <pxr/boost/python/extract.hpp>
+#include <pxr/boost/python/handle.hpp>
 #include <pxr/boost/python/operators.hpp>
 
+#include <vector>
+
 using namespace pxr;
 
 using namespace pxr::boost::python;
@@ -37,6 +41,96 @@ object _WrapSplineSamplesSources(const TsSplineSamplesWithSources<GfVec2d>& samp
     return TfPyCopySequenceToList(samples.sources);
 }
 
+static
+object _WrapFlatSamplesOffsets(const TsSplineFlatSamples<GfVec2d>& samples)
+{
+    return TfPyCopySequenceToList(samples.offsets);
+}
+
+static
+object _WrapFlatSamplesSources(const TsSplineFlatSamples<GfVec2d>& samples)
+{
+    return TfPyCopySequenceToList(samples.sources);
+}
+
+static
+object _WrapFlatSamplesVertices(const object& self)
+{
+    return object(handle<>(PyMemoryView_FromObject(self.ptr())));
+}
+
+// SplineFlatSamples exports its vertices through the buffer protocol, as a
+// read-only N x 2 array of doubles, so that memoryview and numpy.asarray
+// share the C++ storage instead of copying it.  The exported view holds a
+// reference to the samples object, which Python cannot modify, so the storage
+// remains valid for the lifetime of the view.
+static int
+_GetFlatSamplesBuffer(PyObject* self, Py_buffer* view, int flags)
+{
+    static_assert(sizeof(GfVec2d) == 2 * sizeof(double),
+                  "GfVec2d must be two packed doubles");
+
+    view->obj = nullptr;
+    if (flags & PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError,
+                        "SplineFlatSamples vertices are read-only");
+        return -1;
+    }
+
+    // A shape without a format would describe doubles to consumers that
+    // assume unsigned bytes.
+    if ((flags & PyBUF_ND) == PyBUF_ND
+            && (flags & PyBUF_FORMAT) != PyBUF_FORMAT) {
+        PyErr_SetString(PyExc_BufferError,
+                        "SplineFlatSamples vertices require a format "
+                        "when a shape is requested");
+        return -1;
+    }
+
+    extract<const TsSplineFlatSamples<GfVec2d>&> samples(self);
+    if (!samples.check()) {
+        PyErr_SetString(PyExc_BufferError, "Not a SplineFlatSamples");
+        return -1;
+    }
+    const std::vector<GfVec2d>& vertices = samples().vertices;
+
+    // Shape and strides, freed when the view is released.
+    Py_ssize_t* const dims = new Py_ssize_t[4] {
+        Py_ssize_t(vertices.size()), 2,
+        Py_ssize_t(sizeof(GfVec2d)), Py_ssize_t(sizeof(double)) };
+
+    // An empty vector may have no data, but a buffer needs an address.
+    static double empty[2] = {0.0, 0.0};
+
+    view->buf = (vertices.empty() ?
+                 static_cast<void*>(empty) :
+                 const_cast<GfVec2d*>(vertices.data()));
+    view->obj = self;
+    Py_INCREF(self);
+    view->len = Py_ssize_t(vertices.size() * sizeof(GfVec2d));
+    view->readonly = 1;
+
+    // Without a format, consumers see unsigned bytes, so report a flat
+    // array of them.
+    const bool withShape = ((flags & PyBUF_ND) == PyBUF_ND);
+    const bool withFormat = ((flags & PyBUF_FORMAT) == PyBUF_FORMAT);
+    view->itemsize = (withFormat ? sizeof(double) : 1);
+    view->format = (withFormat ? const_cast<char*>("d") : nullptr);
+    view->ndim = (withShape ? 2 : 1);
+    view->shape = (withShape ? dims : nullptr);
+    view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES ?
+                     dims + 2 : nullptr);
+    view->suboffsets = nullptr;
+    view->internal = dims;
+    return 0;
+}
+
+static void
+_ReleaseFlatSamplesBuffer(PyObject* /* self */, Py_buffer* view)
+{
+    delete[] static_cast<Py_ssize_t*>(view->internal);
+}
+
 void wrapSplineSamples()
 {
     class_<TsSplineSamples<GfVec2d>>("SplineSamples", no_init)
@@ -56,6 +150,30 @@ void wrapSplineSamplesWithSources()
         ;
 }
 
+void wrapSplineFlatSamples()
+{
+    using This = TsSplineFlatSamples<GfVec2d>;
+
+    class_<This> cls("SplineFlatSamples", no_init);
+    cls.def_readonly("withSources", &This::withSources)
+        .add_property("vertices", &_WrapFlatSamplesVertices)
+        .add_property("offsets", &_WrapFlatSamplesOffsets)
+        .add_property("sources", &_WrapFlatSamplesSources)
+        .def("GetNumPolylines", &This::GetNumPolylines)
+        .def("GetPolylineSize", &This::GetPolylineSize)
+        ;
+
+    // Boost.Python has no support for the buffer protocol, so install it on
+    // the class's type object directly.
+    static PyBufferProcs bufferProcs = {
+        &_GetFlatSamplesBuffer,
+        &_ReleaseFlatSamplesBuffer
+    };
+    PyTypeObject* const type = reinterpret_cast<PyTypeObject*>(cls.ptr());
+    type->tp_as_buffer = &bufferProcs;
+    PyType_Modified(type);
+}
+
 void wrapTypes()
 {
     TfPyWrapEnum<TsInterpMode>("InterpMode");
@@ -63,6 +181,8 @@ void wrapTypes()
     TfPyWrapEnum<TsExtrapMode>("ExtrapMode");
     TfPyWrapEnum<TsAntiRegressionMode>("AntiRegressionMode");
     TfPyWrapEnum<TsSplineSampleSource>("SplineSampleSource");
+    TfPyWrapEnum<TsBezierSolver>("BezierSolver");
+    TfPyWrapEnum<TsBezierFlattening>("BezierFlattening");
 
     class_<TsLoopParams>("LoopParams")
 
@@ -99,7 +219,21 @@ void wrapTypes()
 
         ;
 
+    class_<TsEvalOptions>("EvalOptions")
+
+        // Default init is not suppressed, so automatically generated.
+
+        .def(init<const TsEvalOptions &>())
+        .def(self == self)
+        .def(self != self)
+
+        .def_readwrite("bezierSolver", &TsEvalOptions::bezierSolver)
+        .def_readwrite("solverTolerance", &TsEvalOptions::solverTolerance)
+
+        ;
+
     wrapSplineSamples();
     wrapSplineSamplesWithSources();
+    wrapSplineFlatSamples();
     
 }
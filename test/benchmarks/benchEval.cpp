@@ -0,0 +1,406 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include "./benchmarks.h"
+
+#include <pxr/ts/parallel.h>
+#include <pxr/ts/knot.h>
+#include <pxr/ts/raii.h>
+#include <pxr/tf/enum.h>
+#include <tsTest/museum.h>
+#include <tsTest/tsEvaluator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace pxr {
+
+
+// Returns evenly spaced times strictly inside an interval, so that every
+// sample evaluates a segment.
+static std::vector<TsTime>
+_GetInteriorTimes(const GfInterval &interval, const int numSamples)
+{
+    std::vector<TsTime> times;
+    for (int i = 1; i < numSamples; ++i) {
+        times.push_back(
+            interval.GetMin() + i * interval.GetSize() / numSamples);
+    }
+    return times;
+}
+
+// Measure the throughput of each solver on cases with vertical and
+// near-vertical tangents, which are the hardest for all of them, and report it
+// along with the largest relative error from a tight Halley solve.
+//
+void
+BenchmarkBezierSolvers()
+{
+    const TsTest_TsEvaluator evaluator;
+    const auto makeOptions = [](
+        const TsBezierSolver solver, const double tolerance)
+    {
+        TsEvalOptions options;
+        options.bezierSolver = solver;
+        options.solverTolerance = tolerance;
+        return options;
+    };
+    const TsEvalOptions reference = makeOptions(TsBezierSolverHalley, 0);
+
+    const std::vector<TsTest_Museum::DataId> cases = {
+        TsTest_Museum::VerticalTorture,
+        TsTest_Museum::NearCenterVertical};
+    const std::vector<TsBezierSolver> solvers = {
+        TsBezierSolverCardano,
+        TsBezierSolverNewton,
+        TsBezierSolverHalley};
+    const int numRepeats = 20;
+
+    for (const TsTest_Museum::DataId id : cases) {
+        const TsSpline spline = evaluator.SplineDataToSpline(
+            TsTest_Museum::GetData(id));
+        const std::vector<TsTime> times = _GetInteriorTimes(
+            spline.GetKnots().GetTimeSpan(), 10000);
+
+        std::vector<double> expected(times.size());
+        for (size_t i = 0; i < times.size(); ++i) {
+            spline.Eval(times[i], &expected[i], reference);
+        }
+
+        for (const TsBezierSolver solver : solvers) {
+            const TsEvalOptions options = makeOptions(solver, 1e-12);
+
+            double maxError = 0;
+            double value = 0;
+            for (size_t i = 0; i < times.size(); ++i) {
+                spline.Eval(times[i], &value, options);
+                maxError = std::max(maxError,
+                    std::abs(value - expected[i])
+                    / std::max({1.0, std::abs(value), std::abs(expected[i])}));
+            }
+
+            double sum = 0;
+            const TsBench_Clock::time_point start = TsBench_Clock::now();
+            for (int r = 0; r < numRepeats; ++r) {
+                for (const TsTime time : times) {
+                    spline.Eval(time, &value, options);
+                    sum += value;
+                }
+            }
+            const TsBench_Clock::time_point end = TsBench_Clock::now();
+
+            std::cout << TfEnum::GetName(id) << " "
+                      << TfEnum::GetName(solver) << ": "
+                      << TsBench_Nanoseconds(end - start)
+                          / (numRepeats * times.size())
+                      << " ns/eval, max error " << maxError
+                      << (std::isfinite(sum) ? "" : " (non-finite)")
+                      << std::endl;
+        }
+    }
+}
+
+// Measure how evaluation of a large job scales with the number of threads.
+//
+void
+BenchmarkParallelEval()
+{
+    // Many copies of the museum splines, each with its own data, like the
+    // independent splines of a rig.  Setting a property makes the copy
+    // duplicate its data.
+    const TsTest_TsEvaluator evaluator;
+    std::vector<TsSpline> splines;
+    GfInterval span;
+    for (const std::string &name : TsTest_Museum::GetAllNames()) {
+        const TsSpline spline = evaluator.SplineDataToSpline(
+            TsTest_Museum::GetDataByName(name));
+        if (spline.IsEmpty()) {
+            continue;
+        }
+        span |= spline.GetKnots().GetTimeSpan();
+        for (int i = 0; i < 20; ++i) {
+            TsSpline copy = spline;
+            copy.SetPreExtrapolation(copy.GetPreExtrapolation());
+            copy.Compile();
+            splines.push_back(copy);
+        }
+    }
+
+    // Extend past the knots, so that extrapolation is evaluated too.
+    const double margin = 0.5 * std::max(span.GetSize(), 1.0);
+    span = GfInterval(span.GetMin() - margin, span.GetMax() + margin);
+
+    // Shuffled, so that successive times don't share segments.
+    const int numSamples = 2000;
+    std::vector<TsTime> times;
+    for (int i = 0; i <= numSamples; ++i) {
+        times.push_back(span.GetMin() + i * span.GetSize() / numSamples);
+    }
+    std::mt19937 rng(42);
+    std::shuffle(times.begin(), times.end(), rng);
+
+    std::vector<double> values(splines.size() * times.size());
+
+    const size_t maxThreads =
+        std::max(1u, std::thread::hardware_concurrency());
+    double serialSeconds = 0;
+
+    for (size_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+        TsThreadPoolExecutor executor(numThreads);
+
+        const TsBench_Clock::time_point start = TsBench_Clock::now();
+        TsEvalManyParallel(
+            splines, times, TfSpan<double>(values),
+            TsEvalOptions(), &executor);
+        const TsBench_Clock::time_point end = TsBench_Clock::now();
+
+        const double seconds =
+            std::chrono::duration<double>(end - start).count();
+        if (numThreads == 1) {
+            serialSeconds = seconds;
+        }
+
+        std::cout << numThreads << " threads: "
+                  << seconds * 1e3 << " ms, speedup "
+                  << serialSeconds / seconds << std::endl;
+    }
+}
+
+// Measure evaluation throughput for Hermite and equivalent Bezier splines,
+// compiled and not.
+//
+void
+BenchmarkHermiteEval()
+{
+    const std::vector<TsTime> times =
+        _GetInteriorTimes(GfInterval(0, 30), 20000);
+    const int numRepeats = 20;
+
+    for (const bool compile : {false, true}) {
+        for (const TsCurveType curveType :
+                 {TsCurveTypeBezier, TsCurveTypeHermite}) {
+            const TsSpline spline = TsBench_MakeWalkCycle(curveType);
+            if (compile) {
+                spline.Compile();
+            }
+
+            double sum = 0, value = 0;
+            const TsBench_Clock::time_point start = TsBench_Clock::now();
+            for (int r = 0; r < numRepeats; ++r) {
+                for (const TsTime time : times) {
+                    spline.Eval(time, &value);
+                    sum += value;
+                }
+            }
+            const TsBench_Clock::time_point end = TsBench_Clock::now();
+
+            std::cout << (curveType == TsCurveTypeBezier ?
+                          "Bezier" : "Hermite")
+                      << (compile ? " compiled" : "") << ": "
+                      << TsBench_Nanoseconds(end - start)
+                          / (numRepeats * times.size())
+                      << " ns/eval"
+                      << (std::isfinite(sum) ? "" : " (non-finite)")
+                      << std::endl;
+        }
+    }
+}
+
+// Measure evaluation throughput for a walk cycle with inner loops and looping
+// extrapolation, which are resolved from the cached loop topology.
+//
+void
+BenchmarkLoopingEval()
+{
+    TsSpline spline = TsBench_MakeWalkCycle(TsCurveTypeBezier);
+    TsLoopParams params;
+    params.protoStart = 0.0;
+    params.protoEnd = 24.0;
+    params.numPostLoops = 3;
+    params.valueOffset = 0.5;
+    spline.SetInnerLoopParams(params);
+    spline.SetPreExtrapolation(TsExtrapolation(TsExtrapLoopRepeat));
+    spline.SetPostExtrapolation(TsExtrapolation(TsExtrapLoopRepeat));
+
+    const int numSamples = 1000000;
+    double sum = 0, value = 0;
+    const TsBench_Clock::time_point start = TsBench_Clock::now();
+    for (int i = 0; i < numSamples; ++i) {
+        spline.Eval(-1000.0 + i * 0.01, &value);
+        sum += value;
+    }
+    const TsBench_Clock::time_point end = TsBench_Clock::now();
+
+    std::cout << "Looping eval: "
+              << TsBench_Nanoseconds(end - start) / numSamples << " ns/eval"
+              << (std::isfinite(sum) ? "" : " (non-finite)") << std::endl;
+}
+
+// Measure evaluation throughput for each feature combination, one time at a
+// time and in a batch.  Each feature is added without changing values, so
+// differences come only from the evaluation kernel chosen.
+//
+void
+BenchmarkEvalFeatures()
+{
+    const TsAntiRegressionAuthoringSelector selector(TsAntiRegressionNone);
+
+    const auto setLastInterp = [](TsSpline *spline, const TsInterpMode interp)
+    {
+        const TsKnotMap knots = spline->GetKnots();
+        TsKnot knot = *(knots.end() - 1);
+        knot.SetNextInterpolation(interp);
+        spline->SetKnot(knot);
+    };
+    const auto addDualValue = [](TsSpline *spline)
+    {
+        const TsKnotMap knots = spline->GetKnots();
+        TsKnot knot = *(knots.begin() + 1);
+        double value = 0;
+        knot.GetValue(&value);
+        knot.SetPreValue(value);
+        spline->SetKnot(knot);
+    };
+    const auto addSlopedExtrap = [](TsSpline *spline)
+    {
+        TsExtrapolation sloped(TsExtrapSloped);
+        sloped.slope = 0;
+        spline->SetPreExtrapolation(sloped);
+        spline->SetPostExtrapolation(sloped);
+    };
+
+    std::vector<std::pair<std::string, TsSpline>> cases;
+
+    const TsSpline bezier = TsBench_MakeWalkCycle(TsCurveTypeBezier);
+    cases.emplace_back("Bezier", bezier);
+    cases.emplace_back(
+        "Hermite", TsBench_MakeWalkCycle(TsCurveTypeHermite));
+
+    const TsSpline linear =
+        TsBench_MakeWalkCycle(TsCurveTypeBezier, TsInterpLinear);
+    cases.emplace_back("Linear", linear);
+
+    TsSpline linearCurve = linear;
+    setLastInterp(&linearCurve, TsInterpCurve);
+    cases.emplace_back("Linear + Bezier", linearCurve);
+
+    TsSpline dual = bezier;
+    addDualValue(&dual);
+    cases.emplace_back("Bezier + dual values", dual);
+
+    TsSpline blocks = bezier;
+    setLastInterp(&blocks, TsInterpValueBlock);
+    cases.emplace_back("Bezier + value blocks", blocks);
+
+    TsSpline sloped = bezier;
+    addSlopedExtrap(&sloped);
+    cases.emplace_back("Bezier + sloped extrapolation", sloped);
+
+    TsSpline looped = bezier;
+    looped.SetPostExtrapolation(TsExtrapolation(TsExtrapLoopRepeat));
+    cases.emplace_back("Bezier + loops", looped);
+
+    TsSpline all = bezier;
+    addDualValue(&all);
+    setLastInterp(&all, TsInterpValueBlock);
+    addSlopedExtrap(&all);
+    all.SetPostExtrapolation(TsExtrapolation(TsExtrapLoopRepeat));
+    cases.emplace_back("All features", all);
+
+    // Mostly inside the knots, with some extrapolation.  Takes the best of
+    // several runs, to reduce noise.
+    const int numSamples = 200000;
+    const int numRuns = 7;
+    std::vector<TsTime> times(numSamples);
+    for (int i = 0; i < numSamples; ++i) {
+        times[i] = -3.0 + i * (36.0 / numSamples);
+    }
+    std::vector<double> values(numSamples);
+
+    for (const auto &[name, spline] : cases) {
+        double best = INFINITY, bestBatched = INFINITY, sum = 0, value = 0;
+        for (int run = 0; run < numRuns; ++run) {
+            const TsBench_Clock::time_point start = TsBench_Clock::now();
+            for (const TsTime time : times) {
+                spline.Eval(time, &value);
+                sum += value;
+            }
+            const TsBench_Clock::time_point middle = TsBench_Clock::now();
+            spline.EvalMany(times, TfSpan<double>(values));
+            const TsBench_Clock::time_point end = TsBench_Clock::now();
+
+            best = std::min(best, TsBench_Nanoseconds(middle - start));
+            bestBatched =
+                std::min(bestBatched, TsBench_Nanoseconds(end - middle));
+        }
+
+        std::cout << name << ": " << best / numSamples << " ns/eval, "
+                  << bestBatched / numSamples << " ns/eval batched"
+                  << (std::isfinite(sum + values.back()) ?
+                      "" : " (non-finite)")
+                  << std::endl;
+    }
+}
+
+// Measure combined evaluation of values and derivatives against separate
+// value and derivative evaluation.
+//
+void
+BenchmarkEvalWithDerivatives()
+{
+    const TsAntiRegressionAuthoringSelector selector(TsAntiRegressionNone);
+
+    const int numSamples = 200000;
+    const int numRuns = 7;
+    std::vector<TsTime> times(numSamples);
+    for (int i = 0; i < numSamples; ++i) {
+        times[i] = -3.0 + i * (36.0 / numSamples);
+    }
+
+    for (const TsCurveType curveType :
+             {TsCurveTypeBezier, TsCurveTypeHermite}) {
+        const TsSpline spline = TsBench_MakeWalkCycle(curveType);
+
+        double bestSeparate = INFINITY, bestCombined = INFINITY, sum = 0;
+        for (int run = 0; run < numRuns; ++run) {
+            double value = 0, deriv = 0, second = 0;
+
+            const TsBench_Clock::time_point start = TsBench_Clock::now();
+            for (const TsTime time : times) {
+                spline.Eval(time, &value);
+                spline.EvalDerivative(time, &deriv);
+                sum += value + deriv;
+            }
+            const TsBench_Clock::time_point middle = TsBench_Clock::now();
+            for (const TsTime time : times) {
+                spline.EvalWithDerivatives(time, &value, &deriv, &second);
+                sum += value + deriv;
+            }
+            const TsBench_Clock::time_point end = TsBench_Clock::now();
+
+            bestSeparate =
+                std::min(bestSeparate, TsBench_Nanoseconds(middle - start));
+            bestCombined =
+                std::min(bestCombined, TsBench_Nanoseconds(end - middle));
+        }
+
+        std::cout << (curveType == TsCurveTypeBezier ? "Bezier" : "Hermite")
+                  << ": separate " << bestSeparate / numSamples
+                  << " ns/time, combined " << bestCombined / numSamples
+                  << " ns/time (with second derivative)"
+                  << (std::isfinite(sum) ? "" : " (non-finite)")
+                  << std::endl;
+    }
+}
+
+
+}  // namespace pxr
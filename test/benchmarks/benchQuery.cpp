@@ -0,0 +1,232 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include "./benchmarks.h"
+
+#include <pxr/ts/knot.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/testHelpers.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace pxr {
+
+
+// Measure retiming a range of frames through a monotonic time-valued spline,
+// against bisection with forward evaluation.
+//
+void
+BenchmarkInverseEval()
+{
+    TsSpline spline;
+    for (int i = 0; i <= 20; ++i) {
+        TsKnot knot = TsTest_MakeKnot(
+            i * 10.0, i * 10.0 + 3 * (i % 3), TsInterpCurve);
+        knot.SetPreTanWidth(3.0);
+        knot.SetPostTanWidth(3.0);
+        spline.SetKnot(knot);
+    }
+
+    const GfInterval interval(0, 200);
+    std::vector<double> values;
+    for (double value = 0; value < 200; value += 0.05) {
+        values.push_back(value);
+    }
+
+    const TsBench_Clock::time_point start = TsBench_Clock::now();
+    std::vector<std::vector<TsTime>> times;
+    spline.FindTimesForValues(values, interval, &times);
+    const TsBench_Clock::time_point middle = TsBench_Clock::now();
+
+    // Bisection over the whole interval, which relies on monotonicity.
+    double sum = 0;
+    for (const double value : values) {
+        TsTime lo = interval.GetMin(), hi = interval.GetMax();
+        for (int i = 0; i < 52; ++i) {
+            const TsTime mid = 0.5 * (lo + hi);
+            double midValue = 0;
+            spline.Eval(mid, &midValue);
+            (midValue < value ? lo : hi) = mid;
+        }
+        sum += lo;
+    }
+    const TsBench_Clock::time_point end = TsBench_Clock::now();
+
+    std::cout << "Inverse evaluation: "
+              << TsBench_Nanoseconds(middle - start) / values.size()
+              << " ns/value; bisection: "
+              << TsBench_Nanoseconds(end - middle) / values.size()
+              << " ns/value"
+              << (std::isfinite(sum) ? "" : " (non-finite)") << std::endl;
+}
+
+// Measure value-range queries against sampling once per frame, which is still
+// approximate, on a long spline.
+//
+void
+BenchmarkValueRange()
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    const TsSpline spline = TsBench_MakeRandomSpline(2000, 5.0, 1.5, 3);
+
+    std::mt19937 rng(3);
+    std::vector<GfInterval> intervals;
+    std::uniform_real_distribution<double> times(0, 10000);
+    for (int i = 0; i < 1000; ++i) {
+        const TsTime a = times(rng), b = times(rng);
+        intervals.emplace_back(std::min(a, b), std::max(a, b));
+    }
+
+    const TsBench_Clock::time_point start = TsBench_Clock::now();
+    double sum = 0;
+    for (const GfInterval &interval : intervals) {
+        std::pair<double, double> range;
+        spline.GetValueRange(interval, &range);
+        sum += range.second - range.first;
+    }
+    const TsBench_Clock::time_point middle = TsBench_Clock::now();
+
+    for (const GfInterval &interval : intervals) {
+        double min = inf, max = -inf, value = 0;
+        for (TsTime time = interval.GetMin(); time <= interval.GetMax();
+                 time += 1) {
+            spline.Eval(time, &value);
+            min = std::min(min, value);
+            max = std::max(max, value);
+        }
+        sum += max - min;
+    }
+    const TsBench_Clock::time_point end = TsBench_Clock::now();
+
+    std::cout << "Value range: "
+              << TsBench_Microseconds(middle - start) / intervals.size()
+              << " us/query; per-frame sampling: "
+              << TsBench_Microseconds(end - middle) / intervals.size()
+              << " us/query"
+              << (std::isfinite(sum) ? "" : " (non-finite)") << std::endl;
+}
+
+// Measure whole-spline queries on a long spline, which are answered from
+// summary flags rather than by visiting knots.
+//
+void
+BenchmarkSummaryQueries()
+{
+    TsSpline spline;
+    const int numKnots = 10000;
+    for (int i = 0; i < numKnots; ++i) {
+        TsKnot knot =
+            TsTest_MakeKnot(i * 1.0, std::sin(i * 0.1), TsInterpCurve);
+        knot.SetPreTanSlope(std::cos(i * 0.1) * 0.1);
+        knot.SetPostTanSlope(std::cos(i * 0.1) * 0.1);
+        knot.SetPreTanWidth(0.3);
+        knot.SetPostTanWidth(0.3);
+        spline.SetKnot(knot);
+    }
+
+    const int numQueries = 100000;
+    int numTrue = 0;
+    const TsBench_Clock::time_point start = TsBench_Clock::now();
+    for (int i = 0; i < numQueries; ++i) {
+        numTrue += spline.HasValueBlocks();
+        numTrue += spline.IsVarying();
+        numTrue += spline.IsC1Continuous();
+    }
+    const TsBench_Clock::time_point end = TsBench_Clock::now();
+
+    std::cout << "Whole-spline query on " << numKnots << " knots: "
+              << TsBench_Nanoseconds(end - start) / (3.0 * numQueries)
+              << " ns/query"
+              << (numTrue ? "" : " (unexpected results)") << std::endl;
+}
+
+// Measure batch integration against averaging by subsamples, as a renderer
+// does for motion blur.
+//
+void
+BenchmarkIntegrate()
+{
+    const TsSpline spline = TsBench_MakeRandomSpline(200, 5.0, 1.5, 5);
+
+    // One shutter interval per frame.
+    const int numFrames = 1000;
+    std::vector<TsTime> boundaries;
+    for (int i = 0; i <= numFrames; ++i) {
+        boundaries.push_back(i);
+    }
+
+    const TsBench_Clock::time_point start = TsBench_Clock::now();
+    std::vector<double> averages(numFrames);
+    TF_AXIOM(spline.AverageMany(boundaries, averages));
+    const TsBench_Clock::time_point middle = TsBench_Clock::now();
+
+    const int numSubsamples = 32;
+    double error = 0;
+    for (int i = 0; i < numFrames; ++i) {
+        double sum = 0, value = 0;
+        for (int j = 0; j < numSubsamples; ++j) {
+            spline.Eval(i + (j + 0.5) / numSubsamples, &value);
+            sum += value;
+        }
+        error = std::max(error, std::abs(sum / numSubsamples - averages[i]));
+    }
+    const TsBench_Clock::time_point end = TsBench_Clock::now();
+
+    std::cout << "Batch average: "
+              << TsBench_Microseconds(middle - start) / numFrames
+              << " us/frame; " << numSubsamples << " subsamples: "
+              << TsBench_Microseconds(end - middle) / numFrames
+              << " us/frame, max difference " << error << std::endl;
+}
+
+// Measure shutter evaluation against evaluating each subframe sample.
+//
+void
+BenchmarkShutterEval()
+{
+    const TsSpline spline = TsBench_MakeRandomSpline(200, 5.0, 1.5, 5);
+
+    const int numFrames = 1000;
+    std::vector<TsTime> frames;
+    for (int i = 0; i < numFrames; ++i) {
+        frames.push_back(i);
+    }
+    TsShutter shutter;
+    shutter.open = -0.25;
+    shutter.close = 0.25;
+    shutter.numSamples = 16;
+
+    const TsBench_Clock::time_point start = TsBench_Clock::now();
+    VtArray<double> values;
+    TF_AXIOM(spline.EvalShutter(frames, shutter, &values));
+    const TsBench_Clock::time_point middle = TsBench_Clock::now();
+
+    double error = 0;
+    for (int i = 0; i < numFrames; ++i) {
+        for (int j = 0; j < shutter.numSamples; ++j) {
+            double value = 0;
+            spline.Eval(frames[i] + shutter.GetSampleOffset(j), &value);
+            error = std::max(
+                error, std::abs(value - values[i * shutter.numSamples + j]));
+        }
+    }
+    const TsBench_Clock::time_point end = TsBench_Clock::now();
+
+    std::cout << "Shutter evaluation: "
+              << TsBench_Microseconds(middle - start) / numFrames
+              << " us/frame; per-sample Eval: "
+              << TsBench_Microseconds(end - middle) / numFrames
+              << " us/frame, max difference " << error << std::endl;
+}
+
+
+}  // namespace pxr
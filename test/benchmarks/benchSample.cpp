@@ -0,0 +1,353 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include "./benchmarks.h"
+
+#include <pxr/ts/parallel.h>
+#include <pxr/ts/sampler.h>
+#include <pxr/ts/knot.h>
+#include <pxr/ts/typeHelpers.h>
+#include <pxr/gf/vec2d.h>
+#include <pxr/gf/vec2f.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/testHelpers.h>
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace pxr {
+
+
+// Measure sampling throughput for Hermite and equivalent Bezier walk cycles,
+// with inner loops and looping extrapolation.
+//
+void
+BenchmarkHermiteSampling()
+{
+    const GfInterval interval(-30, 60);
+    const double timeScale = 2000 / 30.0;
+    const double valueScale = 2000 / 10.0;
+    const int numRepeats = 2000;
+
+    for (const TsCurveType curveType :
+             {TsCurveTypeBezier, TsCurveTypeHermite}) {
+        TsSpline spline = TsBench_MakeWalkCycle(curveType);
+        TsLoopParams params;
+        params.protoStart = 6.0;
+        params.protoEnd = 24.0;
+        params.numPreLoops = 1;
+        params.numPostLoops = 2;
+        params.valueOffset = 2.5;
+        spline.SetInnerLoopParams(params);
+        spline.SetPreExtrapolation(TsExtrapolation(TsExtrapLoopOscillate));
+        spline.SetPostExtrapolation(TsExtrapolation(TsExtrapLoopRepeat));
+
+        size_t numVertices = 0;
+        const TsBench_Clock::time_point start = TsBench_Clock::now();
+        for (int r = 0; r < numRepeats; ++r) {
+            TsSplineSamples<GfVec2d> samples;
+            spline.Sample(interval, timeScale, valueScale, 0.5, &samples);
+            numVertices = 0;
+            for (const auto &polyline : samples.polylines) {
+                numVertices += polyline.size();
+            }
+        }
+        const TsBench_Clock::time_point end = TsBench_Clock::now();
+
+        std::cout << (curveType == TsCurveTypeBezier ? "Bezier" : "Hermite")
+                  << " sampling: "
+                  << TsBench_Microseconds(end - start) / numRepeats
+                  << " us/sample, " << numVertices << " vertices"
+                  << std::endl;
+    }
+}
+
+// Measure uniform sampling against evaluating each time.
+//
+void
+BenchmarkSampleUniform()
+{
+    const GfInterval interval(0, 199 * 24.0);
+    const TsTime step = 0.25;
+
+    for (const TsCurveType curveType :
+             {TsCurveTypeBezier, TsCurveTypeHermite}) {
+        const TsSpline spline =
+            TsBench_MakeRandomSpline(200, 24.0, 8.0, 7, curveType);
+
+        const TsBench_Clock::time_point start = TsBench_Clock::now();
+        VtArray<double> values;
+        TF_AXIOM(spline.SampleUniform(interval, step, &values));
+        const TsBench_Clock::time_point middle = TsBench_Clock::now();
+
+        double error = 0;
+        for (size_t i = 0; i < values.size(); ++i) {
+            double value = 0;
+            spline.Eval(interval.GetMin() + i * step, &value);
+            error = std::max(error, std::abs(value - values[i]));
+        }
+        const TsBench_Clock::time_point end = TsBench_Clock::now();
+
+        std::cout << (curveType == TsCurveTypeBezier ? "Bezier" : "Hermite")
+                  << " uniform sampling: "
+                  << TsBench_Nanoseconds(middle - start) / values.size()
+                  << " ns/sample; per-sample Eval: "
+                  << TsBench_Nanoseconds(end - middle) / values.size()
+                  << " ns/sample, max difference " << error << std::endl;
+    }
+}
+
+// Streams vertices into a flat buffer, as for a vertex buffer, with the start
+// of each polyline in a separate index list.
+struct _BufferVisitor
+{
+    void BeginPolyline(TsSplineSampleSource)
+    {
+        starts.push_back(vertices.size() / 2);
+    }
+
+    void AddVertex(double time, double value)
+    {
+        vertices.push_back(float(time));
+        vertices.push_back(float(value));
+    }
+
+    std::vector<float> vertices;
+    std::vector<size_t> starts;
+};
+
+// Measure streaming into a flat buffer against building
+// TsSplineSamplesWithSources, which breaks polylines in the same places.
+//
+void
+BenchmarkSampleVisitor()
+{
+    TsSpline spline = TsBench_MakeRandomSpline(500, 5.0, 1.5, 11);
+    const TsKnotMap knots = spline.GetKnots();
+    for (size_t i = 3; i < knots.size(); i += 7) {
+        TsKnot knot = *(knots.begin() + i);
+        knot.SetNextInterpolation(TsInterpHeld);
+        spline.SetKnot(knot);
+    }
+    const GfInterval interval(0, 2500);
+    const int numRuns = 20;
+
+    const TsBench_Clock::time_point start = TsBench_Clock::now();
+    size_t numVertices = 0;
+    for (int i = 0; i < numRuns; ++i) {
+        TsSplineSamplesWithSources<GfVec2d> samples;
+        TF_AXIOM(spline.Sample(interval, 4.0, 40.0, 0.05, &samples));
+        for (const auto &polyline : samples.polylines) {
+            numVertices += polyline.size();
+        }
+    }
+    const TsBench_Clock::time_point middle = TsBench_Clock::now();
+    size_t numStreamed = 0;
+    for (int i = 0; i < numRuns; ++i) {
+        _BufferVisitor buffer;
+        TF_AXIOM(spline.SampleToVisitor(interval, 4.0, 40.0, 0.05, &buffer));
+        numStreamed += buffer.vertices.size() / 2;
+    }
+    const TsBench_Clock::time_point end = TsBench_Clock::now();
+
+    std::cout << "TsSplineSamplesWithSources: "
+              << TsBench_Microseconds(middle - start) / numRuns
+              << " us/call; visitor: "
+              << TsBench_Microseconds(end - middle) / numRuns
+              << " us/call (" << numVertices / numRuns << " vertices"
+              << (numStreamed == numVertices ? "" : ", mismatched") << ")"
+              << std::endl;
+}
+
+// Measure flat sampling against nested sampling of a spline with many
+// discontinuities.
+//
+void
+BenchmarkFlatSamples()
+{
+    TsSpline spline;
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<double> dist(-10, 10);
+    for (int i = 0; i < 2000; ++i) {
+        spline.SetKnot(TsTest_MakeKnot(i, dist(rng),
+            i % 2 ? TsInterpHeld : TsInterpLinear));
+    }
+    const GfInterval interval(0, 2000);
+    const int numRuns = 50;
+
+    const TsBench_Clock::time_point start = TsBench_Clock::now();
+    size_t numPolylines = 0;
+    for (int i = 0; i < numRuns; ++i) {
+        TsSplineSamples<GfVec2f> samples;
+        TF_AXIOM(spline.Sample(interval, 1.0, 1.0, 0.1, &samples));
+        numPolylines += samples.polylines.size();
+    }
+    const TsBench_Clock::time_point middle = TsBench_Clock::now();
+    size_t numFlat = 0;
+    for (int i = 0; i < numRuns; ++i) {
+        TsSplineFlatSamples<GfVec2f> samples;
+        TF_AXIOM(spline.Sample(interval, 1.0, 1.0, 0.1, &samples));
+        numFlat += samples.GetNumPolylines();
+    }
+    const TsBench_Clock::time_point end = TsBench_Clock::now();
+
+    std::cout << "TsSplineSamples: "
+              << TsBench_Microseconds(middle - start) / numRuns
+              << " us/call; TsSplineFlatSamples: "
+              << TsBench_Microseconds(end - middle) / numRuns
+              << " us/call (" << numPolylines / numRuns << " polylines"
+              << (numFlat == numPolylines ? "" : ", mismatched") << ")"
+              << std::endl;
+}
+
+// Measure uniform flattening against subdivision, with steep random
+// tangents.
+//
+void
+BenchmarkBezierFlattening()
+{
+    TsSpline spline;
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<double> dist(-10, 10);
+    for (int i = 0; i < 500; ++i) {
+        TsKnot knot = TsTest_MakeKnot(i * 5.0, dist(rng), TsInterpCurve);
+        knot.SetPreTanWidth(1.5);
+        knot.SetPostTanWidth(1.5);
+        knot.SetPreTanSlope(dist(rng));
+        knot.SetPostTanSlope(dist(rng));
+        spline.SetKnot(knot);
+    }
+    const GfInterval interval(0, 2500);
+    const int numRuns = 20;
+
+    size_t numVertices[2] = {0, 0};
+    TsBench_Clock::duration durations[2] = {};
+    const TsBezierFlattening modes[2] = {
+        TsBezierFlatteningSubdivide, TsBezierFlatteningUniform};
+    for (int m = 0; m < 2; ++m) {
+        TsSplineFlatSamples<GfVec2d> flat;
+        const TsBench_Clock::time_point start = TsBench_Clock::now();
+        for (int i = 0; i < numRuns; ++i) {
+            TF_AXIOM(spline.Sample(interval, 1.0, 10.0, 0.05, &flat,
+                                   modes[m]));
+        }
+        durations[m] = TsBench_Clock::now() - start;
+        numVertices[m] = flat.vertices.size();
+    }
+
+    std::cout << "Subdivide: " << TsBench_Microseconds(durations[0]) / numRuns
+              << " us/call, " << numVertices[0] << " vertices; Uniform: "
+              << TsBench_Microseconds(durations[1]) / numRuns << " us/call, "
+              << numVertices[1] << " vertices" << std::endl;
+}
+
+// Measure parallel sampling of a long spline, like those baked from motion
+// capture, against serial sampling.
+//
+void
+BenchmarkParallelSample()
+{
+    // Mixed segments, with some discontinuities.
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> dist(-10, 10);
+    std::uniform_int_distribution<int> pick(0, 15);
+    TsSpline spline;
+    const int numKnots = 200000;
+    for (int i = 0; i < numKnots; ++i) {
+        TsKnot knot = TsTest_MakeKnot(i, dist(rng), TsInterpCurve);
+        knot.SetPreTanWidth(0.4);
+        knot.SetPostTanWidth(0.4);
+        knot.SetPreTanSlope(dist(rng));
+        knot.SetPostTanSlope(dist(rng));
+
+        const int kind = pick(rng);
+        if (kind == 0) {
+            knot.SetNextInterpolation(TsInterpHeld);
+        } else if (kind == 1) {
+            knot.SetNextInterpolation(TsInterpLinear);
+        } else if (kind == 2) {
+            knot.SetPreValue(dist(rng));
+        }
+        spline.SetKnot(knot);
+    }
+    const GfInterval interval(0, numKnots);
+    TsExecutor &pool = TsGetDefaultExecutor();
+
+    TsSplineFlatSamples<GfVec2d> expected, flat;
+    const TsBench_Clock::time_point start = TsBench_Clock::now();
+    TF_AXIOM(spline.Sample(interval, 20.0, 10.0, 0.1, &expected));
+    const TsBench_Clock::time_point middle = TsBench_Clock::now();
+    TF_AXIOM(spline.Sample(interval, 20.0, 10.0, 0.1, &flat,
+                           TsBezierFlatteningSubdivide, &pool));
+    const TsBench_Clock::time_point end = TsBench_Clock::now();
+
+    std::cout << "Serial: " << TsBench_Microseconds(middle - start) / 1e3
+              << " ms; parallel (" << pool.GetConcurrency() << " threads): "
+              << TsBench_Microseconds(end - middle) / 1e3 << " ms ("
+              << expected.vertices.size() << " vertices"
+              << (flat.vertices == expected.vertices ? "" : ", mismatched")
+              << ")" << std::endl;
+}
+
+// Measure a sampler redrawing a looped, float-valued spline as the view pans,
+// against TsSpline::Sample.
+//
+void
+BenchmarkSampler()
+{
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> dist(-10, 10);
+    TsSpline spline(Ts_GetType<float>());
+    for (int i = 0; i < 200; ++i) {
+        TsKnot knot(Ts_GetType<float>(), TsCurveTypeBezier);
+        knot.SetTime(i);
+        knot.SetValue(float(dist(rng)));
+        knot.SetPreTanWidth(0.3f);
+        knot.SetPostTanWidth(0.3f);
+        spline.SetKnot(knot);
+    }
+    TsLoopParams params;
+    params.protoStart = 50;
+    params.protoEnd = 150;
+    params.numPreLoops = 0;
+    params.numPostLoops = 20;
+    spline.SetInnerLoopParams(params);
+
+    const int numFrames = 500;
+    const auto getView = [](const int frame)
+    {
+        return GfInterval(frame, frame + 500);
+    };
+
+    TsSplineFlatSamples<GfVec2f> expected, flat;
+    const TsBench_Clock::time_point start = TsBench_Clock::now();
+    for (int i = 0; i < numFrames; ++i) {
+        TF_AXIOM(spline.Sample(getView(i), 2.0, 20.0, 0.5, &expected));
+    }
+    const TsBench_Clock::time_point middle = TsBench_Clock::now();
+
+    // Panning within what was unrolled for the first, widest view.
+    TsSampler sampler(spline);
+    TF_AXIOM(sampler.Sample(GfInterval(0, numFrames + 500), 2.0, 20.0, 0.5,
+                            &flat));
+    for (int i = 0; i < numFrames; ++i) {
+        TF_AXIOM(sampler.Sample(getView(i), 2.0, 20.0, 0.5, &flat));
+    }
+    const TsBench_Clock::time_point end = TsBench_Clock::now();
+
+    std::cout << "TsSpline::Sample: "
+              << TsBench_Microseconds(middle - start) / numFrames
+              << " us/frame; TsSampler: "
+              << TsBench_Microseconds(end - middle) / numFrames << " us/frame"
+              << (flat.vertices == expected.vertices ? "" : " (mismatched)")
+              << std::endl;
+}
+
+
+}  // namespace pxr
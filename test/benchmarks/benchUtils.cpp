@@ -0,0 +1,72 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include "./benchmarks.h"
+
+#include <pxr/ts/knot.h>
+#include <pxr/ts/typeHelpers.h>
+
+#include <random>
+
+namespace pxr {
+
+
+TsSpline
+TsBench_MakeWalkCycle(
+    const TsCurveType curveType,
+    const TsInterpMode interp)
+{
+    const double values[] = {0.0, 4.0, 1.0, 5.0, 0.0, 3.0};
+    const double slopes[] = {0.5, 0.0, -0.3, 0.0, 0.4, 0.0};
+
+    TsSpline spline;
+    spline.SetCurveType(curveType);
+    for (size_t i = 0; i < 6; ++i) {
+        TsKnot knot(Ts_GetType<double>(), curveType);
+        knot.SetTime(i * 6.0);
+        knot.SetValue(values[i]);
+        knot.SetNextInterpolation(interp);
+        knot.SetPreTanSlope(slopes[i]);
+        knot.SetPostTanSlope(slopes[i]);
+        if (curveType == TsCurveTypeBezier) {
+            knot.SetPreTanWidth(2.0);
+            knot.SetPostTanWidth(2.0);
+        }
+        spline.SetKnot(knot);
+    }
+    return spline;
+}
+
+TsSpline
+TsBench_MakeRandomSpline(
+    const int numKnots,
+    const double spacing,
+    const double tanWidth,
+    const unsigned seed,
+    const TsCurveType curveType)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-10, 10);
+
+    TsSpline spline;
+    spline.SetCurveType(curveType);
+    for (int i = 0; i < numKnots; ++i) {
+        TsKnot knot(Ts_GetType<double>(), curveType);
+        knot.SetTime(i * spacing);
+        knot.SetValue(dist(rng));
+        knot.SetNextInterpolation(TsInterpCurve);
+        if (curveType == TsCurveTypeBezier) {
+            knot.SetPreTanWidth(tanWidth);
+            knot.SetPostTanWidth(tanWidth);
+        }
+        spline.SetKnot(knot);
+    }
+    return spline;
+}
+
+
+}  // namespace pxr
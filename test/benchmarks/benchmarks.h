@@ -0,0 +1,85 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#ifndef PXR_TS_BENCHMARKS_H
+#define PXR_TS_BENCHMARKS_H
+
+#include <pxr/ts/spline.h>
+#include <pxr/ts/types.h>
+
+#include <chrono>
+
+namespace pxr {
+
+
+// Benchmarks measure the speed of one operation, usually against the simpler
+// way of doing the same thing, and print the results.  They check results
+// only as far as needed to keep the work from being optimized away.  Unit
+// tests cover correctness.
+
+// Evaluation.
+void BenchmarkBezierSolvers();
+void BenchmarkParallelEval();
+void BenchmarkHermiteEval();
+void BenchmarkLoopingEval();
+void BenchmarkEvalFeatures();
+void BenchmarkEvalWithDerivatives();
+
+// Whole-spline and interval queries.
+void BenchmarkInverseEval();
+void BenchmarkValueRange();
+void BenchmarkSummaryQueries();
+void BenchmarkIntegrate();
+void BenchmarkShutterEval();
+
+// Sampling.
+void BenchmarkHermiteSampling();
+void BenchmarkSampleUniform();
+void BenchmarkSampleVisitor();
+void BenchmarkFlatSamples();
+void BenchmarkBezierFlattening();
+void BenchmarkParallelSample();
+void BenchmarkSampler();
+
+
+using TsBench_Clock = std::chrono::steady_clock;
+
+inline double
+TsBench_Nanoseconds(const TsBench_Clock::duration d)
+{
+    return std::chrono::duration<double, std::nano>(d).count();
+}
+
+inline double
+TsBench_Microseconds(const TsBench_Clock::duration d)
+{
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+
+// Returns a double-valued spline with knots at multiples of spacing, random
+// values in [-10, 10], and curved segments.  Bezier tangents have the
+// specified width; Hermite tangents have none.
+TsSpline
+TsBench_MakeRandomSpline(
+    int numKnots,
+    double spacing,
+    double tanWidth,
+    unsigned seed,
+    TsCurveType curveType = TsCurveTypeBezier);
+
+// Returns a walk-cycle-like spline of six knots, six frames apart, with no
+// features beyond its interpolation and held extrapolation.  Bezier tangents
+// are a third of the knot spacing, so both curve types give the same curve.
+TsSpline
+TsBench_MakeWalkCycle(
+    TsCurveType curveType,
+    TsInterpMode interp = TsInterpCurve);
+
+
+}  // namespace pxr
+
+#endif
@@ -0,0 +1,82 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include "./benchmarks.h"
+
+#include <cstring>
+#include <iostream>
+
+using namespace pxr;
+
+
+// Runs the benchmarks named on the command line, or all of them, and prints
+// their timings.  Benchmarks are built with BUILD_BENCHMARKS, and are not run
+// by ctest; build in release mode for meaningful numbers.
+
+struct _Benchmark
+{
+    const char *name;
+    void (*func)();
+};
+
+static const _Benchmark _benchmarks[] = {
+    {"BezierSolvers", &BenchmarkBezierSolvers},
+    {"ParallelEval", &BenchmarkParallelEval},
+    {"HermiteEval", &BenchmarkHermiteEval},
+    {"HermiteSampling", &BenchmarkHermiteSampling},
+    {"LoopingEval", &BenchmarkLoopingEval},
+    {"EvalFeatures", &BenchmarkEvalFeatures},
+    {"EvalWithDerivatives", &BenchmarkEvalWithDerivatives},
+    {"InverseEval", &BenchmarkInverseEval},
+    {"ValueRange", &BenchmarkValueRange},
+    {"SummaryQueries", &BenchmarkSummaryQueries},
+    {"Integrate", &BenchmarkIntegrate},
+    {"ShutterEval", &BenchmarkShutterEval},
+    {"SampleUniform", &BenchmarkSampleUniform},
+    {"SampleVisitor", &BenchmarkSampleVisitor},
+    {"FlatSamples", &BenchmarkFlatSamples},
+    {"BezierFlattening", &BenchmarkBezierFlattening},
+    {"ParallelSample", &BenchmarkParallelSample},
+    {"Sampler", &BenchmarkSampler}};
+
+static void
+_Run(const _Benchmark &benchmark)
+{
+    std::cout << "== " << benchmark.name << std::endl;
+    benchmark.func();
+}
+
+int
+main(int argc, char *argv[])
+{
+    if (argc == 1) {
+        for (const _Benchmark &benchmark : _benchmarks) {
+            _Run(benchmark);
+        }
+        return 0;
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        const _Benchmark *found = nullptr;
+        for (const _Benchmark &benchmark : _benchmarks) {
+            if (std::strcmp(argv[i], benchmark.name) == 0) {
+                found = &benchmark;
+            }
+        }
+        if (!found) {
+            std::cerr << "Unknown benchmark: " << argv[i] << std::endl
+                      << "Benchmarks are:";
+            for (const _Benchmark &benchmark : _benchmarks) {
+                std::cerr << " " << benchmark.name;
+            }
+            std::cerr << std::endl;
+            return 1;
+        }
+        _Run(*found);
+    }
+    return 0;
+}
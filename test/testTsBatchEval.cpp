@@ -0,0 +1,250 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/spline.h>
+#include <pxr/ts/knot.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/museum.h>
+#include <tsTest/tsEvaluator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+
+// Returns an interval that covers a spline's knots and inner loops, extended
+// on both sides far enough to include some extrapolation.
+static GfInterval
+_GetTestInterval(const TsSpline &spline)
+{
+    GfInterval knotSpan = spline.GetKnots().GetTimeSpan();
+    if (spline.HasInnerLoops()) {
+        knotSpan |= spline.GetInnerLoopParams().GetLoopedInterval();
+    }
+
+    const double size = std::max(knotSpan.GetSize(), 1.0);
+    return GfInterval(
+        knotSpan.GetMin() - 1.5 * size, knotSpan.GetMax() + 1.5 * size);
+}
+
+// Returns ascending times that sample the interval, plus all knot times, so
+// that both interpolation and at-knot cases are covered.
+static std::vector<TsTime>
+_GetTestTimes(const TsSpline &spline)
+{
+    const GfInterval interval = _GetTestInterval(spline);
+    const int numSamples = 1000;
+
+    std::vector<TsTime> times;
+    for (int i = 0; i <= numSamples; ++i) {
+        times.push_back(
+            interval.GetMin() + i * interval.GetSize() / numSamples);
+    }
+    for (const TsKnot &knot : spline.GetKnots()) {
+        times.push_back(knot.GetTime());
+    }
+
+    std::sort(times.begin(), times.end());
+    return times;
+}
+
+// Exact equality, except that NaNs (from vertical tangents) match each other.
+template <typename T>
+static bool
+_IsSame(const T a, const T b)
+{
+    return a == b || (std::isnan(double(a)) && std::isnan(double(b)));
+}
+
+// Verify that a batch method produces exactly the same results as the
+// corresponding single-time method.
+template <typename T, typename SingleFn, typename ManyFn>
+static void
+_CompareBatch(
+    const std::string &desc,
+    const std::vector<TsTime> &times,
+    const SingleFn &single,
+    const ManyFn &many)
+{
+    // Fill with a sentinel so that we can tell which elements were written.
+    const T sentinel = T(-12345);
+    std::vector<T> values(times.size(), sentinel);
+    const bool haveAll = many(times, TfSpan<T>(values));
+
+    bool expectAll = true;
+    for (size_t i = 0; i < times.size(); ++i) {
+        T expected = sentinel;
+        if (!single(times[i], &expected)) {
+            expectAll = false;
+        }
+
+        if (!_IsSame(values[i], expected)) {
+            std::cerr << "Batch mismatch in " << desc
+                      << " at time " << times[i]
+                      << ": expected " << expected
+                      << ", got " << values[i] << std::endl;
+            TF_FATAL_ERROR("Batch evaluation mismatch");
+        }
+    }
+
+    TF_AXIOM(haveAll == expectAll);
+}
+
+#define COMPARE_ASPECT(T, desc, spline, times, single, many)            \
+    _CompareBatch<T>(                                                   \
+        desc + " " #single, times,                                      \
+        [&spline](TsTime t, T *v) { return spline.single(t, v); },      \
+        [&spline](const std::vector<TsTime> &ts, TfSpan<T> vs)          \
+            { return spline.many(ts, vs); })
+
+template <typename T>
+static void
+_CompareAllAspects(
+    const std::string &desc,
+    const TsSpline &spline,
+    const std::vector<TsTime> &times)
+{
+    COMPARE_ASPECT(T, desc, spline, times, Eval, EvalMany);
+    COMPARE_ASPECT(T, desc, spline, times, EvalPreValue, EvalPreValueMany);
+    COMPARE_ASPECT(T, desc, spline, times, EvalDerivative, EvalDerivativeMany);
+    COMPARE_ASPECT(
+        T, desc, spline, times, EvalPreDerivative, EvalPreDerivativeMany);
+    COMPARE_ASPECT(T, desc, spline, times, EvalHeld, EvalHeldMany);
+    COMPARE_ASPECT(
+        T, desc, spline, times, EvalPreValueHeld, EvalPreValueHeldMany);
+}
+
+template <typename T>
+static void
+TestMuseum()
+{
+    const TfType valueType = Ts_GetType<T>();
+    const TsTest_TsEvaluator evaluator;
+    std::mt19937 rng(42);
+
+    for (const std::string &name : TsTest_Museum::GetAllNames()) {
+        const TsSpline spline = evaluator.SplineDataToSpline(
+            TsTest_Museum::GetDataByName(name), valueType);
+        const std::string desc =
+            name + " (" + valueType.GetTypeName() + ")";
+
+        // Ascending, descending, and shuffled times.
+        std::vector<TsTime> times = _GetTestTimes(spline);
+        _CompareAllAspects<T>(desc + " ascending", spline, times);
+
+        std::reverse(times.begin(), times.end());
+        _CompareAllAspects<T>(desc + " descending", spline, times);
+
+        std::shuffle(times.begin(), times.end(), rng);
+        _CompareAllAspects<T>(desc + " shuffled", spline, times);
+    }
+}
+
+static void
+TestEmptyAndBlocked()
+{
+    const std::vector<TsTime> times = {-1.0, 0.5, 1.5, 2.5};
+
+    // An empty spline has no values, and leaves the output untouched.
+    {
+        const TsSpline spline;
+        std::vector<double> values(times.size(), 7.0);
+        TF_AXIOM(!spline.EvalMany(times, TfSpan<double>(values)));
+        for (const double value : values) {
+            TF_AXIOM(value == 7.0);
+        }
+
+        // An empty batch trivially succeeds.
+        TF_AXIOM(spline.EvalMany(
+            std::vector<TsTime>(), TfSpan<double>()));
+    }
+
+    // A blocked segment and blocked pre-extrapolation leave gaps.
+    {
+        TsSpline spline;
+        spline.SetPreExtrapolation(TsExtrapolation(TsExtrapValueBlock));
+
+        TsKnot knot1;
+        knot1.SetTime(0.0);
+        knot1.SetValue(1.0);
+        knot1.SetNextInterpolation(TsInterpLinear);
+        spline.SetKnot(knot1);
+
+        TsKnot knot2;
+        knot2.SetTime(1.0);
+        knot2.SetValue(3.0);
+        knot2.SetNextInterpolation(TsInterpValueBlock);
+        spline.SetKnot(knot2);
+
+        TsKnot knot3;
+        knot3.SetTime(2.0);
+        knot3.SetValue(5.0);
+        spline.SetKnot(knot3);
+
+        std::vector<double> values(times.size(), 7.0);
+        TF_AXIOM(!spline.EvalMany(times, TfSpan<double>(values)));
+        TF_AXIOM(values[0] == 7.0);
+        TF_AXIOM(values[1] == 2.0);
+        TF_AXIOM(values[2] == 7.0);
+        TF_AXIOM(values[3] == 5.0);
+    }
+}
+
+static void
+TestVtArrayOutput()
+{
+    TsSpline spline;
+
+    TsKnot knot1;
+    knot1.SetTime(0.0);
+    knot1.SetValue(0.0);
+    knot1.SetNextInterpolation(TsInterpLinear);
+    spline.SetKnot(knot1);
+
+    TsKnot knot2;
+    knot2.SetTime(10.0);
+    knot2.SetValue(20.0);
+    spline.SetKnot(knot2);
+
+    std::vector<TsTime> times;
+    for (int i = 0; i <= 10; ++i) {
+        times.push_back(i);
+    }
+
+    // Output arrays are resized to match, and values may be narrowed.
+    VtArray<float> values(3);
+    TF_AXIOM(spline.EvalMany(times, &values));
+    TF_AXIOM(values.size() == times.size());
+    for (size_t i = 0; i < times.size(); ++i) {
+        TF_AXIOM(values[i] == float(2 * times[i]));
+    }
+
+    VtArray<double> slopes;
+    TF_AXIOM(spline.EvalDerivativeMany(times, &slopes));
+    TF_AXIOM(slopes.size() == times.size());
+    for (size_t i = 0; i < times.size() - 1; ++i) {
+        TF_AXIOM(slopes[i] == 2.0);
+    }
+}
+
+int
+main()
+{
+    TestMuseum<double>();
+    TestMuseum<float>();
+    TestMuseum<GfHalf>();
+    TestEmptyAndBlocked();
+    TestVtArrayOutput();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,176 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/spline.h>
+#include <pxr/ts/knot.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/testHelpers.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+
+// Returns the distance from p to the line segment from a to b.
+static double
+_GetDistance(const GfVec2d &p, const GfVec2d &a, const GfVec2d &b)
+{
+    const GfVec2d ab = b - a;
+    const double lengthSq = ab.GetLengthSq();
+    const double u = (lengthSq > 0 ?
+        std::clamp(((p - a) * ab) / lengthSq, 0.0, 1.0) : 0.0);
+    return (p - (a + u * ab)).GetLength();
+}
+
+// Verify that every polyline is within tolerance of the spline, by evaluating
+// the spline densely between each pair of vertices, and measuring in the
+// scaled space in which the tolerance applies.  Returns the number of
+// vertices.
+static size_t
+_Verify(
+    const std::string &desc,
+    const TsSpline &spline,
+    const GfInterval &interval,
+    const double timeScale,
+    const double valueScale,
+    const double tolerance,
+    const TsBezierFlattening flattening)
+{
+    TsSplineSamplesWithSources<GfVec2d> samples;
+    TF_AXIOM(spline.Sample(
+        interval, timeScale, valueScale, tolerance, &samples, flattening));
+
+    const GfVec2d scale(timeScale, valueScale);
+    const int numChecks = 16;
+    size_t numVertices = 0;
+    for (const std::vector<GfVec2d> &polyline : samples.polylines) {
+        numVertices += polyline.size();
+        for (size_t i = 0; i + 1 < polyline.size(); ++i) {
+            const GfVec2d a = GfCompMult(scale, polyline[i]);
+            const GfVec2d b = GfCompMult(scale, polyline[i + 1]);
+            for (int j = 1; j < numChecks; ++j) {
+                const TsTime time = GfLerp(
+                    double(j) / numChecks, polyline[i][0], polyline[i + 1][0]);
+                double value = 0;
+                if (time == polyline[i][0] || time == polyline[i + 1][0] ||
+                    !spline.Eval(time, &value)) {
+                    continue;
+                }
+
+                const double distance = _GetDistance(
+                    GfCompMult(scale, GfVec2d(time, value)), a, b);
+                if (!(distance <= tolerance * 1.01 + 1e-9)) {
+                    std::cerr << "Polyline error in " << desc << " at time "
+                              << time << ": " << distance
+                              << " exceeds tolerance " << tolerance
+                              << std::endl;
+                    TF_FATAL_ERROR("Polyline out of tolerance");
+                }
+            }
+        }
+    }
+    return numVertices;
+}
+
+static void
+TestMuseum()
+{
+    size_t numSubdivided = 0, numUniform = 0;
+    for (const auto &[name, spline] : TsTest_GetMuseumSplines()) {
+        const GfInterval span = TsTest_GetKnotSpan(spline);
+        const double size = std::max(span.GetSize(), 1.0);
+        const double timeScale = 500 / size;
+
+        // Include extrapolation, except where extrapolating loops repeat
+        // inner loops, which sampling doesn't yet reproduce in either mode.
+        const GfInterval interval =
+            (spline.HasInnerLoops() && spline.HasExtrapolatingLoops() ?
+                span : TsTest_GetTestInterval(spline, 1.5));
+
+        for (const double tolerance : {1.0, 0.25}) {
+            numSubdivided += _Verify(
+                name, spline, interval, timeScale, 50, tolerance,
+                TsBezierFlatteningSubdivide);
+            numUniform += _Verify(
+                name + " uniform", spline, interval, timeScale, 50, tolerance,
+                TsBezierFlatteningUniform);
+        }
+    }
+    std::cout << "Museum vertices: subdivided " << numSubdivided
+              << ", uniform " << numUniform << std::endl;
+}
+
+static void
+TestCases()
+{
+    TsSpline spline;
+    TsKnot knot = TsTest_MakeKnot(0, 0, TsInterpCurve);
+    knot.SetPostTanWidth(4.0);
+    knot.SetPostTanSlope(3.0);
+    spline.SetKnot(knot);
+    knot = TsTest_MakeKnot(10, 2, TsInterpCurve);
+    knot.SetPreTanWidth(2.0);
+    knot.SetPreTanSlope(-4.0);
+    spline.SetKnot(knot);
+
+    // The vertices are on the curve, the ends exactly, and the count is known
+    // in advance, so the reservation is exact.
+    TsSplineFlatSamples<GfVec2d> flat;
+    TF_AXIOM(spline.Sample(GfInterval(0, 10), 10.0, 10.0, 0.1, &flat,
+                           TsBezierFlatteningUniform));
+    TF_AXIOM(flat.GetNumPolylines() == 1);
+    TF_AXIOM(flat.vertices.size() > 2);
+    TF_AXIOM(flat.vertices.capacity() == flat.vertices.size());
+    TF_AXIOM(flat.vertices.front() == GfVec2d(0, 0));
+    TF_AXIOM(flat.vertices.back() == GfVec2d(10, 2));
+    for (const GfVec2d &vertex : flat.vertices) {
+        double value = 0;
+        TF_AXIOM(spline.Eval(vertex[0], &value));
+        TF_AXIOM(std::abs(value - vertex[1]) < 1e-6);
+    }
+    for (size_t i = 0; i + 1 < flat.vertices.size(); ++i) {
+        TF_AXIOM(flat.vertices[i][0] < flat.vertices[i + 1][0]);
+    }
+
+    // Halving the tolerance multiplies the count by about the square root of
+    // two.
+    const size_t numVertices = flat.vertices.size();
+    TF_AXIOM(spline.Sample(GfInterval(0, 10), 10.0, 10.0, 0.05, &flat,
+                           TsBezierFlatteningUniform));
+    const double ratio =
+        double(flat.vertices.size() - 1) / double(numVertices - 1);
+    TF_AXIOM(ratio > 1.2 && ratio < 1.6);
+
+    // Clipped to the interval, with the ends interpolated.
+    TF_AXIOM(spline.Sample(GfInterval(2.5, 7.5), 10.0, 10.0, 0.1, &flat,
+                           TsBezierFlatteningUniform));
+    TF_AXIOM(flat.GetNumPolylines() == 1);
+    TF_AXIOM(flat.vertices.front()[0] == 2.5);
+    TF_AXIOM(flat.vertices.back()[0] == 7.5);
+
+    // Linear segments are unaffected.
+    TsSpline linear;
+    linear.SetKnot(TsTest_MakeKnot(0, 0, TsInterpLinear));
+    linear.SetKnot(TsTest_MakeKnot(10, 10, TsInterpLinear));
+    TF_AXIOM(linear.Sample(GfInterval(0, 10), 1.0, 1.0, 0.1, &flat,
+                           TsBezierFlatteningUniform));
+    TF_AXIOM(flat.vertices.size() == 2);
+}
+
+int
+main()
+{
+    TestMuseum();
+    TestCases();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,199 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/spline.h>
+#include <pxr/ts/types.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <pxr/tf/enum.h>
+#include <tsTest/museum.h>
+#include <tsTest/tsEvaluator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+
+// Returns evenly spaced times that cover a spline's knots and inner loops, plus
+// some extrapolation on both sides, followed by the knot times themselves.
+static std::vector<TsTime>
+_GetTestTimes(const TsSpline &spline, const int numSamples)
+{
+    GfInterval span = spline.GetKnots().GetTimeSpan();
+    if (spline.HasInnerLoops()) {
+        span |= spline.GetInnerLoopParams().GetLoopedInterval();
+    }
+
+    const double size = std::max(span.GetSize(), 1.0);
+    const double min = span.GetMin() - 0.5 * size;
+    const double max = span.GetMax() + 0.5 * size;
+
+    std::vector<TsTime> times;
+    for (int i = 0; i <= numSamples; ++i) {
+        times.push_back(min + i * (max - min) / numSamples);
+    }
+    for (const TsKnot &knot : spline.GetKnots()) {
+        times.push_back(knot.GetTime());
+    }
+    return times;
+}
+
+static TsEvalOptions
+_MakeOptions(const TsBezierSolver solver, const double tolerance = 1e-12)
+{
+    TsEvalOptions options;
+    options.bezierSolver = solver;
+    options.solverTolerance = tolerance;
+    return options;
+}
+
+// Relative error, with values near zero compared absolutely.
+static double
+_GetError(const double value, const double reference)
+{
+    return std::abs(value - reference)
+        / std::max({1.0, std::abs(value), std::abs(reference)});
+}
+
+using _EvalMethod =
+    bool (TsSpline::*)(TsTime, double*, const TsEvalOptions&) const;
+
+static const std::vector<std::pair<std::string, _EvalMethod>> &
+_GetMethods()
+{
+    static const std::vector<std::pair<std::string, _EvalMethod>> methods = {
+        {"Eval", &TsSpline::Eval<double>},
+        {"EvalPreValue", &TsSpline::EvalPreValue<double>},
+        {"EvalDerivative", &TsSpline::EvalDerivative<double>},
+        {"EvalPreDerivative", &TsSpline::EvalPreDerivative<double>}};
+    return methods;
+}
+
+static void
+TestOptions()
+{
+    const TsEvalOptions defaults;
+    TF_AXIOM(defaults.bezierSolver == TsBezierSolverCardano);
+    TF_AXIOM(defaults == TsEvalOptions());
+
+    TsEvalOptions options = defaults;
+    options.bezierSolver = TsBezierSolverNewton;
+    TF_AXIOM(options != defaults);
+
+    options = defaults;
+    options.solverTolerance = 1e-6;
+    TF_AXIOM(options != defaults);
+}
+
+// Compare every solver to a reference: Halley iteration with zero tolerance,
+// which runs until it stops making progress, and is thus accurate to rounding.
+// The iterative solvers should be close to the reference everywhere.  Cardano's
+// formula loses precision near vertical tangents, so it is held only to the
+// looser tolerance that testTsCompiledSpline uses.
+//
+static void
+TestAccuracy()
+{
+    const TsTest_TsEvaluator evaluator;
+    const TsEvalOptions reference = _MakeOptions(TsBezierSolverHalley, 0);
+
+    const std::vector<std::pair<TsBezierSolver, double>> solvers = {
+        {TsBezierSolverCardano, 1e-4},
+        {TsBezierSolverNewton, 1e-9},
+        {TsBezierSolverHalley, 1e-9}};
+
+    for (const std::string &name : TsTest_Museum::GetAllNames()) {
+        const TsSpline spline = evaluator.SplineDataToSpline(
+            TsTest_Museum::GetDataByName(name));
+        const std::vector<TsTime> times = _GetTestTimes(spline, 1000);
+
+        for (const auto &method : _GetMethods()) {
+            for (const auto &[solver, maxError] : solvers) {
+                const TsEvalOptions options = _MakeOptions(solver);
+
+                for (const TsTime time : times) {
+                    double expected = 0, actual = 0;
+                    const bool haveExpected =
+                        (spline.*method.second)(time, &expected, reference);
+                    const bool haveActual =
+                        (spline.*method.second)(time, &actual, options);
+                    TF_AXIOM(haveActual == haveExpected);
+
+                    // Derivatives at cusps are undefined.  Very large
+                    // derivatives, at vertical tangents, are compared only by
+                    // sign.
+                    if (!haveExpected
+                        || (std::isnan(expected) && std::isnan(actual))
+                        || (std::abs(expected) > 1e6
+                            && std::abs(actual) > 1e6
+                            && (expected > 0) == (actual > 0))) {
+                        continue;
+                    }
+
+                    if (!(_GetError(actual, expected) <= maxError)) {
+                        std::cerr << TfEnum::GetName(solver) << " error in "
+                                  << name << " " << method.first
+                                  << " at time " << time << ": expected "
+                                  << expected << ", got " << actual
+                                  << std::endl;
+                        TF_FATAL_ERROR("Solver inaccuracy");
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Options apply to compiled splines, and to batch evaluation.
+//
+static void
+TestCompiledAndBatch()
+{
+    const TsTest_TsEvaluator evaluator;
+    const TsEvalOptions newton = _MakeOptions(TsBezierSolverNewton);
+
+    for (const std::string &name : TsTest_Museum::GetAllNames()) {
+        const TsSpline spline = evaluator.SplineDataToSpline(
+            TsTest_Museum::GetDataByName(name));
+        const std::vector<TsTime> times = _GetTestTimes(spline, 500);
+
+        std::vector<double> expected(times.size());
+        std::vector<bool> haveExpected(times.size());
+        for (size_t i = 0; i < times.size(); ++i) {
+            haveExpected[i] = spline.Eval(times[i], &expected[i], newton);
+        }
+
+        spline.Compile();
+
+        std::vector<double> single(times.size());
+        std::vector<double> batch(times.size());
+        spline.EvalMany(times, TfSpan<double>(batch), newton);
+
+        for (size_t i = 0; i < times.size(); ++i) {
+            TF_AXIOM(spline.Eval(times[i], &single[i], newton)
+                     == haveExpected[i]);
+            if (haveExpected[i]) {
+                TF_AXIOM(_GetError(single[i], expected[i]) <= 1e-9);
+                TF_AXIOM(_GetError(batch[i], expected[i]) <= 1e-9);
+            }
+        }
+    }
+}
+
+int
+main()
+{
+    TestOptions();
+    TestAccuracy();
+    TestCompiledAndBatch();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
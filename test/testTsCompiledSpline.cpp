@@ -0,0 +1,338 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/spline.h>
+#include <pxr/ts/knot.h>
+#include <pxr/ts/raii.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/museum.h>
+#include <tsTest/tsEvaluator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace pxr;
+
+
+// Returns times that cover a spline's knots and inner loops, plus some
+// extrapolation on both sides.  Includes the knot times themselves.
+static std::vector<TsTime>
+_GetTestTimes(const TsSpline &spline)
+{
+    GfInterval span = spline.GetKnots().GetTimeSpan();
+    if (spline.HasInnerLoops()) {
+        span |= spline.GetInnerLoopParams().GetLoopedInterval();
+    }
+
+    const double size = std::max(span.GetSize(), 1.0);
+    const double min = span.GetMin() - 1.5 * size;
+    const double max = span.GetMax() + 1.5 * size;
+    const int numSamples = 1000;
+
+    std::vector<TsTime> times;
+    for (int i = 0; i <= numSamples; ++i) {
+        times.push_back(min + i * (max - min) / numSamples);
+    }
+    for (const TsKnot &knot : spline.GetKnots()) {
+        times.push_back(knot.GetTime());
+    }
+    return times;
+}
+
+// Compiled evaluation uses differently arranged arithmetic, so it may differ
+// from uncompiled evaluation by rounding.  The difference is usually tiny, but
+// de-regressed segments are vertical at one point, and near there Cardano's
+// formula amplifies rounding considerably; we have seen relative differences
+// up to about 1e-5.  Very large derivatives are compared only by sign.
+static bool
+_IsClose(const double a, const double b)
+{
+    if (std::isnan(a) || std::isnan(b)) {
+        return std::isnan(a) && std::isnan(b);
+    }
+    if (std::abs(a) > 1e6 && std::abs(b) > 1e6) {
+        return (a > 0) == (b > 0);
+    }
+    return std::abs(a - b) <= 1e-4 * std::max({1.0, std::abs(a), std::abs(b)});
+}
+
+using _EvalMethod = bool (TsSpline::*)(TsTime, double*) const;
+
+static void
+_EvalAll(
+    const TsSpline &spline,
+    const std::vector<TsTime> &times,
+    const _EvalMethod method,
+    std::vector<double> *values,
+    std::vector<bool> *haveValues)
+{
+    values->assign(times.size(), 0.0);
+    haveValues->assign(times.size(), false);
+    for (size_t i = 0; i < times.size(); ++i) {
+        (*haveValues)[i] = (spline.*method)(times[i], &(*values)[i]);
+    }
+}
+
+static void
+TestMuseum()
+{
+    const TsTest_TsEvaluator evaluator;
+
+    const std::vector<std::pair<std::string, _EvalMethod>> methods = {
+        {"Eval", &TsSpline::Eval<double>},
+        {"EvalPreValue", &TsSpline::EvalPreValue<double>},
+        {"EvalDerivative", &TsSpline::EvalDerivative<double>},
+        {"EvalPreDerivative", &TsSpline::EvalPreDerivative<double>},
+        {"EvalHeld", &TsSpline::EvalHeld<double>},
+        {"EvalPreValueHeld", &TsSpline::EvalPreValueHeld<double>}};
+
+    for (const std::string &name : TsTest_Museum::GetAllNames()) {
+        const TsTest_SplineData data = TsTest_Museum::GetDataByName(name);
+        const std::vector<TsTime> times =
+            _GetTestTimes(evaluator.SplineDataToSpline(data));
+
+        for (const auto &method : methods) {
+            // Evaluate without, then with, compiled data.  Compilation affects
+            // all copies, so start each method with independent data.
+            const TsSpline spline = evaluator.SplineDataToSpline(data);
+            TF_AXIOM(!spline.IsCompiled());
+
+            std::vector<double> expected, actual;
+            std::vector<bool> haveExpected, haveActual;
+            _EvalAll(spline, times, method.second,
+                     &expected, &haveExpected);
+
+            spline.Compile();
+            TF_AXIOM(spline.IsCompiled());
+            _EvalAll(spline, times, method.second,
+                     &actual, &haveActual);
+
+            for (size_t i = 0; i < times.size(); ++i) {
+                if (haveActual[i] != haveExpected[i]
+                    || (haveActual[i] && !_IsClose(actual[i], expected[i]))) {
+                    std::cerr << "Compiled mismatch in " << name << " "
+                              << method.first << " at time " << times[i]
+                              << ": expected " << expected[i]
+                              << ", got " << actual[i] << std::endl;
+                    TF_FATAL_ERROR("Compiled evaluation mismatch");
+                }
+            }
+        }
+    }
+}
+
+using _EvalManyMethod =
+    bool (TsSpline::*)(TfSpan<const TsTime>, TfSpan<double>) const;
+
+// Batch evaluation of compiled splines uses block kernels with a different
+// solver.  Compare to single evaluation, in ascending and shuffled order, so
+// that blocks contain samples from one segment and from many.
+static void
+TestBatch()
+{
+    const TsTest_TsEvaluator evaluator;
+    std::mt19937 rng(42);
+
+    const std::vector<std::tuple<std::string, _EvalMethod, _EvalManyMethod>>
+        methods = {
+        {"Eval", &TsSpline::Eval<double>,
+         &TsSpline::EvalMany<double>},
+        {"EvalPreValue", &TsSpline::EvalPreValue<double>,
+         &TsSpline::EvalPreValueMany<double>},
+        {"EvalDerivative", &TsSpline::EvalDerivative<double>,
+         &TsSpline::EvalDerivativeMany<double>},
+        {"EvalPreDerivative", &TsSpline::EvalPreDerivative<double>,
+         &TsSpline::EvalPreDerivativeMany<double>},
+        {"EvalHeld", &TsSpline::EvalHeld<double>,
+         &TsSpline::EvalHeldMany<double>},
+        {"EvalPreValueHeld", &TsSpline::EvalPreValueHeld<double>,
+         &TsSpline::EvalPreValueHeldMany<double>}};
+
+    for (const std::string &name : TsTest_Museum::GetAllNames()) {
+        const TsSpline spline = evaluator.SplineDataToSpline(
+            TsTest_Museum::GetDataByName(name));
+        spline.Compile();
+
+        std::vector<TsTime> times = _GetTestTimes(spline);
+        std::sort(times.begin(), times.end());
+
+        for (const bool shuffle : {false, true}) {
+            if (shuffle) {
+                std::shuffle(times.begin(), times.end(), rng);
+            }
+
+            for (const auto &method : methods) {
+                std::vector<double> expected;
+                std::vector<bool> haveExpected;
+                _EvalAll(spline, times, std::get<1>(method),
+                         &expected, &haveExpected);
+
+                // Fill with a sentinel, which should remain only where there
+                // is no value.
+                const double sentinel = -12345;
+                std::vector<double> actual(times.size(), sentinel);
+                const bool haveAll = (spline.*std::get<2>(method))(
+                    times, TfSpan<double>(actual));
+
+                bool expectAll = true;
+                for (size_t i = 0; i < times.size(); ++i) {
+                    expectAll = expectAll && haveExpected[i];
+                    const bool ok = haveExpected[i] ?
+                        _IsClose(actual[i], expected[i]) :
+                        actual[i] == sentinel;
+                    if (!ok) {
+                        std::cerr << "Compiled batch mismatch in " << name
+                                  << " " << std::get<0>(method)
+                                  << " at time " << times[i]
+                                  << ": expected " << expected[i]
+                                  << ", got " << actual[i] << std::endl;
+                        TF_FATAL_ERROR("Compiled batch evaluation mismatch");
+                    }
+                }
+                TF_AXIOM(haveAll == expectAll);
+            }
+        }
+    }
+}
+
+static TsSpline
+_MakeSpline()
+{
+    TsSpline spline;
+
+    TsKnot knot1;
+    knot1.SetTime(0.0);
+    knot1.SetValue(0.0);
+    knot1.SetNextInterpolation(TsInterpCurve);
+    knot1.SetPostTanWidth(5.0);
+    knot1.SetPostTanSlope(VtValue(2.0));
+    spline.SetKnot(knot1);
+
+    TsKnot knot2;
+    knot2.SetTime(10.0);
+    knot2.SetValue(20.0);
+    knot2.SetPreTanWidth(5.0);
+    knot2.SetPreTanSlope(VtValue(0.0));
+    spline.SetKnot(knot2);
+
+    return spline;
+}
+
+// The block solver can land exactly on a segment end for times that are
+// strictly inside the segment.  Values there are the knot values, but
+// derivatives must still be slopes.
+static void
+TestBatchSegmentEnds()
+{
+    TsSpline spline;
+
+    TsKnot knot1;
+    knot1.SetTime(0.0);
+    knot1.SetValue(0.0);
+    knot1.SetNextInterpolation(TsInterpCurve);
+    knot1.SetPostTanWidth(0.2);
+    knot1.SetPostTanSlope(VtValue(1.0));
+    spline.SetKnot(knot1);
+
+    TsKnot knot2;
+    knot2.SetTime(2.0);
+    knot2.SetValue(5.0);
+    knot2.SetPreTanWidth(0.2);
+    knot2.SetPreTanSlope(VtValue(0.0));
+    spline.SetKnot(knot2);
+
+    spline.Compile();
+
+    // One ULP before the end knot, in every lane of a block.
+    const double inf = std::numeric_limits<double>::infinity();
+    const std::vector<TsTime> times(8, std::nextafter(2.0, -inf));
+
+    const std::vector<std::pair<_EvalMethod, _EvalManyMethod>> methods = {
+        {&TsSpline::EvalDerivative<double>,
+         &TsSpline::EvalDerivativeMany<double>},
+        {&TsSpline::EvalPreDerivative<double>,
+         &TsSpline::EvalPreDerivativeMany<double>}};
+
+    for (const auto &method : methods) {
+        double expected = 0;
+        TF_AXIOM((spline.*method.first)(times.front(), &expected));
+        TF_AXIOM(std::abs(expected) < 1e-6);
+
+        std::vector<double> actual(times.size());
+        TF_AXIOM((spline.*method.second)(times, TfSpan<double>(actual)));
+        for (const double value : actual) {
+            TF_AXIOM(_IsClose(value, expected));
+        }
+    }
+}
+
+static void
+TestCopyOnWrite()
+{
+    // Copies share compiled data.
+    TsSpline spline1 = _MakeSpline();
+    TF_AXIOM(!spline1.IsCompiled());
+    spline1.Compile();
+    TF_AXIOM(spline1.IsCompiled());
+
+    TsSpline spline2 = spline1;
+    TF_AXIOM(spline2.IsCompiled());
+
+    // Compiling again is harmless.
+    spline2.Compile();
+    TF_AXIOM(spline1.IsCompiled());
+
+    // Editing one copy discards compiled data from that copy only.
+    TsKnot knot;
+    TF_AXIOM(spline2.GetKnot(10.0, &knot));
+    knot.SetValue(30.0);
+    spline2.SetKnot(knot);
+    TF_AXIOM(!spline2.IsCompiled());
+    TF_AXIOM(spline1.IsCompiled());
+
+    // Recompiling picks up the edit.
+    double value1 = 0, value2 = 0;
+    spline2.Compile();
+    TF_AXIOM(spline1.Eval(5.0, &value1));
+    TF_AXIOM(spline2.Eval(5.0, &value2));
+    TF_AXIOM(value1 != value2);
+
+    // Editing unshared data discards compiled data too.
+    spline1.SetPostExtrapolation(TsExtrapolation(TsExtrapLinear));
+    TF_AXIOM(!spline1.IsCompiled());
+
+    // So does adjusting regressive tangents in unshared data.
+    TsSpline spline3 = _MakeSpline();
+    TsKnot knot3;
+    TF_AXIOM(spline3.GetKnot(0.0, &knot3));
+    {
+        TsAntiRegressionAuthoringSelector selector(TsAntiRegressionNone);
+        knot3.SetPostTanWidth(50.0);
+        spline3.SetKnot(knot3);
+    }
+    spline3.Compile();
+    TF_AXIOM(spline3.AdjustRegressiveTangents());
+    TF_AXIOM(!spline3.IsCompiled());
+}
+
+int
+main()
+{
+    TestMuseum();
+    TestBatch();
+    TestBatchSegmentEnds();
+    TestCopyOnWrite();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,155 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/spline.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/museum.h>
+#include <tsTest/tsEvaluator.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+
+// Count every heap allocation made by this process.  Evaluation is a hot path
+// that is expected not to allocate; this test verifies that it doesn't.
+
+static std::atomic<size_t> _numAllocations(0);
+
+void* operator new(std::size_t size)
+{
+    ++_numAllocations;
+    if (void* const p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    ++_numAllocations;
+    if (void* const p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+// Returns times that cover a spline's knots, plus some extrapolation on both
+// sides.  Includes the knot times themselves.
+static std::vector<TsTime>
+_GetTestTimes(const TsSpline &spline)
+{
+    GfInterval span = spline.GetKnots().GetTimeSpan();
+    if (spline.HasInnerLoops()) {
+        span |= spline.GetInnerLoopParams().GetLoopedInterval();
+    }
+
+    const double size = std::max(span.GetSize(), 1.0);
+    const double min = span.GetMin() - size;
+    const double max = span.GetMax() + size;
+    const int numSamples = 200;
+
+    std::vector<TsTime> times;
+    for (int i = 0; i <= numSamples; ++i) {
+        times.push_back(min + i * (max - min) / numSamples);
+    }
+    for (const TsKnot &knot : spline.GetKnots()) {
+        times.push_back(knot.GetTime());
+    }
+    return times;
+}
+
+template <typename T>
+static void
+TestMuseum()
+{
+    const TfType valueType = Ts_GetType<T>();
+    const TsTest_TsEvaluator evaluator;
+
+    for (const std::string &name : TsTest_Museum::GetAllNames()) {
+        const TsSpline spline = evaluator.SplineDataToSpline(
+            TsTest_Museum::GetDataByName(name), valueType);
+        const std::vector<TsTime> times = _GetTestTimes(spline);
+        std::vector<T> values(times.size());
+
+        // Evaluate without, then with, compiled data.
+        for (const bool compile : {false, true}) {
+            if (compile) {
+                spline.Compile();
+            }
+
+            // The first evaluation builds the loop topology that is cached
+            // on the spline data, which allocates once.
+            T value;
+            spline.Eval(times.front(), &value);
+
+            // Everything above may allocate.  Nothing below should.
+            const size_t numBefore = _numAllocations;
+
+            for (const TsTime time : times) {
+                spline.Eval(time, &value);
+                spline.EvalPreValue(time, &value);
+                spline.EvalDerivative(time, &value);
+                spline.EvalPreDerivative(time, &value);
+                spline.EvalHeld(time, &value);
+                spline.EvalPreValueHeld(time, &value);
+            }
+
+            spline.EvalMany(times, TfSpan<T>(values));
+            spline.EvalPreValueMany(times, TfSpan<T>(values));
+            spline.EvalDerivativeMany(times, TfSpan<T>(values));
+            spline.EvalPreDerivativeMany(times, TfSpan<T>(values));
+            spline.EvalHeldMany(times, TfSpan<T>(values));
+            spline.EvalPreValueHeldMany(times, TfSpan<T>(values));
+
+            const size_t numDuring = _numAllocations - numBefore;
+            if (numDuring != 0) {
+                std::cerr << "Evaluation of " << name << " ("
+                          << valueType.GetTypeName() << ")"
+                          << (compile ? ", compiled," : "") << " made "
+                          << numDuring << " allocations" << std::endl;
+                TF_FATAL_ERROR("Evaluation allocated");
+            }
+        }
+    }
+}
+
+int
+main()
+{
+    TestMuseum<double>();
+    TestMuseum<float>();
+    TestMuseum<GfHalf>();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
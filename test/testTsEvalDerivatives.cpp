@@ -0,0 +1,292 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/spline.h>
+#include <pxr/ts/knot.h>
+#include <pxr/ts/raii.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/museum.h>
+#include <tsTest/tsEvaluator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+
+// Combined evaluation computes values and derivatives with one knot search and
+// one segment solve.  These tests verify that its results are exactly those of
+// separate evaluation, and that second derivatives are correct.
+
+// Returns times that cover a spline's knots and inner loops, plus some
+// extrapolation on both sides.  Includes the knot times themselves.
+static std::vector<TsTime>
+_GetTestTimes(const TsSpline &spline)
+{
+    GfInterval span = spline.GetKnots().GetTimeSpan();
+    if (spline.HasInnerLoops()) {
+        span |= spline.GetInnerLoopParams().GetLoopedInterval();
+    }
+
+    const double size = std::max(span.GetSize(), 1.0);
+    const double min = span.GetMin() - 2.5 * size;
+    const double max = span.GetMax() + 2.5 * size;
+    const int numSamples = 1000;
+
+    std::vector<TsTime> times;
+    for (int i = 0; i <= numSamples; ++i) {
+        times.push_back(min + i * (max - min) / numSamples);
+    }
+    for (const TsKnot &knot : spline.GetKnots()) {
+        times.push_back(knot.GetTime());
+    }
+    return times;
+}
+
+// Exact equality, except that NaNs (from vertical tangents) match each other.
+static bool
+_IsSame(const double a, const double b)
+{
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+static void
+_VerifySame(
+    const std::string &context,
+    const TsTime time,
+    const char* const what,
+    const double expected,
+    const double actual)
+{
+    if (!_IsSame(expected, actual)) {
+        std::cerr << "Mismatch in " << what << " for " << context
+                  << " at time " << time << ": expected " << expected
+                  << ", got " << actual << std::endl;
+        TF_FATAL_ERROR("Combined evaluation mismatch");
+    }
+}
+
+// Verifies combined evaluation of a spline against separate evaluation, on
+// both sides, singly and in batches.
+static void
+_VerifySpline(
+    const std::string &context,
+    const TsSpline &spline)
+{
+    const std::vector<TsTime> times = _GetTestTimes(spline);
+
+    for (const bool pre : {false, true}) {
+        std::vector<double> values(times.size(), 0);
+        std::vector<double> derivs(times.size(), 0);
+        std::vector<double> seconds(times.size(), 0);
+        bool expectAll = true;
+
+        for (size_t i = 0; i < times.size(); ++i) {
+            const TsTime time = times[i];
+
+            double value = 0, deriv = 0;
+            const bool haveValue = (pre ?
+                spline.EvalPreValue(time, &value) :
+                spline.Eval(time, &value));
+            const bool haveDeriv = (pre ?
+                spline.EvalPreDerivative(time, &deriv) :
+                spline.EvalDerivative(time, &deriv));
+
+            double combinedValue = 0, combinedDeriv = 0, second = 0;
+            const bool haveCombined = (pre ?
+                spline.EvalPreWithDerivatives(
+                    time, &combinedValue, &combinedDeriv, &second) :
+                spline.EvalWithDerivatives(
+                    time, &combinedValue, &combinedDeriv, &second));
+
+            TF_AXIOM(haveCombined == (haveValue && haveDeriv));
+            if (!haveCombined) {
+                expectAll = false;
+                continue;
+            }
+
+            _VerifySame(context, time, "value", value, combinedValue);
+            _VerifySame(context, time, "derivative", deriv, combinedDeriv);
+            values[i] = combinedValue;
+            derivs[i] = combinedDeriv;
+            seconds[i] = second;
+
+            // The second derivative is optional.
+            double valueOnly = 0, derivOnly = 0;
+            TF_AXIOM(pre ?
+                spline.EvalPreWithDerivatives(time, &valueOnly, &derivOnly) :
+                spline.EvalWithDerivatives(time, &valueOnly, &derivOnly));
+            _VerifySame(context, time, "value", value, valueOnly);
+        }
+
+        // Batch results are the same as single ones.
+        std::vector<double> batchValues(times.size(), 0);
+        std::vector<double> batchDerivs(times.size(), 0);
+        std::vector<double> batchSeconds(times.size(), 0);
+        const bool haveAll = (pre ?
+            spline.EvalPreWithDerivativesMany(
+                times, TfSpan<double>(batchValues),
+                TfSpan<double>(batchDerivs), TfSpan<double>(batchSeconds)) :
+            spline.EvalWithDerivativesMany(
+                times, TfSpan<double>(batchValues),
+                TfSpan<double>(batchDerivs), TfSpan<double>(batchSeconds)));
+        TF_AXIOM(haveAll == expectAll);
+
+        for (size_t i = 0; i < times.size(); ++i) {
+            _VerifySame(context, times[i], "batch value",
+                values[i], batchValues[i]);
+            _VerifySame(context, times[i], "batch derivative",
+                derivs[i], batchDerivs[i]);
+            _VerifySame(context, times[i], "batch second derivative",
+                seconds[i], batchSeconds[i]);
+        }
+    }
+}
+
+static void
+TestMuseum()
+{
+    const TsTest_TsEvaluator evaluator;
+
+    for (const std::string &name : TsTest_Museum::GetAllNames()) {
+        const TsSpline spline = evaluator.SplineDataToSpline(
+            TsTest_Museum::GetDataByName(name));
+        _VerifySpline(name, spline);
+
+        TsSpline compiled = spline;
+        compiled.SetPreExtrapolation(compiled.GetPreExtrapolation());
+        compiled.Compile();
+        _VerifySpline(name + " compiled", compiled);
+    }
+}
+
+// A curve with uneven knot spacing and asymmetric tangents.
+static TsSpline
+_MakeCurve(const TsCurveType curveType)
+{
+    TsSpline spline;
+    spline.SetCurveType(curveType);
+    const double times[] = {0.0, 3.0, 10.0, 12.0};
+    const double values[] = {0.0, 4.0, -1.0, 2.0};
+    const double slopes[] = {1.0, -0.5, 2.0, 0.0};
+    for (size_t i = 0; i < 4; ++i) {
+        TsKnot knot(Ts_GetType<double>(), curveType);
+        knot.SetTime(times[i]);
+        knot.SetValue(values[i]);
+        knot.SetNextInterpolation(TsInterpCurve);
+        knot.SetPreTanSlope(slopes[i]);
+        knot.SetPostTanSlope(slopes[i]);
+        if (curveType == TsCurveTypeBezier) {
+            knot.SetPreTanWidth(0.8 + 0.3 * i);
+            knot.SetPostTanWidth(1.5 - 0.2 * i);
+        }
+        spline.SetKnot(knot);
+    }
+    return spline;
+}
+
+// Second derivatives match finite differences of first derivatives, inside
+// segments, and on each side of knots.
+//
+static void
+TestSecondDerivatives()
+{
+    const double h = 1e-5;
+
+    for (const TsCurveType curveType :
+             {TsCurveTypeBezier, TsCurveTypeHermite}) {
+        for (const bool compile : {false, true}) {
+            TsSpline spline = _MakeCurve(curveType);
+            if (compile) {
+                spline.Compile();
+            }
+
+            for (TsTime time = 0.05; time < 12.0; time += 0.1) {
+                double value = 0, deriv = 0, second = 0;
+                TF_AXIOM(spline.EvalWithDerivatives(
+                    time, &value, &deriv, &second));
+
+                double before = 0, after = 0;
+                TF_AXIOM(spline.EvalDerivative(time - h, &before));
+                TF_AXIOM(spline.EvalDerivative(time + h, &after));
+                const double expected = (after - before) / (2 * h);
+                TF_AXIOM(std::abs(second - expected)
+                         < 1e-4 * std::max(1.0, std::abs(expected)));
+            }
+
+            // At knots, each side uses its own segment.
+            for (const TsTime time : {3.0, 10.0}) {
+                double value = 0, deriv = 0, second = 0, preSecond = 0;
+                TF_AXIOM(spline.EvalWithDerivatives(
+                    time, &value, &deriv, &second));
+                TF_AXIOM(spline.EvalPreWithDerivatives(
+                    time, &value, &deriv, &preSecond));
+
+                double atKnot = 0, before = 0, after = 0;
+                TF_AXIOM(spline.EvalDerivative(time, &atKnot));
+                TF_AXIOM(spline.EvalDerivative(time - h, &before));
+                TF_AXIOM(spline.EvalDerivative(time + h, &after));
+                TF_AXIOM(std::abs(second - (after - atKnot) / h) < 1e-3);
+                TF_AXIOM(std::abs(preSecond - (atKnot - before) / h) < 1e-3);
+            }
+        }
+    }
+
+    // Linear and held segments, and extrapolation, have no curvature.
+    TsSpline linear = _MakeCurve(TsCurveTypeBezier);
+    for (TsKnot knot : linear.GetKnots()) {
+        knot.SetNextInterpolation(TsInterpLinear);
+        linear.SetKnot(knot);
+    }
+    linear.SetPostExtrapolation(TsExtrapolation(TsExtrapLinear));
+    for (const TsTime time : {-1.0, 1.0, 3.0, 11.0, 15.0}) {
+        double value = 0, deriv = 0, second = 1;
+        TF_AXIOM(linear.EvalWithDerivatives(time, &value, &deriv, &second));
+        TF_AXIOM(second == 0);
+    }
+}
+
+// Mismatched output sizes are rejected, with coding errors.
+static void
+TestErrors()
+{
+    const TsSpline spline = _MakeCurve(TsCurveTypeBezier);
+    const std::vector<TsTime> times = {1.0, 2.0, 3.0};
+    std::vector<double> values(3), derivs(2), seconds(3);
+
+    TF_AXIOM(!spline.EvalWithDerivativesMany(
+        times, TfSpan<double>(values), TfSpan<double>(derivs)));
+    TF_AXIOM(!spline.EvalWithDerivativesMany(
+        times, TfSpan<double>(values), TfSpan<double>(seconds),
+        TfSpan<double>(derivs)));
+
+    // Floats are converted.
+    std::vector<float> floatValues(3), floatDerivs(3);
+    TF_AXIOM(spline.EvalWithDerivativesMany(
+        times, TfSpan<float>(floatValues), TfSpan<float>(floatDerivs)));
+    double value = 0;
+    TF_AXIOM(spline.Eval(2.0, &value));
+    TF_AXIOM(floatValues[1] == float(value));
+
+    // An empty spline has no values.
+    double deriv = 0;
+    TF_AXIOM(!TsSpline().EvalWithDerivatives(1.0, &value, &deriv));
+}
+
+int
+main()
+{
+    TestMuseum();
+    TestSecondDerivatives();
+    TestErrors();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,201 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/spline.h>
+#include <pxr/ts/knot.h>
+#include <pxr/ts/raii.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/museum.h>
+#include <tsTest/tsEvaluator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+
+// Each spline is evaluated by a kernel that handles only the features the
+// spline has: loops, curve types, value blocks, dual values, and non-held
+// extrapolation.  These tests give splines features that don't change their
+// values, so that they are evaluated by larger kernels, and verify that
+// results are unchanged.
+
+// Returns times that cover a spline's knots, plus some extrapolation on both
+// sides.  Includes the knot times themselves.
+static std::vector<TsTime>
+_GetTestTimes(const TsSpline &spline)
+{
+    const GfInterval span = spline.GetKnots().GetTimeSpan();
+    const double size = std::max(span.GetSize(), 1.0);
+    const double min = span.GetMin() - 0.5 * size;
+    const double max = span.GetMax() + 0.5 * size;
+    const int numSamples = 500;
+
+    std::vector<TsTime> times;
+    for (int i = 0; i <= numSamples; ++i) {
+        times.push_back(min + i * (max - min) / numSamples);
+    }
+    for (const TsKnot &knot : spline.GetKnots()) {
+        times.push_back(knot.GetTime());
+    }
+    return times;
+}
+
+// Exact equality of every evaluation kind, singly and in batches, except that
+// NaNs match each other.
+static void
+_VerifySame(
+    const std::string &context,
+    const TsSpline &expectedSpline,
+    const TsSpline &actualSpline)
+{
+    using _EvalMethod = bool (TsSpline::*)(TsTime, double*) const;
+    static const _EvalMethod methods[] = {
+        &TsSpline::Eval<double>,
+        &TsSpline::EvalPreValue<double>,
+        &TsSpline::EvalDerivative<double>,
+        &TsSpline::EvalPreDerivative<double>,
+        &TsSpline::EvalHeld<double>,
+        &TsSpline::EvalPreValueHeld<double>};
+
+    const std::vector<TsTime> times = _GetTestTimes(expectedSpline);
+
+    for (const TsTime time : times) {
+        for (const _EvalMethod method : methods) {
+            double expected = 0, actual = 0;
+            const bool haveExpected = (expectedSpline.*method)(time, &expected);
+            const bool haveActual = (actualSpline.*method)(time, &actual);
+            if (haveExpected != haveActual
+                || !(expected == actual
+                     || (std::isnan(expected) && std::isnan(actual)))) {
+                std::cerr << "Mismatch for " << context << " at time "
+                          << time << ": expected " << expected
+                          << ", got " << actual << std::endl;
+                TF_FATAL_ERROR("Evaluation kernel mismatch");
+            }
+        }
+    }
+
+    std::vector<double> expected(times.size(), 0), actual(times.size(), 0);
+    TF_AXIOM(expectedSpline.EvalMany(times, TfSpan<double>(expected))
+             == actualSpline.EvalMany(times, TfSpan<double>(actual)));
+    for (size_t i = 0; i < times.size(); ++i) {
+        if (!(expected[i] == actual[i]
+              || (std::isnan(expected[i]) && std::isnan(actual[i])))) {
+            std::cerr << "Batch mismatch for " << context << " at time "
+                      << times[i] << ": expected " << expected[i]
+                      << ", got " << actual[i] << std::endl;
+            TF_FATAL_ERROR("Evaluation kernel mismatch");
+        }
+    }
+}
+
+// Neutral additions.  Each adds a feature to a spline without changing its
+// values.  All require at least three knots and no loops.
+
+// Makes a middle knot dual-valued, with equal values on both sides.
+static void
+_AddDualValue(TsSpline *spline)
+{
+    const TsKnotMap knots = spline->GetKnots();
+    TsKnot knot = *(knots.begin() + 1);
+    double value = 0;
+    knot.GetValue(&value);
+    knot.SetPreValue(value);
+    spline->SetKnot(knot);
+}
+
+// Sets the interpolation after the last knot, which doesn't affect anything.
+static void
+_SetLastInterp(
+    TsSpline *spline,
+    const TsInterpMode interp)
+{
+    const TsKnotMap knots = spline->GetKnots();
+    TsKnot knot = *(knots.end() - 1);
+    knot.SetNextInterpolation(interp);
+    spline->SetKnot(knot);
+}
+
+// Replaces held extrapolation with sloped extrapolation with zero slope.
+static void
+_AddSlopedExtrap(TsSpline *spline)
+{
+    for (const bool pre : {true, false}) {
+        const TsExtrapolation extrap = (pre ?
+            spline->GetPreExtrapolation() : spline->GetPostExtrapolation());
+        if (extrap.mode != TsExtrapHeld) {
+            continue;
+        }
+
+        TsExtrapolation sloped(TsExtrapSloped);
+        sloped.slope = 0;
+        if (pre) {
+            spline->SetPreExtrapolation(sloped);
+        } else {
+            spline->SetPostExtrapolation(sloped);
+        }
+    }
+}
+
+static void
+TestNeutralFeatures()
+{
+    // The additions must not adjust tangents.
+    const TsAntiRegressionAuthoringSelector selector(TsAntiRegressionNone);
+    const TsTest_TsEvaluator evaluator;
+
+    int numTested = 0;
+    for (const std::string &name : TsTest_Museum::GetAllNames()) {
+        const TsSpline original = evaluator.SplineDataToSpline(
+            TsTest_Museum::GetDataByName(name));
+        if (original.GetKnots().size() < 3
+            || original.HasLoops()) {
+            continue;
+        }
+
+        TsSpline dual = original;
+        _AddDualValue(&dual);
+        _VerifySame(name + " dual values", original, dual);
+
+        TsSpline blocks = original;
+        _SetLastInterp(&blocks, TsInterpValueBlock);
+        _VerifySame(name + " value blocks", original, blocks);
+
+        // Adds a curve type to splines that have only held and linear
+        // segments.
+        TsSpline curves = original;
+        _SetLastInterp(&curves, TsInterpCurve);
+        _VerifySame(name + " curves", original, curves);
+
+        TsSpline sloped = original;
+        _AddSlopedExtrap(&sloped);
+        _VerifySame(name + " sloped extrapolation", original, sloped);
+
+        TsSpline all = original;
+        _AddDualValue(&all);
+        _SetLastInterp(&all, TsInterpCurve);
+        _AddSlopedExtrap(&all);
+        _VerifySame(name + " all features", original, all);
+
+        ++numTested;
+    }
+
+    TF_AXIOM(numTested > 0);
+}
+
+int
+main()
+{
+    TestNeutralFeatures();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
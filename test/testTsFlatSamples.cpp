@@ -0,0 +1,140 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/spline.h>
+#include <pxr/ts/knot.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/testHelpers.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+
+// Verify that flat samples hold exactly the polylines, and sources if
+// requested, that the nested samples classes do.
+template <typename Vertex>
+static void
+_Compare(
+    const std::string &desc,
+    const TsSpline &spline,
+    const GfInterval &interval,
+    const double timeScale,
+    const double valueScale,
+    const double tolerance)
+{
+    TsSplineSamples<Vertex> nested;
+    TF_AXIOM(spline.Sample(
+        interval, timeScale, valueScale, tolerance, &nested));
+    TsSplineSamplesWithSources<Vertex> nestedWithSources;
+    TF_AXIOM(spline.Sample(
+        interval, timeScale, valueScale, tolerance, &nestedWithSources));
+
+    for (const bool withSources : {false, true}) {
+        const std::vector<std::vector<Vertex>> &expected = (withSources ?
+            nestedWithSources.polylines : nested.polylines);
+
+        TsSplineFlatSamples<Vertex> flat;
+        flat.withSources = withSources;
+        TF_AXIOM(spline.Sample(
+            interval, timeScale, valueScale, tolerance, &flat));
+
+        bool match = (flat.GetNumPolylines() == expected.size());
+        for (size_t i = 0; match && i < expected.size(); ++i) {
+            match = (flat.GetPolylineSize(i) == expected[i].size() &&
+                     std::equal(expected[i].begin(), expected[i].end(),
+                                flat.GetPolylineData(i)));
+        }
+        match &= (flat.offsets.empty() ?
+                  flat.vertices.empty() :
+                  flat.offsets.front() == 0 &&
+                  flat.offsets.back() == flat.vertices.size());
+        match &= (withSources ?
+                  flat.sources == nestedWithSources.sources :
+                  flat.sources.empty());
+
+        if (!match) {
+            std::cerr << "Flat samples mismatch in " << desc << " over "
+                      << interval << (withSources ? " with sources" : "")
+                      << ": expected " << expected.size()
+                      << " polylines, got " << flat.GetNumPolylines()
+                      << std::endl;
+            TF_FATAL_ERROR("Flat samples mismatch");
+        }
+    }
+}
+
+static void
+TestMuseum()
+{
+    for (const auto &[name, spline] : TsTest_GetMuseumSplines()) {
+        const GfInterval span = TsTest_GetKnotSpan(spline);
+        const double size = std::max(span.GetSize(), 1.0);
+        const GfInterval longSpan = TsTest_GetTestInterval(spline, 1.5);
+        const double timeScale = 500 / size;
+
+        _Compare<GfVec2d>(name, spline, span, timeScale, 50, 1.0);
+        _Compare<GfVec2d>(name, spline, longSpan, timeScale, 50, 0.25);
+        _Compare<GfVec2f>(name, spline, longSpan, timeScale, 50, 1.0);
+    }
+}
+
+static void
+TestCases()
+{
+    TsSpline spline;
+    spline.SetKnot(TsTest_MakeKnot(0, 0, TsInterpLinear));
+    spline.SetKnot(TsTest_MakeKnot(10, 10, TsInterpHeld));
+    spline.SetKnot(TsTest_MakeKnot(20, 4, TsInterpLinear));
+    spline.SetKnot(TsTest_MakeKnot(30, 7, TsInterpHeld));
+
+    // Broken only at the held jump without sources; also at the
+    // extrapolation boundaries with them.
+    TsSplineFlatSamples<GfVec2d> flat;
+    TF_AXIOM(spline.Sample(GfInterval(-10, 40), 1.0, 1.0, 0.1, &flat));
+    TF_AXIOM(flat.GetNumPolylines() == 2);
+    TF_AXIOM((flat.offsets == std::vector<size_t>{0, 4, 7}));
+    TF_AXIOM(flat.vertices[3] == GfVec2d(20, 10));
+    TF_AXIOM(flat.vertices[4] == GfVec2d(20, 4));
+
+    flat.withSources = true;
+    TF_AXIOM(spline.Sample(GfInterval(-10, 40), 1.0, 1.0, 0.1, &flat));
+    TF_AXIOM(flat.GetNumPolylines() == 4);
+    TF_AXIOM((flat.sources == std::vector<TsSplineSampleSource>{
+                TsSourcePreExtrap, TsSourceKnotInterp,
+                TsSourceKnotInterp, TsSourcePostExtrap}));
+
+    // The vertex array is reserved before sampling, and reused capacity
+    // means no reallocation.
+    TF_AXIOM(flat.vertices.capacity() >= flat.vertices.size());
+    const GfVec2d* const data = flat.vertices.data();
+    TF_AXIOM(spline.Sample(GfInterval(-10, 40), 1.0, 1.0, 0.1, &flat));
+    TF_AXIOM(flat.vertices.data() == data);
+
+    // Invalid arguments leave the samples alone.
+    TF_AXIOM(!spline.Sample(GfInterval(), 1.0, 1.0, 0.1, &flat));
+    TF_AXIOM(flat.GetNumPolylines() == 4);
+
+    // No knots, no polylines.
+    TF_AXIOM(TsSpline().Sample(GfInterval(0, 10), 1.0, 1.0, 0.1, &flat));
+    TF_AXIOM(flat.GetNumPolylines() == 0);
+    TF_AXIOM(flat.vertices.empty() && flat.offsets.empty());
+    TF_AXIOM(flat.sources.empty());
+}
+
+int
+main()
+{
+    TestMuseum();
+    TestCases();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
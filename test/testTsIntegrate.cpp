@@ -0,0 +1,282 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/spline.h>
+#include <pxr/ts/knot.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/testHelpers.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+
+// Integrates by the midpoint rule, and finds the time covered by values and
+// the largest magnitude of value.
+static void
+_SampleIntegral(
+    const TsSpline &spline,
+    const GfInterval &interval,
+    double *integralOut,
+    double *coveredOut,
+    double *maxAbsOut)
+{
+    const int numSamples = 100000;
+    const double step = interval.GetSize() / numSamples;
+    *integralOut = *coveredOut = *maxAbsOut = 0;
+    for (int i = 0; i < numSamples; ++i) {
+        double value = 0;
+        if (spline.Eval(interval.GetMin() + (i + 0.5) * step, &value)) {
+            *integralOut += value * step;
+            *coveredOut += step;
+            *maxAbsOut = std::max(*maxAbsOut, std::abs(value));
+        }
+    }
+}
+
+static void
+_Verify(
+    const std::string &context,
+    const TsSpline &spline,
+    const GfInterval &interval)
+{
+    double expected = 0, covered = 0, maxAbs = 0;
+    _SampleIntegral(spline, interval, &expected, &covered, &maxAbs);
+
+    double integral = 0;
+    TF_AXIOM(spline.Integrate(interval, &integral));
+
+    // The midpoint rule is off by about a sample width times the size of any
+    // discontinuity.
+    const double tolerance =
+        1e-4 * interval.GetSize() * std::max(1.0, maxAbs);
+    if (!(std::abs(integral - expected) <= tolerance)) {
+        std::cerr << "Integral mismatch for " << context << " over "
+                  << interval << ": expected about " << expected
+                  << ", got " << integral << std::endl;
+        TF_FATAL_ERROR("Integral mismatch");
+    }
+
+    double average = 0;
+    const bool haveAverage = spline.Average(interval, &average);
+    if (covered < 1e-3 * interval.GetSize()) {
+        return;
+    }
+    TF_AXIOM(haveAverage);
+    if (!(std::abs(average - expected / covered)
+              <= 1e-3 * std::max(1.0, maxAbs))) {
+        std::cerr << "Average mismatch for " << context << " over "
+                  << interval << ": expected about " << expected / covered
+                  << ", got " << average << std::endl;
+        TF_FATAL_ERROR("Average mismatch");
+    }
+}
+
+static void
+TestMuseum()
+{
+    std::mt19937 rng(11);
+
+    for (const auto &[name, spline] : TsTest_GetMuseumSplines()) {
+        const GfInterval interval = TsTest_GetTestInterval(spline, 2.5);
+        _Verify(name, spline, interval);
+
+        // Random sub-intervals, some starting or ending at knots.
+        std::vector<TsTime> ends;
+        for (const TsKnot &knot : spline.GetKnots()) {
+            ends.push_back(knot.GetTime());
+        }
+        std::uniform_real_distribution<double> dist(
+            interval.GetMin(), interval.GetMax());
+        for (int i = 0; i < 10; ++i) {
+            ends.push_back(dist(rng));
+        }
+        std::uniform_int_distribution<size_t> pick(0, ends.size() - 1);
+        for (int i = 0; i < 10; ++i) {
+            const TsTime a = ends[pick(rng)];
+            const TsTime b = ends[pick(rng)];
+            if (a != b) {
+                _Verify(name, spline,
+                        GfInterval(std::min(a, b), std::max(a, b)));
+            }
+        }
+
+        // Batch integration agrees with single intervals.
+        std::vector<TsTime> boundaries(ends.begin(), ends.end());
+        std::sort(boundaries.begin(), boundaries.end());
+        std::vector<double> integrals(boundaries.size() - 1);
+        TF_AXIOM(spline.IntegrateMany(boundaries, integrals));
+        for (size_t i = 0; i < integrals.size(); ++i) {
+            double integral = 0;
+            TF_AXIOM(spline.Integrate(
+                GfInterval(boundaries[i], boundaries[i + 1]), &integral));
+            TF_AXIOM(std::abs(integral - integrals[i])
+                     <= 1e-9 * std::max(1.0, std::abs(integral)));
+        }
+    }
+}
+
+static double
+_GetIntegral(
+    const TsSpline &spline,
+    const GfInterval &interval)
+{
+    double integral = 0;
+    TF_AXIOM(spline.Integrate(interval, &integral));
+    return integral;
+}
+
+static bool
+_IsClose(const double a, const double b)
+{
+    return std::abs(a - b) <= 1e-9 * std::max(1.0, std::abs(b));
+}
+
+static void
+TestCases()
+{
+    double result = 0;
+
+    // No knots.
+    TsSpline spline;
+    TF_AXIOM(!spline.Integrate(GfInterval(0, 10), &result));
+    TF_AXIOM(!spline.Average(GfInterval(0, 10), &result));
+
+    // Linear and held segments, and held extrapolation.
+    spline.SetKnot(TsTest_MakeKnot(0, 0, TsInterpLinear));
+    spline.SetKnot(TsTest_MakeKnot(10, 10, TsInterpHeld));
+    spline.SetKnot(TsTest_MakeKnot(20, 4, TsInterpHeld));
+    TF_AXIOM(_IsClose(_GetIntegral(spline, GfInterval(0, 10)), 50));
+    TF_AXIOM(_IsClose(_GetIntegral(spline, GfInterval(5, 15)), 87.5));
+    TF_AXIOM(_IsClose(_GetIntegral(spline, GfInterval(-5, 30)), 190));
+    TF_AXIOM(!spline.Integrate(GfInterval(), &result));
+
+    // Single times average to their values.
+    TF_AXIOM(spline.Average(GfInterval(5), &result) && result == 5);
+    TF_AXIOM(spline.Average(GfInterval(0, 20), &result)
+             && _IsClose(result, 7.5));
+
+    // Linear extrapolation.
+    spline.SetPostExtrapolation(TsExtrapolation(TsExtrapLinear));
+    spline.SetPreExtrapolation(TsExtrapolation(TsExtrapLinear));
+    TF_AXIOM(_IsClose(_GetIntegral(spline, GfInterval(-10, 0)), -50));
+    TF_AXIOM(_IsClose(_GetIntegral(spline, GfInterval(20, 30)), 40));
+
+    // Blocked extrapolation contributes neither value nor time.
+    spline.SetPreExtrapolation(TsExtrapolation(TsExtrapValueBlock));
+    TF_AXIOM(_IsClose(_GetIntegral(spline, GfInterval(-10, 10)), 50));
+    TF_AXIOM(spline.Average(GfInterval(-10, 10), &result)
+             && _IsClose(result, 5));
+    TF_AXIOM(!spline.Average(GfInterval(-10, -5), &result));
+
+    // A Bezier curve, against Simpson's rule on its parametric form.  The
+    // tangents are wide enough that time is far from linear in the parameter.
+    TsSpline curve;
+    TsKnot knot = TsTest_MakeKnot(0, 0, TsInterpCurve);
+    knot.SetPostTanWidth(4.0);
+    knot.SetPostTanSlope(3.0);
+    curve.SetKnot(knot);
+    knot = TsTest_MakeKnot(6, 2, TsInterpCurve);
+    knot.SetPreTanWidth(0.5);
+    knot.SetPreTanSlope(-8.0);
+    curve.SetKnot(knot);
+    {
+        const double xs[4] = {0, 4, 5.5, 6};
+        const double ys[4] = {0, 12, 6, 2};
+        const auto bezier = [](const double *p, const double u)
+        {
+            const double v = 1 - u;
+            return v*v*v*p[0] + 3*v*v*u*p[1] + 3*v*u*u*p[2] + u*u*u*p[3];
+        };
+        const auto bezierDeriv = [](const double *p, const double u)
+        {
+            const double v = 1 - u;
+            return 3*v*v*(p[1] - p[0]) + 6*v*u*(p[2] - p[1])
+                + 3*u*u*(p[3] - p[2]);
+        };
+        const int n = 2000;
+        double expected = 0;
+        for (int i = 0; i <= n; ++i) {
+            const double u = double(i) / n;
+            const double weight = (i == 0 || i == n) ? 1 : (i % 2 ? 4 : 2);
+            expected += weight * bezier(ys, u) * bezierDeriv(xs, u);
+        }
+        expected /= 3 * n;
+        TF_AXIOM(_IsClose(_GetIntegral(curve, GfInterval(0, 6)), expected));
+
+        // Split at an interior time, the parts add up.
+        const double a = _GetIntegral(curve, GfInterval(0, 2.7));
+        const double b = _GetIntegral(curve, GfInterval(2.7, 6));
+        TF_AXIOM(_IsClose(a + b, expected));
+    }
+
+    // Edits are reflected in subsequent queries.
+    curve.SetKnot(TsTest_MakeKnot(6, 10, TsInterpHeld));
+    TF_AXIOM(_IsClose(_GetIntegral(curve, GfInterval(6, 8)), 20));
+}
+
+static void
+TestLoops()
+{
+    TsSpline spline;
+    spline.SetKnot(TsTest_MakeKnot(0, 0, TsInterpLinear));
+    spline.SetKnot(TsTest_MakeKnot(10, 5, TsInterpLinear));
+
+    // Repeat offsets each iteration.
+    spline.SetPreExtrapolation(TsExtrapolation(TsExtrapLoopRepeat));
+    spline.SetPostExtrapolation(TsExtrapolation(TsExtrapLoopRepeat));
+    TF_AXIOM(_IsClose(_GetIntegral(spline, GfInterval(0, 30)), 225));
+    TF_AXIOM(_IsClose(_GetIntegral(spline, GfInterval(-10, 0)), -25));
+    TF_AXIOM(_IsClose(_GetIntegral(spline, GfInterval(-25, -15)), -100));
+
+    // Far from the knots, in closed form.
+    TF_AXIOM(_IsClose(
+        _GetIntegral(spline, GfInterval(1e6, 1e6 + 10)), 5e6 + 25));
+    TF_AXIOM(_IsClose(
+        _GetIntegral(spline, GfInterval(-1e6 - 5, -1e6 + 5)), -5e6));
+
+    // Oscillate reflects odd iterations.
+    spline.SetPreExtrapolation(TsExtrapolation(TsExtrapLoopOscillate));
+    spline.SetPostExtrapolation(TsExtrapolation(TsExtrapLoopOscillate));
+    TF_AXIOM(_IsClose(_GetIntegral(spline, GfInterval(10, 15)), 18.75));
+    TF_AXIOM(_IsClose(_GetIntegral(spline, GfInterval(-5, 0)), 6.25));
+    TF_AXIOM(_IsClose(_GetIntegral(spline, GfInterval(-1005, 1005)), 5012.5));
+
+    // Reset restarts each iteration.
+    spline.SetPreExtrapolation(TsExtrapolation(TsExtrapLoopReset));
+    spline.SetPostExtrapolation(TsExtrapolation(TsExtrapLoopReset));
+    TF_AXIOM(_IsClose(_GetIntegral(spline, GfInterval(5, 15)), 25));
+
+    // Inner loops, with a value offset.
+    TsSpline inner;
+    inner.SetKnot(TsTest_MakeKnot(0, 0, TsInterpLinear));
+    inner.SetKnot(TsTest_MakeKnot(5, 8, TsInterpLinear));
+    TsLoopParams params;
+    params.protoStart = 0;
+    params.protoEnd = 10;
+    params.numPostLoops = 2;
+    params.valueOffset = 10;
+    inner.SetInnerLoopParams(params);
+    _Verify("inner loops", inner, GfInterval(-5, 40));
+    TF_AXIOM(_IsClose(_GetIntegral(inner, GfInterval(10, 15)), 70));
+}
+
+int
+main()
+{
+    TestMuseum();
+    TestCases();
+    TestLoops();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,356 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/spline.h>
+#include <pxr/ts/knot.h>
+#include <pxr/ts/raii.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/testHelpers.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+// Forward evaluation to check against.  Inverse evaluation solves curves
+// iteratively, and Cardano's formula is less precise near vertical tangents.
+static TsEvalOptions
+_GetNewtonOptions()
+{
+    TsEvalOptions options;
+    options.bezierSolver = TsBezierSolverNewton;
+    return options;
+}
+
+static const TsEvalOptions _newton = _GetNewtonOptions();
+
+// Samples a spline densely over an interval.
+static void
+_SampleDensely(
+    const TsSpline &spline,
+    const GfInterval &interval,
+    std::vector<TsTime> *timesOut,
+    std::vector<double> *valuesOut)
+{
+    const int numSamples = 4000;
+    for (int i = 0; i <= numSamples; ++i) {
+        const TsTime time =
+            interval.GetMin() + i * interval.GetSize() / numSamples;
+        double value = 0;
+        if (spline.Eval(time, &value, _newton)) {
+            timesOut->push_back(time);
+            valuesOut->push_back(value);
+        }
+    }
+}
+
+// Every returned time must be in the interval, in ascending order, and must
+// evaluate to the value.  Every crossing of the value that dense sampling
+// finds must be among the returned times.
+static void
+_Verify(
+    const std::string &context,
+    const TsSpline &spline,
+    const GfInterval &interval,
+    const double value,
+    const std::vector<TsTime> &times,
+    const std::vector<TsTime> &sampleTimes,
+    const std::vector<double> &sampleValues,
+    const double valueTolerance)
+{
+    const double timeTolerance = 1e-6 * interval.GetSize();
+
+    for (size_t i = 0; i < times.size(); ++i) {
+        double actual = 0;
+        if (!interval.Contains(times[i])
+            || (i > 0 && times[i] <= times[i - 1])
+            || !spline.Eval(times[i], &actual, _newton)
+            || !(std::abs(actual - value) <= valueTolerance)) {
+            std::cerr << "Bad time for " << context << ", value " << value
+                      << ": " << times[i] << " evaluates to " << actual
+                      << std::endl;
+            TF_FATAL_ERROR("Inverse evaluation is unsound");
+        }
+    }
+
+    for (size_t i = 0; i + 1 < sampleTimes.size(); ++i) {
+        if (!((sampleValues[i] - value) * (sampleValues[i + 1] - value) < 0)) {
+            continue;
+        }
+
+        // Bisect to the crossing.  Crossings by jumps aren't found by inverse
+        // evaluation, and are ignored.
+        TsTime lo = sampleTimes[i], hi = sampleTimes[i + 1];
+        const bool rising = (sampleValues[i] < value);
+        for (int j = 0; j < 100; ++j) {
+            const TsTime mid = 0.5 * (lo + hi);
+            double midValue = 0;
+            spline.Eval(mid, &midValue, _newton);
+            if ((midValue < value) == rising) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        double loValue = 0, hiValue = 0;
+        spline.Eval(lo, &loValue, _newton);
+        spline.Eval(hi, &hiValue, _newton);
+        if (std::abs(hiValue - loValue) > valueTolerance) {
+            continue;
+        }
+
+        const bool found = std::any_of(
+            times.begin(), times.end(),
+            [lo, timeTolerance](const TsTime time)
+            { return std::abs(time - lo) <= timeTolerance; });
+        if (!found) {
+            std::cerr << "Missed time for " << context << ", value " << value
+                      << ": " << lo << std::endl;
+            TF_FATAL_ERROR("Inverse evaluation is incomplete");
+        }
+    }
+}
+
+static void
+TestMuseum()
+{
+    TsEvalOptions halley;
+    halley.bezierSolver = TsBezierSolverHalley;
+
+    for (const auto &[name, spline] : TsTest_GetMuseumSplines()) {
+        const GfInterval interval = TsTest_GetTestInterval(spline, 1.5);
+        std::vector<TsTime> sampleTimes;
+        std::vector<double> sampleValues;
+        _SampleDensely(spline, interval, &sampleTimes, &sampleValues);
+        if (sampleValues.empty()) {
+            continue;
+        }
+
+        const double min =
+            *std::min_element(sampleValues.begin(), sampleValues.end());
+        const double max =
+            *std::max_element(sampleValues.begin(), sampleValues.end());
+        const double valueTolerance = 1e-7 * std::max(1.0, max - min);
+
+        // Values throughout the range, plus the sampled values at the knots,
+        // which may be extrema or the values of flat spans.
+        std::vector<double> values;
+        for (int i = 0; i <= 20; ++i) {
+            values.push_back(min + (max - min) * (i + 0.37) / 21);
+        }
+        for (const TsKnot &knot : spline.GetKnots()) {
+            double value = 0;
+            if (spline.Eval(knot.GetTime(), &value, _newton)) {
+                values.push_back(value);
+            }
+        }
+
+        std::vector<std::vector<TsTime>> batch;
+        TF_AXIOM(spline.FindTimesForValues(values, interval, &batch));
+        TF_AXIOM(batch.size() == values.size());
+
+        for (size_t i = 0; i < values.size(); ++i) {
+            _Verify(name, spline, interval, values[i], batch[i],
+                    sampleTimes, sampleValues, valueTolerance);
+
+            // The batch form matches the single form, for any solver.
+            for (const TsEvalOptions &options :
+                     {TsEvalOptions(), _newton, halley}) {
+                std::vector<TsTime> times;
+                TF_AXIOM(spline.FindTimesForValue(
+                    values[i], interval, &times, options));
+                TF_AXIOM(times.size() == batch[i].size());
+                for (size_t j = 0; j < times.size(); ++j) {
+                    TF_AXIOM(std::abs(times[j] - batch[i][j]) <= 1e-9);
+                }
+            }
+        }
+    }
+}
+
+static std::vector<TsTime>
+_Find(
+    const TsSpline &spline,
+    const double value,
+    const GfInterval &interval)
+{
+    std::vector<TsTime> times;
+    TF_AXIOM(spline.FindTimesForValue(value, interval, &times));
+    return times;
+}
+
+static bool
+_IsClose(
+    const std::vector<TsTime> &actual,
+    const std::vector<TsTime> &expected)
+{
+    if (actual.size() != expected.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < actual.size(); ++i) {
+        if (!(std::abs(actual[i] - expected[i]) <= 1e-9)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void
+TestRetiming()
+{
+    // A time-valued spline that speeds up and slows down, but never reverses.
+    TsSpline spline;
+    spline.SetKnot(TsTest_MakeKnot(0, 0, TsInterpCurve));
+    spline.SetKnot(TsTest_MakeKnot(10, 20, TsInterpCurve));
+    spline.SetKnot(TsTest_MakeKnot(20, 24, TsInterpCurve));
+    spline.SetKnot(TsTest_MakeKnot(30, 40, TsInterpCurve));
+
+    const GfInterval interval(0, 30);
+    for (double value = 0; value < 40; value += 0.25) {
+        const std::vector<TsTime> times = _Find(spline, value, interval);
+        TF_AXIOM(times.size() == 1);
+
+        double actual = 0;
+        TF_AXIOM(spline.Eval(times[0], &actual, _newton));
+        TF_AXIOM(std::abs(actual - value) <= 1e-9);
+    }
+
+    // The end value is reached at the end of the interval.
+    TF_AXIOM(_IsClose(_Find(spline, 40, interval), {30}));
+
+    // Outside the range of values.
+    TF_AXIOM(_Find(spline, -1, interval).empty());
+    TF_AXIOM(_Find(spline, 41, interval).empty());
+}
+
+static void
+TestHeldAndDual()
+{
+    // Held segments hold values over spans, which are reported by their
+    // starts.  Held extrapolation does too.
+    TsSpline held;
+    held.SetKnot(TsTest_MakeKnot(0, 1, TsInterpHeld));
+    held.SetKnot(TsTest_MakeKnot(5, 2, TsInterpHeld));
+    held.SetKnot(TsTest_MakeKnot(10, 1, TsInterpHeld));
+    TF_AXIOM(_IsClose(_Find(held, 1, GfInterval(-10, 20)), {-10, 10}));
+    TF_AXIOM(_IsClose(_Find(held, 1, GfInterval(2, 20)), {2, 10}));
+    TF_AXIOM(_IsClose(_Find(held, 2, GfInterval(-10, 20)), {5}));
+    TF_AXIOM(_Find(held, 1.5, GfInterval(-10, 20)).empty());
+
+    // Without a bound, the span before the first knot has no start, and is
+    // reported by the first knot.
+    TF_AXIOM(_IsClose(_Find(held, 1, GfInterval::GetFullInterval()), {0, 10}));
+
+    // A dual-valued knot.  Its pre-value is only approached, never evaluated.
+    TsSpline dual;
+    dual.SetKnot(TsTest_MakeKnot(0, 0, TsInterpLinear));
+    TsKnot knot = TsTest_MakeKnot(5, 1, TsInterpLinear);
+    knot.SetPreValue(3.0);
+    dual.SetKnot(knot);
+    dual.SetKnot(TsTest_MakeKnot(10, 2, TsInterpLinear));
+
+    const GfInterval interval(0, 10);
+    TF_AXIOM(_IsClose(_Find(dual, 1, interval), {5.0 / 3, 5}));
+    TF_AXIOM(_IsClose(_Find(dual, 2, interval), {10.0 / 3, 10}));
+    TF_AXIOM(_Find(dual, 3, interval).empty());
+}
+
+static void
+TestLoops()
+{
+    TsSpline spline;
+    spline.SetKnot(TsTest_MakeKnot(0, 0, TsInterpLinear));
+    spline.SetKnot(TsTest_MakeKnot(10, 5, TsInterpLinear));
+
+    const GfInterval interval(0, 40);
+
+    // Repeat offsets each iteration by the change in value.
+    spline.SetPreExtrapolation(TsExtrapolation(TsExtrapLoopRepeat));
+    spline.SetPostExtrapolation(TsExtrapolation(TsExtrapLoopRepeat));
+    TF_AXIOM(_IsClose(_Find(spline, 12, interval), {24}));
+    TF_AXIOM(_IsClose(_Find(spline, 5, interval), {10}));
+    TF_AXIOM(_IsClose(_Find(spline, -7, GfInterval(-40, 0)), {-14}));
+
+    // Only the iterations whose offset values include the value are searched,
+    // so distant bounds are cheap.
+    TF_AXIOM(_IsClose(_Find(spline, -7, GfInterval(-1e12, 0)), {-14}));
+    TF_AXIOM(_IsClose(_Find(spline, 12, GfInterval(0, 1e12)), {24}));
+    TF_AXIOM(_IsClose(_Find(spline, -1e10, GfInterval(-1e12, 0)), {-2e10}));
+    TF_AXIOM(_Find(spline, 1e12, GfInterval(-1e12, 1e12)).empty());
+
+    // Oscillate reflects every other iteration.  The iteration that starts at
+    // a reflection boundary begins with the value at the end of the knots.
+    spline.SetPreExtrapolation(TsExtrapolation(TsExtrapLoopOscillate));
+    spline.SetPostExtrapolation(TsExtrapolation(TsExtrapLoopOscillate));
+    TF_AXIOM(_IsClose(_Find(spline, 2.5, interval), {5, 15, 25, 35}));
+    TF_AXIOM(_IsClose(_Find(spline, 5, interval), {10, 30}));
+    TF_AXIOM(_IsClose(_Find(spline, 2.5, GfInterval(-20, 0)), {-15, -5}));
+
+    // Without offsets, every iteration can reach the value.  Values that no
+    // iteration reaches are found cheaply, but searching too many iterations
+    // fails.
+    TF_AXIOM(_Find(spline, 6, GfInterval(-1e12, 1e12)).empty());
+    std::vector<TsTime> farTimes;
+    TF_AXIOM(!spline.FindTimesForValue(
+        2.5, GfInterval(-1e12, 0), &farTimes));
+    TF_AXIOM(_IsClose(
+        _Find(spline, 2.5, GfInterval(1e9, 1e9 + 20)), {1e9 + 5, 1e9 + 15}));
+
+    // Reset jumps back to the start, so the end value is never evaluated after
+    // the knots.
+    spline.SetPreExtrapolation(TsExtrapolation(TsExtrapLoopReset));
+    spline.SetPostExtrapolation(TsExtrapolation(TsExtrapLoopReset));
+    TF_AXIOM(_IsClose(_Find(spline, 2.5, interval), {5, 15, 25, 35}));
+    TF_AXIOM(_Find(spline, 5, GfInterval(0, 30)).empty());
+
+    // Loops reach values infinitely many times, so intervals must be bounded
+    // on looping sides.
+    std::vector<TsTime> times;
+    TF_AXIOM(!spline.FindTimesForValue(
+        1, GfInterval(0, std::numeric_limits<double>::infinity()), &times));
+    TF_AXIOM(!spline.FindTimesForValue(
+        1, GfInterval(-std::numeric_limits<double>::infinity(), 0), &times));
+    TF_AXIOM(!spline.FindTimesForValue(1, GfInterval(), &times));
+
+    // Only the looping side needs a bound.
+    spline.SetPreExtrapolation(TsExtrapolation(TsExtrapHeld));
+    TF_AXIOM(_IsClose(
+        _Find(spline, 0, GfInterval(-std::numeric_limits<double>::infinity(),
+                                    15)),
+        {0, 10}));
+
+    // Inner loops, with a value offset.  Each iteration rises to 8 above its
+    // start, then to 10 above.
+    TsSpline inner;
+    inner.SetKnot(TsTest_MakeKnot(0, 0, TsInterpLinear));
+    inner.SetKnot(TsTest_MakeKnot(5, 8, TsInterpLinear));
+    TsLoopParams params;
+    params.protoStart = 0;
+    params.protoEnd = 10;
+    params.numPostLoops = 2;
+    params.valueOffset = 10;
+    inner.SetInnerLoopParams(params);
+    TF_AXIOM(_IsClose(_Find(inner, 9, interval), {7.5}));
+    TF_AXIOM(_IsClose(_Find(inner, 12, interval), {11.25}));
+    TF_AXIOM(_IsClose(_Find(inner, 20, interval), {20}));
+    TF_AXIOM(_IsClose(_Find(inner, 30, interval), {30}));
+}
+
+int
+main()
+{
+    TestMuseum();
+    TestRetiming();
+    TestHeldAndDual();
+    TestLoops();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
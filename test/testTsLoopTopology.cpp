@@ -0,0 +1,184 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/spline.h>
+#include <pxr/ts/knot.h>
+#include <pxr/ts/raii.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/museum.h>
+#include <tsTest/tsEvaluator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+
+// Loop and extrapolation topology is computed on first evaluation and cached
+// on the spline data.  These tests verify that edits discard it, so that
+// evaluation always reflects the current spline.
+
+// Returns times that cover a spline's knots and inner loops, plus some
+// extrapolation on both sides.  Includes the knot times themselves.
+static std::vector<TsTime>
+_GetTestTimes(const TsSpline &spline)
+{
+    GfInterval span = spline.GetKnots().GetTimeSpan();
+    if (spline.HasInnerLoops()) {
+        span |= spline.GetInnerLoopParams().GetLoopedInterval();
+    }
+
+    const double size = std::max(span.GetSize(), 1.0);
+    const double min = span.GetMin() - 2.5 * size;
+    const double max = span.GetMax() + 2.5 * size;
+    const int numSamples = 500;
+
+    std::vector<TsTime> times;
+    for (int i = 0; i <= numSamples; ++i) {
+        times.push_back(min + i * (max - min) / numSamples);
+    }
+    for (const TsKnot &knot : spline.GetKnots()) {
+        times.push_back(knot.GetTime());
+    }
+    return times;
+}
+
+// Returns a spline with the same contents, but with data that has never been
+// evaluated.
+static TsSpline
+_Rebuild(const TsSpline &spline)
+{
+    TsSpline result(spline.GetValueType());
+    result.SetCurveType(spline.GetCurveType());
+    result.SetPreExtrapolation(spline.GetPreExtrapolation());
+    result.SetPostExtrapolation(spline.GetPostExtrapolation());
+    result.SetInnerLoopParams(spline.GetInnerLoopParams());
+    for (const TsKnot &knot : spline.GetKnots()) {
+        result.SetKnot(knot);
+    }
+    return result;
+}
+
+// Exact equality of every evaluation kind, except that NaNs match each other.
+static void
+_VerifySame(
+    const std::string &context,
+    const TsSpline &expectedSpline,
+    const TsSpline &actualSpline)
+{
+    using _EvalMethod = bool (TsSpline::*)(TsTime, double*) const;
+    static const _EvalMethod methods[] = {
+        &TsSpline::Eval<double>,
+        &TsSpline::EvalPreValue<double>,
+        &TsSpline::EvalDerivative<double>,
+        &TsSpline::EvalPreDerivative<double>,
+        &TsSpline::EvalHeld<double>,
+        &TsSpline::EvalPreValueHeld<double>};
+
+    for (const TsTime time : _GetTestTimes(expectedSpline)) {
+        for (const _EvalMethod method : methods) {
+            double expected = 0, actual = 0;
+            const bool haveExpected = (expectedSpline.*method)(time, &expected);
+            const bool haveActual = (actualSpline.*method)(time, &actual);
+            if (haveExpected != haveActual
+                || !(expected == actual
+                     || (std::isnan(expected) && std::isnan(actual)))) {
+                std::cerr << "Mismatch after " << context << " at time "
+                          << time << ": expected " << expected
+                          << ", got " << actual << std::endl;
+                TF_FATAL_ERROR("Stale loop topology");
+            }
+        }
+    }
+}
+
+// Evaluates a spline everywhere, so that it has cached topology.
+static void
+_Warm(const TsSpline &spline)
+{
+    double value = 0;
+    for (const TsTime time : _GetTestTimes(spline)) {
+        spline.Eval(time, &value);
+    }
+}
+
+static void
+TestEdits()
+{
+    // Rebuilt splines must match exactly, so don't adjust tangents.
+    const TsAntiRegressionAuthoringSelector selector(TsAntiRegressionNone);
+    const TsTest_TsEvaluator evaluator;
+
+    for (const std::string &name : TsTest_Museum::GetAllNames()) {
+        const TsSpline original = evaluator.SplineDataToSpline(
+            TsTest_Museum::GetDataByName(name));
+        if (original.GetKnots().size() < 2) {
+            continue;
+        }
+
+        // Each edit is applied to unshared data, and to a copy that shares its
+        // data with an evaluated spline.
+        for (const bool shared : {false, true}) {
+            TsSpline spline = _Rebuild(original);
+            TsSpline sharer;
+            if (shared) {
+                sharer = spline;
+            }
+            _Warm(spline);
+
+            // Extrapolating loops.
+            spline.SetPreExtrapolation(
+                TsExtrapolation(TsExtrapLoopRepeat));
+            spline.SetPostExtrapolation(
+                TsExtrapolation(TsExtrapLoopOscillate));
+            _VerifySame(name + " extrapolation", _Rebuild(spline), spline);
+            if (shared) {
+                _VerifySame(name + " shared", _Rebuild(original), sharer);
+            }
+
+            // Inner loops, over the first two knots, with a value offset.
+            const TsKnotMap knots = spline.GetKnots();
+            TsLoopParams params;
+            params.protoStart = knots.begin()->GetTime();
+            params.protoEnd = (knots.begin() + 1)->GetTime();
+            params.numPreLoops = 2;
+            params.numPostLoops = 1;
+            params.valueOffset = 1.5;
+            _Warm(spline);
+            spline.SetInnerLoopParams(params);
+            _VerifySame(name + " inner loops", _Rebuild(spline), spline);
+
+            // A knot value, which affects echoed knots and the Repeat offset.
+            TsKnot knot = *knots.begin();
+            double value = 0;
+            knot.GetValue(&value);
+            knot.SetValue(value + 3.0);
+            _Warm(spline);
+            spline.SetKnot(knot);
+            _VerifySame(name + " knot edit", _Rebuild(spline), spline);
+
+            // Removing all loops.
+            _Warm(spline);
+            spline.SetInnerLoopParams(TsLoopParams());
+            spline.SetPreExtrapolation(TsExtrapolation(TsExtrapHeld));
+            spline.SetPostExtrapolation(TsExtrapolation(TsExtrapLinear));
+            _VerifySame(name + " loop removal", _Rebuild(spline), spline);
+        }
+    }
+}
+
+int
+main()
+{
+    TestEdits();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,275 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/parallel.h>
+#include <pxr/ts/splineBundle.h>
+#include <pxr/ts/spline.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/museum.h>
+#include <tsTest/tsEvaluator.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace pxr;
+
+
+// An executor that runs tasks serially in reverse order, to show that results
+// don't depend on scheduling.
+class _ReverseExecutor : public TsExecutor
+{
+public:
+    size_t GetConcurrency() const override
+    {
+        return 4;
+    }
+
+    void Run(
+        const size_t numTasks,
+        const std::function<void(size_t)> &task) override
+    {
+        for (size_t i = numTasks; i > 0; --i) {
+            task(i - 1);
+        }
+    }
+};
+
+// Verifies that an executor runs each task exactly once.
+static void
+_VerifyRun(TsExecutor *executor, const size_t numTasks)
+{
+    std::vector<std::atomic<int>> counts(numTasks);
+    for (std::atomic<int> &count : counts) {
+        count = 0;
+    }
+
+    executor->Run(numTasks, [&](const size_t i) {
+        // Uneven tasks, so that threads steal from each other.
+        if (i % 7 == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        ++counts[i];
+    });
+
+    for (const std::atomic<int> &count : counts) {
+        TF_AXIOM(count == 1);
+    }
+}
+
+static void
+TestExecutors()
+{
+    TsSerialExecutor serial;
+    TF_AXIOM(serial.GetConcurrency() == 1);
+
+    TsThreadPoolExecutor single(1);
+    TF_AXIOM(single.GetConcurrency() == 1);
+
+    TsThreadPoolExecutor pool(4);
+    TF_AXIOM(pool.GetConcurrency() == 4);
+
+    TF_AXIOM(TsGetDefaultExecutor().GetConcurrency() >= 1);
+
+    for (TsExecutor *executor :
+             {(TsExecutor*) &serial, (TsExecutor*) &single,
+              (TsExecutor*) &pool, &TsGetDefaultExecutor()}) {
+        for (const size_t numTasks : {0, 1, 2, 3, 100, 1000}) {
+            _VerifyRun(executor, numTasks);
+        }
+    }
+
+    // The pool is reusable many times over.
+    for (int i = 0; i < 200; ++i) {
+        _VerifyRun(&pool, 16);
+    }
+
+    // Nested calls run serially on the calling thread.
+    std::atomic<int> total(0);
+    pool.Run(8, [&](size_t) {
+        pool.Run(8, [&](size_t) { ++total; });
+    });
+    TF_AXIOM(total == 64);
+
+    // Concurrent calls from several threads are serialized.
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&pool]() {
+            for (int i = 0; i < 20; ++i) {
+                _VerifyRun(&pool, 100);
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+static std::vector<TsSpline>
+_GetMuseumSplines()
+{
+    const TsTest_TsEvaluator evaluator;
+
+    std::vector<TsSpline> splines;
+    for (const std::string &name : TsTest_Museum::GetAllNames()) {
+        splines.push_back(evaluator.SplineDataToSpline(
+            TsTest_Museum::GetDataByName(name)));
+    }
+    return splines;
+}
+
+// Returns shuffled times that cover all of the splines, plus extrapolation.
+static std::vector<TsTime>
+_GetTestTimes(const std::vector<TsSpline> &splines, const int numSamples)
+{
+    GfInterval span;
+    for (const TsSpline &spline : splines) {
+        span |= spline.GetKnots().GetTimeSpan();
+        if (spline.HasInnerLoops()) {
+            span |= spline.GetInnerLoopParams().GetLoopedInterval();
+        }
+    }
+
+    const double size = std::max(span.GetSize(), 1.0);
+    const double min = span.GetMin() - 0.5 * size;
+    const double max = span.GetMax() + 0.5 * size;
+
+    std::vector<TsTime> times;
+    for (int i = 0; i <= numSamples; ++i) {
+        times.push_back(min + i * (max - min) / numSamples);
+    }
+
+    std::mt19937 rng(42);
+    std::shuffle(times.begin(), times.end(), rng);
+    return times;
+}
+
+// Exact equality, except that NaNs (from vertical tangents) match each other.
+static bool
+_IsSame(const double a, const double b)
+{
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+static void
+_VerifySame(
+    const std::vector<double> &expected,
+    const std::vector<double> &actual)
+{
+    TF_AXIOM(expected.size() == actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        if (!_IsSame(expected[i], actual[i])) {
+            std::cerr << "Parallel mismatch at element " << i
+                      << ": expected " << expected[i]
+                      << ", got " << actual[i] << std::endl;
+            TF_FATAL_ERROR("Parallel evaluation mismatch");
+        }
+    }
+}
+
+// Parallel evaluation must match serial evaluation exactly, for any executor,
+// for compiled and uncompiled splines.
+//
+static void
+TestSplines()
+{
+    const double sentinel = -12345;
+    const std::vector<TsSpline> splines = _GetMuseumSplines();
+    const std::vector<TsTime> times = _GetTestTimes(splines, 20000);
+
+    TsThreadPoolExecutor pool(4);
+    _ReverseExecutor reverse;
+
+    for (const bool compile : {false, true}) {
+        if (compile) {
+            for (const TsSpline &spline : splines) {
+                spline.Compile();
+            }
+        }
+
+        // Serial results.
+        std::vector<double> expected(splines.size() * times.size(), sentinel);
+        bool expectAll = true;
+        for (size_t i = 0; i < splines.size(); ++i) {
+            expectAll &= splines[i].EvalMany(
+                times,
+                TfSpan<double>(expected).subspan(
+                    i * times.size(), times.size()));
+        }
+
+        for (TsExecutor *executor :
+                 {(TsExecutor*) &pool, (TsExecutor*) &reverse,
+                  &TsGetDefaultExecutor(), (TsExecutor*) nullptr}) {
+            std::vector<double> actual(expected.size(), sentinel);
+            const bool haveAll = TsEvalManyParallel(
+                splines, times, TfSpan<double>(actual),
+                TsEvalOptions(), executor);
+            TF_AXIOM(haveAll == expectAll);
+            _VerifySame(expected, actual);
+
+            // One spline.
+            std::vector<double> single(times.size(), sentinel);
+            TsEvalManyParallel(
+                splines[0], times, TfSpan<double>(single),
+                TsEvalOptions(), executor);
+            _VerifySame(
+                std::vector<double>(
+                    expected.begin(), expected.begin() + times.size()),
+                single);
+        }
+    }
+}
+
+static void
+TestBundle()
+{
+    const double sentinel = -12345;
+    const std::vector<TsSpline> splines = _GetMuseumSplines();
+    const std::vector<TsTime> times = _GetTestTimes(splines, 5000);
+    const TsSplineBundle bundle(splines);
+
+    TsThreadPoolExecutor pool(4);
+    _ReverseExecutor reverse;
+
+    std::vector<double> expected(splines.size() * times.size(), sentinel);
+    const bool expectAll = bundle.EvalMany(times, TfSpan<double>(expected));
+
+    for (TsExecutor *executor :
+             {(TsExecutor*) &pool, (TsExecutor*) &reverse,
+              &TsGetDefaultExecutor(), (TsExecutor*) nullptr}) {
+        std::vector<double> actual(expected.size(), sentinel);
+        TF_AXIOM(bundle.EvalMany(times, TfSpan<double>(actual), executor)
+                 == expectAll);
+        _VerifySame(expected, actual);
+
+        for (const TsTime time : {times[0], times[1], times[2]}) {
+            std::vector<double> one(splines.size(), sentinel);
+            std::vector<double> oneParallel(splines.size(), sentinel);
+            TF_AXIOM(bundle.EvalDerivative(time, TfSpan<double>(one))
+                     == bundle.EvalDerivative(
+                         time, TfSpan<double>(oneParallel), executor));
+            _VerifySame(one, oneParallel);
+        }
+    }
+}
+
+int
+main()
+{
+    TestExecutors();
+    TestSplines();
+    TestBundle();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,235 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/parallel.h>
+#include <pxr/ts/spline.h>
+#include <pxr/ts/knot.h>
+#include <pxr/tf/diagnosticLite.h>
+
+#include <atomic>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+
+// An executor that runs tasks serially in reverse order, to show that results
+// don't depend on scheduling, and counts the tasks it is given.
+class _ReverseExecutor : public TsExecutor
+{
+public:
+    size_t GetConcurrency() const override
+    {
+        return 4;
+    }
+
+    void Run(
+        const size_t numTasks,
+        const std::function<void(size_t)> &task) override
+    {
+        numRuns++;
+        totalTasks += numTasks;
+        for (size_t i = numTasks; i > 0; --i) {
+            task(i - 1);
+        }
+    }
+
+    std::atomic<size_t> numRuns{0};
+    std::atomic<size_t> totalTasks{0};
+};
+
+// A visitor that records what it is called with.
+struct _RecordingVisitor
+{
+    void BeginPolyline(const TsSplineSampleSource source)
+    {
+        sources.push_back(source);
+        sizes.push_back(0);
+    }
+
+    void AddVertex(const double time, const double value)
+    {
+        vertices.emplace_back(time, value);
+        sizes.back()++;
+    }
+
+    std::vector<TsSplineSampleSource> sources;
+    std::vector<size_t> sizes;
+    std::vector<GfVec2d> vertices;
+};
+
+// Returns a long spline of mixed segments, like those baked from motion
+// capture, with some discontinuities.
+static TsSpline
+_MakeLongSpline(const int numKnots, const unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-10, 10);
+    std::uniform_int_distribution<int> pick(0, 15);
+
+    TsSpline spline;
+    for (int i = 0; i < numKnots; ++i) {
+        TsKnot knot(Ts_GetType<double>(), TsCurveTypeBezier);
+        knot.SetTime(i);
+        knot.SetValue(dist(rng));
+        knot.SetPreTanWidth(0.4);
+        knot.SetPostTanWidth(0.4);
+        knot.SetPreTanSlope(dist(rng));
+        knot.SetPostTanSlope(dist(rng));
+
+        const int kind = pick(rng);
+        knot.SetNextInterpolation(
+            kind == 0 ? TsInterpHeld :
+            kind == 1 ? TsInterpLinear :
+            kind == 2 ? TsInterpValueBlock : TsInterpCurve);
+        if (kind == 3) {
+            knot.SetPreValue(dist(rng));
+        }
+        spline.SetKnot(knot);
+    }
+    return spline;
+}
+
+// Verify that sampling with an executor gives exactly the results of serial
+// sampling, for each kind of output.
+static void
+_Compare(
+    const std::string &desc,
+    const TsSpline &spline,
+    const GfInterval &interval,
+    TsExecutor *executor,
+    const TsBezierFlattening flattening = TsBezierFlatteningSubdivide)
+{
+    TsSerialExecutor serial;
+    const double timeScale = 20, valueScale = 10, tolerance = 0.5;
+
+    TsSplineSamplesWithSources<GfVec2d> expected, samples;
+    TF_AXIOM(spline.Sample(interval, timeScale, valueScale, tolerance,
+                           &expected, flattening, &serial));
+    TF_AXIOM(spline.Sample(interval, timeScale, valueScale, tolerance,
+                           &samples, flattening, executor));
+    TF_AXIOM(!expected.polylines.empty());
+
+    TsSplineSamples<GfVec2f> expectedFloat, samplesFloat;
+    TF_AXIOM(spline.Sample(interval, timeScale, valueScale, tolerance,
+                           &expectedFloat, flattening, &serial));
+    TF_AXIOM(spline.Sample(interval, timeScale, valueScale, tolerance,
+                           &samplesFloat, flattening, executor));
+
+    TsSplineFlatSamples<GfVec2d> expectedFlat, flat;
+    expectedFlat.withSources = flat.withSources = true;
+    TF_AXIOM(spline.Sample(interval, timeScale, valueScale, tolerance,
+                           &expectedFlat, flattening, &serial));
+    TF_AXIOM(spline.Sample(interval, timeScale, valueScale, tolerance,
+                           &flat, flattening, executor));
+
+    TsSplineFlatSamples<GfVec2f> expectedFlatFloat, flatFloat;
+    TF_AXIOM(spline.Sample(interval, timeScale, valueScale, tolerance,
+                           &expectedFlatFloat, flattening, &serial));
+    TF_AXIOM(spline.Sample(interval, timeScale, valueScale, tolerance,
+                           &flatFloat, flattening, executor));
+
+    _RecordingVisitor expectedVisitor, visitor;
+    TF_AXIOM(spline.SampleToVisitor(interval, timeScale, valueScale,
+                                    tolerance, &expectedVisitor,
+                                    flattening, &serial));
+    TF_AXIOM(spline.SampleToVisitor(interval, timeScale, valueScale,
+                                    tolerance, &visitor,
+                                    flattening, executor));
+
+    if (samples.polylines != expected.polylines ||
+        samples.sources != expected.sources ||
+        samplesFloat.polylines != expectedFloat.polylines ||
+        flat.vertices != expectedFlat.vertices ||
+        flat.offsets != expectedFlat.offsets ||
+        flat.sources != expectedFlat.sources ||
+        flatFloat.vertices != expectedFlatFloat.vertices ||
+        flatFloat.offsets != expectedFlatFloat.offsets ||
+        !flatFloat.sources.empty() ||
+        visitor.vertices != expectedVisitor.vertices ||
+        visitor.sizes != expectedVisitor.sizes ||
+        visitor.sources != expectedVisitor.sources)
+    {
+        std::cerr << "Parallel sampling mismatch in " << desc << " over "
+                  << interval << ": expected " << expected.polylines.size()
+                  << " polylines, got " << samples.polylines.size()
+                  << std::endl;
+        TF_FATAL_ERROR("Parallel sampling mismatch");
+    }
+}
+
+static void
+TestLongSplines()
+{
+    _ReverseExecutor reverse;
+    TsThreadPoolExecutor pool(4);
+
+    TsSpline spline = _MakeLongSpline(20000, 3);
+    for (TsExecutor *executor : {(TsExecutor*) &reverse,
+                                 (TsExecutor*) &pool,
+                                 &TsGetDefaultExecutor()}) {
+        // Whole, with extrapolation, and starting and ending at knots and
+        // between them.
+        _Compare("long", spline, GfInterval(-100, 20100), executor);
+        _Compare("long", spline, GfInterval(0, 19999), executor);
+        _Compare("long", spline, GfInterval(1000.5, 15000.25), executor);
+        _Compare("long", spline, GfInterval(1000, 15000, false, false),
+                 executor);
+        _Compare("long uniform", spline, GfInterval(-100, 20100), executor,
+                 TsBezierFlatteningUniform);
+    }
+
+    // The work was divided.
+    TF_AXIOM(reverse.numRuns > 0);
+    TF_AXIOM(reverse.totalTasks >= 2 * reverse.numRuns);
+
+    // Inner loops, and looping extrapolation.
+    TsLoopParams params;
+    params.protoStart = 2000;
+    params.protoEnd = 6000;
+    params.numPreLoops = 0;
+    params.numPostLoops = 2;
+    params.valueOffset = 5;
+    spline.SetInnerLoopParams(params);
+    _Compare("inner loops", spline, GfInterval(-100, 20100), &reverse);
+    _Compare("inner loops", spline, GfInterval(-100, 20100), &pool);
+
+    spline.SetInnerLoopParams(TsLoopParams());
+    spline.SetPreExtrapolation(TsExtrapolation(TsExtrapLoopRepeat));
+    spline.SetPostExtrapolation(TsExtrapolation(TsExtrapLoopReset));
+    _Compare("extrap loops", spline, GfInterval(-30000, 50000), &reverse);
+    _Compare("extrap loops", spline, GfInterval(-30000, 50000), &pool);
+}
+
+static void
+TestThreshold()
+{
+    // Short splines, and short intervals of long ones, are sampled serially.
+    _ReverseExecutor reverse;
+    const TsSpline shortSpline = _MakeLongSpline(500, 5);
+    _Compare("short", shortSpline, GfInterval(-10, 510), &reverse);
+
+    const TsSpline longSpline = _MakeLongSpline(20000, 5);
+    _Compare("long", longSpline, GfInterval(100, 600), &reverse);
+    TF_AXIOM(reverse.numRuns == 0);
+
+    // A long interval of the same spline is divided.
+    _Compare("long", longSpline, GfInterval(0, 20000), &reverse);
+    TF_AXIOM(reverse.numRuns > 0);
+}
+
+int
+main()
+{
+    TestLongSplines();
+    TestThreshold();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
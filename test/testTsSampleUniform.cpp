@@ -0,0 +1,141 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/spline.h>
+#include <pxr/ts/knot.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/testHelpers.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+
+// Verify that uniform sampling agrees with batch evaluation at the same times.
+// Both are solved iteratively, to the same tolerance, but forward differencing
+// and warm starts round differently, and near vertical tangents the time cubic
+// is so flat that values can differ by more than rounding.
+static void
+_Compare(
+    const std::string &desc,
+    const TsSpline &spline,
+    const TsTime start,
+    const TsTime step,
+    const size_t count)
+{
+    TsEvalOptions options;
+    options.bezierSolver = TsBezierSolverNewton;
+    options.solverTolerance = 1e-14;
+
+    std::vector<TsTime> times(count);
+    for (size_t i = 0; i < count; ++i) {
+        times[i] = start + i * step;
+    }
+
+    const double sentinel = -12345;
+    std::vector<double> expected(count, sentinel);
+    const bool expectAll = spline.EvalMany(
+        times, TfSpan<double>(expected), options);
+
+    std::vector<double> values(count, sentinel);
+    const bool haveAll = spline.SampleUniform(
+        start, step, TfSpan<double>(values), options);
+
+    TF_AXIOM(haveAll == expectAll);
+    for (size_t i = 0; i < count; ++i) {
+        const double tolerance = 1e-5 * std::max(1.0, std::abs(expected[i]));
+        if (!(std::abs(values[i] - expected[i]) <= tolerance)) {
+            std::cerr << "Uniform sampling mismatch in " << desc << " at time "
+                      << times[i] << ": expected " << expected[i]
+                      << ", got " << values[i] << std::endl;
+            TF_FATAL_ERROR("Uniform sampling mismatch");
+        }
+    }
+}
+
+static void
+TestMuseum()
+{
+    for (const auto &[name, spline] : TsTest_GetMuseumSplines()) {
+        TsSpline compiled = spline;
+        compiled.Compile();
+
+        // Cover the knots and inner loops, plus some extrapolation on both
+        // sides, at a coarse and a fine rate.  The fine rate makes long runs,
+        // which exercise restarts of forward differencing.
+        const GfInterval span = TsTest_GetKnotSpan(spline);
+        const double size = std::max(span.GetSize(), 1.0);
+        for (const size_t count : {300, 20000}) {
+            const TsTime step = 3 * size / count;
+            _Compare(name, spline, span.GetMin() - size, step, count + 1);
+            _Compare(name + " compiled",
+                compiled, span.GetMin() - size, step, count + 1);
+        }
+    }
+}
+
+static void
+TestCases()
+{
+    TsSpline spline;
+    spline.SetKnot(TsTest_MakeKnot(0, 0, TsInterpLinear));
+    spline.SetKnot(TsTest_MakeKnot(10, 10, TsInterpHeld));
+    spline.SetKnot(TsTest_MakeKnot(20, 4, TsInterpValueBlock));
+    spline.SetKnot(TsTest_MakeKnot(30, 7, TsInterpHeld));
+
+    // The maximum is included, and samples land on knots.
+    VtArray<double> values;
+    TF_AXIOM(!spline.SampleUniform(GfInterval(-5, 35), 2.5, &values));
+    TF_AXIOM(values.size() == 17);
+    TF_AXIOM(values[0] == 0 && values[2] == 0);
+    TF_AXIOM(values[3] == 2.5 && values[6] == 10);
+    TF_AXIOM(values[9] == 10 && values[10] == 4);
+    TF_AXIOM(values[14] == 7 && values[16] == 7);
+
+    // Open ends are sampled anyway.
+    TF_AXIOM(spline.SampleUniform(
+        GfInterval(0, 10, false, false), 5.0, &values));
+    TF_AXIOM(values.size() == 3 && values[1] == 5 && values[2] == 10);
+
+    // A step that doesn't divide the interval evenly, and rounds badly.
+    TF_AXIOM(spline.SampleUniform(GfInterval(0, 0.3), 0.1, &values));
+    TF_AXIOM(values.size() == 3 || values.size() == 4);
+    TF_AXIOM(0.1 * (values.size() - 1) <= 0.3);
+
+    // A single sample.
+    TF_AXIOM(spline.SampleUniform(GfInterval(5), 1.0, &values));
+    TF_AXIOM(values.size() == 1 && values[0] == 5);
+
+    // Float output.
+    std::vector<float> floats(4);
+    TF_AXIOM(spline.SampleUniform(1.0, 3.0, TfSpan<float>(floats)));
+    TF_AXIOM(floats[0] == 1 && floats[3] == 10);
+
+    // Invalid arguments.
+    TF_AXIOM(!spline.SampleUniform(GfInterval(0, 10), 0.0, &values));
+    TF_AXIOM(!spline.SampleUniform(GfInterval(0, 10), -1.0, &values));
+    TF_AXIOM(!spline.SampleUniform(
+        GfInterval::GetFullInterval(), 1.0, &values));
+    TF_AXIOM(!spline.SampleUniform(0.0, 0.0, TfSpan<float>(floats)));
+
+    // No knots, no values.
+    TF_AXIOM(!TsSpline().SampleUniform(GfInterval(0, 10), 1.0, &values));
+}
+
+int
+main()
+{
+    TestMuseum();
+    TestCases();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,146 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/spline.h>
+#include <pxr/ts/knot.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/testHelpers.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+
+// Collects polylines in the same form as TsSplineSamplesWithSources.
+struct _CollectingVisitor
+{
+    void BeginPolyline(TsSplineSampleSource source)
+    {
+        samples.polylines.emplace_back();
+        samples.sources.push_back(source);
+    }
+
+    void AddVertex(double time, double value)
+    {
+        TF_AXIOM(!samples.polylines.empty());
+        samples.polylines.back().emplace_back(time, value);
+    }
+
+    TsSplineSamplesWithSources<GfVec2d> samples;
+};
+
+// Streams vertices into a flat buffer, as for a vertex buffer, with the start
+// of each polyline in a separate index list.
+struct _BufferVisitor
+{
+    void BeginPolyline(TsSplineSampleSource)
+    {
+        starts.push_back(vertices.size() / 2);
+    }
+
+    void AddVertex(double time, double value)
+    {
+        vertices.push_back(float(time));
+        vertices.push_back(float(value));
+    }
+
+    std::vector<float> vertices;
+    std::vector<size_t> starts;
+};
+
+// The visitor must see exactly the polylines and sources that
+// TsSplineSamplesWithSources receives.
+static void
+_Compare(
+    const std::string &desc,
+    const TsSpline &spline,
+    const GfInterval &interval,
+    const double timeScale,
+    const double valueScale,
+    const double tolerance)
+{
+    TsSplineSamplesWithSources<GfVec2d> expected;
+    TF_AXIOM(spline.Sample(
+        interval, timeScale, valueScale, tolerance, &expected));
+
+    _CollectingVisitor visitor;
+    TF_AXIOM(spline.SampleToVisitor(
+        interval, timeScale, valueScale, tolerance, &visitor));
+
+    if (visitor.samples.sources != expected.sources ||
+        visitor.samples.polylines != expected.polylines)
+    {
+        std::cerr << "Visitor mismatch in " << desc << " over " << interval
+                  << ": expected " << expected.polylines.size()
+                  << " polylines, got " << visitor.samples.polylines.size()
+                  << std::endl;
+        TF_FATAL_ERROR("Sample visitor mismatch");
+    }
+}
+
+static void
+TestMuseum()
+{
+    for (const auto &[name, spline] : TsTest_GetMuseumSplines()) {
+        const GfInterval span = TsTest_GetKnotSpan(spline);
+        const double size = std::max(span.GetSize(), 1.0);
+        const GfInterval longSpan = TsTest_GetTestInterval(spline, 1.5);
+        const double timeScale = 500 / size;
+
+        _Compare(name, spline, span, timeScale, 50, 1.0);
+        _Compare(name, spline, longSpan, timeScale, 50, 0.25);
+    }
+}
+
+static void
+TestCases()
+{
+    TsSpline spline;
+    spline.SetKnot(TsTest_MakeKnot(0, 0, TsInterpLinear));
+    spline.SetKnot(TsTest_MakeKnot(10, 10, TsInterpHeld));
+    spline.SetKnot(TsTest_MakeKnot(20, 4, TsInterpLinear));
+    spline.SetKnot(TsTest_MakeKnot(30, 7, TsInterpHeld));
+
+    // Pre-extrapolation, knot interpolation broken at the held jump, and
+    // post-extrapolation.
+    _BufferVisitor buffer;
+    TF_AXIOM(spline.SampleToVisitor(
+        GfInterval(-10, 40), 1.0, 1.0, 0.1, &buffer));
+    TF_AXIOM(buffer.starts.size() == 4);
+    TF_AXIOM(buffer.starts[0] == 0);
+    TF_AXIOM(buffer.vertices[0] == -10 && buffer.vertices[1] == 0);
+    TF_AXIOM(buffer.vertices.back() == 7);
+
+    // Invalid arguments don't call the visitor.
+    _BufferVisitor unused;
+    TF_AXIOM(!spline.SampleToVisitor(
+        GfInterval(), 1.0, 1.0, 0.1, &unused));
+    TF_AXIOM(!spline.SampleToVisitor(
+        GfInterval(0, 10), 1.0, 1.0, 0.0, &unused));
+    TF_AXIOM(unused.vertices.empty() && unused.starts.empty());
+
+    // No knots, no polylines.
+    TF_AXIOM(TsSpline().SampleToVisitor(
+        GfInterval(0, 10), 1.0, 1.0, 0.1, &unused));
+    TF_AXIOM(unused.vertices.empty());
+    TsSplineSamples<GfVec2d> samples;
+    TF_AXIOM(TsSpline().Sample(GfInterval(0, 10), 1.0, 1.0, 0.1, &samples));
+    TF_AXIOM(samples.polylines.empty());
+}
+
+int
+main()
+{
+    TestMuseum();
+    TestCases();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,265 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/sampler.h>
+#include <pxr/ts/parallel.h>
+#include <pxr/ts/spline.h>
+#include <pxr/ts/knot.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/testHelpers.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+
+// Returns a sequence of intervals like those a graph editor draws: the whole
+// spline, then zooming in, panning, zooming out, and looking at
+// extrapolation only.
+static std::vector<GfInterval>
+_GetViews(const TsSpline &spline)
+{
+    const GfInterval span = TsTest_GetKnotSpan(spline);
+    const double min = span.GetMin();
+    const double size = std::max(span.GetSize(), 1.0);
+
+    return {
+        GfInterval(min - size, min + 2 * size),
+        GfInterval(min, min + size),
+        GfInterval(min + 0.25 * size, min + 0.5 * size),
+        GfInterval(min + 0.3 * size, min + 0.4 * size, false, true),
+        GfInterval(min + 0.6 * size, min + 0.85 * size),
+        GfInterval(min + 0.1 * size, min + 0.9 * size),
+        GfInterval(min - 3 * size, min - 2 * size),
+        GfInterval(min + 2 * size, min + 4 * size),
+        GfInterval(min - size, min + 2 * size)
+    };
+}
+
+// Verify that the sampler gives exactly the results of TsSpline::Sample, for
+// each kind of output.
+static void
+_Compare(
+    const std::string &desc,
+    TsSampler *sampler,
+    const TsSpline &spline,
+    const GfInterval &interval,
+    const double timeScale,
+    const double tolerance,
+    const TsBezierFlattening flattening)
+{
+    const double valueScale = 20;
+
+    TsSplineSamplesWithSources<GfVec2d> expected, samples;
+    TF_AXIOM(spline.Sample(interval, timeScale, valueScale, tolerance,
+                           &expected, flattening));
+    TF_AXIOM(sampler->Sample(interval, timeScale, valueScale, tolerance,
+                             &samples, flattening));
+
+    TsSplineFlatSamples<GfVec2f> expectedFlat, flat;
+    TF_AXIOM(spline.Sample(interval, timeScale, valueScale, tolerance,
+                           &expectedFlat, flattening));
+    TF_AXIOM(sampler->Sample(interval, timeScale, valueScale, tolerance,
+                             &flat, flattening));
+
+    if (samples.polylines != expected.polylines ||
+        samples.sources != expected.sources ||
+        flat.vertices != expectedFlat.vertices ||
+        flat.offsets != expectedFlat.offsets)
+    {
+        std::cerr << "Sampler mismatch in " << desc << " over " << interval
+                  << ": expected " << expected.polylines.size()
+                  << " polylines, got " << samples.polylines.size()
+                  << std::endl;
+        TF_FATAL_ERROR("Sampler mismatch");
+    }
+}
+
+static void
+TestMuseum()
+{
+    // One sampler for all the splines, as a graph editor would use.
+    TsSampler sampler;
+
+    for (const auto &[name, spline] : TsTest_GetMuseumSplines()) {
+        sampler.SetSpline(spline);
+        TF_AXIOM(sampler.GetSpline() == spline);
+
+        const std::vector<GfInterval> views = _GetViews(spline);
+        const double timeScale =
+            500 / std::max(views[1].GetSize(), 1.0);
+        for (const GfInterval &view : views) {
+            _Compare(name, &sampler, spline, view, timeScale, 0.5,
+                     TsBezierFlatteningSubdivide);
+            _Compare(name, &sampler, spline, view, 4 * timeScale, 0.1,
+                     TsBezierFlatteningUniform);
+        }
+    }
+}
+
+// Returns a spline with the given value type, whose values are exactly
+// representable in all of them, with inner loops, knots hidden by the loops,
+// and sloped extrapolation.
+template <typename T>
+static TsSpline
+_MakeLoopedSpline()
+{
+    TsSpline spline(Ts_GetType<T>());
+    const TsTime times[] = {0, 3, 7, 10, 12, 16, 19, 25, 30};
+    const double values[] = {1, 4, 2.5, -3, 0.5, 6, -2, 8, 5};
+    for (size_t i = 0; i < std::size(times); ++i) {
+        TsKnot knot(Ts_GetType<T>(), TsCurveTypeBezier);
+        knot.SetTime(times[i]);
+        knot.SetValue(T(values[i]));
+        knot.SetPreTanWidth(T(1));
+        knot.SetPostTanWidth(T(1));
+        knot.SetPreTanSlope(T(0.5));
+        knot.SetPostTanSlope(T(-1.5));
+        knot.SetNextInterpolation(i == 7 ? TsInterpLinear : TsInterpCurve);
+        spline.SetKnot(knot);
+    }
+
+    // Prototype [7, 12), looped once before and once after, which hides the
+    // knots at 3 and 16.
+    TsLoopParams params;
+    params.protoStart = 7;
+    params.protoEnd = 12;
+    params.numPreLoops = 1;
+    params.numPostLoops = 1;
+    params.valueOffset = 2;
+    spline.SetInnerLoopParams(params);
+
+    spline.SetPreExtrapolation(TsExtrapolation(TsExtrapLinear));
+    TsExtrapolation post(TsExtrapSloped);
+    post.slope = -0.5;
+    spline.SetPostExtrapolation(post);
+    return spline;
+}
+
+static void
+TestValueTypes()
+{
+    // Knots that aren't double-valued are converted before sampling, like
+    // unrolled loops, so the results are the same as for double knots.
+    TsSpline doubleSpline = _MakeLoopedSpline<double>();
+    TsSpline floatSpline = _MakeLoopedSpline<float>();
+
+    TsSampler doubleSampler(doubleSpline);
+    TsSampler floatSampler(floatSpline);
+    for (int pass = 0; pass < 2; ++pass) {
+        for (const GfInterval &view : _GetViews(doubleSpline)) {
+            TsSplineSamplesWithSources<GfVec2d> expected, samples;
+            TF_AXIOM(doubleSpline.Sample(view, 10.0, 10.0, 0.1, &expected));
+            TF_AXIOM(floatSpline.Sample(view, 10.0, 10.0, 0.1, &samples));
+            TF_AXIOM(samples.polylines == expected.polylines);
+            TF_AXIOM(samples.sources == expected.sources);
+
+            TF_AXIOM(floatSampler.Sample(view, 10.0, 10.0, 0.1, &samples));
+            TF_AXIOM(samples.polylines == expected.polylines);
+            TF_AXIOM(doubleSampler.Sample(view, 10.0, 10.0, 0.1, &samples));
+            TF_AXIOM(samples.polylines == expected.polylines);
+            TF_AXIOM(!samples.polylines.empty());
+
+            // Every vertex is on the spline, except where the ends of the
+            // view clip a curve.  The loops and extrapolation here are
+            // continuous, so there are no pre-values to allow for.
+            for (const std::vector<GfVec2d> &polyline : expected.polylines) {
+                for (const GfVec2d &vertex : polyline) {
+                    double value = 0;
+                    TF_AXIOM(doubleSpline.Eval(vertex[0], &value));
+                    TF_AXIOM(vertex[0] == view.GetMin() ||
+                             vertex[0] == view.GetMax() ||
+                             std::abs(value - vertex[1]) < 1e-6);
+                }
+            }
+        }
+
+        // Again without inner loops.
+        doubleSpline.SetInnerLoopParams(TsLoopParams());
+        floatSpline.SetInnerLoopParams(TsLoopParams());
+        doubleSampler.SetSpline(doubleSpline);
+        floatSampler.SetSpline(floatSpline);
+    }
+}
+
+static void
+TestCases()
+{
+    TsSpline spline;
+    spline.SetKnot(TsTest_MakeKnot(0, 0, TsInterpLinear));
+    spline.SetKnot(TsTest_MakeKnot(10, 10, TsInterpLinear));
+    spline.SetPreExtrapolation(TsExtrapolation(TsExtrapLinear));
+    spline.SetPostExtrapolation(TsExtrapolation(TsExtrapLinear));
+
+    // Extrapolation that doesn't reach the knots.
+    TsSampler sampler(spline);
+    TsSplineFlatSamples<GfVec2d> flat;
+    TF_AXIOM(sampler.Sample(GfInterval(-7, -5), 1.0, 1.0, 0.1, &flat));
+    TF_AXIOM(flat.vertices == std::vector<GfVec2d>({{-7, -7}, {-5, -5}}));
+    TF_AXIOM(sampler.Sample(GfInterval(15, 20), 1.0, 1.0, 0.1, &flat));
+    TF_AXIOM(flat.vertices == std::vector<GfVec2d>({{15, 15}, {20, 20}}));
+
+    // The sampler keeps its copy of the spline until given the edited one.
+    TsSpline edited = spline;
+    edited.SetKnot(TsTest_MakeKnot(10, 20, TsInterpLinear));
+    TF_AXIOM(sampler.Sample(GfInterval(0, 10), 1.0, 1.0, 0.1, &flat));
+    TF_AXIOM(flat.vertices.back() == GfVec2d(10, 10));
+    sampler.SetSpline(edited);
+    TF_AXIOM(sampler.Sample(GfInterval(0, 10), 1.0, 1.0, 0.1, &flat));
+    TF_AXIOM(flat.vertices.back() == GfVec2d(10, 20));
+
+    // Output capacity is kept.
+    const GfVec2d* const vertexData = flat.vertices.data();
+    TF_AXIOM(sampler.Sample(GfInterval(2, 8), 1.0, 1.0, 0.1, &flat));
+    TF_AXIOM(flat.vertices.data() == vertexData);
+
+    // Visitors and executors.
+    TsSplineSamplesWithSources<GfVec2d> expected;
+    TF_AXIOM(edited.Sample(GfInterval(-5, 15), 1.0, 1.0, 0.1, &expected));
+    struct _Visitor
+    {
+        void BeginPolyline(TsSplineSampleSource source)
+        {
+            polylines.emplace_back();
+            sources.push_back(source);
+        }
+        void AddVertex(double time, double value)
+        {
+            polylines.back().emplace_back(time, value);
+        }
+        std::vector<std::vector<GfVec2d>> polylines;
+        std::vector<TsSplineSampleSource> sources;
+    } visitor;
+    TsSerialExecutor serial;
+    TF_AXIOM(sampler.SampleToVisitor(GfInterval(-5, 15), 1.0, 1.0, 0.1,
+                                     &visitor, TsBezierFlatteningSubdivide,
+                                     &serial));
+    TF_AXIOM(visitor.polylines == expected.polylines);
+    TF_AXIOM(visitor.sources == expected.sources);
+
+    // Empty splines give empty samples.
+    sampler.SetSpline(TsSpline());
+    TF_AXIOM(sampler.Sample(GfInterval(0, 10), 1.0, 1.0, 0.1, &flat));
+    TF_AXIOM(flat.vertices.empty());
+    TF_AXIOM(TsSampler().Sample(GfInterval(0, 10), 1.0, 1.0, 0.1, &flat));
+    TF_AXIOM(flat.vertices.empty());
+}
+
+int
+main()
+{
+    TestMuseum();
+    TestValueTypes();
+    TestCases();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,164 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/spline.h>
+#include <pxr/ts/knot.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/testHelpers.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+
+// Returns frames that cover a spline's knots and inner loops, plus some
+// extrapolation on both sides.
+static std::vector<TsTime>
+_GetTestFrames(const TsSpline &spline)
+{
+    const GfInterval span = TsTest_GetKnotSpan(spline);
+
+    const double size = std::max(span.GetSize(), 1.0);
+    const int numFrames = 300;
+    std::vector<TsTime> frames;
+    for (int i = 0; i <= numFrames; ++i) {
+        frames.push_back(span.GetMin() - size + i * 3 * size / numFrames);
+    }
+    return frames;
+}
+
+static TsShutter
+_MakeShutter(const double open, const double close, const int numSamples)
+{
+    TsShutter shutter;
+    shutter.open = open;
+    shutter.close = close;
+    shutter.numSamples = numSamples;
+    return shutter;
+}
+
+// Verify that shutter evaluation agrees with batch evaluation at the same
+// times.  Both are solved iteratively, to the same tolerance, so they differ
+// only by where the solver starts.  Near vertical tangents, the time cubic is
+// so flat that a range of parameters solves it to machine precision, and the
+// values there can differ by more than rounding.
+static void
+_Compare(
+    const std::string &desc,
+    const TsSpline &spline,
+    const std::vector<TsTime> &frames,
+    const TsShutter &shutter)
+{
+    TsEvalOptions options;
+    options.bezierSolver = TsBezierSolverNewton;
+    options.solverTolerance = 1e-14;
+
+    std::vector<TsTime> times;
+    for (const TsTime frame : frames) {
+        for (int i = 0; i < shutter.numSamples; ++i) {
+            times.push_back(frame + shutter.GetSampleOffset(i));
+        }
+    }
+
+    const double sentinel = -12345;
+    std::vector<double> expected(times.size(), sentinel);
+    const bool expectAll = spline.EvalMany(
+        times, TfSpan<double>(expected), options);
+
+    std::vector<double> values(times.size(), sentinel);
+    const bool haveAll = spline.EvalShutter(
+        frames, shutter, TfSpan<double>(values), options);
+
+    TF_AXIOM(haveAll == expectAll);
+    for (size_t i = 0; i < times.size(); ++i) {
+        const double tolerance = 1e-5 * std::max(1.0, std::abs(expected[i]));
+        if (!(std::abs(values[i] - expected[i]) <= tolerance)) {
+            std::cerr << "Shutter mismatch in " << desc << " at time "
+                      << times[i] << ": expected " << expected[i]
+                      << ", got " << values[i] << std::endl;
+            TF_FATAL_ERROR("Shutter evaluation mismatch");
+        }
+    }
+}
+
+static void
+TestMuseum()
+{
+    const std::vector<TsShutter> shutters = {
+        _MakeShutter(0, 0, 1),
+        _MakeShutter(-0.25, 0.25, 8),
+        _MakeShutter(0, 0.5, 3),
+        _MakeShutter(-2, 2, 5)
+    };
+
+    for (const auto &[name, spline] : TsTest_GetMuseumSplines()) {
+        TsSpline compiled = spline;
+        compiled.Compile();
+
+        const std::vector<TsTime> frames = _GetTestFrames(spline);
+        for (const TsShutter &shutter : shutters) {
+            _Compare(name, spline, frames, shutter);
+            _Compare(name + " compiled", compiled, frames, shutter);
+        }
+    }
+}
+
+static void
+TestCases()
+{
+    TsSpline spline;
+    spline.SetKnot(TsTest_MakeKnot(0, 0, TsInterpLinear));
+    spline.SetKnot(TsTest_MakeKnot(10, 10, TsInterpHeld));
+    spline.SetKnot(TsTest_MakeKnot(20, 4, TsInterpValueBlock));
+    spline.SetKnot(TsTest_MakeKnot(30, 7, TsInterpHeld));
+
+    // Stratum centers.
+    const TsShutter shutter = _MakeShutter(-0.5, 0.5, 4);
+    TF_AXIOM(shutter.IsValid());
+    TF_AXIOM(shutter.GetSampleOffset(0) == -0.375);
+    TF_AXIOM(shutter.GetSampleOffset(3) == 0.375);
+
+    const std::vector<TsTime> frames = {5, 15, 25};
+    VtArray<double> values;
+    values.assign(12, -1);
+    TF_AXIOM(!spline.EvalShutter(frames, shutter, &values));
+    TF_AXIOM(values.size() == 12);
+    TF_AXIOM(values[0] == 4.625 && values[3] == 5.375);
+    TF_AXIOM(values[4] == 10 && values[7] == 10);
+
+    // The blocked frame is left alone.
+    TF_AXIOM(values[8] == -1 && values[11] == -1);
+
+    // Float output.
+    std::vector<float> floats(8);
+    TF_AXIOM(spline.EvalShutter(
+        std::vector<TsTime>{5, 15}, shutter, TfSpan<float>(floats)));
+    TF_AXIOM(floats[1] == 4.875f);
+
+    // Invalid shutters and sizes.
+    TF_AXIOM(!_MakeShutter(1, 0, 4).IsValid());
+    TF_AXIOM(!_MakeShutter(0, 1, 0).IsValid());
+    std::vector<double> tooFew(5);
+    TF_AXIOM(!spline.EvalShutter(frames, shutter, TfSpan<double>(tooFew)));
+
+    // No knots, no values.
+    TF_AXIOM(!TsSpline().EvalShutter(frames, shutter, &values));
+}
+
+int
+main()
+{
+    TestMuseum();
+    TestCases();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,248 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/splineBundle.h>
+#include <pxr/ts/spline.h>
+#include <pxr/ts/knot.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/museum.h>
+#include <tsTest/tsEvaluator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+
+// Returns all of the museum splines.
+static std::vector<TsSpline>
+_GetMuseumSplines()
+{
+    const TsTest_TsEvaluator evaluator;
+
+    std::vector<TsSpline> splines;
+    for (const std::string &name : TsTest_Museum::GetAllNames()) {
+        splines.push_back(evaluator.SplineDataToSpline(
+            TsTest_Museum::GetDataByName(name)));
+    }
+    return splines;
+}
+
+// Returns ascending times that cover the knots and inner loops of all the
+// splines, plus some extrapolation on both sides.  Includes all knot times.
+static std::vector<TsTime>
+_GetTestTimes(const std::vector<TsSpline> &splines)
+{
+    GfInterval span;
+    std::vector<TsTime> times;
+    for (const TsSpline &spline : splines) {
+        span |= spline.GetKnots().GetTimeSpan();
+        if (spline.HasInnerLoops()) {
+            span |= spline.GetInnerLoopParams().GetLoopedInterval();
+        }
+        for (const TsKnot &knot : spline.GetKnots()) {
+            times.push_back(knot.GetTime());
+        }
+    }
+
+    const double size = std::max(span.GetSize(), 1.0);
+    const double min = span.GetMin() - 0.5 * size;
+    const double max = span.GetMax() + 0.5 * size;
+    const int numSamples = 2000;
+    for (int i = 0; i <= numSamples; ++i) {
+        times.push_back(min + i * (max - min) / numSamples);
+    }
+
+    std::sort(times.begin(), times.end());
+    return times;
+}
+
+// Exact equality, except that NaNs (from vertical tangents) match each other.
+static bool
+_IsSame(const double a, const double b)
+{
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+using _EvalMethod = bool (TsSpline::*)(TsTime, double*) const;
+
+// Verifies that a bundle's results, from both single-time and multi-time
+// evaluation, are identical to those of its splines.
+static void
+_VerifyBundle(
+    const TsSplineBundle &bundle,
+    const std::vector<TsTime> &times)
+{
+    const double sentinel = -12345;
+    const size_t numSplines = bundle.GetSize();
+
+    for (const bool derivative : {false, true}) {
+        const _EvalMethod method = derivative ?
+            _EvalMethod(&TsSpline::EvalDerivative<double>) :
+            _EvalMethod(&TsSpline::Eval<double>);
+
+        std::vector<double> many(numSplines * times.size(), sentinel);
+        const bool haveAllMany = derivative ?
+            bundle.EvalDerivativeMany(times, TfSpan<double>(many)) :
+            bundle.EvalMany(times, TfSpan<double>(many));
+
+        bool expectAll = true;
+        for (size_t j = 0; j < times.size(); ++j) {
+            std::vector<double> single(numSplines, sentinel);
+            const bool haveAllSingle = derivative ?
+                bundle.EvalDerivative(times[j], TfSpan<double>(single)) :
+                bundle.Eval(times[j], TfSpan<double>(single));
+
+            bool expectAllSingle = true;
+            for (size_t i = 0; i < numSplines; ++i) {
+                double expected = sentinel;
+                const bool haveExpected =
+                    (bundle.GetSpline(i).*method)(times[j], &expected);
+                expectAllSingle = expectAllSingle && haveExpected;
+
+                const double manyValue = many[i * times.size() + j];
+                if (!_IsSame(single[i], expected)
+                    || !_IsSame(manyValue, expected)) {
+                    std::cerr << "Bundle mismatch for spline " << i
+                              << (derivative ? " derivative" : " value")
+                              << " at time " << times[j]
+                              << ": expected " << expected
+                              << ", got " << single[i]
+                              << " and " << manyValue << std::endl;
+                    TF_FATAL_ERROR("Bundle evaluation mismatch");
+                }
+            }
+            TF_AXIOM(haveAllSingle == expectAllSingle);
+            expectAll = expectAll && expectAllSingle;
+        }
+        TF_AXIOM(haveAllMany == expectAll);
+    }
+}
+
+// A bundle of every museum spline must agree exactly with each spline's own
+// evaluation.  The bundle compiles its splines, so the comparison is with
+// compiled evaluation.
+//
+static void
+TestMuseum()
+{
+    const std::vector<TsSpline> splines = _GetMuseumSplines();
+    const TsSplineBundle bundle(splines);
+    TF_AXIOM(bundle.GetSize() == splines.size());
+
+    for (size_t i = 0; i < splines.size(); ++i) {
+        TF_AXIOM(bundle.GetSpline(i) == splines[i]);
+        TF_AXIOM(splines[i].IsCompiled());
+    }
+
+    _VerifyBundle(bundle, _GetTestTimes(splines));
+}
+
+static TsSpline
+_MakeSpline(const int numKnots, const double scale)
+{
+    TsSpline spline;
+    for (int i = 0; i < numKnots; ++i) {
+        TsKnot knot;
+        knot.SetTime(i * 10.0);
+        knot.SetValue(scale * ((i % 3) - 1));
+        knot.SetNextInterpolation(i % 4 == 3 ? TsInterpLinear : TsInterpCurve);
+        knot.SetPreTanWidth(3.0);
+        knot.SetPreTanSlope(VtValue(scale * 0.5));
+        knot.SetPostTanWidth(3.0);
+        knot.SetPostTanSlope(VtValue(scale * 0.5));
+        spline.SetKnot(knot);
+    }
+    return spline;
+}
+
+// Replacing individual splines repacks them in place when they fit, and moves
+// them otherwise.  Either way, results must match the new splines.
+//
+static void
+TestSetSpline()
+{
+    std::vector<TsSpline> splines;
+    for (int i = 0; i < 10; ++i) {
+        splines.push_back(_MakeSpline(5, i + 1.0));
+    }
+    TsSplineBundle bundle(splines);
+    const std::vector<TsTime> times = _GetTestTimes(splines);
+    _VerifyBundle(bundle, times);
+
+    // Fewer knots: fits in place.
+    bundle.SetSpline(3, _MakeSpline(3, -2.0));
+    _VerifyBundle(bundle, times);
+
+    // More knots: moves.
+    bundle.SetSpline(4, _MakeSpline(8, 3.0));
+    _VerifyBundle(bundle, times);
+
+    // Empty, single-knot, and looping splines aren't packed.
+    bundle.SetSpline(5, TsSpline());
+    bundle.SetSpline(6, _MakeSpline(1, 1.0));
+    {
+        TsSpline looping = _MakeSpline(4, 1.0);
+        TsLoopParams params;
+        params.protoStart = 0.0;
+        params.protoEnd = 20.0;
+        params.numPreLoops = 1;
+        params.numPostLoops = 2;
+        looping.SetInnerLoopParams(params);
+        bundle.SetSpline(7, looping);
+    }
+    _VerifyBundle(bundle, _GetTestTimes(
+        {bundle.GetSpline(4), bundle.GetSpline(7)}));
+
+    // Many moves, which eventually trigger compaction.
+    for (int i = 0; i < 50; ++i) {
+        bundle.SetSpline(i % 10, _MakeSpline(6 + i, 0.5 * i));
+    }
+    _VerifyBundle(bundle, times);
+
+    // Edits to the originals don't affect the bundle until it is rebuilt.
+    TsSpline spline = bundle.GetSpline(0);
+    double before = 0, after = 0;
+    TF_AXIOM(spline.Eval(15.0, &before));
+
+    TsKnot knot;
+    TF_AXIOM(spline.GetKnot(10.0, &knot));
+    knot.SetValue(100.0);
+    spline.SetKnot(knot);
+
+    std::vector<double> values(bundle.GetSize());
+    bundle.Eval(15.0, TfSpan<double>(values));
+    TF_AXIOM(values[0] == before);
+
+    bundle.SetSpline(0, spline);
+    bundle.Eval(15.0, TfSpan<double>(values));
+    TF_AXIOM(spline.Eval(15.0, &after));
+    TF_AXIOM(after != before);
+    TF_AXIOM(values[0] == after);
+
+    // Full rebuild.
+    bundle.Rebuild(splines);
+    TF_AXIOM(bundle.GetSize() == splines.size());
+    _VerifyBundle(bundle, times);
+
+    bundle.Rebuild({});
+    TF_AXIOM(bundle.GetSize() == 0);
+    TF_AXIOM(bundle.Eval(0.0, TfSpan<double>()));
+}
+
+int
+main()
+{
+    TestMuseum();
+    TestSetSpline();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
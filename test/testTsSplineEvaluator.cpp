@@ -0,0 +1,333 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/splineEvaluator.h>
+#include <pxr/ts/spline.h>
+#include <pxr/ts/knot.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/museum.h>
+#include <tsTest/tsEvaluator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace pxr;
+
+
+// Returns times that cover a spline's knots and inner loops, plus some
+// extrapolation on both sides, in ascending order.  Includes the knot times
+// themselves.
+static std::vector<TsTime>
+_GetTestTimes(const TsSpline &spline)
+{
+    GfInterval span = spline.GetKnots().GetTimeSpan();
+    if (spline.HasInnerLoops()) {
+        span |= spline.GetInnerLoopParams().GetLoopedInterval();
+    }
+
+    const double size = std::max(span.GetSize(), 1.0);
+    const double min = span.GetMin() - 1.5 * size;
+    const double max = span.GetMax() + 1.5 * size;
+    const int numSamples = 1000;
+
+    std::vector<TsTime> times;
+    for (int i = 0; i <= numSamples; ++i) {
+        times.push_back(min + i * (max - min) / numSamples);
+    }
+    for (const TsKnot &knot : spline.GetKnots()) {
+        times.push_back(knot.GetTime());
+    }
+    std::sort(times.begin(), times.end());
+    return times;
+}
+
+// Exact equality, except that NaNs (from vertical tangents) match each other.
+static bool
+_IsSame(const double a, const double b)
+{
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+using _SplineMethod = bool (TsSpline::*)(TsTime, double*) const;
+using _EvaluatorMethod = bool (TsSplineEvaluator::*)(TsTime, double*);
+
+struct _Method
+{
+    std::string name;
+    _SplineMethod splineMethod;
+    _EvaluatorMethod evaluatorMethod;
+};
+
+static const std::vector<_Method> &
+_GetMethods()
+{
+    static const std::vector<_Method> methods = {
+        {"Eval",
+         &TsSpline::Eval<double>,
+         &TsSplineEvaluator::Eval<double>},
+        {"EvalPreValue",
+         &TsSpline::EvalPreValue<double>,
+         &TsSplineEvaluator::EvalPreValue<double>},
+        {"EvalDerivative",
+         &TsSpline::EvalDerivative<double>,
+         &TsSplineEvaluator::EvalDerivative<double>},
+        {"EvalPreDerivative",
+         &TsSpline::EvalPreDerivative<double>,
+         &TsSplineEvaluator::EvalPreDerivative<double>},
+        {"EvalHeld",
+         &TsSpline::EvalHeld<double>,
+         &TsSplineEvaluator::EvalHeld<double>},
+        {"EvalPreValueHeld",
+         &TsSpline::EvalPreValueHeld<double>,
+         &TsSplineEvaluator::EvalPreValueHeld<double>}};
+    return methods;
+}
+
+// Evaluates with a spline and an evaluator, and verifies that the results are
+// identical.
+static void
+_Compare(
+    const std::string &name,
+    const TsSpline &spline,
+    TsSplineEvaluator *evaluator,
+    const _Method &method,
+    const std::vector<TsTime> &times)
+{
+    for (const TsTime time : times) {
+        double expected = 0, actual = 0;
+        const bool haveExpected =
+            (spline.*method.splineMethod)(time, &expected);
+        const bool haveActual =
+            ((*evaluator).*method.evaluatorMethod)(time, &actual);
+
+        if (haveActual != haveExpected
+            || (haveActual && !_IsSame(actual, expected))) {
+            std::cerr << "Evaluator mismatch in " << name << " "
+                      << method.name << " at time " << time
+                      << ": expected " << expected
+                      << ", got " << actual << std::endl;
+            TF_FATAL_ERROR("Evaluator mismatch");
+        }
+    }
+}
+
+// An evaluator must agree exactly with TsSpline::Eval, whatever the order of
+// evaluation times: ascending and descending, which step through adjacent
+// segments, and shuffled, which mostly requires searches.  Test both
+// uncompiled and compiled splines.
+//
+static void
+TestMuseum()
+{
+    const TsTest_TsEvaluator tsEvaluator;
+    std::mt19937 rng(42);
+
+    for (const std::string &name : TsTest_Museum::GetAllNames()) {
+        const TsSpline spline = tsEvaluator.SplineDataToSpline(
+            TsTest_Museum::GetDataByName(name));
+
+        const std::vector<TsTime> ascending = _GetTestTimes(spline);
+        const std::vector<TsTime> descending(
+            ascending.rbegin(), ascending.rend());
+        std::vector<TsTime> shuffled = ascending;
+        std::shuffle(shuffled.begin(), shuffled.end(), rng);
+
+        for (const bool compile : {false, true}) {
+            if (compile) {
+                spline.Compile();
+            }
+
+            for (const _Method &method : _GetMethods()) {
+                // One evaluator for all orders, so that each run starts from
+                // wherever the last one left off.
+                TsSplineEvaluator evaluator(spline);
+                _Compare(name, spline, &evaluator, method, ascending);
+                _Compare(name, spline, &evaluator, method, descending);
+                _Compare(name, spline, &evaluator, method, shuffled);
+            }
+        }
+    }
+}
+
+static TsSpline
+_MakeSpline()
+{
+    TsSpline spline;
+
+    TsKnot knot1;
+    knot1.SetTime(0.0);
+    knot1.SetValue(0.0);
+    knot1.SetNextInterpolation(TsInterpCurve);
+    knot1.SetPostTanWidth(5.0);
+    knot1.SetPostTanSlope(VtValue(2.0));
+    spline.SetKnot(knot1);
+
+    TsKnot knot2;
+    knot2.SetTime(10.0);
+    knot2.SetValue(20.0);
+    knot2.SetNextInterpolation(TsInterpLinear);
+    knot2.SetPreTanWidth(5.0);
+    knot2.SetPreTanSlope(VtValue(0.0));
+    spline.SetKnot(knot2);
+
+    TsKnot knot3;
+    knot3.SetTime(20.0);
+    knot3.SetValue(10.0);
+    spline.SetKnot(knot3);
+
+    return spline;
+}
+
+static void
+TestBasics()
+{
+    // Empty splines have no value.
+    {
+        TsSplineEvaluator evaluator{TsSpline()};
+        double value = 0;
+        TF_AXIOM(!evaluator.Eval(5.0, &value));
+        TF_AXIOM(!evaluator.EvalDerivative(5.0, &value));
+    }
+
+    // Options are passed through.
+    {
+        TsEvalOptions options;
+        options.bezierSolver = TsBezierSolverHalley;
+        const TsSpline spline = _MakeSpline();
+        TsSplineEvaluator evaluator(spline, options);
+        TF_AXIOM(evaluator.GetOptions() == options);
+        TF_AXIOM(evaluator.GetSpline() == spline);
+
+        double expected = 0, actual = 0;
+        TF_AXIOM(spline.Eval(3.0, &expected, options));
+        TF_AXIOM(evaluator.Eval(3.0, &actual));
+        TF_AXIOM(actual == expected);
+    }
+
+    // VtValue output holds the spline's value type.
+    {
+        TsSpline spline(Ts_GetType<float>());
+        TsKnot knot(Ts_GetType<float>());
+        knot.SetTime(1.0);
+        knot.SetValue(2.0f);
+        spline.SetKnot(knot);
+
+        TsSplineEvaluator evaluator(spline);
+        VtValue value;
+        TF_AXIOM(evaluator.Eval(1.0, &value));
+        TF_AXIOM(value.IsHolding<float>());
+        TF_AXIOM(value.UncheckedGet<float>() == 2.0f);
+    }
+}
+
+// Edits to the original spline don't affect an existing evaluator, because the
+// spline makes its own copy of the data before writing.
+//
+static void
+TestCopyOnWrite()
+{
+    TsSpline spline = _MakeSpline();
+    spline.Compile();
+
+    double before = 0;
+    TF_AXIOM(spline.Eval(5.0, &before));
+
+    TsSplineEvaluator evaluator(spline);
+
+    TsKnot knot;
+    TF_AXIOM(spline.GetKnot(10.0, &knot));
+    knot.SetValue(30.0);
+    spline.SetKnot(knot);
+    spline.RemoveKnot(20.0);
+
+    double after = 0, value = 0;
+    TF_AXIOM(spline.Eval(5.0, &after));
+    TF_AXIOM(after != before);
+
+    TF_AXIOM(evaluator.Eval(5.0, &value));
+    TF_AXIOM(value == before);
+    TF_AXIOM(evaluator.Eval(15.0, &value));
+    TF_AXIOM(value == 15.0);
+
+    // A new evaluator sees the edits.
+    TsSplineEvaluator newEvaluator(spline);
+    TF_AXIOM(newEvaluator.Eval(5.0, &value));
+    TF_AXIOM(value == after);
+}
+
+// Evaluators on several threads, one each, while the original spline is
+// copied and edited on the main thread.
+//
+static void
+TestThreads()
+{
+    TsSpline spline = _MakeSpline();
+    const TsSpline original = spline;
+
+    std::vector<TsTime> times;
+    for (int i = -100; i <= 300; ++i) {
+        times.push_back(i * 0.1);
+    }
+
+    std::vector<double> expected(times.size());
+    for (size_t i = 0; i < times.size(); ++i) {
+        TF_AXIOM(original.Eval(times[i], &expected[i]));
+    }
+
+    const int numThreads = 4;
+    std::vector<int> failures(numThreads, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            TsSplineEvaluator evaluator(spline);
+            for (int repeat = 0; repeat < 200; ++repeat) {
+                for (size_t i = 0; i < times.size(); ++i) {
+                    double value = 0;
+                    if (!evaluator.Eval(times[i], &value)
+                        || value != expected[i]) {
+                        ++failures[t];
+                    }
+                }
+            }
+        });
+    }
+
+    // Meanwhile, edit and copy.  Evaluators created before these edits must
+    // not see them.
+    for (int i = 0; i < 200; ++i) {
+        TsSpline copy = spline;
+        TsKnot knot;
+        TF_AXIOM(copy.GetKnot(10.0, &knot));
+        knot.SetValue(20.0 + i);
+        copy.SetKnot(knot);
+        copy.Compile();
+    }
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    for (const int count : failures) {
+        TF_AXIOM(count == 0);
+    }
+}
+
+int
+main()
+{
+    TestMuseum();
+    TestBasics();
+    TestCopyOnWrite();
+    TestThreads();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,440 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/spline.h>
+#include <pxr/ts/knot.h>
+#include <pxr/ts/raii.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/testHelpers.h>
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+
+// Whole-spline queries are answered from per-knot summary flags that are
+// updated as knots are edited.  These tests verify that incremental updates
+// agree with summaries built from scratch, and that the queries agree with
+// evaluation.
+
+// All query results for a spline, for comparison.
+static std::vector<bool>
+_GetQueries(const TsSpline &spline)
+{
+    std::vector<bool> result = {
+        spline.HasValueBlocks(),
+        spline.IsVarying(),
+        spline.IsLinear(),
+        spline.IsC0Continuous(),
+        spline.IsG1Continuous(),
+        spline.IsC1Continuous()};
+
+    const TsKnotMap knots = spline.GetKnots();
+    for (size_t i = 0; i + 1 < knots.size(); ++i) {
+        const TsTime time = (knots.begin() + i)->GetTime();
+        if (spline.HasInnerLoops()
+            && spline.GetInnerLoopParams().GetLoopedInterval().Contains(
+                time)) {
+            continue;
+        }
+        result.push_back(spline.IsSegmentFlat(time));
+        result.push_back(spline.IsSegmentMonotonic(time));
+    }
+    return result;
+}
+
+// Returns a spline with the same contents, with knots set in reverse order,
+// so that its summary is built along a different path.
+static TsSpline
+_Rebuild(const TsSpline &spline)
+{
+    TsSpline result(spline.GetValueType());
+    result.SetCurveType(spline.GetCurveType());
+    result.SetPreExtrapolation(spline.GetPreExtrapolation());
+    result.SetPostExtrapolation(spline.GetPostExtrapolation());
+    result.SetInnerLoopParams(spline.GetInnerLoopParams());
+    const TsKnotMap knots = spline.GetKnots();
+    for (size_t i = knots.size(); i-- > 0;) {
+        result.SetKnot(*(knots.begin() + i));
+    }
+    return result;
+}
+
+static void
+_VerifySame(
+    const std::string &context,
+    const TsSpline &spline)
+{
+    if (_GetQueries(spline) != _GetQueries(_Rebuild(spline))) {
+        std::cerr << "Summary mismatch after " << context << std::endl;
+        TF_FATAL_ERROR("Stale spline summary");
+    }
+}
+
+// Applies random edits to museum splines, comparing queries after each.
+static void
+TestIncrementalEdits()
+{
+    // Rebuilt splines must match exactly, so don't adjust tangents.
+    const TsAntiRegressionAuthoringSelector selector(TsAntiRegressionNone);
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    int numEdits = 0;
+    for (auto [name, spline] : TsTest_GetMuseumSplines()) {
+        if (spline.GetKnots().size() < 2) {
+            continue;
+        }
+        _VerifySame(name, spline);
+
+        for (int edit = 0; edit < 40; ++edit) {
+            const TsKnotMap knots = spline.GetKnots();
+            const size_t index =
+                std::min(knots.size() - 1, size_t(unit(rng) * knots.size()));
+            TsKnot knot = *(knots.begin() + index);
+            double value = 0;
+            knot.GetValue(&value);
+
+            std::string context;
+            const double choice = unit(rng);
+            if (choice < 0.2 && knots.size() > 2) {
+                context = "removal";
+                spline.RemoveKnot(knot.GetTime());
+            } else if (choice < 0.4) {
+                context = "insertion";
+                knot.SetTime(knot.GetTime() + 0.25 + unit(rng) * 0.5);
+                if (knots.find(knot.GetTime()) != knots.end()) {
+                    continue;
+                }
+                knot.SetValue(value + unit(rng) - 0.5);
+                spline.SetKnot(knot);
+            } else if (choice < 0.5) {
+                context = "flattening";
+                knot.SetValue(0.0);
+                knot.SetPreValue(0.0);
+                knot.ClearPreValue();
+                knot.SetPreTanSlope(0.0);
+                knot.SetPostTanSlope(0.0);
+                spline.SetKnot(knot);
+            } else if (choice < 0.6) {
+                context = "dual value";
+                knot.SetPreValue(unit(rng) < 0.5 ? value : value + 1.0);
+                spline.SetKnot(knot);
+            } else if (choice < 0.8) {
+                context = "interpolation";
+                static const TsInterpMode modes[] = {
+                    TsInterpHeld, TsInterpLinear, TsInterpCurve,
+                    TsInterpValueBlock};
+                knot.SetNextInterpolation(modes[size_t(unit(rng) * 4) % 4]);
+                spline.SetKnot(knot);
+            } else {
+                context = "tangents";
+                knot.SetPostTanSlope(unit(rng) < 0.5 ? 0.0 : unit(rng) - 0.5);
+                knot.SetPreTanSlope(unit(rng) < 0.5 ? 0.0 : unit(rng) - 0.5);
+                if (spline.GetCurveType() == TsCurveTypeBezier) {
+                    knot.SetPostTanWidth(0.1 + unit(rng));
+                }
+                spline.SetKnot(knot);
+            }
+
+            _VerifySame(name + " " + context, spline);
+            ++numEdits;
+        }
+
+        // Wholesale replacement.
+        const TsKnotMap knots = spline.GetKnots();
+        spline.SetKnots(knots);
+        _VerifySame(name + " SetKnots", spline);
+
+        spline.ClearKnots();
+        _VerifySame(name + " ClearKnots", spline);
+        TF_AXIOM(!spline.IsVarying() && !spline.HasValueBlocks());
+    }
+
+    TF_AXIOM(numEdits > 0);
+}
+
+// Checks segment flatness and monotonicity against dense sampling.
+static void
+TestSegmentsAgainstSampling()
+{
+    TsEvalOptions options;
+    options.bezierSolver = TsBezierSolverNewton;
+
+    int numFlat = 0, numMonotonic = 0, numNonMonotonic = 0;
+    for (const auto &[name, spline] : TsTest_GetMuseumSplines()) {
+        const TsKnotMap knots = spline.GetKnots();
+
+        for (size_t i = 0; i + 1 < knots.size(); ++i) {
+            const TsTime start = (knots.begin() + i)->GetTime();
+            const TsTime end = (knots.begin() + i + 1)->GetTime();
+            if (spline.HasInnerLoops()
+                && spline.GetInnerLoopParams().GetLoopedInterval().Contains(
+                    start)) {
+                continue;
+            }
+
+            const bool flat = spline.IsSegmentFlat(start);
+            const bool monotonic = spline.IsSegmentMonotonic(start);
+            TF_AXIOM(!flat || monotonic);
+
+            // Sample the interior and the pre-value at the end.
+            std::vector<double> values;
+            const int numSamples = 400;
+            for (int j = 0; j < numSamples; ++j) {
+                double value = 0;
+                if (spline.Eval(
+                        start + j * (end - start) / numSamples,
+                        &value, options)) {
+                    values.push_back(value);
+                }
+            }
+            double endValue = 0;
+            if (spline.EvalPreValue(end, &endValue)) {
+                values.push_back(endValue);
+            }
+            if (values.empty()) {
+                TF_AXIOM(!flat && !monotonic);
+                continue;
+            }
+
+            bool increases = false, decreases = false;
+            for (size_t j = 1; j < values.size(); ++j) {
+                const double tolerance = 1e-9;
+                increases |= (values[j] > values[j - 1] + tolerance);
+                decreases |= (values[j] < values[j - 1] - tolerance);
+            }
+            if (flat) {
+                TF_AXIOM(!increases && !decreases);
+                ++numFlat;
+            }
+            if (monotonic) {
+                if (increases && decreases) {
+                    std::cerr << name << " segment at " << start
+                              << " is not monotonic" << std::endl;
+                    TF_FATAL_ERROR("Monotonic segment mismatch");
+                }
+                ++numMonotonic;
+            } else if (increases && decreases) {
+                ++numNonMonotonic;
+            }
+        }
+    }
+
+    TF_AXIOM(numFlat > 0 && numMonotonic > 0 && numNonMonotonic > 0);
+}
+
+static TsKnot
+_MakeKnot(
+    const TsTime time,
+    const double value,
+    const TsInterpMode interp = TsInterpCurve,
+    const double slope = 0.0,
+    const double width = 1.0)
+{
+    TsKnot knot = TsTest_MakeKnot(time, value, interp);
+    knot.SetPreTanSlope(slope);
+    knot.SetPostTanSlope(slope);
+    knot.SetPreTanWidth(width);
+    knot.SetPostTanWidth(width);
+    return knot;
+}
+
+static void
+TestHandCases()
+{
+    const TsAntiRegressionAuthoringSelector selector(TsAntiRegressionNone);
+
+    // Empty.
+    {
+        const TsSpline spline;
+        TF_AXIOM(!spline.IsVarying());
+        TF_AXIOM(!spline.IsLinear());
+        TF_AXIOM(spline.IsC0Continuous() && spline.IsC1Continuous());
+    }
+
+    // A single knot varies only with sloped extrapolation.
+    {
+        TsSpline spline;
+        spline.SetKnot(_MakeKnot(0.0, 3.0));
+        TF_AXIOM(!spline.IsVarying());
+        TF_AXIOM(!spline.IsLinear());
+        TF_AXIOM(spline.IsC1Continuous());
+
+        TsExtrapolation sloped(TsExtrapSloped);
+        sloped.slope = 2.0;
+        spline.SetPostExtrapolation(sloped);
+        TF_AXIOM(spline.IsVarying());
+        TF_AXIOM(spline.IsC0Continuous());
+        TF_AXIOM(!spline.IsG1Continuous());
+    }
+
+    // Evenly spaced, collinear linear knots, with linear extrapolation, are
+    // C1.  Changing one value breaks G1 but not C0.
+    {
+        TsSpline spline;
+        for (int i = 0; i < 4; ++i) {
+            spline.SetKnot(_MakeKnot(i * 2.0, i * 1.0, TsInterpLinear));
+        }
+        spline.SetPreExtrapolation(TsExtrapolation(TsExtrapLinear));
+        spline.SetPostExtrapolation(TsExtrapolation(TsExtrapLinear));
+        TF_AXIOM(spline.IsLinear());
+        TF_AXIOM(spline.IsVarying());
+        TF_AXIOM(spline.IsC1Continuous());
+        TF_AXIOM(spline.IsSegmentMonotonic(2.0));
+        TF_AXIOM(!spline.IsSegmentFlat(2.0));
+
+        spline.SetKnot(_MakeKnot(4.0, 5.0, TsInterpLinear));
+        TF_AXIOM(spline.IsC0Continuous());
+        TF_AXIOM(!spline.IsG1Continuous());
+
+        // With held extrapolation, the ends are also slope breaks.
+        spline.SetKnot(_MakeKnot(4.0, 2.0, TsInterpLinear));
+        spline.SetPreExtrapolation(TsExtrapolation(TsExtrapHeld));
+        TF_AXIOM(!spline.IsG1Continuous());
+        spline.SetPreExtrapolation(TsExtrapolation(TsExtrapLinear));
+        TF_AXIOM(spline.IsC1Continuous());
+
+        // A held segment that ends at a different value is a discontinuity.
+        spline.SetKnot(_MakeKnot(2.0, 1.0, TsInterpHeld));
+        TF_AXIOM(!spline.IsLinear());
+        TF_AXIOM(!spline.IsC0Continuous());
+        TF_AXIOM(spline.IsSegmentFlat(2.0));
+
+        // So is a dual value.
+        spline.SetKnot(_MakeKnot(2.0, 1.0, TsInterpLinear));
+        TF_AXIOM(spline.IsC0Continuous());
+        TsKnot dual = _MakeKnot(4.0, 2.0, TsInterpLinear);
+        dual.SetPreValue(2.5);
+        spline.SetKnot(dual);
+        TF_AXIOM(!spline.IsC0Continuous());
+        TF_AXIOM(spline.IsVarying());
+
+        // Value blocks are discontinuities, except on the last knot.
+        spline.SetKnot(_MakeKnot(4.0, 2.0, TsInterpLinear));
+        spline.SetKnot(_MakeKnot(6.0, 3.0, TsInterpValueBlock));
+        TF_AXIOM(spline.HasValueBlocks());
+        TF_AXIOM(spline.IsC0Continuous());
+        spline.SetKnot(_MakeKnot(4.0, 2.0, TsInterpValueBlock));
+        TF_AXIOM(!spline.IsC0Continuous());
+        TF_AXIOM(!spline.IsSegmentFlat(4.0));
+        TF_AXIOM(!spline.IsSegmentMonotonic(4.0));
+        spline.RemoveKnot(6.0);
+        TF_AXIOM(spline.HasValueBlocks());
+        spline.RemoveKnot(4.0);
+        TF_AXIOM(!spline.HasValueBlocks());
+    }
+
+    // Bezier curves with matching slopes are G1; widths must also match for
+    // C1.
+    {
+        TsSpline spline;
+        spline.SetKnot(_MakeKnot(0.0, 0.0, TsInterpCurve, 1.0, 1.0));
+        spline.SetKnot(_MakeKnot(3.0, 3.0, TsInterpCurve, 1.0, 1.0));
+        spline.SetKnot(_MakeKnot(6.0, 6.0, TsInterpCurve, 1.0, 1.0));
+        spline.SetPreExtrapolation(TsExtrapolation(TsExtrapLinear));
+        spline.SetPostExtrapolation(TsExtrapolation(TsExtrapLinear));
+        TF_AXIOM(!spline.IsLinear());
+        TF_AXIOM(spline.IsC1Continuous());
+        TF_AXIOM(spline.IsSegmentMonotonic(0.0));
+
+        TsKnot knot = _MakeKnot(3.0, 3.0, TsInterpCurve, 1.0, 1.0);
+        knot.SetPostTanWidth(2.0);
+        spline.SetKnot(knot);
+        TF_AXIOM(spline.IsG1Continuous());
+        TF_AXIOM(!spline.IsC1Continuous());
+
+        knot.SetPostTanSlope(0.5);
+        spline.SetKnot(knot);
+        TF_AXIOM(spline.IsC0Continuous());
+        TF_AXIOM(!spline.IsG1Continuous());
+
+        // An overshooting tangent makes a segment non-monotonic.
+        knot.SetPostTanSlope(-2.0);
+        spline.SetKnot(knot);
+        TF_AXIOM(!spline.IsSegmentMonotonic(3.0));
+        TF_AXIOM(spline.IsSegmentMonotonic(0.0));
+
+        // A flat curve.
+        spline.SetKnot(_MakeKnot(0.0, 3.0, TsInterpCurve, 0.0, 1.0));
+        spline.SetKnot(_MakeKnot(3.0, 3.0, TsInterpCurve, 0.0, 1.0));
+        TF_AXIOM(spline.IsSegmentFlat(0.0));
+        TF_AXIOM(!spline.IsSegmentFlat(3.0));
+    }
+
+    // Loops.  Repeat joins continuously; Reset doesn't, unless the ends have
+    // the same value; Oscillate is G1 only with flat ends.
+    {
+        TsSpline spline;
+        spline.SetKnot(_MakeKnot(0.0, 0.0, TsInterpCurve, 1.0, 1.0));
+        spline.SetKnot(_MakeKnot(3.0, 2.0, TsInterpCurve, 1.0, 1.0));
+        spline.SetPreExtrapolation(TsExtrapolation(TsExtrapLoopRepeat));
+        spline.SetPostExtrapolation(TsExtrapolation(TsExtrapLoopRepeat));
+        TF_AXIOM(spline.IsC1Continuous());
+
+        spline.SetPreExtrapolation(TsExtrapolation(TsExtrapLoopReset));
+        spline.SetPostExtrapolation(TsExtrapolation(TsExtrapLoopReset));
+        TF_AXIOM(!spline.IsC0Continuous());
+
+        spline.SetPreExtrapolation(TsExtrapolation(TsExtrapLoopOscillate));
+        spline.SetPostExtrapolation(TsExtrapolation(TsExtrapLoopOscillate));
+        TF_AXIOM(spline.IsC0Continuous());
+        TF_AXIOM(!spline.IsG1Continuous());
+
+        spline.SetKnot(_MakeKnot(0.0, 0.0, TsInterpCurve, 0.0, 1.0));
+        spline.SetKnot(_MakeKnot(3.0, 2.0, TsInterpCurve, 0.0, 1.0));
+        TF_AXIOM(spline.IsC1Continuous());
+
+        // Repeat with mismatched end widths is G1 but not C1.
+        TsKnot knot = _MakeKnot(3.0, 2.0, TsInterpCurve, 1.0, 1.0);
+        knot.SetPreTanWidth(0.5);
+        spline.SetKnot(knot);
+        spline.SetKnot(_MakeKnot(0.0, 0.0, TsInterpCurve, 1.0, 1.0));
+        spline.SetPreExtrapolation(TsExtrapolation(TsExtrapLoopRepeat));
+        spline.SetPostExtrapolation(TsExtrapolation(TsExtrapLoopRepeat));
+        TF_AXIOM(spline.IsG1Continuous());
+        TF_AXIOM(!spline.IsC1Continuous());
+    }
+
+    // Inner loops with a value offset vary, even though the authored knots
+    // don't.  Segments are found at echoed knots.
+    {
+        TsSpline spline;
+        spline.SetKnot(_MakeKnot(0.0, 1.0, TsInterpHeld));
+        spline.SetKnot(_MakeKnot(5.0, 1.0, TsInterpHeld));
+        TF_AXIOM(!spline.IsVarying());
+
+        TsLoopParams params;
+        params.protoStart = 0.0;
+        params.protoEnd = 10.0;
+        params.numPostLoops = 2;
+        params.valueOffset = 0.0;
+        spline.SetInnerLoopParams(params);
+        TF_AXIOM(!spline.IsVarying());
+        TF_AXIOM(spline.IsSegmentFlat(15.0));
+
+        params.valueOffset = 2.0;
+        spline.SetInnerLoopParams(params);
+        TF_AXIOM(spline.IsVarying());
+        TF_AXIOM(!spline.IsC0Continuous());
+        TF_AXIOM(spline.IsSegmentFlat(25.0));
+    }
+}
+
+int
+main()
+{
+    TestIncrementalEdits();
+    TestSegmentsAgainstSampling();
+    TestHandCases();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
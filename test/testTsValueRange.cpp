@@ -0,0 +1,254 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/spline.h>
+#include <pxr/ts/knot.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/testHelpers.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+static const double _inf = std::numeric_limits<double>::infinity();
+
+
+// Finds the range of values by dense sampling, including pre-values at knots
+// in the interior of the interval.
+static std::pair<double, double>
+_SampleRange(
+    const TsSpline &spline,
+    const GfInterval &interval)
+{
+    std::pair<double, double> range(_inf, -_inf);
+    const auto add = [&range](const double value)
+    {
+        range.first = std::min(range.first, value);
+        range.second = std::max(range.second, value);
+    };
+
+    const int numSamples = 20000;
+    for (int i = 0; i <= numSamples; ++i) {
+        const TsTime time =
+            interval.GetMin() + i * interval.GetSize() / numSamples;
+        double value = 0;
+        if (spline.Eval(time, &value)) {
+            add(value);
+        }
+    }
+
+    // Knot times, and their echoes in loops, which may be between samples.
+    const GfInterval span = spline.GetKnots().GetTimeSpan();
+    for (const TsKnot &knot : spline.GetKnots()) {
+        for (int iter = -3; iter <= 3; ++iter) {
+            const TsTime time = knot.GetTime() + iter * span.GetSize();
+            double value = 0;
+            if (interval.Contains(time) && spline.Eval(time, &value)) {
+                add(value);
+            }
+            if (interval.Contains(time) && time > interval.GetMin()
+                && spline.EvalPreValue(time, &value)) {
+                add(value);
+            }
+        }
+    }
+
+    return range;
+}
+
+static void
+_Verify(
+    const std::string &context,
+    const TsSpline &spline,
+    const GfInterval &interval)
+{
+    std::pair<double, double> range;
+    const bool found = spline.GetValueRange(interval, &range);
+    const std::pair<double, double> expected = _SampleRange(spline, interval);
+
+    // No values.
+    if (expected.first > expected.second) {
+        TF_AXIOM(!found);
+        return;
+    }
+
+    // The range must contain every sample, and must not be much larger.
+    // Samples may miss extrema between them, especially at cusps.
+    const double tolerance =
+        1e-2 * std::max(1.0, expected.second - expected.first);
+    if (!found
+        || !(range.first <= expected.first + 1e-9 * tolerance)
+        || !(range.second >= expected.second - 1e-9 * tolerance)
+        || !(range.first >= expected.first - tolerance)
+        || !(range.second <= expected.second + tolerance)) {
+        std::cerr << "Range mismatch for " << context << " over "
+                  << interval << ": expected about [" << expected.first
+                  << ", " << expected.second << "], got [" << range.first
+                  << ", " << range.second << "]" << std::endl;
+        TF_FATAL_ERROR("Value range mismatch");
+    }
+}
+
+static void
+TestMuseum()
+{
+    std::mt19937 rng(7);
+
+    for (const auto &[name, spline] : TsTest_GetMuseumSplines()) {
+        const GfInterval interval = TsTest_GetTestInterval(spline, 2.5);
+        _Verify(name, spline, interval);
+
+        // Random sub-intervals, large and small, some starting or ending at
+        // knots.
+        std::vector<TsTime> ends;
+        for (const TsKnot &knot : spline.GetKnots()) {
+            ends.push_back(knot.GetTime());
+        }
+        std::uniform_real_distribution<double> dist(
+            interval.GetMin(), interval.GetMax());
+        for (int i = 0; i < 20; ++i) {
+            ends.push_back(dist(rng));
+        }
+        std::uniform_int_distribution<size_t> pick(0, ends.size() - 1);
+        for (int i = 0; i < 30; ++i) {
+            const TsTime a = ends[pick(rng)];
+            const TsTime b = ends[pick(rng)];
+            if (a != b) {
+                _Verify(name, spline,
+                        GfInterval(std::min(a, b), std::max(a, b)));
+            }
+        }
+    }
+}
+
+static std::pair<double, double>
+_GetRange(
+    const TsSpline &spline,
+    const GfInterval &interval)
+{
+    std::pair<double, double> range;
+    TF_AXIOM(spline.GetValueRange(interval, &range));
+    return range;
+}
+
+static void
+TestCases()
+{
+    std::pair<double, double> range;
+
+    // No knots.
+    TsSpline spline;
+    TF_AXIOM(!spline.GetValueRange(GfInterval(0, 10), &range));
+
+    // A curve that overshoots its knots.
+    TsKnot knot = TsTest_MakeKnot(0, 0, TsInterpCurve);
+    knot.SetPostTanWidth(1.0);
+    knot.SetPostTanSlope(6.0);
+    spline.SetKnot(knot);
+    knot = TsTest_MakeKnot(2, 0, TsInterpCurve);
+    knot.SetPreTanWidth(1.0);
+    knot.SetPreTanSlope(-6.0);
+    spline.SetKnot(knot);
+    range = _GetRange(spline, GfInterval(-10, 10));
+    TF_AXIOM(range.first == 0);
+    TF_AXIOM(std::abs(range.second - 4.5) < 1e-9);
+
+    // Empty intervals have no values.
+    TF_AXIOM(!spline.GetValueRange(GfInterval(), &range));
+
+    // Unbounded linear extrapolation.
+    spline.SetPostExtrapolation(TsExtrapolation(TsExtrapLinear));
+    range = _GetRange(spline, GfInterval(-10, _inf));
+    TF_AXIOM(range.first == -_inf);
+    TF_AXIOM(std::abs(range.second - 4.5) < 1e-9);
+
+    // Blocked extrapolation.
+    spline.SetPostExtrapolation(TsExtrapolation(TsExtrapValueBlock));
+    spline.SetPreExtrapolation(TsExtrapolation(TsExtrapValueBlock));
+    TF_AXIOM(!spline.GetValueRange(GfInterval(-10, -5), &range));
+    range = _GetRange(spline, GfInterval(-10, 0));
+    TF_AXIOM(range.first == 0 && range.second == 0);
+
+    // Edits are reflected in subsequent queries.
+    spline.SetKnot(TsTest_MakeKnot(4, 10, TsInterpLinear));
+    range = _GetRange(spline, GfInterval(-10, 10));
+    TF_AXIOM(range.first == 0 && range.second == 10);
+
+    // Float splines give float values.
+    TsSpline floatSpline(Ts_GetType<float>());
+    TsKnot floatKnot(Ts_GetType<float>(), TsCurveTypeBezier);
+    floatKnot.SetTime(0);
+    floatKnot.SetValue(1.5f);
+    floatSpline.SetKnot(floatKnot);
+    std::pair<VtValue, VtValue> vtRange;
+    TF_AXIOM(floatSpline.GetValueRange(GfInterval(-1, 1), &vtRange));
+    TF_AXIOM(vtRange.first.IsHolding<float>());
+    TF_AXIOM(vtRange.second.Get<float>() == 1.5f);
+}
+
+static void
+TestLoops()
+{
+    TsSpline spline;
+    spline.SetKnot(TsTest_MakeKnot(0, 0, TsInterpLinear));
+    spline.SetKnot(TsTest_MakeKnot(10, 5, TsInterpLinear));
+
+    // Repeat offsets each iteration.  The end value of each iteration is only
+    // approached.
+    spline.SetPreExtrapolation(TsExtrapolation(TsExtrapLoopRepeat));
+    spline.SetPostExtrapolation(TsExtrapolation(TsExtrapLoopRepeat));
+    std::pair<double, double> range = _GetRange(spline, GfInterval(0, 35));
+    TF_AXIOM(range.first == 0 && range.second == 17.5);
+    range = _GetRange(spline, GfInterval(-1000, 1000));
+    TF_AXIOM(range.first == -500 && range.second == 500);
+    range = _GetRange(spline, GfInterval(0, _inf));
+    TF_AXIOM(range.first == 0 && range.second == _inf);
+    range = _GetRange(spline, GfInterval(-_inf, 0));
+    TF_AXIOM(range.first == -_inf && range.second == 0);
+
+    // Oscillate stays within the knot values.
+    spline.SetPreExtrapolation(TsExtrapolation(TsExtrapLoopOscillate));
+    spline.SetPostExtrapolation(TsExtrapolation(TsExtrapLoopOscillate));
+    range = _GetRange(spline, GfInterval::GetFullInterval());
+    TF_AXIOM(range.first == 0 && range.second == 5);
+    range = _GetRange(spline, GfInterval(12, 16));
+    TF_AXIOM(std::abs(range.first - 2) < 1e-9);
+    TF_AXIOM(std::abs(range.second - 4) < 1e-9);
+
+    // Inner loops, with a value offset.
+    TsSpline inner;
+    inner.SetKnot(TsTest_MakeKnot(0, 0, TsInterpLinear));
+    inner.SetKnot(TsTest_MakeKnot(5, 8, TsInterpLinear));
+    TsLoopParams params;
+    params.protoStart = 0;
+    params.protoEnd = 10;
+    params.numPostLoops = 2;
+    params.valueOffset = 10;
+    inner.SetInnerLoopParams(params);
+    range = _GetRange(inner, GfInterval(12, 22));
+    TF_AXIOM(std::abs(range.first - 13.2) < 1e-9);
+    TF_AXIOM(std::abs(range.second - 23.2) < 1e-9);
+    range = _GetRange(inner, GfInterval(-5, 100));
+    TF_AXIOM(range.first == 0 && range.second == 30);
+}
+
+int
+main()
+{
+    TestMuseum();
+    TestCases();
+    TestLoops();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
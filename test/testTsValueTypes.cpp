@@ -0,0 +1,211 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include <pxr/ts/spline.h>
+#include <pxr/ts/knot.h>
+#include <pxr/ts/raii.h>
+#include <pxr/tf/diagnosticLite.h>
+#include <tsTest/museum.h>
+#include <tsTest/tsEvaluator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace pxr;
+
+
+// Float and half splines are evaluated and sampled in double precision, from
+// knot data that is widened as it is read.  Widening is exact, so the results
+// must be identical to those of a double spline whose knots hold the same
+// values.
+
+// Returns a double-typed copy of a spline of value type T.
+template <typename T>
+static TsSpline
+_WidenSpline(const TsSpline &spline)
+{
+    // Copy tangents verbatim, even if regressive.
+    TsAntiRegressionAuthoringSelector selector(TsAntiRegressionNone);
+
+    TsSpline result(Ts_GetType<double>());
+    result.SetCurveType(spline.GetCurveType());
+    result.SetPreExtrapolation(spline.GetPreExtrapolation());
+    result.SetPostExtrapolation(spline.GetPostExtrapolation());
+
+    for (const TsKnot &knot : spline.GetKnots()) {
+        TsKnot wide(Ts_GetType<double>(), knot.GetCurveType());
+        T value = 0;
+
+        wide.SetTime(knot.GetTime());
+        wide.SetNextInterpolation(knot.GetNextInterpolation());
+
+        TF_AXIOM(knot.GetValue(&value));
+        wide.SetValue(double(value));
+        if (knot.IsDualValued()) {
+            TF_AXIOM(knot.GetPreValue(&value));
+            wide.SetPreValue(double(value));
+        }
+
+        wide.SetPreTanWidth(knot.GetPreTanWidth());
+        TF_AXIOM(knot.GetPreTanSlope(&value));
+        wide.SetPreTanSlope(double(value));
+
+        wide.SetPostTanWidth(knot.GetPostTanWidth());
+        TF_AXIOM(knot.GetPostTanSlope(&value));
+        wide.SetPostTanSlope(double(value));
+
+        result.SetKnot(wide);
+    }
+
+    // Set loop params after knots, because they require a knot at the
+    // prototype start.
+    result.SetInnerLoopParams(spline.GetInnerLoopParams());
+
+    return result;
+}
+
+// Returns times that cover a spline's knots and inner loops, plus some
+// extrapolation on both sides.  Includes the knot times themselves.
+static std::vector<TsTime>
+_GetTestTimes(const TsSpline &spline)
+{
+    GfInterval span = spline.GetKnots().GetTimeSpan();
+    if (spline.HasInnerLoops()) {
+        span |= spline.GetInnerLoopParams().GetLoopedInterval();
+    }
+
+    const double size = std::max(span.GetSize(), 1.0);
+    const double min = span.GetMin() - 1.5 * size;
+    const double max = span.GetMax() + 1.5 * size;
+    const int numSamples = 1000;
+
+    std::vector<TsTime> times;
+    for (int i = 0; i <= numSamples; ++i) {
+        times.push_back(min + i * (max - min) / numSamples);
+    }
+    for (const TsKnot &knot : spline.GetKnots()) {
+        times.push_back(knot.GetTime());
+    }
+    return times;
+}
+
+// Exact equality, except that NaNs (from vertical tangents) match each other.
+static bool
+_IsSame(const double a, const double b)
+{
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+using _EvalMethod = bool (TsSpline::*)(TsTime, double*) const;
+
+template <typename T>
+static void
+TestEval()
+{
+    const TfType valueType = Ts_GetType<T>();
+    const TsTest_TsEvaluator evaluator;
+
+    const std::vector<std::pair<std::string, _EvalMethod>> methods = {
+        {"Eval", &TsSpline::Eval<double>},
+        {"EvalPreValue", &TsSpline::EvalPreValue<double>},
+        {"EvalDerivative", &TsSpline::EvalDerivative<double>},
+        {"EvalPreDerivative", &TsSpline::EvalPreDerivative<double>},
+        {"EvalHeld", &TsSpline::EvalHeld<double>},
+        {"EvalPreValueHeld", &TsSpline::EvalPreValueHeld<double>}};
+
+    for (const std::string &name : TsTest_Museum::GetAllNames()) {
+        const TsSpline spline = evaluator.SplineDataToSpline(
+            TsTest_Museum::GetDataByName(name), valueType);
+        const TsSpline wide = _WidenSpline<T>(spline);
+        const std::vector<TsTime> times = _GetTestTimes(spline);
+
+        for (const auto &method : methods) {
+            for (const TsTime time : times) {
+                double expected = 0, actual = 0;
+                const bool haveExpected =
+                    (wide.*method.second)(time, &expected);
+                const bool haveActual =
+                    (spline.*method.second)(time, &actual);
+
+                if (haveActual != haveExpected
+                    || (haveActual && !_IsSame(actual, expected))) {
+                    std::cerr << "Mismatch in " << name << " ("
+                              << valueType.GetTypeName() << ") "
+                              << method.first << " at time " << time
+                              << ": expected " << expected
+                              << ", got " << actual << std::endl;
+                    TF_FATAL_ERROR("Typed evaluation mismatch");
+                }
+            }
+        }
+
+        // Batch evaluation converts to the output type at the end.
+        std::vector<double> expected(times.size()), actual(times.size());
+        wide.EvalMany(times, TfSpan<double>(expected));
+        spline.EvalMany(times, TfSpan<double>(actual));
+        for (size_t i = 0; i < times.size(); ++i) {
+            TF_AXIOM(_IsSame(actual[i], expected[i]));
+        }
+    }
+}
+
+template <typename T>
+static void
+TestSample()
+{
+    const TfType valueType = Ts_GetType<T>();
+    const TsTest_TsEvaluator evaluator;
+
+    for (const std::string &name : TsTest_Museum::GetAllNames()) {
+        const TsSpline spline = evaluator.SplineDataToSpline(
+            TsTest_Museum::GetDataByName(name), valueType);
+        const TsSpline wide = _WidenSpline<T>(spline);
+
+        const std::vector<TsTime> times = _GetTestTimes(spline);
+        const GfInterval interval(
+            *std::min_element(times.begin(), times.end()),
+            *std::max_element(times.begin(), times.end()));
+
+        TsSplineSamples<GfVec2d> expected, actual;
+        const bool haveExpected =
+            wide.Sample(interval, 1.0, 1.0, 1e-3, &expected);
+        const bool haveActual =
+            spline.Sample(interval, 1.0, 1.0, 1e-3, &actual);
+        TF_AXIOM(haveActual == haveExpected);
+
+        TF_AXIOM(actual.polylines.size() == expected.polylines.size());
+        for (size_t i = 0; i < actual.polylines.size(); ++i) {
+            const auto &actualLine = actual.polylines[i];
+            const auto &expectedLine = expected.polylines[i];
+            TF_AXIOM(actualLine.size() == expectedLine.size());
+            for (size_t j = 0; j < actualLine.size(); ++j) {
+                if (!_IsSame(actualLine[j][0], expectedLine[j][0])
+                    || !_IsSame(actualLine[j][1], expectedLine[j][1])) {
+                    std::cerr << "Sample mismatch in " << name << " ("
+                              << valueType.GetTypeName() << ")" << std::endl;
+                    TF_FATAL_ERROR("Typed sampling mismatch");
+                }
+            }
+        }
+    }
+}
+
+int
+main()
+{
+    TestEval<float>();
+    TestEval<GfHalf>();
+
+    TestSample<float>();
+    TestSample<GfHalf>();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,135 @@
+# Copyright 2025 Pixar
+#
+# Licensed under the terms set forth in the LICENSE.txt file available at
+# https://openusd.org/license.
+#
+# Modified by Jeremy Retailleau.
+
+from pxr import Ts, Gf
+
+import ctypes
+import unittest
+
+
+class TestTsFlatSamples(unittest.TestCase):
+
+    def _MakeSpline(self):
+        spline = Ts.Spline()
+        for time, value, interp in [
+                (0.0, 0.0, Ts.InterpCurve),
+                (10.0, 10.0, Ts.InterpHeld),
+                (20.0, 4.0, Ts.InterpCurve),
+                (30.0, 7.0, Ts.InterpCurve)]:
+            spline.SetKnot(Ts.Knot(
+                time = time, value = value, nextInterp = interp,
+                preTanWidth = 3.0, postTanWidth = 3.0))
+        return spline
+
+    def test_MatchesNestedSamples(self):
+        """
+        Flat samples hold the same polylines and sources as nested ones.
+        """
+        spline = self._MakeSpline()
+        interval = Gf.Interval(-10, 40)
+
+        for withSources in (False, True):
+            nested = spline.Sample(interval, 10, 10, 0.5, withSources)
+            flat = spline.SampleFlat(interval, 10, 10, 0.5, withSources)
+            self.assertEqual(flat.withSources, withSources)
+
+            offsets = flat.offsets
+            vertices = flat.vertices
+            self.assertEqual(flat.GetNumPolylines(), len(nested.polylines))
+            self.assertEqual(len(offsets), len(nested.polylines) + 1)
+            self.assertEqual(offsets[-1], vertices.shape[0])
+
+            for i, polyline in enumerate(nested.polylines):
+                self.assertEqual(
+                    flat.GetPolylineSize(i), len(polyline))
+                for j, vertex in enumerate(polyline):
+                    k = offsets[i] + j
+                    self.assertEqual(
+                        (vertices[k, 0], vertices[k, 1]),
+                        (vertex[0], vertex[1]))
+
+            if withSources:
+                self.assertEqual(flat.sources, nested.sources)
+            else:
+                self.assertEqual(flat.sources, [])
+
+    def test_Buffer(self):
+        """
+        The vertices are exported as a read-only N x 2 buffer of doubles,
+        which outlives the reference to the samples object.
+        """
+        spline = self._MakeSpline()
+        view = memoryview(
+            spline.SampleFlat(Gf.Interval(0, 30), 10, 10, 0.5))
+        self.assertEqual(view.format, "d")
+        self.assertEqual(view.ndim, 2)
+        self.assertEqual(view.shape[1], 2)
+        self.assertEqual(view.strides, (16, 8))
+        self.assertTrue(view.readonly)
+        self.assertEqual(view[0, 0], 0.0)
+        self.assertEqual(view[view.shape[0] - 1, 0], 30.0)
+
+        with self.assertRaises(TypeError):
+            view[0, 0] = 1.0
+
+    def test_BufferRequests(self):
+        """
+        Plain requests get the vertices as bytes.  Requests for a shape
+        without a format are refused, since the shape describes doubles.
+        """
+        getBuffer = ctypes.pythonapi.PyObject_GetBuffer
+        getBuffer.argtypes = [ctypes.py_object, ctypes.c_void_p, ctypes.c_int]
+        getBuffer.restype = ctypes.c_int
+        releaseBuffer = ctypes.pythonapi.PyBuffer_Release
+        releaseBuffer.argtypes = [ctypes.c_void_p]
+        releaseBuffer.restype = None
+
+        PyBUF_SIMPLE = 0
+        PyBUF_ND = 0x0008
+
+        flat = self._MakeSpline().SampleFlat(Gf.Interval(0, 30), 10, 10, 0.5)
+        view = ctypes.create_string_buffer(256)
+        self.assertEqual(getBuffer(flat, view, PyBUF_SIMPLE), 0)
+        releaseBuffer(view)
+
+        with self.assertRaises(BufferError):
+            getBuffer(flat, view, PyBUF_ND)
+
+    def test_UniformFlattening(self):
+        """
+        Uniform flattening gives polylines that span the same times, with at
+        least as many vertices as subdivision.
+        """
+        spline = self._MakeSpline()
+        interval = Gf.Interval(0, 30)
+        subdivided = spline.SampleFlat(
+            interval, 10, 10, 0.5,
+            flattening = Ts.BezierFlatteningSubdivide)
+        uniform = spline.SampleFlat(
+            interval, 10, 10, 0.5,
+            flattening = Ts.BezierFlatteningUniform)
+
+        self.assertEqual(
+            uniform.GetNumPolylines(), subdivided.GetNumPolylines())
+        self.assertGreaterEqual(
+            uniform.vertices.shape[0], subdivided.vertices.shape[0])
+        self.assertEqual(uniform.vertices[0, 0], 0.0)
+        self.assertEqual(
+            uniform.vertices[uniform.vertices.shape[0] - 1, 0], 30.0)
+
+    def test_Empty(self):
+        """
+        An empty spline gives no polylines.
+        """
+        flat = Ts.Spline().SampleFlat(Gf.Interval(0, 10), 1, 1, 0.1)
+        self.assertEqual(flat.GetNumPolylines(), 0)
+        self.assertEqual(flat.offsets, [])
+        self.assertEqual(memoryview(flat).shape, (0, 2))
+
+
+if __name__ == "__main__":
+    unittest.main()
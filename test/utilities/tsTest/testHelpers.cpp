@@ -0,0 +1,77 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#include "./testHelpers.h"
+#include "./museum.h"
+#include "./tsEvaluator.h"
+
+#include <pxr/ts/typeHelpers.h>
+#include <pxr/tf/diagnostic.h>
+
+#include <algorithm>
+
+namespace pxr {
+
+
+std::vector<TsTest_MuseumSpline>
+TsTest_GetMuseumSplines()
+{
+    const TsTest_TsEvaluator evaluator;
+
+    std::vector<TsTest_MuseumSpline> result;
+    for (const std::string &name : TsTest_Museum::GetAllNames())
+    {
+        TsSpline spline = evaluator.SplineDataToSpline(
+            TsTest_Museum::GetDataByName(name));
+        if (!spline.IsEmpty())
+        {
+            result.push_back({name, std::move(spline)});
+        }
+    }
+
+    TF_VERIFY(!result.empty());
+    return result;
+}
+
+TsKnot
+TsTest_MakeKnot(
+    const TsTime time,
+    const double value,
+    const TsInterpMode interp)
+{
+    TsKnot knot(Ts_GetType<double>(), TsCurveTypeBezier);
+    knot.SetTime(time);
+    knot.SetValue(value);
+    knot.SetNextInterpolation(interp);
+    return knot;
+}
+
+GfInterval
+TsTest_GetKnotSpan(
+    const TsSpline &spline)
+{
+    GfInterval span = spline.GetKnots().GetTimeSpan();
+    if (spline.HasInnerLoops())
+    {
+        span |= spline.GetInnerLoopParams().GetLoopedInterval();
+    }
+    return span;
+}
+
+GfInterval
+TsTest_GetTestInterval(
+    const TsSpline &spline,
+    const double margin)
+{
+    const GfInterval span = TsTest_GetKnotSpan(spline);
+    const double size = std::max(span.GetSize(), 1.0);
+    return GfInterval(
+        span.GetMin() - margin * size, span.GetMax() + margin * size);
+}
+
+
+}  // namespace pxr
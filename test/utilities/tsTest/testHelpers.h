@@ -0,0 +1,66 @@
+// Copyright 2025 Pixar
+//
+// Licensed under the terms set forth in the LICENSE.txt file available at
+// https://openusd.org/license.
+//
+// Modified by Jeremy Retailleau.
+
+#ifndef PXR_TS_TS_TEST_TEST_HELPERS_H
+#define PXR_TS_TS_TEST_TEST_HELPERS_H
+
+#include "./api.h"
+#include <pxr/ts/knot.h>
+#include <pxr/ts/spline.h>
+#include <pxr/ts/types.h>
+#include <pxr/gf/interval.h>
+
+#include <string>
+#include <vector>
+
+namespace pxr {
+
+
+// A museum exhibit, as a double-valued TsSpline.
+//
+struct TsTest_MuseumSpline
+{
+    std::string name;
+    TsSpline spline;
+};
+
+// Returns all museum exhibits that have knots, converted to TsSplines.
+//
+TS_TEST_API
+std::vector<TsTest_MuseumSpline>
+TsTest_GetMuseumSplines();
+
+// Returns a double-valued Bezier knot with default tangents.
+//
+TS_TEST_API
+TsKnot
+TsTest_MakeKnot(
+    TsTime time,
+    double value,
+    TsInterpMode interp);
+
+// Returns the time span of a spline's knots, extended to cover its inner
+// loops, if any.
+//
+TS_TEST_API
+GfInterval
+TsTest_GetKnotSpan(
+    const TsSpline &spline);
+
+// Returns the knot span of a spline, extended on both sides by margin times
+// its size, or by margin if the span is shorter than 1.
+//
+TS_TEST_API
+GfInterval
+TsTest_GetTestInterval(
+    const TsSpline &spline,
+    double margin);
+
+
+}  // namespace pxr
+
+#endif